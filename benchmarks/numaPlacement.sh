@@ -0,0 +1,40 @@
+#!/bin/bash
+
+#------------------------------------------------------------------------------
+#
+# File: numaPlacement.sh
+# Description: This script compares the interleaved and local (first-touch)
+#              placement of the per-grid-point network rates and diffusion
+#              coefficients on a NUMA node, using the 1D tungsten network
+#              from tungsten_1D.h5. The OpenMP threads are pinned to their
+#              own cores in both cases, only the memory policy changes. It
+#              prints the number of threads Xolotl used and the timers of
+#              the rate computation and of the whole run for each placement.
+# Usage: ./numaPlacement.sh <path to the xolotl executable> [threads] [ranks]
+#
+#------------------------------------------------------------------------------
+
+XOLOTL=$1
+THREADS=${2:-$(nproc)}
+RANKS=${3:-1}
+
+if [ -z "$XOLOTL" ]; then
+	echo "Usage: $0 <path to the xolotl executable> [threads] [ranks]"
+	exit 1
+fi
+
+# Run from this directory so the network file is found
+cd "$(dirname "$0")"
+
+# Xolotl only starts the threads when they are asked for and pinned
+export OMP_NUM_THREADS=$THREADS
+export OMP_PROC_BIND=close
+export OMP_PLACES=cores
+
+for placement in "--interleave=all" "--localalloc"; do
+	echo "Placement: numactl $placement, $RANKS rank(s), $THREADS thread(s)"
+	# Give each rank its own cores (Open MPI syntax)
+	mpirun -np $RANKS --map-by slot:PE=$THREADS --bind-to core \
+		numactl $placement "$XOLOTL" params_PSI_1D_NUMA.txt \
+		| grep -E -A 5 "OpenMP thread|name: (setTemperature|total)$"
+done
@@ -0,0 +1,324 @@
+#!/usr/bin/env python3
+#=======================================================================================
+# perfRegression.py
+# Runs the benchmark parameter files for a fixed number of time steps at the given
+# numbers of MPI ranks, and compares the run time and the retention outputs against
+# stored baselines. Each run keeps its parameter file, its output (with the xolotlPerf
+# report), and its per-timestep solver health (solverHealth.txt) in
+# <workdir>/<case>_np<ranks>/.
+#
+# Usage: ./perfRegression.py <path to the xolotl executable> [options]
+#   --cases PSI2,NE,Iron,800H   the cases to run
+#   --ranks 1,4                 the numbers of MPI ranks
+#   --steps 20                  the number of time steps, 0 to keep the ones of the
+#                               parameter files
+#   --mpirun "mpirun -np {ranks}"
+#   --update-baseline           store the run times as the new baseline instead of
+#                               comparing them
+#
+# The run times are compared with perfBaselines.json, which is only meaningful on the
+# machine it was recorded on: record it with --update-baseline on the cluster the new
+# build is validated on. The retention outputs are compared with the references of
+# this directory, over the time steps both of them have.
+#=======================================================================================
+
+import argparse
+import glob
+import json
+import math
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import time
+
+## The directory of the parameter files and references
+benchmarkDir = os.path.dirname(os.path.abspath(__file__))
+
+## The cases: their parameter file, the output of the retention monitor they use, its
+## reference, and whether the reference can only be compared after the full run
+cases = {
+    'PSI2': {'params': 'params_PSI2.txt', 'output': 'retentionOut.txt',
+             'reference': 'retention_PSI2.txt', 'fullRunOnly': False},
+    'NE': {'params': 'params_NE.txt', 'output': 'retentionOut.txt',
+           'reference': 'retention_NE.txt', 'fullRunOnly': False},
+    'Iron': {'params': 'params_Iron.txt', 'output': 'bubble_*.dat',
+             'reference': 'bubble_Iron.dat', 'fullRunOnly': True},
+    '800H': {'params': 'params_800H.txt', 'output': 'Alloy.dat',
+             'reference': 'Alloy_800H.dat', 'fullRunOnly': False},
+}
+
+## The columns of solverHealth.txt before the time of each rank
+healthColumns = ['step', 'time', 'dt', 'SNESIterations', 'KSPIterations',
+                 'rejectedSteps', 'RHSFunctionCalls', 'RHSJacobianCalls',
+                 'maxRHSTime', 'meanRHSTime', 'imbalance']
+
+
+def writeParams(case, steps, runDir):
+    """Write the parameter file of a run: the one of the case, with the std perf
+    handler, the given number of steps, and the solver health recorded every 10 steps.
+    Returns the number of steps of the run."""
+    lines = []
+    runSteps = steps
+    with open(os.path.join(benchmarkDir, cases[case]['params'])) as paramFile:
+        for line in paramFile:
+            key, _, value = line.strip().partition('=')
+            if key == 'perfHandler':
+                continue
+            if key == 'networkFile':
+                value = os.path.join(benchmarkDir, value)
+            if key == 'petscArgs':
+                args = value.split()
+                if '-ts_max_steps' in args:
+                    i = args.index('-ts_max_steps')
+                    if steps > 0:
+                        args[i + 1] = str(steps)
+                    else:
+                        runSteps = int(args[i + 1])
+                elif steps > 0:
+                    args += ['-ts_max_steps', str(steps)]
+                value = ' '.join(args + ['-solver_health', '10'])
+            lines.append(key + '=' + value)
+    lines.append('perfHandler=std')
+
+    with open(os.path.join(runDir, 'params.txt'), 'w') as paramFile:
+        paramFile.write('\n'.join(lines) + '\n')
+
+    # The TRIDYN profile is read from the working directory
+    shutil.copy(os.path.join(benchmarkDir, 'tridyn.dat'), runDir)
+
+    return runSteps
+
+
+def readTimers(output):
+    """Read the timers of the xolotlPerf report: {name: {statistic: value}}."""
+    timers = {}
+    inTimers = False
+    name = None
+    for line in output.splitlines():
+        if line.strip() in ('Timers:', 'Memory:', 'Counters:', 'HardwareCounters:',
+                            'Phases:'):
+            inTimers = line.strip() == 'Timers:'
+            continue
+        if not inTimers:
+            continue
+        match = re.match(r'\s*(\w+): (.*)$', line)
+        if not match:
+            continue
+        if match.group(1) == 'name':
+            name = match.group(2)
+            timers[name] = {}
+        elif name is not None:
+            timers[name][match.group(1)] = float(match.group(2))
+
+    return timers
+
+
+def readTable(fileName):
+    """Read the rows of numbers of a text output."""
+    rows = []
+    with open(fileName) as dataFile:
+        for line in dataFile:
+            if line.strip():
+                rows.append([float(value) for value in line.split()])
+
+    return rows
+
+
+def compareTables(rows, referenceRows, tolerance):
+    """Compare the rows both tables have, returns the largest relative difference."""
+    maxDiff = 0.0
+    for row, referenceRow in zip(rows, referenceRows):
+        if len(row) != len(referenceRow):
+            return float('inf')
+        for value, reference in zip(row, referenceRow):
+            if math.isnan(value) and math.isnan(reference):
+                continue
+            # Absolute for the values close to zero
+            diff = abs(value - reference) / max(abs(reference), tolerance)
+            if math.isnan(diff):
+                diff = float('inf')
+            maxDiff = max(maxDiff, diff)
+
+    return maxDiff
+
+
+def summarizeHealth(runDir):
+    """Summarize the per-timestep solver health of a run."""
+    fileName = os.path.join(runDir, 'solverHealth.txt')
+    if not os.path.exists(fileName):
+        return {}
+    rows = readTable(fileName)
+    if not rows:
+        return {}
+    column = {name: i for i, name in enumerate(healthColumns)}
+
+    return {
+        'steps': len(rows),
+        'SNESIterations': sum(row[column['SNESIterations']] for row in rows),
+        'rejectedSteps': sum(row[column['rejectedSteps']] for row in rows),
+        'maxImbalance': max(row[column['imbalance']] for row in rows),
+        'meanImbalance': sum(row[column['imbalance']] for row in rows) / len(rows),
+    }
+
+
+def runCase(args, case, ranks):
+    """Run a case and compare it with its baselines."""
+    runDir = os.path.join(args.workdir, '%s_np%d' % (case, ranks))
+    if os.path.exists(runDir):
+        shutil.rmtree(runDir)
+    os.makedirs(runDir)
+    steps = writeParams(case, args.steps, runDir)
+
+    # Run it
+    command = shlex.split(args.mpirun.format(ranks=ranks)) + [args.xolotl, 'params.txt']
+    start = time.time()
+    process = subprocess.run(command, cwd=runDir, stdout=subprocess.PIPE,
+                             stderr=subprocess.STDOUT, universal_newlines=True)
+    wallTime = time.time() - start
+    with open(os.path.join(runDir, 'xolotl.log'), 'w') as logFile:
+        logFile.write(process.stdout)
+
+    result = {'case': case, 'ranks': ranks, 'steps': steps, 'wallTime': wallTime,
+              'status': 'ok', 'notes': []}
+    if process.returncode != 0:
+        result['status'] = 'FAIL'
+        result['notes'].append('exit code %d' % process.returncode)
+        return result
+
+    # The run time, the slowest process of the xolotlPerf total timer
+    timers = readTimers(process.stdout)
+    result['timers'] = timers
+    result['time'] = timers.get('total', {}).get('max', wallTime)
+
+    # The retention
+    config = cases[case]
+    outputs = sorted(glob.glob(os.path.join(runDir, config['output'])),
+                     key=os.path.getmtime)
+    if not outputs:
+        result['status'] = 'FAIL'
+        result['notes'].append('no ' + config['output'])
+    elif config['fullRunOnly'] and args.steps > 0:
+        result['notes'].append('retention not compared before the end of the run')
+    else:
+        rows = readTable(outputs[-1])
+        referenceRows = readTable(os.path.join(benchmarkDir, config['reference']))
+        result['retentionDiff'] = compareTables(rows, referenceRows,
+                                                args.retention_tolerance)
+        if result['retentionDiff'] > args.retention_tolerance:
+            result['status'] = 'FAIL'
+            result['notes'].append('retention differs from ' + config['reference'])
+
+    result['health'] = summarizeHealth(runDir)
+
+    return result
+
+
+def compareTime(result, baselines, tolerance):
+    """Compare the run time with its baseline."""
+    baseline = baselines.get(result['case'], {}).get(str(result['ranks']))
+    if baseline is None or baseline['steps'] != result['steps']:
+        result['notes'].append('no baseline')
+        return
+    result['baseline'] = baseline['time']
+    if result['time'] > baseline['time'] * (1.0 + tolerance):
+        result['status'] = 'SLOW' if result['status'] == 'ok' else result['status']
+        result['notes'].append('%.0f%% slower than the baseline'
+                               % (100.0 * (result['time'] / baseline['time'] - 1.0)))
+
+    return
+
+
+def printSummary(results):
+    """Print a table of the results."""
+    header = '%-6s %5s %6s %10s %10s %9s %9s %10s %6s  %s' % (
+        'case', 'ranks', 'steps', 'time (s)', 'baseline', 'ratio', 'retention',
+        'imbalance', 'status', 'notes')
+    print(header)
+    print('-' * len(header))
+    for result in results:
+        baseline = result.get('baseline')
+        runTime = result.get('time')
+        ratio = runTime / baseline if runTime is not None and baseline else None
+        retention = result.get('retentionDiff')
+        imbalance = result.get('health', {}).get('maxImbalance')
+        print('%-6s %5d %6d %10s %10s %9s %9s %10s %6s  %s' % (
+            result['case'], result['ranks'], result['steps'],
+            '%.3f' % runTime if runTime is not None else '-',
+            '%.3f' % baseline if baseline else '-',
+            '%.3f' % ratio if ratio else '-',
+            '%.1e' % retention if retention is not None else '-',
+            '%.3f' % imbalance if imbalance is not None else '-',
+            result['status'], ', '.join(result['notes'])))
+
+    return
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Performance and retention regression of the benchmarks.')
+    parser.add_argument('xolotl', help='the xolotl executable')
+    parser.add_argument('--cases', default=','.join(cases),
+                        help='the cases to run (%(default)s)')
+    parser.add_argument('--ranks', default='1',
+                        help='the numbers of MPI ranks (%(default)s)')
+    parser.add_argument('--steps', type=int, default=20,
+                        help='the number of time steps, 0 for the ones of the '
+                        'parameter files (%(default)s)')
+    parser.add_argument('--mpirun', default='mpirun -np {ranks}',
+                        help='how to launch the runs (%(default)s)')
+    parser.add_argument('--workdir', default='regressionRuns',
+                        help='where to run them (%(default)s)')
+    parser.add_argument('--baseline',
+                        default=os.path.join(benchmarkDir, 'perfBaselines.json'),
+                        help='the run times of the baseline (%(default)s)')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the run times as the new baseline')
+    parser.add_argument('--time-tolerance', type=float, default=0.1,
+                        help='the relative slowdown allowed (%(default)s)')
+    parser.add_argument('--retention-tolerance', type=float, default=1.0e-3,
+                        help='the relative difference allowed for the retention '
+                        '(%(default)s)')
+    args = parser.parse_args()
+    args.xolotl = os.path.abspath(args.xolotl)
+    args.workdir = os.path.abspath(args.workdir)
+
+    baselines = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as baselineFile:
+            baselines = json.load(baselineFile)
+
+    # Run everything
+    results = []
+    for case in args.cases.split(','):
+        if case not in cases:
+            parser.error('unknown case ' + case)
+        for ranks in [int(n) for n in args.ranks.split(',')]:
+            print('Running %s on %d rank(s)...' % (case, ranks))
+            sys.stdout.flush()
+            result = runCase(args, case, ranks)
+            if 'time' in result:
+                if args.update_baseline:
+                    baselines.setdefault(case, {})[str(ranks)] = {
+                        'steps': result['steps'], 'time': result['time']}
+                else:
+                    compareTime(result, baselines, args.time_tolerance)
+            results.append(result)
+
+    print('')
+    printSummary(results)
+    with open(os.path.join(args.workdir, 'summary.json'), 'w') as summaryFile:
+        json.dump(results, summaryFile, indent=2)
+
+    if args.update_baseline:
+        with open(args.baseline, 'w') as baselineFile:
+            json.dump(baselines, baselineFile, indent=2, sort_keys=True)
+        print('\nBaseline written to ' + args.baseline)
+
+    return 0 if all(result['status'] == 'ok' for result in results) else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
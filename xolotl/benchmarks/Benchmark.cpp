@@ -0,0 +1,331 @@
+// Includes
+#include <mpi.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include "Benchmark.h"
+
+namespace xolotlBenchmark {
+
+/**
+ * A registered benchmark.
+ */
+struct Benchmark {
+	//! The name of the benchmark.
+	std::string name;
+
+	//! The benchmark.
+	Function function;
+
+	//! What it is run for.
+	std::vector<std::string> arguments;
+};
+
+/**
+ * The results of a benchmark for one of its arguments.
+ */
+struct Result {
+	//! The full name, "name/argument".
+	std::string name;
+
+	//! The number of iterations of the last run.
+	std::size_t iterations;
+
+	//! The wall time of an iteration in nanoseconds.
+	double realTime;
+
+	//! The processor time of an iteration in nanoseconds.
+	double cpuTime;
+
+	//! The number of items processed per second, 0 if it is not known.
+	double itemsPerSecond;
+
+	//! What the benchmark said about the run.
+	std::string label;
+
+	//! Why it failed, empty if it did not.
+	std::string error;
+};
+
+/**
+ * Get the registered benchmarks.
+ *
+ * @return The benchmarks
+ */
+static std::vector<Benchmark>& getBenchmarks() {
+	static std::vector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+/**
+ * Write a string in JSON, escaping the quotes, the backslashes, and the
+ * control characters.
+ *
+ * @param os The stream
+ * @param str The string
+ */
+static void writeJSONString(std::ostream& os, const std::string& str) {
+	os << '"';
+	for (auto c : str) {
+		switch (c) {
+		case '"':
+			os << "\\\"";
+			break;
+		case '\\':
+			os << "\\\\";
+			break;
+		case '\b':
+			os << "\\b";
+			break;
+		case '\f':
+			os << "\\f";
+			break;
+		case '\n':
+			os << "\\n";
+			break;
+		case '\r':
+			os << "\\r";
+			break;
+		case '\t':
+			os << "\\t";
+			break;
+		default:
+			if ((unsigned char) c < 0x20) {
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+						(unsigned char) c);
+				os << escaped;
+			} else
+				os << c;
+			break;
+		}
+	}
+	os << '"';
+
+	return;
+}
+
+void State::pauseTiming() {
+	if (!running)
+		return;
+
+	realTime += std::chrono::duration<double>(Clock::now() - realStart).count();
+	cpuTime += (double) (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+	running = false;
+
+	return;
+}
+
+void State::resumeTiming() {
+	if (running)
+		return;
+
+	running = true;
+	cpuStart = std::clock();
+	realStart = Clock::now();
+
+	return;
+}
+
+Registration::Registration(const std::string& name, Function function,
+		const std::vector<std::string>& arguments) {
+	getBenchmarks().push_back( { name, function, arguments });
+}
+
+/**
+ * Run a benchmark for one of its arguments, with more and more iterations
+ * until it runs for at least the minimum time.
+ *
+ * @param benchmark The benchmark
+ * @param argument Its argument
+ * @param minTime The minimum time in seconds
+ * @return The results
+ */
+static Result runBenchmark(const Benchmark& benchmark,
+		const std::string& argument, double minTime) {
+	Result result = { benchmark.name + "/" + argument, 0, 0.0, 0.0, 0.0, "",
+			"" };
+
+	try {
+		std::size_t iterations = 1;
+		while (true) {
+			State state(iterations);
+			benchmark.function(state, argument);
+
+			result.iterations = state.getIterations();
+			result.realTime = 1.0e9 * state.getRealTime() / iterations;
+			result.cpuTime = 1.0e9 * state.getCPUTime() / iterations;
+			result.itemsPerSecond =
+					state.getRealTime() > 0.0 ?
+							state.getItemsPerIteration() * iterations
+									/ state.getRealTime() :
+							0.0;
+			result.label = state.getLabel();
+
+			// Long enough
+			const std::size_t maxIterations = 1000000000;
+			if (state.getRealTime() >= minTime || iterations >= maxIterations)
+				break;
+
+			// Guess how many iterations are needed, without growing too fast
+			// when the first runs are too short to be measured
+			double multiplier = 10.0;
+			if (state.getRealTime() > 0.0)
+				multiplier = std::min(10.0,
+						1.4 * minTime / state.getRealTime());
+			iterations = std::min(maxIterations,
+					std::max(iterations + 1,
+							(std::size_t) (iterations * multiplier)));
+		}
+	} catch (const std::string& error) {
+		result.error = error;
+	} catch (const std::exception& error) {
+		result.error = error.what();
+	}
+
+	return result;
+}
+
+/**
+ * Write the results in the JSON format of Google Benchmark.
+ *
+ * @param fileName The file
+ * @param executable The name of the executable
+ * @param results The results
+ */
+static void writeResults(const std::string& fileName,
+		const std::string& executable, const std::vector<Result>& results) {
+	std::ofstream outputFile(fileName);
+	if (!outputFile) {
+		throw std::string(
+				"\nBenchmark Exception: unable to open " + fileName + ".");
+	}
+
+	std::time_t now = std::time(nullptr);
+	char date[64];
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+	outputFile << std::setprecision(10);
+	outputFile << "{\n  \"context\": {\n    \"date\": \"" << date
+			<< "\",\n    \"executable\": ";
+	writeJSONString(outputFile, executable);
+	outputFile << ",\n    \"num_cpus\": " << std::thread::hardware_concurrency()
+			<< "\n  },\n  \"benchmarks\": [";
+	for (std::size_t i = 0; i < results.size(); i++) {
+		auto const& result = results[i];
+		outputFile << (i == 0 ? "\n" : ",\n") << "    {\n      \"name\": ";
+		writeJSONString(outputFile, result.name);
+		outputFile << ",\n      \"run_name\": ";
+		writeJSONString(outputFile, result.name);
+		if (!result.error.empty()) {
+			outputFile << ",\n      \"error_occurred\": true"
+					<< ",\n      \"error_message\": ";
+			writeJSONString(outputFile, result.error);
+		} else {
+			outputFile << ",\n      \"iterations\": " << result.iterations
+					<< ",\n      \"real_time\": " << result.realTime
+					<< ",\n      \"cpu_time\": " << result.cpuTime
+					<< ",\n      \"time_unit\": \"ns\"";
+			if (result.itemsPerSecond > 0.0)
+				outputFile << ",\n      \"items_per_second\": "
+						<< result.itemsPerSecond;
+			if (!result.label.empty()) {
+				outputFile << ",\n      \"label\": ";
+				writeJSONString(outputFile, result.label);
+			}
+		}
+		outputFile << "\n    }";
+	}
+	outputFile << "\n  ]\n}\n";
+
+	return;
+}
+
+int runBenchmarks(int argc, char **argv) {
+	// Read the options
+	std::string executable = argc > 0 ? argv[0] : "benchmark";
+	std::string filter = ".*";
+	double minTime = 0.5;
+	std::string outputName =
+			executable.substr(executable.find_last_of('/') + 1) + ".json";
+	bool listOnly = false;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		auto value = arg.substr(arg.find('=') + 1);
+		if (arg.find("--benchmark_filter=") == 0)
+			filter = value;
+		else if (arg.find("--benchmark_min_time=") == 0)
+			minTime = std::stod(value);
+		else if (arg.find("--benchmark_out=") == 0)
+			outputName = value;
+		else if (arg == "--benchmark_list_tests")
+			listOnly = true;
+		else {
+			std::cerr << "Unknown option: " << arg << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Run the benchmarks matching the filter
+	std::regex pattern(filter);
+	std::vector<Result> results;
+	std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+			<< std::setw(16) << "Time (ns)" << std::setw(16) << "CPU (ns)"
+			<< std::setw(12) << "Iterations" << std::setw(14) << "Items/s"
+			<< "  Label" << std::endl;
+	for (auto const& benchmark : getBenchmarks()) {
+		for (auto const& argument : benchmark.arguments) {
+			auto name = benchmark.name + "/" + argument;
+			if (!std::regex_search(name, pattern))
+				continue;
+			if (listOnly) {
+				std::cout << name << std::endl;
+				continue;
+			}
+
+			auto result = runBenchmark(benchmark, argument, minTime);
+			std::cout << std::left << std::setw(48) << result.name
+					<< std::right;
+			if (result.error.empty()) {
+				std::cout << std::setw(16) << std::setprecision(6)
+						<< result.realTime << std::setw(16) << result.cpuTime
+						<< std::setw(12) << result.iterations << std::setw(14)
+						<< result.itemsPerSecond << "  " << result.label
+						<< std::endl;
+			} else {
+				std::cout << "  ERROR: " << result.error << std::endl;
+			}
+			results.push_back(result);
+		}
+	}
+
+	// The benchmarks that failed are reported with their error, like the
+	// ones that are skipped with Google Benchmark
+	if (!listOnly)
+		writeResults(outputName, executable, results);
+
+	return EXIT_SUCCESS;
+}
+
+} /* namespace xolotlBenchmark */
+
+int main(int argc, char **argv) {
+	// HDF5 needs MPI to read the networks
+	MPI_Init(&argc, &argv);
+
+	int exitCode = EXIT_FAILURE;
+	try {
+		exitCode = xolotlBenchmark::runBenchmarks(argc, argv);
+	} catch (const std::string& error) {
+		std::cerr << error << std::endl;
+	}
+
+	MPI_Finalize();
+
+	return exitCode;
+}
@@ -0,0 +1,204 @@
+#ifndef XOLOTLBENCHMARK_BENCHMARK_H
+#define XOLOTLBENCHMARK_BENCHMARK_H
+
+// Includes
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace xolotlBenchmark {
+
+/**
+ * This class times the loop of a benchmark. The benchmark prepares what it
+ * needs, then runs the code to time as long as keepRunning() returns true:
+ *
+ *     while (state.keepRunning()) {
+ *         network.computeAllFluxes(updatedConc);
+ *     }
+ *
+ * The clock starts at the first call to keepRunning() and stops when it
+ * returns false, so the preparation is not timed.
+ */
+class State {
+public:
+
+	//! The clock used for the wall time.
+	using Clock = std::chrono::steady_clock;
+
+private:
+
+	//! The number of times the loop has to run.
+	std::size_t maxIterations;
+
+	//! The number of times it ran.
+	std::size_t iterations;
+
+	//! Is the clock running?
+	bool running;
+
+	//! When the clock was started.
+	Clock::time_point realStart;
+
+	//! The processor time when the clock was started.
+	std::clock_t cpuStart;
+
+	//! The wall time spent in the loop, in seconds.
+	double realTime;
+
+	//! The processor time spent in the loop, in seconds.
+	double cpuTime;
+
+	//! The number of items processed by each iteration.
+	double itemsPerIteration;
+
+	//! What the benchmark says about the run.
+	std::string label;
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param _maxIterations The number of times the loop has to run
+	 */
+	explicit State(std::size_t _maxIterations) :
+			maxIterations(_maxIterations), iterations(0), running(false), cpuStart(
+					0), realTime(0.0), cpuTime(0.0), itemsPerIteration(0.0) {
+	}
+
+	/**
+	 * Should the loop run one more time?
+	 *
+	 * @return True if it should
+	 */
+	bool keepRunning() {
+		if (iterations == 0 && !running)
+			resumeTiming();
+		if (iterations < maxIterations) {
+			iterations++;
+			return true;
+		}
+		pauseTiming();
+		return false;
+	}
+
+	/**
+	 * Stop the clock, to prepare the next iteration without timing it.
+	 */
+	void pauseTiming();
+
+	/**
+	 * Start the clock again.
+	 */
+	void resumeTiming();
+
+	/**
+	 * Set the number of items (clusters, grid points, ...) each iteration
+	 * processes, to report the throughput.
+	 *
+	 * @param items The number of items
+	 */
+	void setItemsPerIteration(double items) {
+		itemsPerIteration = items;
+	}
+
+	/**
+	 * Say something about the run, the size of the network for instance.
+	 *
+	 * @param _label The label
+	 */
+	void setLabel(const std::string& _label) {
+		label = _label;
+	}
+
+	/**
+	 * Get the number of times the loop ran.
+	 *
+	 * @return The number of iterations
+	 */
+	std::size_t getIterations() const {
+		return iterations;
+	}
+
+	/**
+	 * Get the wall time spent in the loop.
+	 *
+	 * @return The time in seconds
+	 */
+	double getRealTime() const {
+		return realTime;
+	}
+
+	/**
+	 * Get the processor time spent in the loop.
+	 *
+	 * @return The time in seconds
+	 */
+	double getCPUTime() const {
+		return cpuTime;
+	}
+
+	/**
+	 * Get the number of items processed by each iteration.
+	 *
+	 * @return The number of items, 0 if it was not set
+	 */
+	double getItemsPerIteration() const {
+		return itemsPerIteration;
+	}
+
+	/**
+	 * Get what the benchmark said about the run.
+	 *
+	 * @return The label
+	 */
+	const std::string& getLabel() const {
+		return label;
+	}
+};
+
+//! A benchmark, called with the argument it is run for.
+using Function = std::function<void(State&, const std::string&)>;
+
+/**
+ * This class registers a benchmark when it is constructed, it is meant to
+ * be declared as a static variable next to the benchmark:
+ *
+ *     static Registration fluxes("computeAllFluxes", benchmarkFluxes,
+ *             getNetworkPresets());
+ */
+class Registration {
+public:
+
+	/**
+	 * The constructor registers the benchmark, it will be run once for
+	 * each argument and named "name/argument".
+	 *
+	 * @param name The name of the benchmark
+	 * @param function The benchmark
+	 * @param arguments What it is run for
+	 */
+	Registration(const std::string& name, Function function,
+			const std::vector<std::string>& arguments);
+};
+
+/**
+ * Run the registered benchmarks, printing a table of the results and
+ * writing them in the JSON format of Google Benchmark. The options are:
+ *   --benchmark_filter=<regex>   only run the benchmarks matching it
+ *   --benchmark_min_time=<s>     run each one at least this long (0.5s)
+ *   --benchmark_out=<file>       where to write the JSON
+ *                                (<executable>.json)
+ *   --benchmark_list_tests       only print the names of the benchmarks
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The exit code
+ */
+int runBenchmarks(int argc, char **argv);
+
+} /* namespace xolotlBenchmark */
+
+#endif // XOLOTLBENCHMARK_BENCHMARK_H
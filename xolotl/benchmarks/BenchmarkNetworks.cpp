@@ -0,0 +1,201 @@
+// Includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <HDF5NetworkLoader.h>
+#include <Options.h>
+#include <DummyHandlerRegistry.h>
+#include "BenchmarkNetworks.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace xolotlBenchmark {
+
+/**
+ * A network to benchmark, named after what it comes from.
+ */
+struct NetworkPreset {
+	//! The name of the network.
+	std::string name;
+
+	//! The lines of the parameter file that define it.
+	std::string parameters;
+};
+
+/**
+ * Get the definitions of the networks.
+ *
+ * @return The definitions
+ */
+static const std::vector<NetworkPreset>& getNetworkDefinitions() {
+	static const std::vector<NetworkPreset> definitions = {
+			// The network of the tests
+			{ "PSI_He8V5", "netParam=8 0 0 5 0\n" },
+			// With interstitials
+			{ "PSI_He8V20I6", "netParam=8 0 0 20 6\n" },
+			// The one of params_PSI2.txt
+			{ "PSI2_He8V50I6", "netParam=8 0 0 50 6\ngrouping=31 4 4\n" },
+			// A bigger grouped network
+			{ "PSI_He8V250I6", "netParam=8 0 0 250 6\ngrouping=31 4 4\n" },
+			// The network file of the benchmarks
+			{ "tungsten_1D", "networkFile=" XOLOTL_BENCHMARK_DATA_DIR
+					"/tungsten_1D.h5\n" } };
+	return definitions;
+}
+
+const std::vector<std::string>& getNetworkPresets() {
+	static std::vector<std::string> presets;
+	if (presets.empty()) {
+		for (auto const& definition : getNetworkDefinitions()) {
+			presets.push_back(definition.name);
+		}
+	}
+
+	return presets;
+}
+
+/**
+ * Read the options of a network.
+ *
+ * @param parameters The lines of the parameter file that define it
+ * @param options The options to fill
+ */
+static void readOptions(const std::string& parameters,
+		xolotlCore::Options& options) {
+	// Create the parameter file
+	std::string parameterFile = "benchmarkParams.txt";
+	std::ofstream paramFile(parameterFile);
+	paramFile << parameters;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForBenchmarks";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+	options.readParams(argc, argv);
+
+	delete[] argv[0];
+	delete[] argv[1];
+	delete[] argv;
+	std::remove(parameterFile.c_str());
+
+	return;
+}
+
+std::string BenchmarkNetwork::describe() const {
+	std::ostringstream os;
+	os << "size=" << network->size() << " dof=" << dof << " partials="
+			<< partialsIndices.size();
+	return os.str();
+}
+
+/**
+ * Build a network and prepare it for the benchmarks.
+ *
+ * @param preset The name of the network
+ * @return The network
+ */
+static BenchmarkNetwork buildNetwork(const std::string& preset) {
+	// Find its definition
+	auto const& definitions = getNetworkDefinitions();
+	auto definition = std::find_if(definitions.begin(), definitions.end(),
+			[&preset](const NetworkPreset& def) {
+				return def.name == preset;
+			});
+	if (definition == definitions.end()) {
+		throw std::string(
+				"\nBenchmark Exception: unknown network \"" + preset + "\".");
+	}
+	xolotlCore::Options options;
+	readOptions(definition->parameters, options);
+
+	// Load or generate it the way the PSI reaction handler factory does
+	auto loader = xolotlCore::HDF5NetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	loader.setFilename(options.getNetworkFilename());
+	loader.setVMin(options.getGroupingMin());
+	loader.setWidth(options.getGroupingWidthA(), 0);
+	loader.setWidth(options.getGroupingWidthA(), 1);
+	loader.setWidth(options.getGroupingWidthA(), 2);
+	loader.setWidth(options.getGroupingWidthB(), 3);
+	BenchmarkNetwork benchmarkNetwork;
+	if (options.useHDF5())
+		benchmarkNetwork.network = loader.load(options);
+	else
+		benchmarkNetwork.network = loader.generate(options);
+	auto& network = *benchmarkNetwork.network;
+	if (network.size() == 0) {
+		throw std::string(
+				"\nBenchmark Exception: the network \"" + preset
+						+ "\" is empty.");
+	}
+
+	// Prepare it like the solver handlers do
+	network.reinitializeConnectivities();
+	benchmarkNetwork.dof = network.getDOF();
+#ifdef _OPENMP
+	// Like xolotl, one thread unless OMP_NUM_THREADS asks for more
+	if (std::getenv("OMP_NUM_THREADS"))
+		network.setNumThreads(omp_get_max_threads());
+#endif
+	network.addGridPoints(BenchmarkNetwork::nGridPoints);
+	for (int i = 0; i < BenchmarkNetwork::nGridPoints; i++) {
+		network.setTemperature(1000.0, i);
+	}
+
+	// Some concentration everywhere
+	int size = BenchmarkNetwork::nGridPoints * benchmarkNetwork.dof;
+	for (int i = 0; i < size; i++) {
+		benchmarkNetwork.concentrations.push_back(
+				1.0e-3 / (1 + i % benchmarkNetwork.dof));
+	}
+	benchmarkNetwork.updatedConcentrations.resize(size, 0.0);
+
+	// The arrays for the partial derivatives
+	xolotlCore::IReactionNetwork::SparseFillMap dfill;
+	network.getDiagonalFill(dfill);
+	benchmarkNetwork.partialsSizes.resize(benchmarkNetwork.dof);
+	benchmarkNetwork.partialsStartingIdx.resize(benchmarkNetwork.dof);
+	auto nPartials = network.initPartialsSizes(benchmarkNetwork.partialsSizes,
+			benchmarkNetwork.partialsStartingIdx);
+	benchmarkNetwork.partialsIndices.resize(nPartials);
+	network.initPartialsIndices(benchmarkNetwork.partialsSizes,
+			benchmarkNetwork.partialsStartingIdx,
+			benchmarkNetwork.partialsIndices);
+	benchmarkNetwork.partialsValues.resize(nPartials);
+
+	return benchmarkNetwork;
+}
+
+BenchmarkNetwork& getNetwork(const std::string& preset) {
+	static std::map<std::string, BenchmarkNetwork> networks;
+	auto it = networks.find(preset);
+	if (it != networks.end())
+		return it->second;
+
+	// Don't try to load a network twice
+	static std::map<std::string, std::string> errors;
+	auto error = errors.find(preset);
+	if (error != errors.end())
+		throw error->second;
+	try {
+		return networks.emplace(preset, buildNetwork(preset)).first->second;
+	} catch (const std::string& message) {
+		errors[preset] = message;
+	} catch (const std::exception& exception) {
+		errors[preset] = exception.what();
+	}
+	throw errors[preset];
+}
+
+} /* namespace xolotlBenchmark */
@@ -0,0 +1,72 @@
+#ifndef XOLOTLBENCHMARK_BENCHMARKNETWORKS_H
+#define XOLOTLBENCHMARK_BENCHMARKNETWORKS_H
+
+// Includes
+#include <memory>
+#include <string>
+#include <vector>
+#include <IReactionNetwork.h>
+
+namespace xolotlBenchmark {
+
+/**
+ * A network ready to be benchmarked, with the concentrations of three grid
+ * points (left, middle, right) at 1000K and the arrays for the partial
+ * derivatives of the reactions.
+ */
+struct BenchmarkNetwork {
+	//! The number of grid points.
+	static const int nGridPoints = 3;
+
+	//! The network.
+	std::unique_ptr<xolotlCore::IReactionNetwork> network;
+
+	//! The number of degrees of freedom.
+	int dof;
+
+	//! The concentrations of all the grid points.
+	std::vector<double> concentrations;
+
+	//! The updated concentrations of all the grid points.
+	std::vector<double> updatedConcentrations;
+
+	//! The number of partials for each cluster.
+	std::vector<int> partialsSizes;
+
+	//! Where the partials of each cluster start.
+	std::vector<size_t> partialsStartingIdx;
+
+	//! The indices of the partials.
+	std::vector<int> partialsIndices;
+
+	//! The values of the partials.
+	std::vector<double> partialsValues;
+
+	/**
+	 * Describe the network for the label of the benchmarks.
+	 *
+	 * @return The description
+	 */
+	std::string describe() const;
+};
+
+/**
+ * Get the names of the networks the kernels are benchmarked with: the
+ * networks generated from the netParam of a few problems, from the
+ * smallest to the largest, and the one of benchmarks/tungsten_1D.h5.
+ *
+ * @return The names
+ */
+const std::vector<std::string>& getNetworkPresets();
+
+/**
+ * Get a network, building it the first time it is asked for.
+ *
+ * @param preset The name of the network
+ * @return The network
+ */
+BenchmarkNetwork& getNetwork(const std::string& preset);
+
+} /* namespace xolotlBenchmark */
+
+#endif // XOLOTLBENCHMARK_BENCHMARKNETWORKS_H
@@ -0,0 +1,157 @@
+// Includes
+#include <mpi.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <XFile.h>
+#include "Benchmark.h"
+#include "BenchmarkNetworks.h"
+
+using namespace xolotlBenchmark;
+
+/**
+ * The checkpoints of the 1D tungsten problem: the network of
+ * benchmarks/tungsten_1D.h5 on the 51 grid points of its header.
+ */
+struct CheckpointData {
+	//! The number of grid points.
+	static const int nGridPoints = 51;
+
+	//! The step size.
+	static constexpr double hx = 0.5;
+
+	//! The grid.
+	std::vector<double> grid;
+
+	//! The compositions of the clusters.
+	std::vector<std::vector<int> > compositions;
+
+	//! The first grid point of this process.
+	int baseX;
+
+	//! The concentrations of the grid points of this process above 1e-16,
+	//! as the startStop monitors keep them.
+	xolotlCore::XFile::TimestepGroup::Concs1DType concs;
+
+	//! The number of concentrations of all the processes.
+	long long nValues;
+};
+
+/**
+ * Get the checkpoint data, building it the first time.
+ *
+ * The concentrations decrease with the size of the clusters and the depth,
+ * with some noise in the mantissa so that they don't compress better than
+ * the ones of a run. Each process gets a contiguous block of grid points,
+ * like the DMDA gives them.
+ *
+ * @return The data
+ */
+static CheckpointData& getCheckpointData() {
+	static CheckpointData data;
+	if (!data.grid.empty())
+		return data;
+
+	auto& benchmarkNetwork = getNetwork("tungsten_1D");
+	data.compositions = benchmarkNetwork.network->getCompositionList();
+	int dof = benchmarkNetwork.dof;
+
+	for (int i = 0; i < CheckpointData::nGridPoints + 2; i++) {
+		data.grid.push_back((double) i * CheckpointData::hx);
+	}
+
+	// Our grid points
+	int procId, nProcs;
+	MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+	MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+	data.baseX = procId * CheckpointData::nGridPoints / nProcs;
+	int endX = (procId + 1) * CheckpointData::nGridPoints / nProcs;
+
+	// The same values on every run
+	std::mt19937 generator(procId);
+	std::uniform_real_distribution<double> noise(0.9, 1.1);
+	long long nValues = 0;
+	for (int i = data.baseX; i < endX; i++) {
+		data.concs.emplace_back();
+		for (int l = 0; l < dof; l++) {
+			double conc = 1.0e-3 * std::exp(-0.05 * l - 0.2 * i)
+					* noise(generator);
+			if (conc > 1.0e-16)
+				data.concs.back().emplace_back(l, conc);
+		}
+		nValues += data.concs.back().size();
+	}
+	MPI_Allreduce(&nValues, &data.nValues, 1, MPI_LONG_LONG, MPI_SUM,
+			MPI_COMM_WORLD);
+
+	return data;
+}
+
+/**
+ * Get the size of a file.
+ *
+ * @param fileName The name of the file
+ * @return The size in bytes
+ */
+static long long getFileSize(const std::string& fileName) {
+	std::FILE* file = std::fopen(fileName.c_str(), "rb");
+	if (!file)
+		return 0;
+	std::fseek(file, 0, SEEK_END);
+	long long size = std::ftell(file);
+	std::fclose(file);
+
+	return size;
+}
+
+/**
+ * Time the write of the concentration checkpoints at a deflate level,
+ * each one flushed like the startStop monitors do by default. The label
+ * gives the size each checkpoint adds to the file.
+ *
+ * @param state The state of the benchmark
+ * @param level The deflate level, 0 for no compression
+ */
+static void benchmarkWriteCheckpoint(State& state, const std::string& level) {
+	auto& data = getCheckpointData();
+	int compressionLevel = std::stoi(level);
+	const std::string fileName = "benchmarkCheckpoint.h5";
+
+	long long emptySize = 0, fullSize = 0;
+	int timeStep = 0;
+	{
+		// Create the checkpoint file
+		xolotlCore::XFile checkpointFile(fileName, data.grid,
+				data.compositions);
+		checkpointFile.Flush();
+		emptySize = getFileSize(fileName);
+
+		auto concGroup = checkpointFile.getGroup<
+				xolotlCore::XFile::ConcentrationGroup>();
+		while (state.keepRunning()) {
+			auto tsGroup = concGroup->addTimestepGroup(timeStep,
+					(double) timeStep, (double) timeStep - 1.0, 1.0);
+			tsGroup->writeConcentrations(checkpointFile, data.baseX,
+					data.concs, compressionLevel);
+			checkpointFile.Flush();
+			timeStep++;
+		}
+	}
+	fullSize = getFileSize(fileName);
+	std::remove(fileName.c_str());
+
+	std::ostringstream label;
+	label << "values=" << data.nValues << " bytes/checkpoint="
+			<< (fullSize - emptySize) / std::max(timeStep, 1)
+			<< " raw="
+			<< data.nValues * (sizeof(int) + sizeof(double));
+	state.setItemsPerIteration(data.nValues);
+	state.setLabel(label.str());
+
+	return;
+}
+
+static Registration writeCheckpoint("writeCheckpoint",
+		benchmarkWriteCheckpoint, { "0", "1", "4", "6", "9" });
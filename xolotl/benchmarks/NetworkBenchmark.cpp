@@ -0,0 +1,135 @@
+// Includes
+#include "Benchmark.h"
+#include "BenchmarkNetworks.h"
+
+using namespace xolotlBenchmark;
+
+/**
+ * Time the fluxes of all the reactions at the middle grid point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkFluxes(State& state, const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	int dof = benchmarkNetwork.dof;
+	network.updateConcentrationsFromArray(
+			benchmarkNetwork.concentrations.data() + dof);
+	double *updatedConcOffset = benchmarkNetwork.updatedConcentrations.data()
+			+ dof;
+
+	while (state.keepRunning()) {
+		network.computeAllFluxes(updatedConcOffset, 1);
+	}
+
+	state.setItemsPerIteration(dof);
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time the partial derivatives of all the reactions at the middle grid
+ * point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkPartials(State& state, const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	network.updateConcentrationsFromArray(
+			benchmarkNetwork.concentrations.data() + benchmarkNetwork.dof);
+
+	while (state.keepRunning()) {
+		network.computeAllPartials(benchmarkNetwork.partialsStartingIdx,
+				benchmarkNetwork.partialsIndices,
+				benchmarkNetwork.partialsValues, 1);
+	}
+
+	state.setItemsPerIteration(benchmarkNetwork.partialsIndices.size());
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time a change of temperature at the middle grid point, which updates the
+ * diffusion coefficients and the rate constants.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkSetTemperature(State& state, const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+
+	// Change the temperature every time
+	double temperature = 1000.0;
+	while (state.keepRunning()) {
+		temperature = 2000.0 - temperature;
+		network.setTemperature(temperature, 1);
+	}
+	network.setTemperature(1000.0, 1);
+
+	state.setItemsPerIteration(benchmarkNetwork.dof);
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time the rate constants at the middle grid point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkRateConstants(State& state, const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+
+	while (state.keepRunning()) {
+		network.computeRateConstants(1);
+	}
+
+	state.setItemsPerIteration(benchmarkNetwork.dof);
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time the copy of the concentrations of the middle grid point to the
+ * network.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkUpdateConcentrations(State& state,
+		const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	double *concOffset = benchmarkNetwork.concentrations.data()
+			+ benchmarkNetwork.dof;
+
+	while (state.keepRunning()) {
+		network.updateConcentrationsFromArray(concOffset);
+	}
+
+	state.setItemsPerIteration(benchmarkNetwork.dof);
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+static Registration fluxes("computeAllFluxes", benchmarkFluxes,
+		getNetworkPresets());
+static Registration partials("computeAllPartials", benchmarkPartials,
+		getNetworkPresets());
+static Registration setTemperature("setTemperature", benchmarkSetTemperature,
+		getNetworkPresets());
+static Registration rateConstants("computeRateConstants",
+		benchmarkRateConstants, getNetworkPresets());
+static Registration updateConcentrations("updateConcentrationsFromArray",
+		benchmarkUpdateConcentrations, getNetworkPresets());
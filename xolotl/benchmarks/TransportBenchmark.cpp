@@ -0,0 +1,181 @@
+// Includes
+#include <Diffusion1DHandler.h>
+#include <W100AdvectionHandler.h>
+#include "Benchmark.h"
+#include "BenchmarkNetworks.h"
+
+using namespace xolotlBenchmark;
+
+/**
+ * The pointers to the concentrations of the middle, left, and right grid
+ * points, and the step size, as the 1D solver handler gives them to the
+ * diffusion and advection handlers.
+ */
+struct Stencil {
+	//! The concentrations at the middle, left, and right grid points.
+	double *concVector[3];
+
+	//! The updated concentrations at the middle grid point.
+	double *updatedConcOffset;
+
+	//! The step size.
+	double hx;
+
+	//! The grid.
+	std::vector<double> grid;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param benchmarkNetwork The network with the concentrations
+	 */
+	Stencil(BenchmarkNetwork& benchmarkNetwork) :
+			hx(1.0) {
+		int dof = benchmarkNetwork.dof;
+		double *conc = benchmarkNetwork.concentrations.data();
+		concVector[0] = conc + dof; // middle
+		concVector[1] = conc; // left
+		concVector[2] = conc + 2 * dof; // right
+		updatedConcOffset = benchmarkNetwork.updatedConcentrations.data() + dof;
+		for (int l = 0; l < BenchmarkNetwork::nGridPoints + 2; l++) {
+			grid.push_back((double) l * hx);
+		}
+	}
+};
+
+/**
+ * Time the diffusion at the middle grid point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkDiffusion(State& state, const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	Stencil stencil(benchmarkNetwork);
+
+	xolotlCore::Diffusion1DHandler diffusionHandler;
+	xolotlCore::IReactionNetwork::SparseFillMap ofill;
+	std::vector<xolotlCore::IAdvectionHandler *> advectionHandlers;
+	diffusionHandler.initializeOFill(network, ofill);
+	diffusionHandler.initializeDiffusionGrid(advectionHandlers, stencil.grid,
+			BenchmarkNetwork::nGridPoints, 0);
+
+	while (state.keepRunning()) {
+		diffusionHandler.computeDiffusion(network, stencil.concVector,
+				stencil.updatedConcOffset, stencil.hx, stencil.hx, 0);
+	}
+
+	state.setItemsPerIteration(diffusionHandler.getNumberOfDiffusing());
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time the partial derivatives of the diffusion at the middle grid point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkDiffusionPartials(State& state,
+		const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	Stencil stencil(benchmarkNetwork);
+
+	xolotlCore::Diffusion1DHandler diffusionHandler;
+	xolotlCore::IReactionNetwork::SparseFillMap ofill;
+	std::vector<xolotlCore::IAdvectionHandler *> advectionHandlers;
+	diffusionHandler.initializeOFill(network, ofill);
+	diffusionHandler.initializeDiffusionGrid(advectionHandlers, stencil.grid,
+			BenchmarkNetwork::nGridPoints, 0);
+	int nDiff = diffusionHandler.getNumberOfDiffusing();
+	std::vector<int> indices(nDiff);
+	std::vector<double> values(3 * nDiff);
+
+	while (state.keepRunning()) {
+		diffusionHandler.computePartialsForDiffusion(network, values.data(),
+				indices.data(), stencil.hx, stencil.hx, 0);
+	}
+
+	state.setItemsPerIteration(nDiff);
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time the advection toward the surface at the middle grid point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkAdvection(State& state, const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	Stencil stencil(benchmarkNetwork);
+
+	xolotlCore::W100AdvectionHandler advectionHandler;
+	xolotlCore::IReactionNetwork::SparseFillMap ofill;
+	std::vector<xolotlCore::IAdvectionHandler *> advectionHandlers;
+	advectionHandler.initialize(network, ofill);
+	advectionHandler.initializeAdvectionGrid(advectionHandlers, stencil.grid,
+			BenchmarkNetwork::nGridPoints, 0);
+	xolotlCore::Point<3> gridPosition { stencil.hx, 0.0, 0.0 };
+
+	while (state.keepRunning()) {
+		advectionHandler.computeAdvection(network, gridPosition,
+				stencil.concVector, stencil.updatedConcOffset, stencil.hx,
+				stencil.hx, 0);
+	}
+
+	state.setItemsPerIteration(advectionHandler.getNumberOfAdvecting());
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+/**
+ * Time the partial derivatives of the advection toward the surface at the
+ * middle grid point.
+ *
+ * @param state The state of the benchmark
+ * @param preset The network
+ */
+static void benchmarkAdvectionPartials(State& state,
+		const std::string& preset) {
+	auto& benchmarkNetwork = getNetwork(preset);
+	auto& network = *benchmarkNetwork.network;
+	Stencil stencil(benchmarkNetwork);
+
+	xolotlCore::W100AdvectionHandler advectionHandler;
+	xolotlCore::IReactionNetwork::SparseFillMap ofill;
+	std::vector<xolotlCore::IAdvectionHandler *> advectionHandlers;
+	advectionHandler.initialize(network, ofill);
+	advectionHandler.initializeAdvectionGrid(advectionHandlers, stencil.grid,
+			BenchmarkNetwork::nGridPoints, 0);
+	xolotlCore::Point<3> gridPosition { stencil.hx, 0.0, 0.0 };
+	int nAdvec = advectionHandler.getNumberOfAdvecting();
+	std::vector<int> indices(nAdvec);
+	std::vector<double> values(2 * nAdvec);
+
+	while (state.keepRunning()) {
+		advectionHandler.computePartialsForAdvection(network, values.data(),
+				indices.data(), gridPosition, stencil.hx, stencil.hx, 0);
+	}
+
+	state.setItemsPerIteration(nAdvec);
+	state.setLabel(benchmarkNetwork.describe());
+
+	return;
+}
+
+static Registration diffusion("computeDiffusion", benchmarkDiffusion,
+		getNetworkPresets());
+static Registration diffusionPartials("computePartialsForDiffusion",
+		benchmarkDiffusionPartials, getNetworkPresets());
+static Registration advection("computeAdvection", benchmarkAdvection,
+		getNetworkPresets());
+static Registration advectionPartials("computePartialsForAdvection",
+		benchmarkAdvectionPartials, getNetworkPresets());
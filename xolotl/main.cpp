@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <cassert>
 #include <Reactant.h>
 #include <PetscSolver.h>
@@ -20,6 +21,13 @@
 #include <ISolverHandler.h>
 #include <IReactionHandlerFactory.h>
 #include <ctime>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using std::shared_ptr;
@@ -35,6 +43,74 @@ void printStartMessage() {
 	std::cout << std::asctime(std::localtime(&currentTime)); // << std::endl;
 }
 
+//! This operation chooses the number of OpenMP threads computing the network rates of each process.
+int getNetworkThreads(int rank) {
+	int nThreads = 1;
+#ifdef _OPENMP
+	// Every process would start a thread per core of the node, only use
+	// more than one when the user asks for them
+	int requested = 1;
+	if (std::getenv("OMP_NUM_THREADS"))
+		requested = omp_get_max_threads();
+
+	// The number of processes on our node
+	MPI_Comm nodeComm;
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank,
+			MPI_INFO_NULL, &nodeComm);
+	int nNodeProcs = 1;
+	MPI_Comm_size(nodeComm, &nNodeProcs);
+	MPI_Comm_free(&nodeComm);
+
+	// The threads only keep the rates they first touched on their NUMA node
+	// if they are pinned to their own cores
+	std::ostringstream reason;
+	if (requested > 1) {
+		if (omp_get_proc_bind() == omp_proc_bind_false) {
+			reason << "they are not pinned, set OMP_PROC_BIND=close and "
+					"OMP_PLACES=cores";
+		} else if (omp_get_num_places() < requested) {
+			reason << "there are only " << omp_get_num_places()
+					<< " places for them, set OMP_PLACES=cores";
+		}
+#ifdef __linux__
+		// The processes of a node must not share their cores
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		if (reason.str().empty() && nNodeProcs > 1
+				&& sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0
+				&& CPU_COUNT(&cpuSet) >= sysconf(_SC_NPROCESSORS_ONLN)) {
+			reason << "the " << nNodeProcs << " processes of the node are "
+					"not bound to different cores";
+		}
+#endif
+		if (reason.str().empty())
+			nThreads = requested;
+	}
+
+	// Use the threads only if every process can
+	int minThreads = nThreads, maxRequested = requested;
+	MPI_Allreduce(&nThreads, &minThreads, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	MPI_Allreduce(&requested, &maxRequested, 1, MPI_INT, MPI_MAX,
+			MPI_COMM_WORLD);
+	if (minThreads < maxRequested) {
+		nThreads = 1;
+		if (rank == 0) {
+			std::cout << "Warning: using one OpenMP thread per process "
+					"instead of " << maxRequested << " because "
+					<< (reason.str().empty() ?
+							std::string("the threads of some processes are "
+									"not pinned to their own cores") :
+							reason.str()) << "." << std::endl;
+		}
+	} else if (rank == 0 && nThreads > 1) {
+		std::cout << "Using " << nThreads << " pinned OpenMP threads per "
+				"process for the network rates." << std::endl;
+	}
+#endif
+
+	return nThreads;
+}
+
 std::shared_ptr<xolotlFactory::IMaterialFactory> initMaterial(
 		const Options &options) {
 	// Create the material factory
@@ -110,6 +186,92 @@ void launchPetscSolver(xolotlSolver::PetscSolver& solver,
 	solverTimer->stop();
 }
 
+//! Report the memory the most loaded process would use, without solving.
+void reportProjectedMemory(const Options& options,
+		xolotlCore::IReactionNetwork& network) {
+	int rank, nProcs;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+
+	// The grid points of this process, PETSc splits the grid evenly
+	int dim = options.getDimensionNumber();
+	long long nGridPoints = 1;
+	if (dim > 0)
+		nGridPoints *= options.getNX();
+	if (dim > 1)
+		nGridPoints *= options.getNY();
+	if (dim > 2)
+		nGridPoints *= options.getNZ();
+	long long nLocalPoints = (nGridPoints + nProcs - 1) / nProcs;
+
+	// The network keeps its rates along x only, with a ghost point on each
+	// side. In 2D and 3D the split of x is not known yet, take all of it.
+	int nRatePoints = 1;
+	if (dim == 1)
+		nRatePoints = nLocalPoints + 2;
+	else if (dim > 1)
+		nRatePoints = options.getNX() + 2;
+
+	// The nonzeros of a grid point: the reactions, and the diffusing
+	// clusters coupled to each neighbor
+	xolotlCore::IReactionNetwork::SparseFillMap dfill;
+	network.getDiagonalFill(dfill);
+	std::size_t nNonzeros = 0;
+	for (auto const& row : dfill) {
+		nNonzeros += row.second.size();
+	}
+	int nDiffusing = 0;
+	for (IReactant const& reactant : network.getAll()) {
+		if (reactant.getDiffusionFactor() > 0.0)
+			nDiffusing++;
+	}
+	nNonzeros += 2 * dim * nDiffusing;
+	const int dof = network.getDOF();
+
+	// What the network already uses, then the projections
+	auto& tracker = xperf::getMemoryTracker();
+	const int nCategories = (int) xperf::MemoryCategory::Count;
+	std::vector<long long> bytes(nCategories + 1, 0);
+	for (int i = 0; i < nCategories; i++) {
+		bytes[i] = tracker.getPeak((xperf::MemoryCategory) i);
+	}
+	bytes[(int) xperf::MemoryCategory::GridPointRates] =
+			network.getGridPointMemorySize(nRatePoints);
+	bytes[(int) xperf::MemoryCategory::Jacobian] =
+			xolotlSolver::PetscSolver::getJacobianMemorySize(
+					dof * nLocalPoints, nNonzeros * nLocalPoints);
+	// The two concentration snapshots of the checkpoints
+	bytes[(int) xperf::MemoryCategory::IO] = std::max(
+			bytes[(int) xperf::MemoryCategory::IO],
+			(long long) (2 * dof * nLocalPoints * sizeof(double)));
+	for (int i = 0; i < nCategories; i++) {
+		bytes[nCategories] += bytes[i];
+	}
+
+	// The most loaded process
+	std::vector<long long> maxBytes(nCategories + 1, 0);
+	MPI_Reduce(bytes.data(), maxBytes.data(), nCategories + 1, MPI_LONG_LONG,
+	MPI_MAX, 0, MPI_COMM_WORLD);
+
+	if (rank == 0) {
+		std::cout << "\nProjected memory per process (bytes) on " << nProcs
+				<< " processes, " << nGridPoints << " grid points, " << dof
+				<< " degrees of freedom:" << std::endl;
+		for (int i = 0; i < nCategories; i++) {
+			std::cout << "  "
+					<< xperf::getMemoryCategoryName((xperf::MemoryCategory) i)
+					<< ": " << maxBytes[i] << std::endl;
+		}
+		std::cout << "  total: " << maxBytes[nCategories] << std::endl;
+		std::cout << "  solution vector: " << dof * nLocalPoints * sizeof(double)
+				<< " for each of the vectors of the time stepper" << std::endl;
+		std::cout << "Multiply by the processes per node to compare with the "
+				"memory of a node." << std::endl;
+	}
+
+	return;
+}
+
 //! Run the Xolotl simulation.
 int runXolotl(const Options& opts) {
 
@@ -124,6 +286,8 @@ int runXolotl(const Options& opts) {
 		// Print the start message
 		printStartMessage();
 	}
+	// Check the threads placement
+	int nThreads = getNetworkThreads(rank);
 
 	// Set up the material infrastructure that is used to calculate flux
 	auto material = initMaterial(opts);
@@ -163,6 +327,13 @@ int runXolotl(const Options& opts) {
 		std::cout << std::asctime(std::localtime(&currentTime));
 	}
 	auto& network = networkFactory->getNetworkHandler();
+	network.setNumThreads(nThreads);
+
+	// Only report the memory the run would use
+	if (opts.isDryRun()) {
+		reportProjectedMemory(opts, network);
+		return 0;
+	}
 
 	// Initialize and get the solver handler
 	bool dimOK = xolotlFactory::initializeDimension(opts, network);
@@ -200,6 +371,33 @@ int runXolotl(const Options& opts) {
 	return 0;
 }
 
+//! Check if the parameter file asks for the asynchronous checkpoints, before MPI is initialized.
+bool useAsyncCheckpoints(int argc, char **argv) {
+	if (argc < 2)
+		return false;
+
+	// Look for the option in the PETSc arguments
+	std::ifstream paramFile(argv[1]);
+	std::string line;
+	while (std::getline(paramFile, line)) {
+		auto pos = line.find('=');
+		std::istringstream key(line.substr(0, pos));
+		std::string keyName;
+		key >> keyName;
+		if (pos == std::string::npos || keyName != "petscArgs")
+			continue;
+
+		std::istringstream args(line.substr(pos + 1));
+		std::string arg;
+		while (args >> arg) {
+			if (arg == "-async_checkpoint")
+				return true;
+		}
+	}
+
+	return false;
+}
+
 //! Main program
 int main(int argc, char **argv) {
 
@@ -211,7 +409,14 @@ int main(int argc, char **argv) {
 	// with overlapping Timer scopes.
 	// We do this before our own parsing of the command line,
 	// because it may change the command line.
-	MPI_Init(&argc, &argv);
+	// Full thread support is only asked for when the checkpoints are
+	// written by a separate thread, it slows down MPI on some systems.
+	// The writer checks what was provided.
+	if (useAsyncCheckpoints(argc, argv)) {
+		int provided;
+		MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+	} else
+		MPI_Init(&argc, &argv);
 
 	try {
 		// Check the command line arguments.
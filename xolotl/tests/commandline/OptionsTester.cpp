@@ -104,6 +104,7 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 	"-ts_adapt_dt_max 10 -pc_type fieldsplit "
 	"-fieldsplit_1_pc_type sor -ts_final_time 1000 "
 	"-ts_max_steps 3" << std::endl << "networkFile=tungsten.txt"
+	<< std::endl << "networkCache=netCache" << std::endl << "restartRemap=linear"
 	<< std::endl << "startTemp=900" << std::endl << "perfHandler=std"
 	<< std::endl << "flux=1.5" << std::endl << "material=W100"
 	<< std::endl << "initialV=0.05" << std::endl << "dimensions=1"
@@ -138,6 +139,8 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 
 	// Check the network filename
 	BOOST_REQUIRE_EQUAL(opts.getNetworkFilename(), "tungsten.txt");
+	BOOST_REQUIRE_EQUAL(opts.getNetworkCacheDirectory(), "netCache");
+	BOOST_REQUIRE_EQUAL(opts.getRestartRemap(), "linear");
 
 	// Check the temperature
 	BOOST_REQUIRE_EQUAL(opts.useConstTemperatureHandlers(), true);
@@ -242,6 +242,8 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 		BOOST_REQUIRE(networkGroup);
 		int normalSize = 0, superSize = 0;
 		networkGroup->readNetworkSize(normalSize, superSize);
+		BOOST_REQUIRE_EQUAL(networkGroup->getLayoutVersion(),
+				XFile::NetworkGroup::columnarLayout);
 		// Get all the reactants
 		auto const& reactants = network->getAll();
 		// Check the network vector
@@ -249,15 +251,13 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 			// Get the i-th reactant in the network
 			auto& reactant = (PSICluster&) it;
 			int id = reactant.getId() - 1;
-			// Open the cluster group
-			XFile::ClusterGroup clusterGroup(*networkGroup, id);
 
 			if (id < normalSize) {
 				// Normal cluster
 				// Read the composition
 				double formationEnergy = 0.0, migrationEnergy = 0.0,
 						diffusionFactor = 0.0;
-				auto comp = clusterGroup.readCluster(formationEnergy,
+				auto comp = networkGroup->readCluster(id, formationEnergy,
 						migrationEnergy, diffusionFactor);
 				// Check the composition
 				auto& composition = reactant.getComposition();
@@ -546,4 +546,185 @@ BOOST_AUTO_TEST_CASE(checkSurface3D) {
 	}
 }
 
+/**
+ * Method checking the writing and reading of compressed concentrations.
+ */
+BOOST_AUTO_TEST_CASE(checkCompressedConcentrations) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	const uint32_t nGridPointsPerRank = 6;
+
+	// Create the test HDF5 file.
+	// Done in its own scope so that it closes when the
+	// object goes out of scope.
+	const std::string testFileName = "test_compressed.h5";
+	{
+		BOOST_TEST_MESSAGE("Creating compression test file");
+
+		// Set the number of grid points and step size
+		int nGrid = 5;
+		double stepSize = 0.5;
+		std::vector<double> grid;
+		for (int i = 0; i < nGrid + 2; i++)
+			grid.push_back((double) i * stepSize);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Define our part of the concentration dataset, with an empty
+	// grid point.
+	uint32_t baseX = commRank * nGridPointsPerRank;
+	XFile::TimestepGroup::Concs1DType myConcs(nGridPointsPerRank);
+	for (auto i = 1; i < nGridPointsPerRank; ++i) {
+		for (auto j = 0; j < 1000 * i; ++j) {
+			myConcs[i].emplace_back(j, 1.0e-3 * (baseX + i) * j);
+		}
+	}
+
+	// Write them twice, uncompressed and compressed
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+
+		auto tsGroup = concGroup->addTimestepGroup(0, 1.0, 0.0, 1.0);
+		tsGroup->writeConcentrations(testFile, baseX, myConcs);
+		tsGroup = concGroup->addTimestepGroup(1, 2.0, 1.0, 1.0);
+		tsGroup->writeConcentrations(testFile, baseX, myConcs, 4);
+	}
+
+	// Read them back
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+
+		for (int timeStep = 0; timeStep < 2; timeStep++) {
+			XFile::TimestepGroup tsGroup(*concGroup, timeStep);
+			auto readConcs = tsGroup.readConcentrations(testFile, baseX,
+					nGridPointsPerRank);
+			BOOST_REQUIRE_EQUAL(readConcs.size(), myConcs.size());
+			for (auto ptIdx = 0; ptIdx < nGridPointsPerRank; ++ptIdx) {
+				BOOST_REQUIRE_EQUAL(readConcs[ptIdx].size(),
+						myConcs[ptIdx].size());
+				for (auto i = 0; i < myConcs[ptIdx].size(); ++i) {
+					BOOST_REQUIRE_EQUAL(readConcs[ptIdx][i].first,
+							myConcs[ptIdx][i].first);
+					BOOST_REQUIRE_EQUAL(readConcs[ptIdx][i].second,
+							myConcs[ptIdx][i].second);
+				}
+			}
+		}
+
+		// The compressed values use the shuffle and deflate filters
+		XFile::TimestepGroup tsGroup(*concGroup, 1);
+		hid_t datasetId = H5Dopen(tsGroup.getId(), "concValues", H5P_DEFAULT);
+		BOOST_REQUIRE(datasetId >= 0);
+		hid_t plistId = H5Dget_create_plist(datasetId);
+		BOOST_REQUIRE_EQUAL(H5Pget_layout(plistId), H5D_CHUNKED);
+		BOOST_REQUIRE_EQUAL(H5Pget_nfilters(plistId), 2);
+		H5Pclose(plistId);
+		H5Dclose(datasetId);
+	}
+
+	// Remove the created file
+	std::remove(testFileName.c_str());
+}
+
+/**
+ * Method checking the writing and reading of delta encoded concentrations.
+ */
+BOOST_AUTO_TEST_CASE(checkDeltaConcentrations) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	const uint32_t nGridPointsPerRank = 4;
+	uint32_t baseX = commRank * nGridPointsPerRank;
+
+	// Create the test HDF5 file.
+	const std::string testFileName = "test_delta.h5";
+	{
+		std::vector<double> grid;
+		for (int i = 0; i < 7; i++)
+			grid.push_back((double) i * 0.5);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Build three sets of concentrations where values change a little,
+	// some stay the same, some indices appear and some disappear
+	std::vector<XFile::TimestepGroup::Concs1DType> allConcs(3,
+			XFile::TimestepGroup::Concs1DType(nGridPointsPerRank));
+	for (int step = 0; step < 3; step++) {
+		for (auto i = 0; i < nGridPointsPerRank; ++i) {
+			for (auto j = 0; j < 20; ++j) {
+				// Drop some indices depending on the step
+				if ((j + step) % 7 == 0)
+					continue;
+				double value = 1.0e-3 * (baseX + i + 1) * (j + 1);
+				// Only the even indices change
+				if (j % 2 == 0)
+					value *= 1.0 + 1.0e-6 * step;
+				allConcs[step][i].emplace_back(j, value);
+			}
+		}
+	}
+
+	// Write a keyframe followed by two deltas
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+
+		auto tsGroup = concGroup->addTimestepGroup(0, 1.0, 0.0, 1.0);
+		tsGroup->writeConcentrations(testFile, baseX, allConcs[0]);
+		tsGroup = concGroup->addTimestepGroup(1, 2.0, 1.0, 1.0);
+		tsGroup->writeConcentrationDeltas(testFile, baseX, allConcs[1], 0,
+				allConcs[0]);
+		tsGroup = concGroup->addTimestepGroup(2, 3.0, 2.0, 1.0);
+		tsGroup->writeConcentrationDeltas(testFile, baseX, allConcs[2], 1,
+				allConcs[1], 4);
+	}
+
+	// Read them back, they must be exactly the same
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+
+		for (int step = 0; step < 3; step++) {
+			XFile::TimestepGroup tsGroup(*concGroup, step);
+			auto readConcs = tsGroup.readConcentrations(testFile, baseX,
+					nGridPointsPerRank);
+			BOOST_REQUIRE_EQUAL(readConcs.size(), allConcs[step].size());
+			for (auto ptIdx = 0; ptIdx < nGridPointsPerRank; ++ptIdx) {
+				BOOST_REQUIRE_EQUAL(readConcs[ptIdx].size(),
+						allConcs[step][ptIdx].size());
+				for (auto i = 0; i < readConcs[ptIdx].size(); ++i) {
+					BOOST_REQUIRE_EQUAL(readConcs[ptIdx][i].first,
+							allConcs[step][ptIdx][i].first);
+					BOOST_REQUIRE_EQUAL(readConcs[ptIdx][i].second,
+							allConcs[step][ptIdx][i].second);
+				}
+			}
+		}
+	}
+
+	// Remove the created file
+	std::remove(testFileName.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
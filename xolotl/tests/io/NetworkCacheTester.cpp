@@ -0,0 +1,93 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <NetworkCache.h>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+// The directory used for the tests
+const string cacheDir = "testNetworkCache";
+
+BOOST_AUTO_TEST_SUITE(NetworkCache_testSuite)
+
+/**
+ * This operation checks that a stored network is mapped back identically.
+ */
+BOOST_AUTO_TEST_CASE(checkStoreAndMap) {
+	// Build a fake packed network
+	vector<double> buffer;
+	for (int i = 0; i < 1000; i++) {
+		buffer.push_back(0.5 * i);
+	}
+
+	// Nothing is cached yet
+	NetworkCache cache(cacheDir, "netParam 8 0 0 5 1 grouping 4 4 4 4 1");
+	BOOST_REQUIRE_EQUAL(cache.map(), false);
+	BOOST_REQUIRE_EQUAL(cache.isMapped(), false);
+	BOOST_REQUIRE(cache.getData() == nullptr);
+
+	// Store it and map it back
+	BOOST_REQUIRE_EQUAL(cache.store(buffer), true);
+	BOOST_REQUIRE_EQUAL(cache.map(), true);
+	BOOST_REQUIRE_EQUAL(cache.getSize(), buffer.size());
+	for (int i = 0; i < buffer.size(); i++) {
+		BOOST_REQUIRE_EQUAL(cache.getData()[i], buffer[i]);
+	}
+
+	// Another cache with the same description sees it too
+	NetworkCache otherCache(cacheDir, "netParam 8 0 0 5 1 grouping 4 4 4 4 1");
+	BOOST_REQUIRE_EQUAL(otherCache.getFileName(), cache.getFileName());
+	BOOST_REQUIRE_EQUAL(otherCache.map(), true);
+	BOOST_REQUIRE_EQUAL(otherCache.getSize(), buffer.size());
+
+	// But not one with a different description
+	NetworkCache wrongCache(cacheDir, "netParam 8 0 0 6 1 grouping 4 4 4 4 1");
+	BOOST_REQUIRE(wrongCache.getFileName() != cache.getFileName());
+	BOOST_REQUIRE_EQUAL(wrongCache.map(), false);
+
+	// Remove the created files
+	std::remove(cache.getFileName().c_str());
+	rmdir(cacheDir.c_str());
+
+	return;
+}
+
+/**
+ * This operation checks that damaged files are not used.
+ */
+BOOST_AUTO_TEST_CASE(checkDamagedFile) {
+	vector<double> buffer(10, 1.0);
+	NetworkCache cache(cacheDir, "damaged");
+	BOOST_REQUIRE_EQUAL(cache.store(buffer), true);
+
+	// Truncate the file
+	{
+		ifstream in(cache.getFileName(), ios::binary);
+		string content((istreambuf_iterator<char>(in)),
+				istreambuf_iterator<char>());
+		in.close();
+		ofstream out(cache.getFileName(), ios::binary | ios::trunc);
+		out.write(content.data(), content.size() - sizeof(double));
+	}
+	BOOST_REQUIRE_EQUAL(cache.map(), false);
+
+	// Write garbage
+	{
+		ofstream out(cache.getFileName(), ios::binary | ios::trunc);
+		out << "This is not a network";
+	}
+	BOOST_REQUIRE_EQUAL(cache.map(), false);
+
+	// Remove the created files
+	std::remove(cache.getFileName().c_str());
+	rmdir(cacheDir.c_str());
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
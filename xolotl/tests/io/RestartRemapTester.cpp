@@ -0,0 +1,158 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <RestartRemap.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+// A network with a single cluster
+const RestartRemap::NetworkCompsType singleComps = { { 1, 0, 0, 0, 0 } };
+
+BOOST_AUTO_TEST_SUITE(RestartRemap_testSuite)
+
+/**
+ * This operation checks that nothing changes with the same grid and network.
+ */
+BOOST_AUTO_TEST_CASE(checkIdentity) {
+	vector<double> grid = { 0.0, 1.0, 3.0 };
+	RestartRemap remap(grid, grid, singleComps, singleComps, 2,
+			RestartRemap::Method::Conservative);
+	BOOST_REQUIRE_EQUAL(remap.isIdentity(), true);
+
+	// The source range is the same
+	auto source = remap.getSourceRange(1, 2);
+	BOOST_REQUIRE_EQUAL(source.first, 1);
+	BOOST_REQUIRE_EQUAL(source.second, 2);
+
+	// And so are the concentrations
+	RestartRemap::Concs1DType concs = { { { 0, 2.0 }, { 1, 900.0 } }, { { 0,
+			3.0 }, { 1, 1000.0 } } };
+	auto newConcs = remap.apply(concs, 1, 1, 2);
+	BOOST_REQUIRE_EQUAL(newConcs.size(), 2);
+	for (int i = 0; i < 2; i++) {
+		BOOST_REQUIRE_EQUAL(newConcs[i].size(), 2);
+		BOOST_REQUIRE_EQUAL(newConcs[i][0].first, 0);
+		BOOST_REQUIRE_CLOSE(newConcs[i][0].second, concs[i][0].second,
+				1.0e-10);
+		BOOST_REQUIRE_CLOSE(newConcs[i][1].second, concs[i][1].second,
+				1.0e-10);
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the conservative remap keeps the inventory.
+ */
+BOOST_AUTO_TEST_CASE(checkConservative) {
+	// Refine a coarse grid
+	vector<double> oldGrid = { 0.0, 1.0, 2.0, 3.0 };
+	vector<double> newGrid = { 0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0 };
+	RestartRemap remap(oldGrid, newGrid, singleComps, singleComps, 2,
+			RestartRemap::Method::Conservative);
+	BOOST_REQUIRE_EQUAL(remap.isIdentity(), false);
+
+	// Every new point needs at most two old ones
+	auto source = remap.getSourceRange(0, 7);
+	BOOST_REQUIRE_EQUAL(source.first, 0);
+	BOOST_REQUIRE_EQUAL(source.second, 4);
+	source = remap.getSourceRange(3, 1);
+	BOOST_REQUIRE_EQUAL(source.first, 1);
+	BOOST_REQUIRE_EQUAL(source.second, 2);
+
+	RestartRemap::Concs1DType concs = { { { 0, 1.0 }, { 1, 1000.0 } }, { { 0,
+			2.0 }, { 1, 1000.0 } }, { { 0, 4.0 }, { 1, 1000.0 } }, { { 0,
+			8.0 }, { 1, 1000.0 } } };
+	auto newConcs = remap.apply(concs, 0, 0, 7);
+
+	// The cells are between the midpoints
+	vector<double> oldWidths = { 0.5, 1.0, 1.0, 0.5 };
+	vector<double> newWidths = { 0.25, 0.5, 0.5, 0.5, 0.5, 0.5, 0.25 };
+	double oldInventory = 0.0, newInventory = 0.0;
+	for (int i = 0; i < 4; i++) {
+		oldInventory += concs[i][0].second * oldWidths[i];
+	}
+	for (int i = 0; i < 7; i++) {
+		BOOST_REQUIRE_EQUAL(newConcs[i].size(), 2);
+		newInventory += newConcs[i][0].second * newWidths[i];
+		// The temperature is the last one
+		BOOST_REQUIRE_EQUAL(newConcs[i][1].first, 1);
+		BOOST_REQUIRE_CLOSE(newConcs[i][1].second, 1000.0, 1.0e-10);
+	}
+	BOOST_REQUIRE_CLOSE(newInventory, oldInventory, 1.0e-10);
+
+	// The point between two old cells gets their average
+	BOOST_REQUIRE_CLOSE(newConcs[3][0].second, 3.0, 1.0e-10);
+
+	return;
+}
+
+/**
+ * This operation checks the linear interpolation.
+ */
+BOOST_AUTO_TEST_CASE(checkLinear) {
+	vector<double> oldGrid = { 0.0, 1.0, 2.0 };
+	vector<double> newGrid = { 0.0, 0.25, 1.5, 3.0 };
+	RestartRemap remap(oldGrid, newGrid, singleComps, singleComps, 2,
+			RestartRemap::Method::Linear);
+
+	RestartRemap::Concs1DType concs = { { { 0, 1.0 }, { 1, 1000.0 } }, { { 0,
+			2.0 }, { 1, 1000.0 } }, { { 0, 4.0 }, { 1, 1000.0 } } };
+	auto newConcs = remap.apply(concs, 0, 0, 4);
+	BOOST_REQUIRE_CLOSE(newConcs[0][0].second, 1.0, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(newConcs[1][0].second, 1.25, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(newConcs[2][0].second, 3.0, 1.0e-10);
+	// Beyond the old grid
+	BOOST_REQUIRE_CLOSE(newConcs[3][0].second, 4.0, 1.0e-10);
+
+	// The surface moves to the closest point
+	BOOST_REQUIRE_EQUAL(remap.getClosestPoint(0), 0);
+	BOOST_REQUIRE_EQUAL(remap.getClosestPoint(1), 2);
+	BOOST_REQUIRE_EQUAL(remap.getClosestPoint(2), 2);
+
+	// Unknown methods are refused
+	BOOST_REQUIRE_THROW(RestartRemap::getMethod("cubic"), std::string);
+	BOOST_REQUIRE(
+			RestartRemap::getMethod("linear") == RestartRemap::Method::Linear);
+
+	return;
+}
+
+/**
+ * This operation checks that the clusters are matched by composition.
+ */
+BOOST_AUTO_TEST_CASE(checkNetwork) {
+	// The new network has more clusters in another order
+	RestartRemap::NetworkCompsType oldComps = { { 1, 0, 0, 0, 0 }, { 0, 0, 0,
+			1, 0 } };
+	RestartRemap::NetworkCompsType newComps = { { 0, 0, 0, 1, 0 }, { 2, 0, 0,
+			0, 0 }, { 1, 0, 0, 0, 0 } };
+	vector<double> grid;
+	RestartRemap remap(grid, grid, oldComps, newComps, 4,
+			RestartRemap::Method::Conservative);
+	BOOST_REQUIRE_EQUAL(remap.isIdentity(), false);
+
+	RestartRemap::Concs1DType concs =
+			{ { { 0, 1.0 }, { 1, 2.0 }, { 2, 900.0 } } };
+	auto newConcs = remap.apply(concs, 0, 0, 1);
+	BOOST_REQUIRE_EQUAL(newConcs[0].size(), 3);
+	BOOST_REQUIRE_EQUAL(newConcs[0][0].first, 0);
+	BOOST_REQUIRE_CLOSE(newConcs[0][0].second, 2.0, 1.0e-10);
+	BOOST_REQUIRE_EQUAL(newConcs[0][1].first, 2);
+	BOOST_REQUIRE_CLOSE(newConcs[0][1].second, 1.0, 1.0e-10);
+	BOOST_REQUIRE_EQUAL(newConcs[0][2].first, 3);
+	BOOST_REQUIRE_CLOSE(newConcs[0][2].second, 900.0, 1.0e-10);
+
+	// The other way around a cluster is missing
+	RestartRemap backward(grid, grid, newComps, oldComps, 3,
+			RestartRemap::Method::Conservative);
+	RestartRemap::Concs1DType moreConcs = { { { 0, 1.0 }, { 1, 2.0 }, { 3,
+			900.0 } } };
+	BOOST_REQUIRE_THROW(backward.apply(moreConcs, 0, 0, 1), std::string);
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
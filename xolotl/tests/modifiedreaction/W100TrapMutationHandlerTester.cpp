@@ -178,6 +178,29 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 5.53624e+14, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 5.53624e+14, 0.01);
 
+	// The disappearing rate was never computed for a solution
+	BOOST_REQUIRE(trapMutationHandler.isDisappearingRateUpToDate(-1, -1));
+	trapMutationHandler.setDisappearingRateState(3, 4);
+	BOOST_REQUIRE(trapMutationHandler.isDisappearingRateUpToDate(3, 4));
+	BOOST_REQUIRE(!trapMutationHandler.isDisappearingRateUpToDate(3, 5));
+	BOOST_REQUIRE(!trapMutationHandler.isDisappearingRateUpToDate(2, 4));
+
+	// Attenuate the trap-mutation
+	trapMutationHandler.updateDisappearingRate(0.5);
+
+	// Compute the partial derivatives again at the grid point 8
+	nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
+			valPointer, indicesPointer, 9);
+
+	// Check values
+	BOOST_REQUIRE_EQUAL(nMutating, 3);
+	BOOST_REQUIRE_CLOSE(val[0], -5.53624e+14 * exp(-2.0), 0.01);
+	BOOST_REQUIRE_CLOSE(val[1], 5.53624e+14 * exp(-2.0), 0.01);
+	BOOST_REQUIRE_CLOSE(val[2], 5.53624e+14 * exp(-2.0), 0.01);
+	BOOST_REQUIRE_CLOSE(val[3], -5.53624e+14 * exp(-2.0), 0.01);
+	BOOST_REQUIRE_CLOSE(val[4], 5.53624e+14 * exp(-2.0), 0.01);
+	BOOST_REQUIRE_CLOSE(val[5], 5.53624e+14 * exp(-2.0), 0.01);
+
 	// Remove the created file
 	std::string tempFile = "param.txt";
 	std::remove(tempFile.c_str());
@@ -0,0 +1,176 @@
+#define BOOST_TEST_MODULE Regression
+
+#include <string>
+#include <vector>
+#include <boost/test/included/unit_test.hpp>
+#include "xolotlPerf/xolotlPerf.h"
+#include "xolotlPerf/standard/StdHandlerRegistry.h"
+
+namespace xperf = xolotlPerf;
+
+// our coordinates in the MPI world
+int cwRank = -1;
+int cwSize = -1;
+
+/**
+ * Test suite for the MemoryTracker and TrackedMemory classes.
+ */
+BOOST_AUTO_TEST_SUITE (MemoryTracker_testSuite)
+
+struct MPIFixture {
+	MPIFixture(void) {
+		MPI_Init(&boost::unit_test::framework::master_test_suite().argc,
+				&boost::unit_test::framework::master_test_suite().argv);
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
+		MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+	}
+
+	~MPIFixture(void) {
+		MPI_Finalize();
+	}
+};
+
+#if BOOST_VERSION >= 105900
+// In Boost 1.59, the semicolon at the end of the definition of BOOST_GLOBAL_FIXTURE is removed
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+#else
+// With earlier Boost versions, naively adding a semicolon to our code will generate compiler
+// warnings about redundant semicolons
+BOOST_GLOBAL_FIXTURE (MPIFixture)
+#endif
+
+/**
+ * This operation checks the current use and the high-water marks.
+ */
+BOOST_AUTO_TEST_CASE(checkTracker) {
+	auto& tracker = xperf::getMemoryTracker();
+	tracker.reset();
+
+	tracker.add(xperf::MemoryCategory::Reactants, 100);
+	tracker.add(xperf::MemoryCategory::Jacobian, 50);
+	tracker.add(xperf::MemoryCategory::Reactants, -60);
+	tracker.add(xperf::MemoryCategory::Jacobian, 30);
+
+	BOOST_REQUIRE_EQUAL(tracker.getCurrent(xperf::MemoryCategory::Reactants),
+			40);
+	BOOST_REQUIRE_EQUAL(tracker.getPeak(xperf::MemoryCategory::Reactants),
+			100);
+	BOOST_REQUIRE_EQUAL(tracker.getCurrent(xperf::MemoryCategory::Jacobian),
+			80);
+	BOOST_REQUIRE_EQUAL(tracker.getPeak(xperf::MemoryCategory::Jacobian), 80);
+	BOOST_REQUIRE_EQUAL(tracker.getPeak(xperf::MemoryCategory::IO), 0);
+
+	// The total peaked at 150, before the reactants were released
+	BOOST_REQUIRE_EQUAL(tracker.getTotal(), 120);
+	BOOST_REQUIRE_EQUAL(tracker.getTotalPeak(), 150);
+
+	// The names
+	BOOST_REQUIRE_EQUAL(
+			xperf::getMemoryCategoryName(xperf::MemoryCategory::Reactants),
+			"reactants");
+	BOOST_REQUIRE_EQUAL(
+			xperf::getMemoryCategoryName(xperf::MemoryCategory::GridPointRates),
+			"gridPointRates");
+
+	tracker.reset();
+	BOOST_REQUIRE_EQUAL(tracker.getPeak(xperf::MemoryCategory::Reactants), 0);
+	BOOST_REQUIRE_EQUAL(tracker.getTotalPeak(), 0);
+}
+
+/**
+ * This operation checks that a tracked data structure reports the
+ * difference of its sizes and releases them when it is destroyed.
+ */
+BOOST_AUTO_TEST_CASE(checkTrackedMemory) {
+	auto& tracker = xperf::getMemoryTracker();
+	tracker.reset();
+
+	{
+		std::vector<double> buffer(1000);
+		xperf::TrackedMemory memory(xperf::MemoryCategory::IO);
+		memory.set(xperf::getVectorMemorySize(buffer));
+		BOOST_REQUIRE_EQUAL(memory.get(), 1000 * sizeof(double));
+		BOOST_REQUIRE_EQUAL(tracker.getCurrent(xperf::MemoryCategory::IO),
+				1000 * sizeof(double));
+
+		// Smaller
+		memory.set(10);
+		BOOST_REQUIRE_EQUAL(tracker.getCurrent(xperf::MemoryCategory::IO), 10);
+	}
+
+	BOOST_REQUIRE_EQUAL(tracker.getCurrent(xperf::MemoryCategory::IO), 0);
+	BOOST_REQUIRE_EQUAL(tracker.getPeak(xperf::MemoryCategory::IO),
+			1000 * sizeof(double));
+
+	tracker.reset();
+}
+
+/**
+ * This operation checks the capacity of the vectors that grow one element
+ * at a time.
+ */
+BOOST_AUTO_TEST_CASE(checkGrownCapacity) {
+	BOOST_REQUIRE_EQUAL(xperf::getGrownCapacity(0), 0U);
+	BOOST_REQUIRE_EQUAL(xperf::getGrownCapacity(1), 1U);
+	BOOST_REQUIRE_EQUAL(xperf::getGrownCapacity(5), 8U);
+	BOOST_REQUIRE_EQUAL(xperf::getGrownCapacity(64), 64U);
+
+	std::vector<double> buffer;
+	for (int i = 0; i < 100; i++) {
+		buffer.emplace(buffer.begin(), 0.0);
+		BOOST_REQUIRE(buffer.capacity() <= xperf::getGrownCapacity(i + 1));
+	}
+}
+
+/**
+ * This operation checks the aggregation of the high-water marks over the
+ * processes.
+ */
+BOOST_AUTO_TEST_CASE(checkAggregation) {
+	xperf::initialize(xperf::IHandlerRegistry::std);
+	auto reg = std::dynamic_pointer_cast<xperf::StdHandlerRegistry>(
+			xperf::getHandlerRegistry());
+	BOOST_REQUIRE(reg);
+
+	// Each process uses as many bytes as its rank plus one
+	auto& tracker = xperf::getMemoryTracker();
+	tracker.reset();
+	xperf::TrackedMemory memory(xperf::MemoryCategory::Coefficients);
+	memory.set(cwRank + 1);
+
+	xperf::PerfObjStatsMap<xperf::ITimer::ValType> timerStats;
+	xperf::PerfObjStatsMap<xperf::IEventCounter::ValType> ctrStats;
+	xperf::PerfObjStatsMap<xperf::IHardwareCounter::CounterType> hwCtrStats;
+	reg->collectStatistics(timerStats, ctrStats, hwCtrStats);
+
+	// Only rank 0 does the verification
+	if (cwRank == 0) {
+		auto const& stats = reg->getMemoryStatistics();
+		const int nCategories = (int) xperf::MemoryCategory::Count;
+		BOOST_REQUIRE_EQUAL(stats.size(), nCategories + 2U);
+
+		auto const& coefStats =
+				stats[(int) xperf::MemoryCategory::Coefficients];
+		BOOST_REQUIRE_EQUAL(coefStats.name, "coefficients");
+		BOOST_REQUIRE_EQUAL(coefStats.processCount, (unsigned int )cwSize);
+		BOOST_REQUIRE_EQUAL(coefStats.min, 1.0);
+		BOOST_REQUIRE_EQUAL(coefStats.max, cwSize);
+		BOOST_REQUIRE_CLOSE(coefStats.average, (cwSize + 1) / 2.0, 1.0e-10);
+
+		// Nothing else was tracked
+		BOOST_REQUIRE_EQUAL(
+				stats[(int) xperf::MemoryCategory::Reactions].max, 0.0);
+		BOOST_REQUIRE_EQUAL(stats[nCategories].name, "total");
+		BOOST_REQUIRE_EQUAL(stats[nCategories].max, cwSize);
+
+		// The operating system saw at least that much
+		BOOST_REQUIRE_EQUAL(stats[nCategories + 1].name, "process");
+		BOOST_REQUIRE(stats[nCategories + 1].min >= 1.0);
+	}
+
+	memory.set(0);
+	tracker.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,178 @@
+#define BOOST_TEST_MODULE Regression
+
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include "xolotlPerf/os/PerfEventHardwareCounter.h"
+
+using namespace std;
+using namespace xolotlPerf;
+
+const IHardwareCounter::SpecType test_hwCtrSpec =
+		{ IHardwareCounter::Instructions, IHardwareCounter::Cycles,
+				IHardwareCounter::FPOps, IHardwareCounter::FPInstructions,
+				IHardwareCounter::L1CacheMisses,
+				IHardwareCounter::L2CacheMisses,
+				IHardwareCounter::L3CacheMisses,
+				IHardwareCounter::BranchMispredictions };
+
+/**
+ * Do some work to count.
+ *
+ * @param n The amount of work
+ * @return Its result
+ */
+double work(int n) {
+	volatile double sum = 0.0;
+	for (int i = 0; i < n; i++) {
+		sum = sum + 1.0 / (i + 1);
+	}
+	return sum;
+}
+
+/**
+ * Does the name of a counter say it is unavailable?
+ *
+ * @param name The name
+ * @return True if it is unavailable
+ */
+bool isUnavailable(const std::string& name) {
+	return name.find("(unavailable)") != std::string::npos;
+}
+
+/**
+ * This suite is responsible for testing the PerfEventHardwareCounter.
+ * The kernel may not give access to the hardware counters (in a virtual
+ * machine for instance), so the counts are only checked for the counters
+ * that are available.
+ */
+BOOST_AUTO_TEST_SUITE (PerfEventHardwareCounter_testSuite)
+
+BOOST_AUTO_TEST_CASE(checkNames) {
+	PerfEventHardwareCounter tester("test", test_hwCtrSpec);
+
+	BOOST_REQUIRE_EQUAL("test", tester.getName());
+	BOOST_REQUIRE_EQUAL(tester.getSpecification().size(),
+			test_hwCtrSpec.size());
+
+	// These have no generic perf event
+	BOOST_REQUIRE_EQUAL("Floating point operations(unavailable)",
+			tester.getCounterName(IHardwareCounter::FPOps));
+	BOOST_REQUIRE_EQUAL("L2 cache misses(unavailable)",
+			tester.getCounterName(IHardwareCounter::L2CacheMisses));
+
+	// The others are named after their perf event when they count
+	std::string name = tester.getCounterName(IHardwareCounter::Cycles);
+	BOOST_REQUIRE(name == "Total cycles(cycles)" or isUnavailable(name));
+	BOOST_REQUIRE(name.find(':') == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(checkCounting) {
+	PerfEventHardwareCounter tester("test", test_hwCtrSpec);
+
+	// Count twice, the counts add up
+	const int n = 1000000;
+	tester.start();
+	work(n);
+	tester.stop();
+	auto firstValues = tester.getValues();
+	tester.start();
+	work(n);
+	tester.stop();
+	auto values = tester.getValues();
+
+	BOOST_REQUIRE_EQUAL(values.size(), test_hwCtrSpec.size());
+	for (unsigned int i = 0; i < values.size(); i++) {
+		auto name = tester.getCounterName(test_hwCtrSpec[i]);
+		BOOST_TEST_MESSAGE(name << " = " << values[i]);
+		if (isUnavailable(name)) {
+			BOOST_REQUIRE_EQUAL(values[i], 0);
+		} else {
+			BOOST_REQUIRE(values[i] >= firstValues[i]);
+		}
+	}
+
+	// Each iteration needs a few instructions
+	if (!isUnavailable(tester.getCounterName(IHardwareCounter::Instructions)))
+		BOOST_REQUIRE(values[0] > 2 * n);
+
+	// Can't start twice or stop a stopped counter
+	BOOST_REQUIRE_THROW(tester.stop(), std::runtime_error);
+	tester.start();
+	BOOST_REQUIRE_THROW(tester.start(), std::runtime_error);
+	tester.stop();
+}
+
+BOOST_AUTO_TEST_CASE(checkPhases) {
+	auto& tree = getPhaseTree();
+	auto counters = std::make_shared<PerfEventCounterGroup>(
+			IHardwareCounter::SpecType { IHardwareCounter::Instructions,
+					IHardwareCounter::FPOps });
+	tree.setCounters(counters);
+	tree.setEnabled(true);
+	BOOST_REQUIRE_EQUAL(tree.getNumberOfCounters(), 2);
+
+	{
+		ScopedPhase phase(Phase::RHSFunction);
+		work(1000);
+		ScopedPhase innerPhase(Phase::Flux);
+		work(1000);
+	}
+
+	// The parent counts everything its child counts
+	auto records = tree.getRecords();
+	BOOST_REQUIRE_EQUAL(records.size(), 2U);
+	BOOST_REQUIRE_EQUAL(records[0].counts.size(), 2U);
+	BOOST_REQUIRE(records[0].counts[0] >= records[1].counts[0]);
+	BOOST_REQUIRE_EQUAL(records[0].counts[1], 0.0);
+	BOOST_REQUIRE_EQUAL(records[1].counts[1], 0.0);
+	if (!counters->isAvailable(0))
+		BOOST_REQUIRE_EQUAL(records[0].counts[0], 0.0);
+
+	// Without counters
+	tree.setCounters(nullptr);
+	BOOST_REQUIRE_EQUAL(tree.getNumberOfCounters(), 0);
+	{
+		ScopedPhase phase(Phase::RHSFunction);
+	}
+	records = tree.getRecords();
+	BOOST_REQUIRE_EQUAL(records.size(), 1U);
+	BOOST_REQUIRE_EQUAL(records[0].counts.size(), 0U);
+	tree.setEnabled(false);
+}
+
+BOOST_AUTO_TEST_CASE(checkThreads) {
+	PerfEventCounterGroup master(
+			IHardwareCounter::SpecType { IHardwareCounter::Instructions });
+	PerfEventCounterGroup all(
+			IHardwareCounter::SpecType { IHardwareCounter::Instructions },
+			true);
+	if (!all.isAvailable(0))
+		return;
+	BOOST_REQUIRE_EQUAL(master.getNumberOfThreads(), 1);
+	BOOST_REQUIRE(all.getNumberOfThreads() >= 1);
+	BOOST_REQUIRE(
+			master.getCounterName(IHardwareCounter::Instructions).find(
+					"threads") == std::string::npos);
+	if (all.getNumberOfThreads() > 1)
+		BOOST_REQUIRE(
+				all.getCounterName(IHardwareCounter::Instructions).find(
+						"threads") != std::string::npos);
+
+	// The work of the other threads is only counted by the second group
+	IHardwareCounter::CounterType masterStart, allStart;
+	master.read(&masterStart);
+	all.read(&allStart);
+	const int n = 1000000;
+#pragma omp parallel
+	work(n);
+	IHardwareCounter::CounterType masterEnd, allEnd;
+	master.read(&masterEnd);
+	all.read(&allEnd);
+	BOOST_REQUIRE(
+			allEnd - allStart
+					>= (IHardwareCounter::CounterType) all.getNumberOfThreads()
+							* 2 * n);
+	BOOST_REQUIRE(allEnd - allStart >= masterEnd - masterStart);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+#define BOOST_TEST_MODULE Regression
+
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include "xolotlPerf/xolotlPerf.h"
+#include "xolotlPerf/standard/StdHandlerRegistry.h"
+
+namespace xperf = xolotlPerf;
+
+// our coordinates in the MPI world
+int cwRank = -1;
+int cwSize = -1;
+
+/**
+ * Test suite for the PhaseTree and ScopedPhase classes.
+ */
+BOOST_AUTO_TEST_SUITE (PhaseTimer_testSuite)
+
+struct MPIFixture {
+	MPIFixture(void) {
+		MPI_Init(&boost::unit_test::framework::master_test_suite().argc,
+				&boost::unit_test::framework::master_test_suite().argv);
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
+		MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+	}
+
+	~MPIFixture(void) {
+		MPI_Finalize();
+	}
+};
+
+#if BOOST_VERSION >= 105900
+// In Boost 1.59, the semicolon at the end of the definition of BOOST_GLOBAL_FIXTURE is removed
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+#else
+// With earlier Boost versions, naively adding a semicolon to our code will generate compiler
+// warnings about redundant semicolons
+BOOST_GLOBAL_FIXTURE (MPIFixture)
+#endif
+
+/**
+ * Time the same phases as the Jacobian would, twice.
+ */
+void timeJacobian() {
+	for (int n = 0; n < 2; n++) {
+		xperf::ScopedPhase functionPhase(xperf::Phase::RHSJacobian);
+		xperf::ScopedPhase phase(xperf::Phase::OffDiagonalJacobian);
+		{
+			xperf::ScopedPhase innerPhase(xperf::Phase::Diffusion);
+			innerPhase.enter(xperf::Phase::MatrixAssembly);
+			innerPhase.enter(xperf::Phase::Diffusion);
+		}
+		phase.enter(xperf::Phase::DiagonalJacobian);
+		{
+			xperf::ScopedPhase innerPhase(xperf::Phase::Reactions);
+			innerPhase.enter(xperf::Phase::MatrixAssembly);
+		}
+		phase.leave();
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that nothing is recorded when the tree is disabled.
+ */
+BOOST_AUTO_TEST_CASE(checkDisabled) {
+	auto& tree = xperf::getPhaseTree();
+	tree.reset();
+	tree.setEnabled(false);
+
+	timeJacobian();
+
+	BOOST_REQUIRE_EQUAL(tree.getRecords().size(), 0U);
+}
+
+/**
+ * This operation checks the shape of the tree, the number of calls and
+ * the times of each node.
+ */
+BOOST_AUTO_TEST_CASE(checkTree) {
+	auto& tree = xperf::getPhaseTree();
+	tree.reset();
+	tree.setEnabled(true);
+
+	timeJacobian();
+
+	auto records = tree.getRecords();
+	BOOST_REQUIRE_EQUAL(records.size(), 7U);
+
+	// The nodes come in the depth-first order of the phases
+	xperf::Phase phases[] = { xperf::Phase::RHSJacobian,
+			xperf::Phase::OffDiagonalJacobian, xperf::Phase::Diffusion,
+			xperf::Phase::MatrixAssembly, xperf::Phase::DiagonalJacobian,
+			xperf::Phase::Reactions, xperf::Phase::MatrixAssembly };
+	unsigned long calls[] = { 2, 2, 4, 2, 2, 2, 2 };
+	std::size_t depths[] = { 1, 2, 3, 3, 2, 3, 3 };
+	for (int i = 0; i < 7; i++) {
+		BOOST_REQUIRE(records[i].phase == phases[i]);
+		BOOST_REQUIRE_EQUAL(records[i].calls, calls[i]);
+		BOOST_REQUIRE_EQUAL(records[i].key.size(), depths[i]);
+		BOOST_REQUIRE(records[i].self >= 0.0);
+		BOOST_REQUIRE(records[i].self <= records[i].inclusive);
+		if (i > 0)
+			BOOST_REQUIRE(records[i - 1].key < records[i].key);
+	}
+
+	// The names
+	BOOST_REQUIRE_EQUAL(xperf::getPhaseName(records[0].phase), "RHSJacobian");
+	BOOST_REQUIRE_EQUAL(xperf::getPhaseName(records[6].phase),
+			"matrixAssembly");
+
+	// A leaf only spends time in itself
+	BOOST_REQUIRE_EQUAL(records[3].self, records[3].inclusive);
+
+	tree.reset();
+	BOOST_REQUIRE_EQUAL(tree.getRecords().size(), 0U);
+}
+
+/**
+ * This operation checks the aggregation of the trees over the processes.
+ */
+BOOST_AUTO_TEST_CASE(checkAggregation) {
+	xperf::initialize(xperf::IHandlerRegistry::std);
+	auto reg = std::dynamic_pointer_cast<xperf::StdHandlerRegistry>(
+			xperf::getHandlerRegistry());
+	BOOST_REQUIRE(reg);
+
+	// Initializing a registry that collects the data enables the tree
+	auto& tree = xperf::getPhaseTree();
+	BOOST_REQUIRE(tree.isEnabled());
+	tree.reset();
+
+	timeJacobian();
+	// Only the first process goes through the nucleation
+	if (cwRank == 0) {
+		xperf::ScopedPhase phase(xperf::Phase::Nucleation);
+	}
+
+	xperf::PerfObjStatsMap<xperf::ITimer::ValType> timerStats;
+	xperf::PerfObjStatsMap<xperf::IEventCounter::ValType> ctrStats;
+	xperf::PerfObjStatsMap<xperf::IHardwareCounter::CounterType> hwCtrStats;
+	reg->collectStatistics(timerStats, ctrStats, hwCtrStats);
+
+	// Only rank 0 does the verification
+	if (cwRank == 0) {
+		auto const& stats = reg->getPhaseStatistics();
+		BOOST_REQUIRE_EQUAL(stats.size(), 8U);
+
+		// The jacobian was timed everywhere
+		BOOST_REQUIRE(stats[0].getPhase() == xperf::Phase::RHSJacobian);
+		BOOST_REQUIRE_EQUAL(stats[0].calls.processCount,
+				(unsigned int )cwSize);
+		BOOST_REQUIRE_EQUAL(stats[0].calls.min, 2.0);
+		BOOST_REQUIRE_EQUAL(stats[0].calls.max, 2.0);
+		BOOST_REQUIRE_EQUAL(stats[0].calls.average, 2.0);
+		BOOST_REQUIRE(stats[0].inclusive.min <= stats[0].inclusive.max);
+		BOOST_REQUIRE(stats[0].self.max <= stats[0].inclusive.max);
+
+		// The nucleation only on one process
+		BOOST_REQUIRE(stats[7].getPhase() == xperf::Phase::Nucleation);
+		BOOST_REQUIRE_EQUAL(stats[7].calls.processCount, 1U);
+		BOOST_REQUIRE_EQUAL(stats[7].calls.max, 1.0);
+	}
+
+	tree.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+#define BOOST_TEST_MODULE Regression
+
+#include <cstdio>
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include "xolotlPerf/xolotlPerf.h"
+#include "xolotlPerf/trace/TraceHandlerRegistry.h"
+
+namespace xperf = xolotlPerf;
+namespace pt = boost::property_tree;
+
+// our coordinates in the MPI world
+int cwRank = -1;
+int cwSize = -1;
+
+/**
+ * Test suite for the TraceRecorder and TraceHandlerRegistry classes.
+ */
+BOOST_AUTO_TEST_SUITE (TraceRecorder_testSuite)
+
+struct MPIFixture {
+	MPIFixture(void) {
+		MPI_Init(&boost::unit_test::framework::master_test_suite().argc,
+				&boost::unit_test::framework::master_test_suite().argv);
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
+		MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+	}
+
+	~MPIFixture(void) {
+		MPI_Finalize();
+	}
+};
+
+#if BOOST_VERSION >= 105900
+// In Boost 1.59, the semicolon at the end of the definition of BOOST_GLOBAL_FIXTURE is removed
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+#else
+// With earlier Boost versions, naively adding a semicolon to our code will generate compiler
+// warnings about redundant semicolons
+BOOST_GLOBAL_FIXTURE (MPIFixture)
+#endif
+
+/**
+ * Count the events of a trace file with a given name.
+ *
+ * @param trace The parsed trace
+ * @param name The name of the events
+ * @return Their number
+ */
+int countEvents(const pt::ptree& trace, const std::string& name) {
+	int count = 0;
+	for (auto const& event : trace) {
+		if (event.second.get<std::string>("name") == name)
+			count++;
+	}
+
+	return count;
+}
+
+/**
+ * This operation checks the trace written by the registry.
+ */
+BOOST_AUTO_TEST_CASE(checkRegistry) {
+	xperf::initialize(xperf::toPerfRegistryType("trace"));
+	auto reg = xperf::getHandlerRegistry();
+	BOOST_REQUIRE(std::dynamic_pointer_cast<xperf::TraceHandlerRegistry>(reg));
+	BOOST_REQUIRE(xperf::getTraceRecorder().isEnabled());
+
+	// A timer
+	auto timer = reg->getTimer("testTimer");
+	timer->start();
+	timer->stop();
+	timer->start();
+	timer->stop();
+
+	// Phases, the third level is too deep to be traced
+	{
+		xperf::ScopedPhase functionPhase(xperf::Phase::RHSFunction);
+		xperf::ScopedPhase phase(xperf::Phase::GhostExchange);
+		phase.enter(xperf::Phase::UpdateConcentration);
+		xperf::ScopedPhase innerPhase(xperf::Phase::Flux);
+	}
+
+	// Write half the events now and the rest at the end
+	xperf::getTraceRecorder().write();
+	auto now = xperf::TraceRecorder::Clock::now();
+	xperf::getTraceRecorder().record("timestep", "solver", now, now, "step",
+			3);
+
+	xperf::PerfObjStatsMap<xperf::ITimer::ValType> timerStats;
+	xperf::PerfObjStatsMap<xperf::IEventCounter::ValType> ctrStats;
+	xperf::PerfObjStatsMap<xperf::IHardwareCounter::CounterType> hwCtrStats;
+	reg->collectStatistics(timerStats, ctrStats, hwCtrStats);
+	BOOST_REQUIRE(!xperf::getTraceRecorder().isEnabled());
+
+	// Only rank 0 reads the file
+	if (cwRank == 0) {
+		pt::ptree trace;
+		pt::read_json(xperf::TraceHandlerRegistry::traceFileName, trace);
+
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "process_name"), cwSize);
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "testTimer"), 2 * cwSize);
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "RHSFunction"), cwSize);
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "ghostExchange"), cwSize);
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "updateConcentration"),
+				cwSize);
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "flux"), 0);
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "timestep"), cwSize);
+		BOOST_REQUIRE_EQUAL(trace.size(), 7U * cwSize);
+
+		// Look at the time step of the last process
+		for (auto const& event : trace) {
+			if (event.second.get<std::string>("name") != "timestep"
+					|| event.second.get<int>("pid") != cwSize - 1)
+				continue;
+			BOOST_REQUIRE_EQUAL(event.second.get<std::string>("cat"),
+					"solver");
+			BOOST_REQUIRE_EQUAL(event.second.get<std::string>("ph"), "X");
+			BOOST_REQUIRE_EQUAL(event.second.get<int>("args.step"), 3);
+			BOOST_REQUIRE_EQUAL(event.second.get<double>("dur"), 0.0);
+			BOOST_REQUIRE(event.second.get<double>("ts") >= 0.0);
+		}
+
+		std::remove(xperf::TraceHandlerRegistry::traceFileName.c_str());
+	}
+
+	// The phases are not traced anymore
+	xperf::initialize(xperf::IHandlerRegistry::std);
+}
+
+/**
+ * This operation checks that the oldest events are dropped when the
+ * buffer is full.
+ */
+BOOST_AUTO_TEST_CASE(checkRing) {
+	auto& recorder = xperf::getTraceRecorder();
+	recorder.start(MPI_COMM_WORLD, "ringTrace.json", 2);
+
+	auto now = xperf::TraceRecorder::Clock::now();
+	for (int i = 0; i < 5; i++) {
+		recorder.record("event", "test", now, now, "index", i);
+	}
+	recorder.finish();
+
+	if (cwRank == 0) {
+		pt::ptree trace;
+		pt::read_json("ringTrace.json", trace);
+
+		// The last two events are kept
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "event"), 2 * cwSize);
+		int index = 3;
+		for (auto const& event : trace) {
+			if (event.second.get<std::string>("name") == "event"
+					&& event.second.get<int>("pid") == 0) {
+				BOOST_REQUIRE_EQUAL(event.second.get<int>("args.index"),
+						index);
+				index++;
+			}
+			if (event.second.get<std::string>("name") == "droppedEvents")
+				BOOST_REQUIRE_EQUAL(event.second.get<int>("args.count"), 3);
+		}
+		BOOST_REQUIRE_EQUAL(countEvents(trace, "droppedEvents"), cwSize);
+
+		std::remove("ringTrace.json");
+	}
+
+	// Nothing is recorded once it is finished
+	recorder.record("event", "test", now, now);
+	BOOST_REQUIRE(!recorder.isEnabled());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,9 +5,12 @@
 #include <PSIClusterReactionNetwork.h>
 #include <DummyHandlerRegistry.h>
 #include <HDF5NetworkLoader.h>
+#include <XFile.h>
 #include <XolotlConfig.h>
 #include <mpi.h>
 #include <memory>
+#include <fstream>
+#include <cstring>
 #include <Options.h>
 #include "tests/utils/MPIFixture.h"
 
@@ -99,4 +102,277 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	return;
 }
 
+/**
+ * Method checking that a network rebuilt from a packed buffer is the same
+ * as the original one.
+ */
+BOOST_AUTO_TEST_CASE(checkPackNetwork) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 1" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader and set grouping parameters
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options and pack it
+	auto network = loader.generate(opts);
+	auto buffer = HDF5NetworkLoader::packNetwork(*network);
+
+	// Rebuild it with another loader
+	HDF5NetworkLoader otherLoader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	auto otherNetwork = otherLoader.unpackNetwork(opts, buffer);
+
+	// Check the sizes
+	BOOST_REQUIRE_EQUAL(otherNetwork->size(), network->size());
+	BOOST_REQUIRE_EQUAL(otherNetwork->getSuperSize(), network->getSuperSize());
+	BOOST_REQUIRE(network->getSuperSize() > 0);
+	BOOST_REQUIRE_EQUAL(otherNetwork->getDOF(), network->getDOF());
+
+	// Packing the rebuilt network should give back the same buffer
+	auto otherBuffer = HDF5NetworkLoader::packNetwork(*otherNetwork);
+	BOOST_REQUIRE_EQUAL(otherBuffer.size(), buffer.size());
+	for (unsigned int i = 0; i < buffer.size(); i++) {
+		BOOST_REQUIRE_EQUAL(otherBuffer[i], buffer[i]);
+	}
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+
+	return;
+}
+
+/**
+ * Method checking that a network written with the columnar layout
+ * is loaded back identically.
+ */
+BOOST_AUTO_TEST_CASE(checkColumnarLayout) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 1" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader and set grouping parameters
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options and write it
+	auto network = loader.generate(opts);
+	const std::string fileName = "test_columnar.h5";
+	{
+		std::vector<double> grid = { 0.0, 0.5, 1.0 };
+		XFile networkFile(fileName, grid, network->getCompositionList());
+		XFile::NetworkGroup networkGroup(networkFile, *network);
+		BOOST_REQUIRE_EQUAL(networkGroup.getLayoutVersion(),
+				XFile::NetworkGroup::columnarLayout);
+	}
+
+	// Load it back
+	HDF5NetworkLoader otherLoader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	otherLoader.setFilename(fileName);
+	auto otherNetwork = otherLoader.load(opts);
+
+	// Check the sizes
+	BOOST_REQUIRE_EQUAL(otherNetwork->size(), network->size());
+	BOOST_REQUIRE_EQUAL(otherNetwork->getSuperSize(), network->getSuperSize());
+	BOOST_REQUIRE(network->getSuperSize() > 0);
+	BOOST_REQUIRE_EQUAL(otherNetwork->getDOF(), network->getDOF());
+
+	// The clusters and reactions should be the same
+	auto buffer = HDF5NetworkLoader::packNetwork(*network);
+	auto otherBuffer = HDF5NetworkLoader::packNetwork(*otherNetwork);
+	BOOST_REQUIRE_EQUAL(otherBuffer.size(), buffer.size());
+	for (unsigned int i = 0; i < buffer.size(); i++) {
+		BOOST_REQUIRE_EQUAL(otherBuffer[i], buffer[i]);
+	}
+
+	// Remove the created files
+	std::remove(fileName.c_str());
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+
+	return;
+}
+
+/**
+ * Method checking that a file with the legacy layout, a single dataset
+ * without reactions, is loaded and gets its reactions created.
+ */
+BOOST_AUTO_TEST_CASE(checkLegacyLayout) {
+	// Write the file: He, V, I, formation energy, migration energy,
+	// diffusion factor
+	const std::string fileName = "test_legacy.h5";
+	double rows[4][6] = { { 0, 0, 1, 10.0, 0.01, 8.8e+10 }, { 1, 0, 0, 6.15,
+			0.13, 2.9e+10 }, { 2, 0, 0, 11.44, 0.2, 3.2e+10 }, { 0, 1, 0, 3.6,
+			1.3, 1.8e+12 } };
+	hid_t fileId = H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+	H5P_DEFAULT);
+	hid_t groupId = H5Gcreate2(fileId, "networkGroup", H5P_DEFAULT,
+	H5P_DEFAULT, H5P_DEFAULT);
+	hsize_t dims[2] = { 4, 6 };
+	hid_t spaceId = H5Screate_simple(2, dims, NULL);
+	hid_t datasetId = H5Dcreate2(groupId, "network", H5T_IEEE_F64LE, spaceId,
+	H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(datasetId, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, rows);
+	H5Dclose(datasetId);
+	H5Sclose(spaceId);
+	H5Gclose(groupId);
+	H5Fclose(fileId);
+
+	// Check the layout
+	{
+		XFile networkFile(fileName);
+		auto networkGroup = networkFile.getGroup<XFile::NetworkGroup>();
+		BOOST_REQUIRE(networkGroup);
+		BOOST_REQUIRE_EQUAL(networkGroup->getLayoutVersion(),
+				XFile::NetworkGroup::legacyLayout);
+		BOOST_REQUIRE(!networkGroup->hasReactions());
+		int normalSize = 0, superSize = 0;
+		networkGroup->readNetworkSize(normalSize, superSize);
+		BOOST_REQUIRE_EQUAL(normalSize, 4);
+		BOOST_REQUIRE_EQUAL(superSize, 0);
+	}
+
+	// Load it
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	loader.setFilename(fileName);
+	Options opts;
+	auto network = loader.load(opts);
+
+	// Check the clusters
+	BOOST_REQUIRE_EQUAL(network->size(), 4);
+	auto psiNetwork = (PSIClusterReactionNetwork*) network.get();
+	BOOST_REQUIRE(psiNetwork->getMaxClusterSize(ReactantType::He) == 2);
+	BOOST_REQUIRE(psiNetwork->getMaxClusterSize(ReactantType::V) == 1);
+	BOOST_REQUIRE(psiNetwork->getMaxClusterSize(ReactantType::I) == 1);
+	auto& he1 = *(network->get(Species::He, 1));
+	BOOST_REQUIRE_CLOSE(he1.getFormationEnergy(), 6.15, 1.0e-10);
+	BOOST_REQUIRE_CLOSE(he1.getDiffusionFactor(), 2.9e+10, 1.0e-10);
+
+	// He_1 + He_1 -> He_2 was created
+	network->reinitializeConnectivities();
+	auto& he2 = *(network->get(Species::He, 2));
+	auto connectivity = he2.getConnectivity();
+	BOOST_REQUIRE_EQUAL(connectivity[he1.getId() - 1], 1);
+
+	// Remove the created file
+	std::remove(fileName.c_str());
+
+	return;
+}
+
+/**
+ * Method checking that the weight vectors of the totals give the same
+ * concentrations as the network.
+ */
+BOOST_AUTO_TEST_CASE(checkTotalWeights) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 1" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader and set grouping parameters
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network
+	auto network = loader.generate(opts);
+	BOOST_REQUIRE(network->getSuperSize() > 0);
+
+	// Set different concentrations everywhere, including the moments
+	const int dof = network->getDOF();
+	std::vector<double> concentrations(dof);
+	for (int i = 0; i < dof; i++) {
+		concentrations[i] = 1.0 + 0.1 * (double) i;
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Check the totals
+	BOOST_REQUIRE_CLOSE(
+			IReactionNetwork::sumWeights(network->getTotalAtomWeights(0),
+					concentrations.data()),
+			network->getTotalAtomConcentration(0), 1.0e-10);
+	BOOST_REQUIRE_CLOSE(
+			IReactionNetwork::sumWeights(
+					network->getTotalTrappedAtomWeights(0),
+					concentrations.data()),
+			network->getTotalTrappedAtomConcentration(0), 1.0e-10);
+	BOOST_REQUIRE_CLOSE(
+			IReactionNetwork::sumWeights(network->getTotalVWeights(),
+					concentrations.data()), network->getTotalVConcentration(),
+			1.0e-10);
+	BOOST_REQUIRE_CLOSE(
+			IReactionNetwork::sumWeights(network->getTotalIWeights(),
+					concentrations.data()), network->getTotalIConcentration(),
+			1.0e-10);
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -159,6 +159,18 @@ BOOST_AUTO_TEST_CASE(checkReactants) {
 	psiNetwork->setTemperature(1000.0, 0);
 	BOOST_REQUIRE_CLOSE(1000.0, reactant.getTemperature(0), 0.0001);
 
+	// The memory reported for the grid points stays below the projection
+	auto& tracker = xolotlPerf::getMemoryTracker();
+	auto gridPointBytes = tracker.getCurrent(
+			xolotlPerf::MemoryCategory::GridPointRates);
+	BOOST_REQUIRE(gridPointBytes >= 2 * sizeof(double));
+	BOOST_REQUIRE(gridPointBytes <= psiNetwork->getGridPointMemorySize(1));
+	psiNetwork->addGridPoints(2);
+	gridPointBytes = tracker.getCurrent(
+			xolotlPerf::MemoryCategory::GridPointRates);
+	BOOST_REQUIRE(gridPointBytes >= 6 * sizeof(double));
+	BOOST_REQUIRE(gridPointBytes <= psiNetwork->getGridPointMemorySize(3));
+
 	return;
 }
 
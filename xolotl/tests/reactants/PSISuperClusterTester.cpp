@@ -338,6 +338,67 @@ BOOST_AUTO_TEST_CASE(checkGetConcentrations) {
 	return;
 }
 
+/**
+ * This operation checks that moving the coefficients of a PSISuperCluster
+ * to an external memory segment keeps them unchanged.
+ */
+BOOST_AUTO_TEST_CASE(checkShareCoefficients) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 0" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+
+	// Get a super cluster and save its coefficients
+	auto& cluster = network->getAll(ReactantType::PSISuper).begin()->second;
+	auto& superCluster = static_cast<PSISuperCluster&>(*cluster);
+	auto prodVec = superCluster.getProdVector();
+	auto dissoVec = superCluster.getDissoVector();
+	BOOST_REQUIRE(prodVec.size() > 0);
+
+	// Move the coefficients to another segment
+	std::vector<double> segment(superCluster.getNCoefficients());
+	double *pool = segment.data();
+	superCluster.shareCoefficients(pool, true);
+	BOOST_REQUIRE(pool == segment.data() + segment.size());
+
+	// The coefficients are the same
+	BOOST_REQUIRE(prodVec == superCluster.getProdVector());
+	BOOST_REQUIRE(dissoVec == superCluster.getDissoVector());
+
+	// And they are read from the segment
+	segment[0] = -1.0;
+	BOOST_REQUIRE_EQUAL(superCluster.getProdVector()[0][2], -1.0);
+
+	return;
+}
+
 /**
  * This operation checks the boundary methods for PSISuperCluster.
  */
@@ -94,6 +94,65 @@ BOOST_AUTO_TEST_CASE(checkGetReactantFluxesAndParials) {
 	return;
 }
 
+/**
+ * This operation checks that the diffusion coefficients and rates computed
+ * by several threads, on rows they allocated, are the ones of a single
+ * thread.
+ */
+BOOST_AUTO_TEST_CASE(checkThreadedRates) {
+	// Local Declarations
+	string sourceDir(XolotlSourceDirectory);
+	string pathToFile("/tests/testfiles/tungsten.txt");
+	string networkFilename = sourceDir + pathToFile;
+
+	// Load the same network twice
+	Options opts;
+	shared_ptr<PSIClusterNetworkLoader> networkLoader = make_shared<
+			PSIClusterNetworkLoader>(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	networkLoader->setInputstream(make_shared<ifstream>(networkFilename));
+	auto serialNetwork = networkLoader->load(opts);
+	networkLoader->setInputstream(make_shared<ifstream>(networkFilename));
+	auto threadedNetwork = networkLoader->load(opts);
+
+	// One thread by default
+	BOOST_REQUIRE_EQUAL(serialNetwork->getNumThreads(), 1);
+	threadedNetwork->setNumThreads(4);
+	BOOST_REQUIRE_EQUAL(threadedNetwork->getNumThreads(), 4);
+
+	// Three grid points at different temperatures
+	const int nGridPoints = 3;
+	serialNetwork->addGridPoints(nGridPoints);
+	threadedNetwork->addGridPoints(nGridPoints);
+	for (int i = 0; i < nGridPoints; i++) {
+		serialNetwork->setTemperature(900.0 + 100.0 * i, i);
+		threadedNetwork->setTemperature(900.0 + 100.0 * i, i);
+	}
+	BOOST_REQUIRE_EQUAL(serialNetwork->getBiggestRate(),
+			threadedNetwork->getBiggestRate());
+
+	// Compare the clusters
+	auto& serialReactants = serialNetwork->getAll();
+	auto& threadedReactants = threadedNetwork->getAll();
+	BOOST_REQUIRE_EQUAL(serialReactants.size(), threadedReactants.size());
+	for (int j = 0; j < serialReactants.size(); j++) {
+		serialReactants.at(j).get().setConcentration(0.001);
+		threadedReactants.at(j).get().setConcentration(0.001);
+	}
+	for (int j = 0; j < serialReactants.size(); j++) {
+		IReactant& serialReactant = serialReactants.at(j);
+		IReactant& threadedReactant = threadedReactants.at(j);
+		for (int i = 0; i < nGridPoints; i++) {
+			BOOST_REQUIRE_EQUAL(serialReactant.getDiffusionCoefficient(i),
+					threadedReactant.getDiffusionCoefficient(i));
+			BOOST_REQUIRE_EQUAL(serialReactant.getTotalFlux(i),
+					threadedReactant.getTotalFlux(i));
+		}
+	}
+
+	return;
+}
+
 /**
  * This operation checks the partial derivatives for the production
  * He_1 + He_1 --> He_2
@@ -24,6 +24,7 @@
 #include <IReactionHandlerFactory.h>
 #include <VizHandlerRegistryFactory.h>
 #include <cassert>
+#include <algorithm>
 
 using namespace std;
 using namespace xolotlCore;
@@ -575,4 +576,229 @@ BOOST_AUTO_TEST_CASE(checkPetscSolver3DHandler) {
 	std::remove(tempFile.c_str());
 }
 
+/**
+ * This operation checks the ownership ranges of the 1D grid points when
+ * the surface moved: they cover the grid, every process has at least one
+ * grid point, and the active ones are shared within one grid point.
+ */
+BOOST_AUTO_TEST_CASE(checkOwnershipRanges) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "vizHandler=dummy" << std::endl << "petscArgs=-ts_max_steps 1"
+			<< std::endl << "startTemp=900" << std::endl
+			<< "perfHandler=dummy" << std::endl << "flux=4.0e5" << std::endl
+			<< "material=W100" << std::endl << "dimensions=1" << std::endl
+			<< "process=diff advec reaction movingSurface" << std::endl
+			<< "netParam=8 0 0 2 2" << std::endl << "grid=50 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the material factory
+	auto materialFactory =
+			xolotlFactory::IMaterialFactory::createMaterialFactory(
+					opts.getMaterial(), opts.getDimensionNumber());
+
+	// Initialize and get the temperature handler
+	bool tempInitOK = xolotlFactory::initializeTempHandler(opts);
+	auto tempHandler = xolotlFactory::getTemperatureHandler();
+
+	// Create the network handler factory
+	auto networkFactory =
+			xolotlFactory::IReactionHandlerFactory::createNetworkFactory(
+					opts.getMaterial());
+	networkFactory->initializeReactionNetwork(opts,
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Get the network
+	auto& network = networkFactory->getNetworkHandler();
+
+	// Create a solver handler and initialize it
+	xolotlSolver::PetscSolver1DHandler solverHandler(network);
+	solverHandler.initializeHandlers(materialFactory, tempHandler, opts);
+	const int nX = 50;
+
+	// Loop on the surface positions, the last ones leave fewer active
+	// grid points than processes
+	for (int surfacePos : { 0, 17, 40, 47 }) {
+		solverHandler.setSurfacePosition(surfacePos);
+		// The active grid points are between the surface and the right
+		// boundary
+		int firstActive = surfacePos + solverHandler.getLeftOffset();
+		int lastActive = nX - solverHandler.getRightOffset();
+
+		// Loop on the number of processes
+		for (int nProcs : { 1, 2, 3, 4, 7 }) {
+			auto lx = solverHandler.computeOwnershipRanges(nProcs);
+			BOOST_REQUIRE_EQUAL(lx.size(), (std::size_t) nProcs);
+
+			// Count the active grid points of each process
+			int sum = 0, minActive = nX, maxActive = 0;
+			for (int i = 0; i < nProcs; i++) {
+				BOOST_REQUIRE(lx[i] >= 1);
+				int start = std::max(sum, firstActive);
+				int end = std::min(sum + (int) lx[i], lastActive);
+				int nActive = std::max(end - start, 0);
+				minActive = std::min(minActive, nActive);
+				maxActive = std::max(maxActive, nActive);
+				sum += lx[i];
+			}
+			BOOST_REQUIRE_EQUAL(sum, nX);
+
+			// The active grid points are balanced when there are enough
+			if (lastActive - firstActive >= nProcs)
+				BOOST_REQUIRE(maxActive - minActive <= 1);
+		}
+	}
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+}
+
+/**
+ * This operation checks that the solution and the grid points of the
+ * network follow the new partition of the grid when the surface moved.
+ */
+BOOST_AUTO_TEST_CASE(checkRepartition) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "vizHandler=dummy" << std::endl << "petscArgs=-ts_max_steps 1"
+			<< std::endl << "startTemp=900" << std::endl
+			<< "perfHandler=dummy" << std::endl << "flux=4.0e5" << std::endl
+			<< "material=W100" << std::endl << "dimensions=1" << std::endl
+			<< "process=diff advec reaction movingSurface" << std::endl
+			<< "netParam=8 0 0 2 2" << std::endl << "grid=50 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the material factory
+	auto materialFactory =
+			xolotlFactory::IMaterialFactory::createMaterialFactory(
+					opts.getMaterial(), opts.getDimensionNumber());
+
+	// Initialize and get the temperature handler
+	bool tempInitOK = xolotlFactory::initializeTempHandler(opts);
+	auto tempHandler = xolotlFactory::getTemperatureHandler();
+
+	// Create the network handler factory
+	auto networkFactory =
+			xolotlFactory::IReactionHandlerFactory::createNetworkFactory(
+					opts.getMaterial());
+	networkFactory->initializeReactionNetwork(opts,
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Get the network
+	auto& network = networkFactory->getNetworkHandler();
+	const int dof = network.getDOF();
+
+	// Create a solver handler and initialize it
+	xolotlSolver::PetscSolver1DHandler solverHandler(network);
+	solverHandler.initializeHandlers(materialFactory, tempHandler, opts);
+
+	// Create the solver to initialize PETSc
+	std::unique_ptr<xolotlSolver::PetscSolver> solver(
+			new xolotlSolver::PetscSolver(solverHandler,
+					make_shared<xolotlPerf::DummyHandlerRegistry>()));
+	xolotlPerf::initialize(xolotlPerf::toPerfRegistryType("dummy"));
+	xolotlFactory::initializeVizHandler(false);
+	solver->setCommandLineOptions(opts.getPetscArg());
+	solver->initialize();
+
+	// Create the distributed array and the solution like the solver does
+	DM da;
+	solverHandler.createSolverContext(da);
+	Vec C;
+	PetscErrorCode ierr = DMCreateGlobalVector(da, &C);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	solverHandler.initializeConcentration(da, C);
+
+	// Give each value its global index
+	PetscScalar **concs = nullptr;
+	PetscInt xs, xm;
+	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMDAVecGetArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	for (int xi = xs; xi < xs + xm; xi++) {
+		for (int l = 0; l < dof; l++) {
+			concs[xi][l] = xi * dof + l;
+		}
+	}
+	ierr = DMDAVecRestoreArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_EQUAL(network.getNumberOfGridPoints(), xm + 2);
+
+	// Move the surface and repartition
+	solverHandler.setSurfacePosition(17);
+	solverHandler.repartitionSolverContext(da, C);
+
+	// The new partition is the computed one
+	int nProcs;
+	MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+	auto lx = solverHandler.computeOwnershipRanges(nProcs);
+	const PetscInt* newLx = nullptr;
+	ierr = DMDAGetOwnershipRanges(da, &newLx, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	for (int i = 0; i < nProcs; i++) {
+		BOOST_REQUIRE_EQUAL(newLx[i], lx[i]);
+	}
+
+	// The values moved with their grid points
+	PetscInt newXs, newXm;
+	ierr = DMDAGetCorners(da, &newXs, NULL, NULL, &newXm, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMDAVecGetArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	for (int xi = newXs; xi < newXs + newXm; xi++) {
+		for (int l = 0; l < dof; l++) {
+			BOOST_REQUIRE_EQUAL(concs[xi][l], xi * dof + l);
+		}
+	}
+	ierr = DMDAVecRestoreArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The network has the rates of the new local grid points and the
+	// ghost ones
+	BOOST_REQUIRE_EQUAL(network.getNumberOfGridPoints(), newXm + 2);
+
+	// Free the work space
+	ierr = VecDestroy(&C);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMDestroy(&da);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	solver->finalize();
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,245 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <hdf5.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "xolotlSolver/monitor/TelemetrySink.h"
+
+using namespace std;
+using namespace xolotlSolver;
+
+namespace {
+
+/**
+ * Read the lines of a file.
+ *
+ * @param fileName The name of the file
+ * @return The lines
+ */
+vector<string> readLines(const string& fileName) {
+	vector<string> lines;
+	ifstream inputFile(fileName);
+	string line;
+	while (getline(inputFile, line)) {
+		lines.push_back(line);
+	}
+
+	return lines;
+}
+
+/**
+ * Read a one dimensional dataset of a telemetry group.
+ *
+ * @param fileId The file
+ * @param name The path of the dataset
+ * @param memType The type of the values in memory
+ * @return The values
+ */
+template<typename T>
+vector<T> readDataset(hid_t fileId, const string& name, hid_t memType) {
+	hid_t datasetId = H5Dopen(fileId, name.c_str(), H5P_DEFAULT);
+	BOOST_REQUIRE(datasetId >= 0);
+	hid_t spaceId = H5Dget_space(datasetId);
+	vector<T> data(H5Sget_simple_extent_npoints(spaceId));
+	if (!data.empty())
+		H5Dread(datasetId, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				data.data());
+	H5Sclose(spaceId);
+	H5Dclose(datasetId);
+
+	return data;
+}
+
+} // namespace
+
+/**
+ * The test suite configuration
+ */
+BOOST_AUTO_TEST_SUITE (TelemetrySinkTester_testSuite)
+
+/**
+ * This operation checks the backend names.
+ */
+BOOST_AUTO_TEST_CASE(checkBackend) {
+	BOOST_REQUIRE(
+			TelemetrySink::getBackend("text") == TelemetrySink::Backend::Text);
+	BOOST_REQUIRE(
+			TelemetrySink::getBackend("csv") == TelemetrySink::Backend::CSV);
+	BOOST_REQUIRE(
+			TelemetrySink::getBackend("hdf5") == TelemetrySink::Backend::HDF5);
+	BOOST_REQUIRE_THROW(TelemetrySink::getBackend("xml"), std::string);
+}
+
+/**
+ * This operation checks that the records are written when the buffers get
+ * bigger than the given size, and only then.
+ */
+BOOST_AUTO_TEST_CASE(checkSizeThreshold) {
+	const string fileName = "telemetrySize.txt";
+	{
+		// Three doubles and a day
+		TelemetrySink sink(TelemetrySink::Backend::Text, 3 * sizeof(double),
+				86400.0, 0);
+		sink.addStream(fileName, { "time", "value" }, true);
+
+		sink.push(fileName, { 1.0, 2.0 });
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 0U);
+
+		// Four doubles are buffered now
+		sink.push(fileName, { 3.0, 4.0 });
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 2U);
+
+		sink.push(fileName, { 5.0, 6.0 });
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 2U);
+	}
+
+	// The destructor wrote the rest
+	BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 3U);
+	std::remove(fileName.c_str());
+}
+
+/**
+ * This operation checks that the records are written when the given time
+ * has passed since the last write.
+ */
+BOOST_AUTO_TEST_CASE(checkTimeThreshold) {
+	const string fileName = "telemetryTime.txt";
+	{
+		// Big buffers but no time
+		TelemetrySink sink(TelemetrySink::Backend::Text, 1 << 20, 0.0, 0);
+		sink.addStream(fileName, { "time", "value" }, true);
+
+		sink.push(fileName, { 1.0, 2.0 });
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 1U);
+		sink.push(fileName, { 3.0, 4.0 });
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 2U);
+	}
+	std::remove(fileName.c_str());
+
+	{
+		// Big buffers and a day
+		TelemetrySink sink(TelemetrySink::Backend::Text, 1 << 20, 86400.0,
+				0);
+		sink.addStream(fileName, { "time", "value" }, true);
+
+		sink.push(fileName, { 1.0, 2.0 });
+		sink.push(fileName, { 3.0, 4.0 });
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 0U);
+
+		sink.flush();
+		BOOST_REQUIRE_EQUAL(readLines(fileName).size(), 2U);
+	}
+	std::remove(fileName.c_str());
+}
+
+/**
+ * This operation checks the text and CSV files.
+ */
+BOOST_AUTO_TEST_CASE(checkTextOutput) {
+	{
+		TelemetrySink sink(TelemetrySink::Backend::Text, 1 << 20, 86400.0,
+				0);
+		sink.addStream("telemetryText.txt", { "time", "value" }, true);
+		sink.push("telemetryText.txt", { 1.5, 2.0 });
+		sink.push("telemetryText.txt", { 3.0, 4.0, 5.0 });
+	}
+	auto lines = readLines("telemetryText.txt");
+	BOOST_REQUIRE_EQUAL(lines.size(), 2U);
+	BOOST_REQUIRE_EQUAL(lines[0], "1.5 2");
+	BOOST_REQUIRE_EQUAL(lines[1], "3 4 5");
+
+	// The stream is appended to when it is not cleared
+	{
+		TelemetrySink sink(TelemetrySink::Backend::Text, 1 << 20, 86400.0,
+				0);
+		sink.push("telemetryText.txt", { 6.0, 7.0 });
+	}
+	lines = readLines("telemetryText.txt");
+	BOOST_REQUIRE_EQUAL(lines.size(), 3U);
+	BOOST_REQUIRE_EQUAL(lines[2], "6 7");
+	std::remove("telemetryText.txt");
+
+	// The CSV file starts with the column names
+	{
+		TelemetrySink sink(TelemetrySink::Backend::CSV, 1 << 20, 86400.0, 0);
+		sink.addStream("telemetryCSV.txt", { "time", "value" }, true);
+		sink.push("telemetryCSV.txt", { 1.5, 2.0 });
+		sink.push("telemetryCSV.txt", { 3.0, 4.0 });
+	}
+	lines = readLines("telemetryCSV.csv");
+	BOOST_REQUIRE_EQUAL(lines.size(), 3U);
+	BOOST_REQUIRE_EQUAL(lines[0], "time,value");
+	BOOST_REQUIRE_EQUAL(lines[1], "1.5,2");
+	BOOST_REQUIRE_EQUAL(lines[2], "3,4");
+	std::remove("telemetryCSV.csv");
+}
+
+/**
+ * This operation checks the layout of the HDF5 file and that a new sink,
+ * like the one of a restarted run, appends to it.
+ */
+BOOST_AUTO_TEST_CASE(checkHDF5Output) {
+	// The file of rank 3
+	const string fileName = "telemetry_3.h5";
+	std::remove(fileName.c_str());
+	{
+		TelemetrySink sink(TelemetrySink::Backend::HDF5, 1 << 20, 86400.0,
+				3);
+		sink.addStream("retention.txt", { "time", "fluence" }, true);
+		sink.push("retention.txt", { 1.0, 2.0 });
+		sink.push("retention.txt", { 3.0, 4.0, 5.0 });
+	}
+
+	// The restart only appends
+	{
+		TelemetrySink sink(TelemetrySink::Backend::HDF5, 1 << 20, 86400.0,
+				3);
+		sink.addStream("retention.txt", { "time", "fluence" }, false);
+		sink.push("retention.txt", { 6.0 });
+	}
+
+	hid_t fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	BOOST_REQUIRE(fileId >= 0);
+	auto values = readDataset<double>(fileId, "retention.txt/values",
+	H5T_NATIVE_DOUBLE);
+	auto rowEnds = readDataset<unsigned long long>(fileId,
+			"retention.txt/rowEnds", H5T_NATIVE_ULLONG);
+	BOOST_REQUIRE_EQUAL(values.size(), 6U);
+	for (int i = 0; i < 6; i++) {
+		BOOST_REQUIRE_EQUAL(values[i], i + 1.0);
+	}
+	BOOST_REQUIRE_EQUAL(rowEnds.size(), 3U);
+	BOOST_REQUIRE_EQUAL(rowEnds[0], 2U);
+	BOOST_REQUIRE_EQUAL(rowEnds[1], 5U);
+	BOOST_REQUIRE_EQUAL(rowEnds[2], 6U);
+
+	// The column names
+	hid_t groupId = H5Gopen2(fileId, "retention.txt", H5P_DEFAULT);
+	hid_t attrId = H5Aopen(groupId, "columns", H5P_DEFAULT);
+	hid_t typeId = H5Aget_type(attrId);
+	string columns(H5Tget_size(typeId), '\0');
+	H5Aread(attrId, typeId, &columns[0]);
+	BOOST_REQUIRE_EQUAL(columns, "time,fluence");
+	H5Tclose(typeId);
+	H5Aclose(attrId);
+	H5Gclose(groupId);
+	H5Fclose(fileId);
+
+	// Clearing the stream starts it over, even before anything is written
+	{
+		TelemetrySink sink(TelemetrySink::Backend::HDF5, 1 << 20, 86400.0,
+				3);
+		sink.addStream("retention.txt", { "time", "fluence" }, true);
+	}
+	fileId = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	BOOST_REQUIRE(fileId >= 0);
+	BOOST_REQUIRE(H5Lexists(fileId, "retention.txt", H5P_DEFAULT) == 0);
+	H5Fclose(fileId);
+	std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -60,6 +60,14 @@ public:
 	 */
 	virtual void setExitCode(int code) = 0;
 
+	/**
+	 * Should the program only report the memory the simulation would use,
+	 * without solving?
+	 *
+	 * @return true for a dry run
+	 */
+	virtual bool isDryRun() const = 0;
+
 	/**
 	 * Get the name of the network file.
 	 *
@@ -67,6 +75,21 @@ public:
 	 */
 	virtual std::string getNetworkFilename() const = 0;
 
+	/**
+	 * Get the directory where the generated networks are cached.
+	 *
+	 * @return The directory, empty if the cache is not used
+	 */
+	virtual std::string getNetworkCacheDirectory() const = 0;
+
+	/**
+	 * Get how the concentrations are moved onto the grid of the parameter
+	 * file when restarting, "none" keeps the grid of the restart file.
+	 *
+	 * @return "none", "conservative" or "linear"
+	 */
+	virtual std::string getRestartRemap() const = 0;
+
 	/**
 	 * Get the Arguments for PETSc.
 	 *
@@ -10,8 +10,8 @@ namespace bpo = boost::program_options;
 namespace xolotlCore {
 
 Options::Options() :
-		shouldRunFlag(true), exitCode(EXIT_SUCCESS), petscArg(""), networkFilename(
-				""), constTempFlag(false), constTemperature(1000.0), tempProfileFlag(
+		shouldRunFlag(true), exitCode(EXIT_SUCCESS), dryRunFlag(false), petscArg(""), networkFilename(
+				""), networkCacheDirectory(""), restartRemap("none"), constTempFlag(false), constTemperature(1000.0), tempProfileFlag(
 				false), tempProfileFilename(""), heatFlag(false), bulkTemperature(
 				0.0), fluxFlag(false), fluxAmplitude(0.0), fluxProfileFlag(
 				false), perfRegistryType(xolotlPerf::IHandlerRegistry::std), vizStandardHandlersFlag(
@@ -43,7 +43,9 @@ void Options::readParams(int argc, char* argv[]) {
 
 	// Parse the command line options.
 	bpo::options_description desc("Command line options");
-	desc.add_options()("help", "show this help message")("parameterFile",
+	desc.add_options()("help", "show this help message")("dry-run",
+			"build the network and report the memory each process would use, "
+					"without solving")("parameterFile",
 			bpo::value<std::string>(&param_file), "input file name");
 
 	bpo::positional_options_description p;
@@ -61,7 +63,15 @@ void Options::readParams(int argc, char* argv[]) {
 	// config file
 	bpo::options_description config("Parameters");
 	config.add_options()("networkFile", bpo::value<string>(&networkFilename),
-			"The network will be loaded from this HDF5 file.")("startTemp",
+			"The network will be loaded from this HDF5 file.")("networkCache",
+			bpo::value<string>(&networkCacheDirectory),
+			"The directory where the networks are cached once built, "
+					"runs with the same network options then skip building it.")(
+			"restartRemap", bpo::value<string>(&restartRemap),
+			"How the concentrations of the network file are moved onto the grid "
+					"given here when restarting (available none,conservative,linear). "
+					"With none (default) the grid of the network file is kept.")(
+			"startTemp",
 			bpo::value<string>(),
 			"The temperature (in Kelvin) will be the constant floating point value specified. "
 					"(default = 1000). If two values are given, the second one is interpreted "
@@ -82,7 +92,7 @@ void Options::readParams(int argc, char* argv[]) {
 					"(NOTE: If a flux profile file is given, "
 					"a constant flux should NOT be given)")("perfHandler",
 			bpo::value<string>()->default_value("std"),
-			"Which set of performance handlers to use. (default = std, available std,dummy,os,papi).")(
+			"Which set of performance handlers to use. (default = std, available std,dummy,os,papi,trace,perf).")(
 			"vizHandler", bpo::value<string>()->default_value("dummy"),
 			"Which set of handlers to use for the visualization. (default = dummy, available std,dummy).")(
 			"dimensions", bpo::value<int>(&dimensionNumber),
@@ -161,6 +171,8 @@ void Options::readParams(int argc, char* argv[]) {
 	bpo::options_description visible("Allowed options");
 	visible.add(desc).add(config);
 
+	dryRunFlag = (opts.count("dry-run") > 0);
+
 	if (opts.count("help")) {
 		std::cout << visible << '\n';
 		shouldRunFlag = false;
@@ -304,6 +316,16 @@ void Options::readParams(int argc, char* argv[]) {
 			}
 		}
 
+		// Check the restart remap method
+		if (restartRemap != "none" and restartRemap != "conservative"
+				and restartRemap != "linear") {
+			std::cerr
+					<< "\nOptions: could not understand the restart remap method. "
+							"Aborting!\n" << std::endl;
+			shouldRunFlag = false;
+			exitCode = EXIT_FAILURE;
+		}
+
 		// Take care of the radius minimum size
 		if (opts.count("radiusSize")) {
 			// Build an input stream from the argument string.
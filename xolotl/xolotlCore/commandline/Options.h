@@ -23,11 +23,27 @@ protected:
 	 */
 	int exitCode;
 
+	/**
+	 * The flag that says if Xolotl should only report the memory it
+	 * would use.
+	 */
+	bool dryRunFlag;
+
 	/**
 	 * The name of the file where the network is stored.
 	 */
 	std::string networkFilename;
 
+	/**
+	 * The directory where the generated networks are cached.
+	 */
+	std::string networkCacheDirectory;
+
+	/**
+	 * How to move the restart concentrations onto a new grid.
+	 */
+	std::string restartRemap;
+
 	/**
 	 * The options that will be given to PETSc.
 	 */
@@ -366,6 +382,14 @@ public:
 		exitCode = code;
 	}
 
+	/**
+	 * Should the program only report the memory it would use?
+	 * \see IOptions.h
+	 */
+	bool isDryRun() const override {
+		return dryRunFlag;
+	}
+
 	/**
 	 * Get the name of the network file.
 	 * \see IOptions.h
@@ -374,6 +398,22 @@ public:
 		return networkFilename;
 	}
 
+	/**
+	 * Get the directory where the generated networks are cached.
+	 * \see IOptions.h
+	 */
+	std::string getNetworkCacheDirectory() const override {
+		return networkCacheDirectory;
+	}
+
+	/**
+	 * Get how the restart concentrations are moved onto a new grid.
+	 * \see IOptions.h
+	 */
+	std::string getRestartRemap() const override {
+		return restartRemap;
+	}
+
 	/**
 	 * Get the Arguments for PETSc.
 	 * \see IOptions.h
@@ -130,5 +130,14 @@ HDF5File::hasGroup(fs::path path) const {
     return (cret != 0);
 }
 
+void
+HDF5File::Flush(void) const {
+
+    auto status = H5Fflush(getId(), H5F_SCOPE_GLOBAL);
+    if(status < 0) {
+        throw HDF5Exception(BuildHDF5ErrorString());
+    }
+}
+
 } // namespace xolotlCore
 
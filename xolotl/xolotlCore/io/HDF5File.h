@@ -192,6 +192,19 @@ public:
           : LocatedHDF5Object(loc, name)
         { }
 
+        /**
+         * Set up a dataset creation property list for a chunked layout
+         * compressed with the shuffle and deflate (zlib) filters.
+         * Does nothing for an empty dataspace, which cannot be chunked.
+         *
+         * @param createProps The dataset creation property list.
+         * @param dspace The dataspace of the dataset to be created.
+         * @param compressionLevel The deflate level, from 1 to 9.
+         */
+        static void setCompression(const PropertyList& createProps,
+                                    const DataSpace& dspace,
+                                    int compressionLevel);
+
     public:
         DataSetBase(void) = delete;
         DataSetBase(const DataSetBase& other) = delete;
@@ -213,9 +226,12 @@ public:
         DataSetTBase(const DataSetTBase<T>& other) = delete;
 
         // Create data set.
+        // A positive compression level gives a chunked data set
+        // compressed with that deflate level.
         DataSetTBase(const HDF5Object& loc,
                         std::string dsetName,
-                        const DataSpace& dspace);
+                        const DataSpace& dspace,
+                        int compressionLevel = 0);
 
         // Open existing data set.
         DataSetTBase(const HDF5Object& loc, std::string dsetName);
@@ -411,12 +427,15 @@ public:
          * @param dsetName The name of the dataset.
          * @param baseX Index of the first X point we own.
          * @param data The data to be written.
+         * @param compressionLevel The deflate level used for the flattened
+         *              data, 0 to store it contiguous and uncompressed.
          */
         RaggedDataSet2D(MPI_Comm comm,
                         const HDF5Object& loc,
                         std::string dsetName,
                         int baseX,
-                        const Ragged2DType& data);
+                        const Ragged2DType& data,
+                        int compressionLevel = 0);
 
         /**
          * Open an existing data set.
@@ -743,6 +762,12 @@ public:
 		Open(_path, _mode, _comm, par);
 	}
 
+	/**
+	 * Flush the buffers of our file to storage.
+	 * Collective when the file is accessed with parallel I/O.
+	 */
+	void Flush(void) const;
+
 	/**
 	 * Close the file if open and destroy the in-memory object.
 	 */
@@ -1,7 +1,68 @@
+#include <algorithm>
+#include <sstream>
 #include "xolotlCore/io/HDF5File.h"
 
 namespace xolotlCore {
 
 const std::string HDF5File::RaggedDataSetBase::startIndicesDatasetNameSuffix = "_startingIndices";
 
+void
+HDF5File::DataSetBase::setCompression(const PropertyList& createProps,
+                                        const DataSpace& dspace,
+                                        int compressionLevel) {
+
+    // Filtered datasets can only be written in parallel since HDF5 1.10.2.
+#if defined(H5_HAVE_PARALLEL) && !H5_VERSION_GE(1, 10, 2)
+    throw HDF5Exception("Compressed datasets need HDF5 1.10.2 or later "
+                        "with parallel I/O");
+#endif
+
+    if((compressionLevel < 1) or (compressionLevel > 9)) {
+        std::ostringstream estr;
+        estr << "Invalid compression level " << compressionLevel
+            << ", it must be between 1 and 9";
+        throw HDF5Exception(estr.str());
+    }
+    if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+        throw HDF5Exception("The deflate filter is not available in this "
+                            "HDF5 library");
+    }
+
+    // Determine the shape of the dataset.
+    auto nDims = H5Sget_simple_extent_ndims(dspace.getId());
+    if(nDims < 1) {
+        return;
+    }
+    std::vector<hsize_t> dims(nDims);
+    H5Sget_simple_extent_dims(dspace.getId(), dims.data(), nullptr);
+    if(std::find(dims.begin(), dims.end(), 0) != dims.end()) {
+        return;
+    }
+
+    // Chunk along the first dimension, about 64k items per chunk.
+    const hsize_t chunkItems = 1 << 16;
+    std::vector<hsize_t> chunkDims(dims);
+    hsize_t rowItems = 1;
+    for(auto i = 1; i < nDims; ++i) {
+        rowItems *= dims[i];
+    }
+    chunkDims[0] = std::min(dims[0], std::max<hsize_t>(1, chunkItems / rowItems));
+
+    // Shuffling the bytes first helps deflate with numeric data.
+    auto status = H5Pset_chunk(createProps.getId(), nDims, chunkDims.data());
+    if(status >= 0) {
+        status = H5Pset_shuffle(createProps.getId());
+    }
+    if(status >= 0) {
+        status = H5Pset_deflate(createProps.getId(), compressionLevel);
+    }
+    if(status >= 0) {
+        // Every item is written, no need for fill values.
+        status = H5Pset_fill_time(createProps.getId(), H5D_FILL_TIME_NEVER);
+    }
+    if(status < 0) {
+        throw HDF5Exception("Failed to set up a compressed dataset layout");
+    }
+}
+
 } // namespace xolotlCore
@@ -11,15 +11,21 @@ namespace xolotlCore
 template<typename T>
 HDF5File::DataSetTBase<T>::DataSetTBase(const HDF5Object& loc,
                                     std::string dsetName,
-                                    const DataSpace& dspace)
+                                    const DataSpace& dspace,
+                                    int compressionLevel)
   : DataSetBase(loc, dsetName)
 {
+    PropertyList createProps(H5P_DATASET_CREATE);
+    if(compressionLevel > 0) {
+        setCompression(createProps, dspace, compressionLevel);
+    }
+
     setId(H5Dcreate(loc.getId(),
                         dsetName.c_str(),
                         TypeInFile<T>().getId(),
                         dspace.getId(),
                         H5P_DEFAULT,
-                        H5P_DEFAULT,
+                        createProps.getId(),
                         H5P_DEFAULT));
     if(getId() < 0)
     {
@@ -182,9 +188,11 @@ HDF5File::RaggedDataSet2D<T>::RaggedDataSet2D(MPI_Comm _comm,
                                     const HDF5Object& loc,
                                     std::string dsetName,
                                     int baseX,
-                                    const Ragged2DType& data)
+                                    const Ragged2DType& data,
+                                    int compressionLevel)
   : RaggedDataSetBase(_comm),
-    DataSetTBase<T>(loc, dsetName, *(buildDataSpace(_comm, data))) {
+    DataSetTBase<T>(loc, dsetName, *(buildDataSpace(_comm, data)),
+                    compressionLevel) {
 
     // We assume the gridpoint values are indices into the gridpoint array,
     // so non-negative and base 0.
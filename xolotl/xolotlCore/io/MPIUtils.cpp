@@ -2,6 +2,8 @@
 #include "MPIUtils.h"
 #include <fstream>
 #include <sstream>
+#include <limits>
+#include <algorithm>
 
 using namespace xolotlCore;
 using std::shared_ptr;
@@ -59,3 +61,22 @@ shared_ptr<std::istream> MPIUtils::broadcastStream(
 	
 	return bufferSS;
 }
+
+void MPIUtils::broadcastBuffer(std::vector<double>& buffer, int master) {
+	// Broadcast the size
+	unsigned long bufferSize = buffer.size();
+	MPI_Bcast(&bufferSize, 1, MPI_UNSIGNED_LONG, master, MPI_COMM_WORLD);
+
+	// Make room on the nodes
+	buffer.resize(bufferSize);
+
+	// Broadcast the buffer, the count of MPI_Bcast is an int
+	const unsigned long maxCount = std::numeric_limits<int>::max();
+	for (unsigned long offset = 0; offset < bufferSize; offset += maxCount) {
+		int count = std::min(maxCount, bufferSize - offset);
+		MPI_Bcast(buffer.data() + offset, count, MPI_DOUBLE, master,
+				MPI_COMM_WORLD);
+	}
+
+	return;
+}
@@ -4,6 +4,7 @@
 #include <mpi.h>
 #include <memory>
 #include <iostream>
+#include <vector>
 
 
 namespace xolotlCore {
@@ -23,6 +24,18 @@ namespace MPIUtils {
 	 */
 	std::shared_ptr<std::istream> broadcastStream(
 		std::shared_ptr<std::istream> stream, int root);
+
+	/**
+	 * Sends the input buffer from the master task to all the slaves
+	 *
+	 * This method blocks until it is called by all processes.
+	 * The buffer of worker tasks is resized and overwritten. The data is
+	 * sent in several pieces if it is too large for a single MPI_Bcast.
+	 *
+	 * @param buffer The buffer to broadcast
+	 * @param root The rank of the master process
+	 */
+	void broadcastBuffer(std::vector<double>& buffer, int root);
 }
 
 } /* namespace xolotlCore */
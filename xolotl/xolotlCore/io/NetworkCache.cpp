@@ -0,0 +1,161 @@
+#include "NetworkCache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xolotlCore {
+
+namespace {
+
+// The magic number at the start of every cache file ("XNETCACH").
+const std::uint64_t cacheMagic = 0x4843414354454E58ULL;
+
+// The number of 64-bit words in the header.
+const std::size_t headerSize = 4;
+
+/**
+ * Round a number of bytes up to a whole number of 64-bit words.
+ *
+ * @param nBytes The number of bytes
+ * @return The number of words
+ */
+std::size_t toWords(std::size_t nBytes) {
+	return (nBytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+}
+
+} // namespace
+
+NetworkCache::NetworkCache(const std::string& dirName,
+		const std::string& desc) :
+		description(desc), directory(dirName), mapping(nullptr), mappingSize(
+				0), data(nullptr), dataSize(0) {
+	// Name the file after the hash of the description
+	std::ostringstream name;
+	name << directory << "/network_" << std::hex << std::setw(16)
+			<< std::setfill('0') << hash(description) << ".bin";
+	fileName = name.str();
+}
+
+NetworkCache::~NetworkCache() {
+	unmap();
+}
+
+std::uint64_t NetworkCache::hash(const std::string& desc) {
+	std::uint64_t value = 0xcbf29ce484222325ULL;
+	for (unsigned char c : desc) {
+		value ^= c;
+		value *= 0x100000001b3ULL;
+	}
+
+	return value;
+}
+
+void NetworkCache::unmap() {
+	if (mapping) {
+		munmap(mapping, mappingSize);
+	}
+	mapping = nullptr;
+	mappingSize = 0;
+	data = nullptr;
+	dataSize = 0;
+
+	return;
+}
+
+bool NetworkCache::map() {
+	unmap();
+
+	// Open the file
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0
+			|| (std::size_t) fileStat.st_size
+					< headerSize * sizeof(std::uint64_t)) {
+		close(fd);
+		return false;
+	}
+
+	// Map it privately, the pages are shared with the other processes
+	// reading the same file as long as nobody writes to them
+	mappingSize = fileStat.st_size;
+	mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+			fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		mapping = nullptr;
+		mappingSize = 0;
+		return false;
+	}
+
+	// Check the header
+	auto words = static_cast<std::uint64_t*>(mapping);
+	std::size_t descWords = toWords(words[2]);
+	std::size_t nWords = mappingSize / sizeof(std::uint64_t);
+	if (words[0] != cacheMagic || words[1] != formatVersion
+			|| words[2] != description.size()
+			|| headerSize + descWords + words[3] != nWords
+			|| std::memcmp(words + headerSize, description.data(),
+					description.size()) != 0) {
+		unmap();
+		return false;
+	}
+
+	// The packed network follows the description
+	data = reinterpret_cast<double*>(words + headerSize + descWords);
+	dataSize = words[3];
+
+	return true;
+}
+
+bool NetworkCache::store(const std::vector<double>& buffer) const {
+	// Create the directory if needed
+	if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+		std::cout << "NetworkCache: could not create the directory "
+				<< directory << ", the network will not be cached."
+				<< std::endl;
+		return false;
+	}
+
+	// Write under a temporary name
+	std::ostringstream tempName;
+	tempName << fileName << ".tmp." << getpid();
+	{
+		std::ofstream file(tempName.str(), std::ios::binary);
+		std::uint64_t header[headerSize] = { cacheMagic, formatVersion,
+				description.size(), buffer.size() };
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		std::vector<char> desc(toWords(description.size())
+				* sizeof(std::uint64_t), '\0');
+		std::copy(description.begin(), description.end(), desc.begin());
+		file.write(desc.data(), desc.size());
+		file.write(reinterpret_cast<const char*>(buffer.data()),
+				buffer.size() * sizeof(double));
+		if (!file) {
+			std::cout << "NetworkCache: could not write " << tempName.str()
+					<< ", the network will not be cached." << std::endl;
+			std::remove(tempName.str().c_str());
+			return false;
+		}
+	}
+
+	// Then move it in place
+	if (std::rename(tempName.str().c_str(), fileName.c_str()) != 0) {
+		std::remove(tempName.str().c_str());
+		return false;
+	}
+
+	return true;
+}
+
+} /* namespace xolotlCore */
@@ -0,0 +1,138 @@
+#ifndef NETWORKCACHE_H
+#define NETWORKCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace xolotlCore {
+
+/**
+ * This class stores packed networks on disk so that the runs sharing the
+ * same network options can skip building it.
+ *
+ * Each network is kept in its own binary file, named after a hash of the
+ * description of the options that define it. The file starts with a header
+ * (magic number, format version, size of the description, size of the
+ * data) followed by the description itself, padded to a multiple of
+ * 8 bytes, and by the packed network. The packed network only contains
+ * indices and values so the file can be mapped anywhere in memory.
+ */
+class NetworkCache {
+private:
+
+	//! The version of the file format, bumped each time the layout changes.
+	static const std::uint64_t formatVersion = 1;
+
+	//! The description of the network options.
+	std::string description;
+
+	//! The name of the cache directory.
+	std::string directory;
+
+	//! The name of the file for this network.
+	std::string fileName;
+
+	//! The mapped file, null if it is not mapped.
+	void *mapping;
+
+	//! The size of the mapped file in bytes.
+	std::size_t mappingSize;
+
+	//! The packed network inside the mapping.
+	double *data;
+
+	//! The number of values in the packed network.
+	std::size_t dataSize;
+
+	/**
+	 * Unmap the file if it is mapped.
+	 */
+	void unmap();
+
+public:
+
+	NetworkCache() = delete;
+	NetworkCache(const NetworkCache& other) = delete;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param dirName The cache directory
+	 * @param desc The description of everything that defines the network
+	 */
+	NetworkCache(const std::string& dirName, const std::string& desc);
+
+	/**
+	 * The destructor unmaps the file.
+	 */
+	~NetworkCache();
+
+	/**
+	 * Compute the 64-bit FNV-1a hash of a description.
+	 *
+	 * @param desc The description
+	 * @return The hash
+	 */
+	static std::uint64_t hash(const std::string& desc);
+
+	/**
+	 * Get the name of the file where this network is cached.
+	 *
+	 * @return The file name
+	 */
+	const std::string& getFileName() const {
+		return fileName;
+	}
+
+	/**
+	 * Map the cached file in memory. Fails if the file doesn't exist or
+	 * if its version or description don't match.
+	 *
+	 * @return True if the network is in the cache
+	 */
+	bool map();
+
+	/**
+	 * Is the file currently mapped?
+	 *
+	 * @return True if it is mapped
+	 */
+	bool isMapped() const {
+		return data != nullptr;
+	}
+
+	/**
+	 * Get the packed network from the mapped file. The pages are private
+	 * and copy-on-write so the values can be handed to code that expects
+	 * non-const pointers.
+	 *
+	 * @return The pointer to the first value, null if not mapped
+	 */
+	double* getData() const {
+		return data;
+	}
+
+	/**
+	 * Get the number of values in the packed network.
+	 *
+	 * @return The size, 0 if not mapped
+	 */
+	std::size_t getSize() const {
+		return dataSize;
+	}
+
+	/**
+	 * Write the packed network in the cache. The file is first written
+	 * under a temporary name and then renamed so that concurrent runs never
+	 * map a partial file.
+	 *
+	 * @param buffer The packed network
+	 * @return True if the file was written
+	 */
+	bool store(const std::vector<double>& buffer) const;
+};
+
+} /* namespace xolotlCore */
+
+#endif
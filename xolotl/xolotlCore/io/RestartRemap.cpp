@@ -0,0 +1,236 @@
+#include "RestartRemap.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+
+namespace xolotlCore {
+
+namespace {
+
+/**
+ * Compute the bounds of the cells around the grid points, from the
+ * midpoints between neighbors. The first and last cells stop at their
+ * grid points.
+ *
+ * @param positions The positions of the grid points
+ * @return The bounds, one more than the grid points
+ */
+std::vector<double> getCellBounds(const std::vector<double>& positions) {
+	std::vector<double> bounds;
+	bounds.push_back(positions.front());
+	for (std::size_t i = 1; i < positions.size(); i++) {
+		bounds.push_back((positions[i - 1] + positions[i]) / 2.0);
+	}
+	bounds.push_back(positions.back());
+
+	return bounds;
+}
+
+/**
+ * Get the index of the grid point closest to a position.
+ *
+ * @param positions The sorted positions of the grid points
+ * @param x The position
+ * @return The index
+ */
+int findClosest(const std::vector<double>& positions, double x) {
+	auto it = std::lower_bound(positions.begin(), positions.end(), x);
+	if (it == positions.end())
+		return positions.size() - 1;
+	int index = it - positions.begin();
+	if (index > 0 && x - positions[index - 1] < positions[index] - x)
+		index--;
+
+	return index;
+}
+
+} // namespace
+
+RestartRemap::RestartRemap(const std::vector<double>& oldGrid,
+		const std::vector<double>& newGrid, const NetworkCompsType& oldComps,
+		const NetworkCompsType& newComps, int newDof, Method method) :
+		oldPositions(oldGrid), newPositions(newGrid), dof(newDof), sameGrid(
+				false), sameNetwork(oldComps == newComps) {
+	// An empty grid is a single point
+	if (oldPositions.empty())
+		oldPositions.push_back(0.0);
+	if (newPositions.empty())
+		newPositions.push_back(0.0);
+
+	// Compare the grids
+	if (oldPositions.size() == newPositions.size()) {
+		sameGrid = true;
+		for (std::size_t i = 0; i < oldPositions.size(); i++) {
+			if (std::fabs(oldPositions[i] - newPositions[i])
+					> 1.0e-6 * (1.0 + std::fabs(newPositions[i]))) {
+				sameGrid = false;
+				break;
+			}
+		}
+	}
+
+	// Compute the weights
+	weights.resize(newPositions.size());
+	if (sameGrid) {
+		for (std::size_t i = 0; i < newPositions.size(); i++) {
+			weights[i].emplace_back(i, 1.0);
+		}
+	} else if (method == Method::Linear) {
+		computeLinearWeights();
+	} else {
+		computeConservativeWeights();
+	}
+
+	// Match the clusters by composition
+	if (!sameNetwork) {
+		std::map<std::vector<int>, int> newIndices;
+		for (std::size_t i = 0; i < newComps.size(); i++) {
+			newIndices.emplace(newComps[i], i);
+		}
+		clusterMap.resize(oldComps.size(), -1);
+		for (std::size_t i = 0; i < oldComps.size(); i++) {
+			auto it = newIndices.find(oldComps[i]);
+			if (it != newIndices.end())
+				clusterMap[i] = it->second;
+		}
+	}
+}
+
+RestartRemap::Method RestartRemap::getMethod(const std::string& name) {
+	if (name == "conservative")
+		return Method::Conservative;
+	if (name == "linear")
+		return Method::Linear;
+
+	throw std::string(
+			"\nxolotlCore::RestartRemap: unknown remap method " + name
+					+ ", use conservative or linear.");
+}
+
+void RestartRemap::computeConservativeWeights() {
+	auto oldBounds = getCellBounds(oldPositions);
+	auto newBounds = getCellBounds(newPositions);
+
+	// Loop on the new grid points
+	for (std::size_t i = 0; i < newPositions.size(); i++) {
+		double left = newBounds[i], right = newBounds[i + 1];
+
+		// Loop on the old cells overlapping the new one
+		double total = 0.0;
+		for (std::size_t k = 0; k < oldPositions.size(); k++) {
+			double overlap = std::min(right, oldBounds[k + 1])
+					- std::max(left, oldBounds[k]);
+			if (overlap > 0.0) {
+				weights[i].emplace_back(k, overlap);
+				total += overlap;
+			}
+		}
+
+		// Normalize, the part of the new cell outside of the old grid
+		// doesn't count
+		if (total > 0.0) {
+			for (auto& weight : weights[i]) {
+				weight.second /= total;
+			}
+		} else {
+			// Empty cells and cells outside of the old grid
+			weights[i].clear();
+			weights[i].emplace_back(findClosest(oldPositions, newPositions[i]),
+					1.0);
+		}
+	}
+
+	return;
+}
+
+void RestartRemap::computeLinearWeights() {
+	// Loop on the new grid points
+	for (std::size_t i = 0; i < newPositions.size(); i++) {
+		double x = newPositions[i];
+
+		// Outside of the old grid
+		if (x <= oldPositions.front()) {
+			weights[i].emplace_back(0, 1.0);
+			continue;
+		}
+		if (x >= oldPositions.back()) {
+			weights[i].emplace_back(oldPositions.size() - 1, 1.0);
+			continue;
+		}
+
+		// Between two old grid points
+		int right = std::upper_bound(oldPositions.begin(), oldPositions.end(),
+				x) - oldPositions.begin();
+		int left = right - 1;
+		double t = (x - oldPositions[left])
+				/ (oldPositions[right] - oldPositions[left]);
+		weights[i].emplace_back(left, 1.0 - t);
+		if (t > 0.0)
+			weights[i].emplace_back(right, t);
+	}
+
+	return;
+}
+
+std::pair<int, int> RestartRemap::getSourceRange(int baseX, int numX) const {
+	if (numX <= 0)
+		return std::make_pair(0, 0);
+
+	int first = oldPositions.size(), last = -1;
+	for (int i = baseX; i < baseX + numX; i++) {
+		for (const auto& weight : weights[i]) {
+			first = std::min(first, weight.first);
+			last = std::max(last, weight.first);
+		}
+	}
+
+	return std::make_pair(first, last - first + 1);
+}
+
+int RestartRemap::getClosestPoint(int oldX) const {
+	return findClosest(newPositions, oldPositions[oldX]);
+}
+
+RestartRemap::Concs1DType RestartRemap::apply(const Concs1DType& oldConcs,
+		int oldBaseX, int baseX, int numX) const {
+	Concs1DType newConcs(numX);
+
+	// Loop on the new grid points
+	for (int i = 0; i < numX; i++) {
+		std::map<int, double> pointConcs;
+
+		// Loop on the old grid points contributing to it
+		for (const auto& weight : weights[baseX + i]) {
+			const auto& oldPointConcs = oldConcs[weight.first - oldBaseX];
+			for (std::size_t j = 0; j < oldPointConcs.size(); j++) {
+				int index = oldPointConcs[j].first;
+
+				// The temperature is always the last one
+				if (j == oldPointConcs.size() - 1)
+					index = dof - 1;
+				else if (!sameNetwork) {
+					// The moments can't be matched
+					if (index >= (int) clusterMap.size())
+						continue;
+					if (clusterMap[index] < 0) {
+						std::ostringstream error;
+						error << "\nxolotlCore::RestartRemap: the cluster "
+								<< index << " of the restart file "
+										"is not in the network.";
+						throw error.str();
+					}
+					index = clusterMap[index];
+				}
+
+				pointConcs[index] += weight.second * oldPointConcs[j].second;
+			}
+		}
+
+		newConcs[i].assign(pointConcs.begin(), pointConcs.end());
+	}
+
+	return newConcs;
+}
+
+} /* namespace xolotlCore */
@@ -0,0 +1,149 @@
+#ifndef RESTARTREMAP_H
+#define RESTARTREMAP_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "xolotlCore/io/XFile.h"
+
+namespace xolotlCore {
+
+/**
+ * This class moves the concentrations of a checkpoint onto the grid and
+ * the network of a new run, so that a run can restart from a checkpoint
+ * written with another grid in the depth direction or with a smaller
+ * network.
+ *
+ * The clusters are matched by composition: every cluster present in the
+ * checkpoint must exist in the new network. The higher moments of the
+ * super clusters can only be kept if the networks are identical, otherwise
+ * they are dropped. The temperature, which is the last degree of freedom,
+ * is always kept.
+ *
+ * Each new grid point is a weighted sum of old grid points. With the
+ * conservative method every grid point stands for the cell between the
+ * midpoints to its neighbors and the weights are the overlaps of the new
+ * cell with the old cells, which preserves the inventory when both grids
+ * cover the same depth. With the linear method the weights come from the
+ * linear interpolation between the two surrounding old grid points. New
+ * grid points beyond the old grid take the value of the closest old one.
+ */
+class RestartRemap {
+public:
+
+	//! The ways to move the concentrations from a grid to another.
+	enum class Method {
+		Conservative, Linear
+	};
+
+	//! The type of the concentrations.
+	using Concs1DType = XFile::TimestepGroup::Concs1DType;
+
+	//! The type of the network compositions.
+	using NetworkCompsType = XFile::HeaderGroup::NetworkCompsType;
+
+private:
+
+	//! The positions of the old grid points.
+	std::vector<double> oldPositions;
+
+	//! The positions of the new grid points.
+	std::vector<double> newPositions;
+
+	//! For each new grid point, the old grid points and their weights.
+	std::vector<std::vector<std::pair<int, double> > > weights;
+
+	//! For each old cluster, its index in the new network or -1.
+	std::vector<int> clusterMap;
+
+	//! The number of degrees of freedom of the new network.
+	int dof;
+
+	//! Are the grids the same?
+	bool sameGrid;
+
+	//! Are the networks the same?
+	bool sameNetwork;
+
+	/**
+	 * Compute the weights of the conservative remap.
+	 */
+	void computeConservativeWeights();
+
+	/**
+	 * Compute the weights of the linear interpolation.
+	 */
+	void computeLinearWeights();
+
+public:
+
+	RestartRemap() = delete;
+
+	/**
+	 * The constructor. The grids are the positions of the grid points
+	 * in the depth direction, an empty grid stands for a single point.
+	 *
+	 * @param oldGrid The grid of the checkpoint
+	 * @param newGrid The grid of the new run
+	 * @param oldComps The network compositions of the checkpoint
+	 * @param newComps The network compositions of the new run
+	 * @param newDof The number of degrees of freedom of the new run
+	 * @param method How to move the concentrations between the grids
+	 */
+	RestartRemap(const std::vector<double>& oldGrid,
+			const std::vector<double>& newGrid,
+			const NetworkCompsType& oldComps, const NetworkCompsType& newComps,
+			int newDof, Method method);
+
+	/**
+	 * Parse the name of a remap method.
+	 *
+	 * @param name "conservative" or "linear"
+	 * @return The method
+	 */
+	static Method getMethod(const std::string& name);
+
+	/**
+	 * Is the remap doing nothing?
+	 *
+	 * @return True if the grids and the networks are the same
+	 */
+	bool isIdentity() const {
+		return sameGrid && sameNetwork;
+	}
+
+	/**
+	 * Get the old grid points needed to build some new grid points.
+	 *
+	 * @param baseX The first new grid point
+	 * @param numX The number of new grid points
+	 * @return The first old grid point and the number of old grid points
+	 */
+	std::pair<int, int> getSourceRange(int baseX, int numX) const;
+
+	/**
+	 * Get the new grid point closest to an old one, for instance to move
+	 * the position of the surface.
+	 *
+	 * @param oldX The old grid point
+	 * @return The new grid point
+	 */
+	int getClosestPoint(int oldX) const;
+
+	/**
+	 * Build the concentrations of some new grid points.
+	 *
+	 * @param oldConcs The concentrations of the old grid points given by
+	 * getSourceRange
+	 * @param oldBaseX The first old grid point in oldConcs
+	 * @param baseX The first new grid point
+	 * @param numX The number of new grid points
+	 * @return The concentrations of the new grid points, ordered by index
+	 */
+	Concs1DType apply(const Concs1DType& oldConcs, int oldBaseX, int baseX,
+			int numX) const;
+};
+
+} /* namespace xolotlCore */
+
+#endif
@@ -1,11 +1,323 @@
 #include <iostream>
+#include <array>
 #include <string>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
 #include "boost/program_options.hpp"
 #include "xolotlCore/io/XFile.h"
 
 namespace bpo = boost::program_options;
 namespace xcore = xolotlCore;
 
+namespace {
+
+/**
+ * Parse a list of values like "0,4-7,12". "all" stands for every value
+ * in [0, maxValue] and "last" for maxValue.
+ *
+ * @param spec The list to parse
+ * @param maxValue The largest valid value
+ * @return The sorted values without duplicates
+ */
+std::vector<int> parseList(const std::string& spec, int maxValue) {
+	std::vector<int> ret;
+
+	std::istringstream specStream(spec);
+	std::string item;
+	while (std::getline(specStream, item, ',')) {
+		if (item.empty())
+			continue;
+
+		if (item == "all") {
+			for (int i = 0; i <= maxValue; ++i)
+				ret.push_back(i);
+			continue;
+		}
+		if (item == "last") {
+			ret.push_back(maxValue);
+			continue;
+		}
+
+		// A single value or a range
+		auto dash = item.find('-', 1);
+		int first = std::stoi(item.substr(0, dash));
+		int last = (dash == std::string::npos) ?
+				first : std::stoi(item.substr(dash + 1));
+		if (first < 0 || last > maxValue || first > last) {
+			throw std::runtime_error(
+					"Invalid item \"" + item + "\" in list \"" + spec + "\"");
+		}
+		for (int i = first; i <= last; ++i)
+			ret.push_back(i);
+	}
+
+	std::sort(ret.begin(), ret.end());
+	ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+
+	return ret;
+}
+
+/**
+ * Split a range of grid points between the processes, in rank order
+ * as expected by the ragged concentration datasets.
+ *
+ * @param begin The first grid point
+ * @param end One past the last grid point
+ * @param rank Our rank
+ * @param size The number of processes
+ * @return The first grid point we own and how many we own
+ */
+std::pair<int, int> findSlab(int begin, int end, int rank, int size) {
+	int nPoints = end - begin;
+	int first = begin + (nPoints * rank) / size;
+	int last = begin + (nPoints * (rank + 1)) / size;
+
+	return std::make_pair(first, last - first);
+}
+
+/**
+ * Read our slab of concentrations from a time step that only has one
+ * dataset per grid point, the layout used before the ragged datasets.
+ * Every process takes part in the collective read of each dataset of the
+ * range, selecting nothing from the ones it doesn't own.
+ *
+ * @param tsGroup The time step group
+ * @param begin The first grid point of all the processes
+ * @param end One past the last grid point of all the processes
+ * @param baseX The first grid point we own
+ * @param numX The number of grid points we own
+ * @return The concentrations
+ */
+xcore::XFile::TimestepGroup::Concs1DType readGridPoints(
+		const xcore::XFile::TimestepGroup& tsGroup, int begin, int end,
+		int baseX, int numX) {
+	xcore::XFile::TimestepGroup::Concs1DType concs(numX);
+
+	// Create property list for collective dataset read.
+	hid_t propertyListId = H5Pcreate(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(propertyListId, H5FD_MPIO_COLLECTIVE);
+
+	// Loop on all the grid points
+	for (auto i = begin; i < end; ++i) {
+		// Set the dataset name
+		std::ostringstream datasetName;
+		datasetName << "position_" << i << "_-1_-1";
+
+		// The same on every process
+		if (H5Lexists(tsGroup.getId(), datasetName.str().c_str(),
+		H5P_DEFAULT) <= 0)
+			continue;
+
+		// Open the dataset and get its dimensions
+		hid_t datasetId = H5Dopen(tsGroup.getId(), datasetName.str().c_str(),
+		H5P_DEFAULT);
+		hid_t fileSpaceId = H5Dget_space(datasetId);
+		std::array<hsize_t, 2> dims;
+		H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr);
+
+		// Only the owner of the grid point reads it
+		bool owned = (i >= baseX and i < baseX + numX);
+		std::array<hsize_t, 2> memDims { owned ? dims[0] : 0, dims[1] };
+		if (not owned)
+			H5Sselect_none(fileSpaceId);
+		hid_t memSpaceId = H5Screate_simple(2, memDims.data(), nullptr);
+		if (not owned)
+			H5Sselect_none(memSpaceId);
+
+		std::vector<double> conc(memDims[0] * memDims[1]);
+		auto status = H5Dread(datasetId, H5T_IEEE_F64LE, memSpaceId,
+				fileSpaceId, propertyListId, conc.data());
+		H5Sclose(memSpaceId);
+		H5Sclose(fileSpaceId);
+		H5Dclose(datasetId);
+		if (status < 0) {
+			throw std::runtime_error(
+					"Failed to read the " + datasetName.str() + " dataset");
+		}
+
+		// Our concentrations, as [id, concentration] rows
+		if (owned) {
+			auto& pointConcs = concs[i - baseX];
+			pointConcs.reserve(memDims[0]);
+			for (hsize_t n = 0; n < memDims[0]; ++n) {
+				pointConcs.emplace_back((int) conc[n * memDims[1]],
+						conc[n * memDims[1] + 1]);
+			}
+		}
+	}
+
+	H5Pclose(propertyListId);
+
+	return concs;
+}
+
+/**
+ * Convert the per grid point concentrations of the given time steps to
+ * the ragged representation, in place. The time steps that already have
+ * it are skipped.
+ *
+ * @param xfile The file, open for writing
+ * @param timeSteps The time steps to convert
+ * @param nPoints The number of grid points
+ * @param compressionLevel The deflate level for the new datasets
+ */
+void convert(const xcore::XFile& xfile, const std::vector<int>& timeSteps,
+		int nPoints, int compressionLevel) {
+	int cwRank, cwSize;
+	MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+
+	auto concGroup = xfile.getGroup<xcore::XFile::ConcentrationGroup>();
+	assert(concGroup);
+	auto slab = findSlab(0, nPoints, cwRank, cwSize);
+
+	// Loop on the time steps
+	for (auto timeStep : timeSteps) {
+		auto tsGroup = concGroup->getTimestepGroup(timeStep);
+		if (not tsGroup or tsGroup->hasConcentrations())
+			continue;
+
+		if (cwRank == 0)
+			std::cout << "Converting time step " << timeStep << std::endl;
+
+		// Read our grid points and write them all together
+		auto concs = readGridPoints(*tsGroup, 0, nPoints, slab.first,
+				slab.second);
+		tsGroup->writeConcentrations(xfile, slab.first, concs,
+				compressionLevel);
+	}
+
+	return;
+}
+
+/**
+ * Copy the concentrations of the given time steps, species and grid
+ * points into a new file. Each time step is read and written on its own
+ * and each process only holds its own slab of grid points, so the memory
+ * needed doesn't depend on the size of the input file.
+ *
+ * @param xfile The input file
+ * @param outName The name of the new file
+ * @param timeSteps The time steps to copy
+ * @param species The ids of the clusters to keep, empty to keep them all
+ * @param xBegin The first grid point to copy
+ * @param xEnd One past the last grid point to copy
+ * @param compressionLevel The deflate level for the new datasets
+ */
+void extract(const xcore::XFile& xfile, const std::string& outName,
+		const std::vector<int>& timeSteps, const std::vector<int>& species,
+		int xBegin, int xEnd, int compressionLevel) {
+	int cwRank, cwSize;
+	MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+
+	// The grid of the input file, with the ghost points around it
+	auto headerGroup = xfile.getGroup<xcore::XFile::HeaderGroup>();
+	assert(headerGroup);
+	int nx, ny, nz;
+	double hx, hy, hz;
+	headerGroup->read(nx, hx, ny, hy, nz, hz);
+	std::vector<double> grid;
+	if (nx > 0) {
+		auto pointGrid = headerGroup->readGrid();
+		std::vector<double> fullGrid { -hx };
+		fullGrid.insert(fullGrid.end(), pointGrid.begin(), pointGrid.end());
+		double lastStep =
+				(nx > 1) ? pointGrid[nx - 1] - pointGrid[nx - 2] : hx;
+		fullGrid.push_back(pointGrid[nx - 1] + lastStep);
+
+		// Its [xBegin, xEnd + 1] slice, starting at 0
+		for (int i = xBegin; i <= xEnd + 1; ++i)
+			grid.push_back(fullGrid[i] - fullGrid[xBegin]);
+	}
+
+	// Create the new file with a header describing the extracted grid.
+	// It is closed before the network is copied with a single-process
+	// communicator.
+	{
+		xcore::XFile outFile(outName, grid, headerGroup->readNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Copy the network group, if the input file has one. A single process
+	// does it because H5Ocopy is much slower when all the processes call it.
+	if (cwRank == 0) {
+		auto netGroup = xfile.getGroup<xcore::XFile::NetworkGroup>();
+		if (netGroup) {
+			xcore::XFile outFile(outName, MPI_COMM_SELF,
+					xcore::XFile::AccessMode::OpenReadWrite);
+			netGroup->copyTo(outFile);
+		}
+	}
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	// Reopen the new file on every process
+	xcore::XFile outFile(outName, MPI_COMM_WORLD,
+			xcore::XFile::AccessMode::OpenReadWrite);
+
+	// Save where the extracted grid starts
+	{
+		xcore::XFile::HeaderGroup outHeaderGroup(outFile);
+		xcore::XFile::ScalarDataSpace scalarDSpace;
+		xcore::HDF5File::Attribute<int> offsetAttr(outHeaderGroup, "xOffset",
+				scalarDSpace);
+		offsetAttr.setTo(xBegin);
+	}
+
+	auto concGroup = xfile.getGroup<xcore::XFile::ConcentrationGroup>();
+	assert(concGroup);
+	auto outConcGroup = outFile.getGroup<xcore::XFile::ConcentrationGroup>();
+	assert(outConcGroup);
+	auto slab = findSlab(xBegin, xEnd, cwRank, cwSize);
+
+	// Loop on the time steps
+	for (auto timeStep : timeSteps) {
+		auto tsGroup = concGroup->getTimestepGroup(timeStep);
+		if (not tsGroup)
+			continue;
+
+		if (cwRank == 0)
+			std::cout << "Extracting time step " << timeStep << std::endl;
+
+		// Read our slab
+		xcore::XFile::TimestepGroup::Concs1DType concs;
+		if (tsGroup->hasConcentrations())
+			concs = tsGroup->readConcentrations(xfile, slab.first,
+					slab.second);
+		else
+			concs = readGridPoints(*tsGroup, xBegin, xEnd, slab.first,
+					slab.second);
+
+		// Only keep the requested species
+		if (not species.empty()) {
+			for (auto& pointConcs : concs) {
+				pointConcs.erase(
+						std::remove_if(pointConcs.begin(), pointConcs.end(),
+								[&species](
+										const xcore::XFile::TimestepGroup::ConcType& conc) {
+									return not std::binary_search(
+											species.begin(), species.end(),
+											conc.first);
+								}), pointConcs.end());
+			}
+		}
+
+		// Write them in the new file
+		auto times = tsGroup->readTimes();
+		auto outTsGroup = outConcGroup->addTimestepGroup(timeStep, times.first,
+				tsGroup->readPreviousTime(), times.second);
+		outTsGroup->writeConcentrations(outFile, slab.first - xBegin, concs,
+				compressionLevel);
+	}
+
+	return;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
 
 	int ret = 0;
@@ -20,25 +332,33 @@ int main(int argc, char* argv[]) {
 		MPI_Comm_rank(MPI_COMM_WORLD, &cwRank);
 		MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
 
-		// We have to be an MPI program,
-		// but for now we only support a single process.
-		if (cwSize > 1) {
-			throw std::runtime_error(
-					"Multiple MPI processes not yet supported.  Run with 1 proc.");
-		}
-
 		// Parse the command line options.
 		bool shouldRun = true;
 		bpo::options_description desc("Supported options");
 		desc.add_options()("help", "show this help message")("infile",
-				bpo::value<std::string>(), "input file name");
+				bpo::value<std::string>(), "input file name")("mode",
+				bpo::value<std::string>()->default_value("convert"),
+				"convert: write the per grid point concentrations of the "
+						"input file in the ragged representation, in place; "
+						"extract: copy a part of the input file into outfile")(
+				"outfile", bpo::value<std::string>(),
+				"output file name for the extract mode")("timesteps",
+				bpo::value<std::string>()->default_value("last"),
+				"time steps to process, like \"0,10-20,last\" or \"all\"")(
+				"species", bpo::value<std::string>()->default_value("all"),
+				"cluster ids to extract, like \"0-5,12\" or \"all\"")(
+				"xrange", bpo::value<std::string>(),
+				"grid points to extract, like \"10-50\" (default: all)")(
+				"compression", bpo::value<int>()->default_value(0),
+				"deflate level for the written concentrations, 0 for none");
 
 		bpo::variables_map opts;
 		bpo::store(bpo::parse_command_line(argc, argv, desc), opts);
 		bpo::notify(opts);
 
 		if (opts.count("help")) {
-			std::cout << desc << '\n';
+			if (cwRank == 0)
+				std::cout << desc << '\n';
 			shouldRun = false;
 		}
 
@@ -49,58 +369,85 @@ int main(int argc, char* argv[]) {
 			ret = 1;
 		}
 
+		auto mode = opts["mode"].as<std::string>();
+		if (mode != "convert" and mode != "extract") {
+			std::cerr << "unknown mode " << mode << std::endl;
+			shouldRun = false;
+			ret = 1;
+		}
+		if (mode == "extract"
+				and ((opts.count("outfile") == 0)
+						or opts["outfile"].as<std::string>().empty())) {
+			std::cerr << "output file name must not be empty in extract mode"
+					<< std::endl;
+			shouldRun = false;
+			ret = 1;
+		}
+
 		if (shouldRun) {
 
 			std::string fname = opts["infile"].as<std::string>();
 
-			// Open the file.
+			// Open the file, every process accesses it collectively.
 			xcore::XFile xfile(fname,
-			MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+			MPI_COMM_WORLD,
+					(mode == "convert") ?
+							xolotlCore::XFile::AccessMode::OpenReadWrite :
+							xolotlCore::XFile::AccessMode::OpenReadOnly);
 
 			// Determine the number of grid points.
 			auto headerGroup = xfile.getGroup<xcore::XFile::HeaderGroup>();
 			assert(headerGroup);
-			xcore::HDF5File::Attribute<int> nxAttr(*headerGroup, "nx");
-			auto nx = nxAttr.get();
+			int nx, ny, nz;
+			double hx, hy, hz;
+			headerGroup->read(nx, hx, ny, hy, nz, hz);
+			if (ny > 0 or nz > 0) {
+				throw std::runtime_error(
+						"Only 0D and 1D files are supported.");
+			}
+			// 0D files have a single grid point
+			auto nPoints = std::max(nx, 1);
 
 			// Determine the last timestep written to the file.
 			auto concGroup = xfile.getGroup<xcore::XFile::ConcentrationGroup>();
 			assert(concGroup);
-			xcore::HDF5File::Attribute<int> lastTimestepAttr(*concGroup,
-					"lastTimeStep");
-			auto lastTimeStep = lastTimestepAttr.get();
-
-			std::cout << "nx: " << nx << '\n' << "last time step: "
-					<< lastTimeStep << std::endl;
-
-			// Open the timestep group associated with the
-			// last written timestep.
-			auto tsGroup = concGroup->getLastTimestepGroup();
-			assert(tsGroup);
-
-			// Convert the last written timestep's concentrations to
-			// the new representation.
-			xcore::XFile::TimestepGroup::Concs1DType allConcs(nx);
-			for (auto x = 0; x < nx; ++x) {
-				// Read the concentrations for the current position.
-				std::ostringstream dsNameStr;
-				dsNameStr << "position_" << x << "-1_-1";
-				std::string dsName = dsNameStr.str();
-				std::cout << "Reading conc data for gridpoint " << x
-						<< " from dataset " << dsName << std::endl;
-				auto oldData = tsGroup->readGridPoint(x);
-				auto nConcs = oldData.size();
-
-				// Store into our ragged 2D representation.
-				for (auto i = 0; i < nConcs; ++i) {
-					auto l = oldData[i][0];
-					auto conc = oldData[i][1];
-					allConcs[x].emplace_back(l, conc);
-				}
+			auto lastTimeStep = concGroup->getLastTimeStep();
+
+			if (cwRank == 0) {
+				std::cout << "nx: " << nx << '\n' << "last time step: "
+						<< lastTimeStep << std::endl;
 			}
 
-			// Write the dataset to the file.
-			tsGroup->writeConcentrations(xfile, 0, allConcs);
+			// Select the time steps.
+			auto timeSteps = parseList(opts["timesteps"].as<std::string>(),
+					lastTimeStep);
+			auto compressionLevel = opts["compression"].as<int>();
+
+			if (mode == "convert") {
+				convert(xfile, timeSteps, nPoints, compressionLevel);
+			} else {
+				// Select the species, all of them by default
+				std::vector<int> species;
+				auto speciesSpec = opts["species"].as<std::string>();
+				if (speciesSpec != "all") {
+					species = parseList(speciesSpec,
+							headerGroup->readNetworkComps().size() - 1);
+				}
+
+				// Select the grid points
+				int xBegin = 0, xEnd = nPoints;
+				if (opts.count("xrange")) {
+					auto points = parseList(opts["xrange"].as<std::string>(),
+							nPoints - 1);
+					if (not points.empty()) {
+						xBegin = points.front();
+						xEnd = points.back() + 1;
+					}
+				}
+
+				extract(xfile, opts["outfile"].as<std::string>(), timeSteps,
+						species, xBegin, xEnd, compressionLevel);
+			}
 		}
 	} catch (std::exception& e) {
 		std::cerr << e.what() << std::endl;
@@ -115,4 +462,3 @@ int main(int argc, char* argv[]) {
 
 	return ret;
 }
-
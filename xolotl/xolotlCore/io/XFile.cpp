@@ -2,6 +2,7 @@
 #include <sstream>
 #include <iterator>
 #include <array>
+#include <cstring>
 #include "hdf5.h"
 #include "mpi.h"
 #include "xolotlCore/io/XFile.h"
@@ -9,6 +10,7 @@
 #include <FeSuperCluster.h>
 #include <NESuperCluster.h>
 #include <AlloySuperCluster.h>
+#include <ReactionLoader.h>
 
 namespace xolotlCore {
 
@@ -58,6 +60,7 @@ XFile::XFile(fs::path _path, MPI_Comm _comm, AccessMode _mode) :
 //
 const fs::path XFile::HeaderGroup::path = "/headerGroup";
 const std::string XFile::HeaderGroup::netCompsDatasetName = "composition";
+const std::string XFile::HeaderGroup::gridDatasetName = "grid";
 const std::string XFile::HeaderGroup::nxAttrName = "nx";
 const std::string XFile::HeaderGroup::hxAttrName = "hx";
 const std::string XFile::HeaderGroup::nyAttrName = "ny";
@@ -109,8 +112,9 @@ XFile::HeaderGroup::HeaderGroup(const XFile& file,
 		}
 		std::array<hsize_t, 1> dims { (hsize_t) nx };
 		XFile::SimpleDataSpace<1> gridDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), "grid", H5T_IEEE_F64LE,
-				gridDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		hid_t datasetId = H5Dcreate2(getId(), gridDatasetName.c_str(),
+		H5T_IEEE_F64LE, gridDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
+		H5P_DEFAULT);
 		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 		H5P_DEFAULT, &gridArray);
 		status = H5Dclose(datasetId);
@@ -183,6 +187,35 @@ void XFile::HeaderGroup::read(int &nx, double &hx, int &ny, double &hy, int &nz,
 	hz = hzAttr.get();
 }
 
+std::vector<double> XFile::HeaderGroup::readGrid(void) const {
+
+	// There is no grid dataset without grid points in x
+	std::vector<double> grid;
+	Attribute<int> nxAttr(*this, nxAttrName);
+	int nx = nxAttr.get();
+	if (nx <= 0)
+		return grid;
+
+	// Open and read the dataset
+	grid.resize(nx);
+	hid_t datasetId = H5Dopen(getId(), gridDatasetName.c_str(), H5P_DEFAULT);
+	if (datasetId < 0) {
+		std::ostringstream estr;
+		estr << "Failed to open the " << gridDatasetName << " dataset";
+		throw HDF5Exception(estr.str());
+	}
+	auto status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+	H5P_DEFAULT, grid.data());
+	H5Dclose(datasetId);
+	if (status < 0) {
+		std::ostringstream estr;
+		estr << "Failed to read the " << gridDatasetName << " dataset";
+		throw HDF5Exception(estr.str());
+	}
+
+	return grid;
+}
+
 XFile::HeaderGroup::NetworkCompsType XFile::HeaderGroup::readNetworkComps(
 		void) const {
 
@@ -216,6 +249,116 @@ XFile::HeaderGroup::NetworkCompsType XFile::HeaderGroup::readNetworkComps(
 	return networkComps;
 }
 
+//----------------------------------------------------------------------------
+// Helpers for the network layouts
+//
+namespace {
+
+/**
+ * Write a whole column of the network group in a dataset.
+ *
+ * @param groupId The group where to write.
+ * @param name The name of the dataset.
+ * @param type The HDF5 type of the data.
+ * @param data The data, row major.
+ * @param width The number of values in each row.
+ */
+template<typename T>
+void writeColumn(hid_t groupId, const std::string& name, hid_t type,
+		const std::vector<T>& data, hsize_t width = 1) {
+	// Create the dataspace, with a second dimension only for rows
+	std::array<hsize_t, 2> dims { (hsize_t) data.size() / width, width };
+	hid_t dataspaceId = H5Screate_simple((width > 1) ? 2 : 1, dims.data(),
+	NULL);
+	hid_t datasetId = H5Dcreate2(groupId, name.c_str(), type, dataspaceId,
+	H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Failed to create dataset " + name);
+	}
+	// Write in the dataset
+	if (data.size() > 0) {
+		auto status = H5Dwrite(datasetId, type, H5S_ALL, H5S_ALL,
+		H5P_DEFAULT, data.data());
+	}
+	// Close everything
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+
+	return;
+}
+
+/**
+ * Read a whole column of the network group with a single read.
+ *
+ * @param groupId The group where to read.
+ * @param name The name of the dataset.
+ * @param type The HDF5 type of the data.
+ * @return The data, row major.
+ */
+template<typename T>
+std::vector<T> readColumn(hid_t groupId, const std::string& name,
+		hid_t type) {
+	hid_t datasetId = H5Dopen(groupId, name.c_str(), H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Failed to open dataset " + name);
+	}
+	// Get the size of the dataset
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	std::vector<T> data(H5Sget_simple_extent_npoints(dataspaceId));
+	// Read the data set
+	if (data.size() > 0) {
+		auto status = H5Dread(datasetId, type, H5S_ALL, H5S_ALL,
+		H5P_DEFAULT, data.data());
+	}
+	// Close everything
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+
+	return data;
+}
+
+/**
+ * Get the clusters of the network ordered by id.
+ *
+ * @param network The network.
+ * @return The clusters, the one with id i at index i - 1.
+ */
+std::vector<IReactant*> getClustersById(IReactionNetwork& network) {
+	auto& allReactants = network.getAll();
+	std::vector<IReactant*> clusters(allReactants.size(), nullptr);
+	for (IReactant& currReactant : allReactants) {
+		clusters.at(currReactant.getId() - 1) = &currReactant;
+	}
+
+	return clusters;
+}
+
+/**
+ * Get the bits of a concentration, to compute deltas.
+ *
+ * @param value The concentration
+ * @return Its bits
+ */
+uint64_t toBits(double value) {
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/**
+ * Get the concentration from its bits.
+ *
+ * @param bits The bits
+ * @return The concentration
+ */
+double fromBits(uint64_t bits) {
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+} // namespace
+
 //----------------------------------------------------------------------------
 // NetworkGroup
 //
@@ -223,15 +366,43 @@ const fs::path XFile::NetworkGroup::path = "/networkGroup";
 const std::string XFile::NetworkGroup::normalSizeAttrName = "normalSize";
 const std::string XFile::NetworkGroup::superSizeAttrName = "superSize";
 const std::string XFile::NetworkGroup::phaseSpaceAttrName = "phaseSpace";
+const std::string XFile::NetworkGroup::layoutVersionAttrName = "layoutVersion";
+const std::string XFile::NetworkGroup::compositionDataName = "composition";
+const std::string XFile::NetworkGroup::formationEnergyDataName =
+		"formationEnergy";
+const std::string XFile::NetworkGroup::migrationEnergyDataName =
+		"migrationEnergy";
+const std::string XFile::NetworkGroup::diffusionFactorDataName =
+		"diffusionFactor";
+const std::string XFile::NetworkGroup::superOffsetDataName = "superOffset";
+const std::string XFile::NetworkGroup::heVListDataName = "heVList";
+const std::array<std::string, 4> XFile::NetworkGroup::reactionDataNames { {
+		"prod", "comb", "disso", "emit" } };
+const std::string XFile::NetworkGroup::legacyDataName = "network";
+const int XFile::NetworkGroup::legacyLayout;
+const int XFile::NetworkGroup::groupLayout;
+const int XFile::NetworkGroup::columnarLayout;
 
 XFile::NetworkGroup::NetworkGroup(const XFile& file) :
-		HDF5File::Group(file, NetworkGroup::path, false) {
-
-	// Base class opened the group, so nothing else to do.
+		HDF5File::Group(file, NetworkGroup::path, false), layoutVersion(
+				groupLayout), compSize(0) {
+	// Base class opened the group.
+
+	// Files written before the columnar layout have no version
+	if (H5Aexists(getId(), layoutVersionAttrName.c_str()) > 0) {
+		Attribute<int> layoutVersionAttr(*this, layoutVersionAttrName);
+		layoutVersion = layoutVersionAttr.get();
+	}
+	// The oldest files have neither the sizes nor the cluster groups
+	else if (H5Aexists(getId(), normalSizeAttrName.c_str()) <= 0
+			&& H5Lexists(getId(), legacyDataName.c_str(), H5P_DEFAULT) > 0) {
+		layoutVersion = legacyLayout;
+	}
 }
 
 XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network) :
-		HDF5File::Group(file, NetworkGroup::path, true) {
+		HDF5File::Group(file, NetworkGroup::path, true), layoutVersion(
+				columnarLayout), compSize(0) {
 	// Base class created the group.
 
 	// Get the sizes information
@@ -260,8 +431,34 @@ XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network)
 	auto status = H5Awrite(attrId, H5T_STD_I32LE, &list);
 	status = H5Aclose(attrId);
 
-	// Loop on all the clusters
+	// The columns only know about PSI super clusters, and need the
+	// normal clusters to come first
 	auto& allReactants = network.getAll();
+	for (IReactant& currReactant : allReactants) {
+		auto type = currReactant.getType();
+		if (type == ReactantType::FeSuper || type == ReactantType::NESuper
+				|| type == ReactantType::VoidSuper
+				|| type == ReactantType::FrankSuper
+				|| type == ReactantType::PerfectSuper
+				|| type == ReactantType::FaultedSuper
+				|| (type == ReactantType::PSISuper)
+						!= (currReactant.getId() > normalSize)) {
+			layoutVersion = groupLayout;
+			break;
+		}
+	}
+
+	// Add the layout version attribute
+	Attribute<decltype(layoutVersion)> layoutVersionAttr(*this,
+			layoutVersionAttrName, scalarDSpace);
+	layoutVersionAttr.setTo(layoutVersion);
+
+	if (layoutVersion == columnarLayout) {
+		writeColumns(network);
+		return;
+	}
+
+	// Loop on all the clusters
 	std::for_each(allReactants.begin(), allReactants.end(),
 			[this](IReactant& currReactant) {
 				// Create and initialize the cluster group
@@ -270,8 +467,154 @@ XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network)
 			});
 }
 
+void XFile::NetworkGroup::writeColumns(IReactionNetwork& network) {
+	// Get the sizes information
+	int totalSize = network.size(), superSize = network.getSuperSize(),
+			normalSize = totalSize - superSize;
+	auto clusters = getClustersById(network);
+
+	// Gather the properties of the normal clusters
+	compSize = (normalSize > 0) ? clusters[0]->getComposition().size() : 0;
+	for (int i = 0; i < normalSize; i++) {
+		auto& comp = clusters[i]->getComposition();
+		for (int j = 0; j < compSize; j++) {
+			compositions.push_back(comp[j]);
+		}
+		formationEnergies.push_back(clusters[i]->getFormationEnergy());
+		migrationEnergies.push_back(clusters[i]->getMigrationEnergy());
+		diffusionFactors.push_back(clusters[i]->getDiffusionFactor());
+	}
+
+	// Gather the coordinates of the clusters in each super cluster
+	superOffsets.push_back(0);
+	for (int i = normalSize; i < totalSize; i++) {
+		auto& currCluster = static_cast<PSISuperCluster&>(*clusters[i]);
+		for (auto const& pair : currCluster.getCoordList()) {
+			heVList.push_back(std::get<0>(pair));
+			heVList.push_back(std::get<1>(pair));
+			heVList.push_back(std::get<2>(pair));
+			heVList.push_back(std::get<3>(pair));
+		}
+		superOffsets.push_back(heVList.size() / 4);
+	}
+
+	// Write the cluster columns
+	writeColumn(getId(), compositionDataName, H5T_STD_I32LE, compositions,
+			std::max(compSize, 1));
+	writeColumn(getId(), formationEnergyDataName, H5T_IEEE_F64LE,
+			formationEnergies);
+	writeColumn(getId(), migrationEnergyDataName, H5T_IEEE_F64LE,
+			migrationEnergies);
+	writeColumn(getId(), diffusionFactorDataName, H5T_IEEE_F64LE,
+			diffusionFactors);
+	writeColumn(getId(), superOffsetDataName, H5T_STD_I32LE, superOffsets);
+	writeColumn(getId(), heVListDataName, H5T_STD_I32LE, heVList, 4);
+
+	// Build one CSR table per type of reaction: the values of all the rows
+	// of all the clusters, the offset of each cluster in the values,
+	// and the row width of each cluster
+	std::array<std::vector<int64_t>, 4> offsets;
+	std::array<std::vector<int>, 4> widths;
+	std::array<std::vector<double>, 4> values;
+	for (int k = 0; k < reactionDataNames.size(); k++) {
+		offsets[k].push_back(0);
+	}
+	// Loop on the clusters
+	for (int i = 0; i < totalSize; i++) {
+		std::array<std::vector<std::vector<double> >, 4> rows { {
+				clusters[i]->getProdVector(), clusters[i]->getCombVector(),
+				clusters[i]->getDissoVector(), clusters[i]->getEmitVector() } };
+		// Loop on the types of reactions
+		for (int k = 0; k < reactionDataNames.size(); k++) {
+			widths[k].push_back((rows[k].size() > 0) ? rows[k][0].size() : 0);
+			for (auto const& row : rows[k]) {
+				values[k].insert(values[k].end(), row.begin(), row.end());
+			}
+			offsets[k].push_back(values[k].size());
+		}
+	}
+
+	// Write the reaction tables
+	for (int k = 0; k < reactionDataNames.size(); k++) {
+		writeColumn(getId(), reactionDataNames[k] + "Offset", H5T_STD_I64LE,
+				offsets[k]);
+		writeColumn(getId(), reactionDataNames[k] + "Width", H5T_STD_I32LE,
+				widths[k]);
+		writeColumn(getId(), reactionDataNames[k] + "Value", H5T_IEEE_F64LE,
+				values[k]);
+	}
+
+	return;
+}
+
+void XFile::NetworkGroup::readColumns() const {
+	// Nothing to do if they were already read
+	if (!superOffsets.empty())
+		return;
+
+	if (layoutVersion == legacyLayout) {
+		readLegacyColumns();
+		return;
+	}
+
+	compositions = readColumn<int>(getId(), compositionDataName,
+	H5T_STD_I32LE);
+	formationEnergies = readColumn<double>(getId(), formationEnergyDataName,
+	H5T_IEEE_F64LE);
+	migrationEnergies = readColumn<double>(getId(), migrationEnergyDataName,
+	H5T_IEEE_F64LE);
+	diffusionFactors = readColumn<double>(getId(), diffusionFactorDataName,
+	H5T_IEEE_F64LE);
+	superOffsets = readColumn<int>(getId(), superOffsetDataName,
+	H5T_STD_I32LE);
+	heVList = readColumn<int>(getId(), heVListDataName, H5T_STD_I32LE);
+
+	// Deduce the size of a composition
+	compSize =
+			(formationEnergies.size() > 0) ?
+					compositions.size() / formationEnergies.size() : 0;
+
+	return;
+}
+
+void XFile::NetworkGroup::readLegacyColumns() const {
+	// Read the whole dataset
+	auto rows = readColumn<double>(getId(), legacyDataName, H5T_IEEE_F64LE);
+	const int rowSize = 6;
+	int nClusters = rows.size() / rowSize;
+
+	// Dispatch the values in the columns
+	compSize = NumSpecies;
+	compositions.assign(nClusters * compSize, 0);
+	for (int i = 0; i < nClusters; i++) {
+		const double* row = &(rows[i * rowSize]);
+		compositions[i * compSize + toCompIdx(Species::He)] = (int) row[0];
+		compositions[i * compSize + toCompIdx(Species::V)] = (int) row[1];
+		compositions[i * compSize + toCompIdx(Species::I)] = (int) row[2];
+		formationEnergies.push_back(row[3]);
+		migrationEnergies.push_back(row[4]);
+		diffusionFactors.push_back(row[5]);
+	}
+
+	// There is no super cluster
+	superOffsets.assign(1, 0);
+	heVList.clear();
+
+	return;
+}
+
 Array<int, 5> XFile::NetworkGroup::readNetworkSize(int &normalSize,
 		int &superSize) const {
+	// Deduce the sizes from the dataset, the network is not grouped
+	if (layoutVersion == legacyLayout) {
+		readColumns();
+		normalSize = formationEnergies.size();
+		superSize = 0;
+		Array<int, 5> list;
+		list.Init(0);
+		return list;
+	}
+
 	// Open and read the normal size attribute
 	Attribute<int> normalSizeAttr(*this, normalSizeAttrName);
 	normalSize = normalSizeAttr.get();
@@ -290,7 +633,83 @@ Array<int, 5> XFile::NetworkGroup::readNetworkSize(int &normalSize,
 	return list;
 }
 
+std::vector<int> XFile::NetworkGroup::readCluster(int id,
+		double &formationEnergy, double &migrationEnergy,
+		double &diffusionFactor) const {
+	// Old layout
+	if (layoutVersion == groupLayout) {
+		ClusterGroup clusterGroup(*this, id);
+		return clusterGroup.readCluster(formationEnergy, migrationEnergy,
+				diffusionFactor);
+	}
+
+	// Get the values from the columns
+	readColumns();
+	formationEnergy = formationEnergies.at(id);
+	migrationEnergy = migrationEnergies.at(id);
+	diffusionFactor = diffusionFactors.at(id);
+
+	return std::vector<int>(compositions.begin() + id * compSize,
+			compositions.begin() + (id + 1) * compSize);
+}
+
+std::set<std::tuple<int, int, int, int> > XFile::NetworkGroup::readPSISuperCluster(
+		int id) const {
+	// Old layout
+	if (layoutVersion == groupLayout) {
+		ClusterGroup clusterGroup(*this, id);
+		return clusterGroup.readPSISuperCluster();
+	}
+
+	// Get the coordinates from the columns, super clusters come after
+	// the normal ones
+	readColumns();
+	int superId = id - formationEnergies.size();
+	std::set<std::tuple<int, int, int, int> > list;
+	for (int i = superOffsets.at(superId); i < superOffsets.at(superId + 1);
+			i++) {
+		list.emplace(heVList[4 * i], heVList[4 * i + 1], heVList[4 * i + 2],
+				heVList[4 * i + 3]);
+	}
+
+	return list;
+}
+
 void XFile::NetworkGroup::readReactions(IReactionNetwork& network) const {
+	if (layoutVersion == columnarLayout) {
+		// Read each reaction table at once
+		std::array<std::vector<int64_t>, 4> offsets;
+		std::array<std::vector<int>, 4> widths;
+		std::array<std::vector<double>, 4> values;
+		for (int k = 0; k < reactionDataNames.size(); k++) {
+			offsets[k] = readColumn<int64_t>(getId(),
+					reactionDataNames[k] + "Offset", H5T_STD_I64LE);
+			widths[k] = readColumn<int>(getId(),
+					reactionDataNames[k] + "Width", H5T_STD_I32LE);
+			values[k] = readColumn<double>(getId(),
+					reactionDataNames[k] + "Value", H5T_IEEE_F64LE);
+		}
+
+		// Loop on the clusters, keeping the same order as the old layout
+		auto clusters = getClustersById(network);
+		for (int i = 0; i < clusters.size(); i++) {
+			// Loop on the types of reactions
+			for (int k = 0; k < reactionDataNames.size(); k++) {
+				// Loop on the rows of this cluster
+				for (auto j = offsets[k].at(i); j < offsets[k].at(i + 1); j +=
+						widths[k][i]) {
+					reactionAdders[k](network, *clusters[i], &(values[k][j]));
+				}
+			}
+		}
+
+		return;
+	}
+
+	// The legacy layout has no reactions, see hasReactions()
+	if (layoutVersion == legacyLayout)
+		return;
+
 	// Loop on the reactants
 	auto& allReactants = network.getAll();
 	std::for_each(allReactants.begin(), allReactants.end(),
@@ -683,9 +1102,6 @@ void XFile::ClusterGroup::readAlloySuperCluster(int &nTot, int &maxAtom,
 
 void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
 		IReactant &cluster) const {
-	// Get all the reactants
-	auto& allReactants = network.getAll();
-
 	// Read the production dataset
 	bool datasetExist = H5Lexists(getId(), productionDataName.c_str(),
 	H5P_DEFAULT);
@@ -702,17 +1118,7 @@ void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
 		status = H5Dclose(datasetId);
 		// Loop on the prod vector
 		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the 2 reactants
-			auto& firstReactant = allReactants.at(prodVec[i][0]);
-			auto& secondReactant = allReactants.at(prodVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-
-			// Add the reaction to the cluster
-			cluster.resultFrom(prref, &(prodVec[i][2]));
+			addProductionReaction(network, cluster, prodVec[i]);
 		}
 	}
 
@@ -730,18 +1136,9 @@ void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
 		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 		H5P_DEFAULT, &combVec);
 		status = H5Dclose(datasetId);
-		// Loop on the prod vector
+		// Loop on the comb vector
 		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the combining reactant
-			auto& firstReactant = allReactants.at(combVec[i][0]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, cluster));
-			auto& prref = network.add(std::move(reaction));
-
-			// Add the reaction to the cluster
-			cluster.participateIn(prref, &(combVec[i][1]));
+			addCombinationReaction(network, cluster, combVec[i]);
 		}
 	}
 
@@ -759,23 +1156,9 @@ void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
 		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 		H5P_DEFAULT, &dissoVec);
 		status = H5Dclose(datasetId);
-		// Loop on the prod vector
+		// Loop on the disso vector
 		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the other reactants
-			auto& emittingReactant = allReactants.at(dissoVec[i][0]);
-			auto& secondReactant = allReactants.at(dissoVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(cluster, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-			std::unique_ptr<DissociationReaction> dissociationReaction(
-					new DissociationReaction(emittingReactant, prref.first,
-							prref.second, &prref));
-			auto& drref = network.add(std::move(dissociationReaction));
-
-			// Add the reaction to the cluster
-			cluster.participateIn(drref, &(dissoVec[i][2]));
+			addDissociationReaction(network, cluster, dissoVec[i]);
 		}
 	}
 
@@ -793,23 +1176,9 @@ void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
 		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
 		H5P_DEFAULT, &emitVec);
 		status = H5Dclose(datasetId);
-		// Loop on the prod vector
+		// Loop on the emit vector
 		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the other reactants
-			auto& firstReactant = allReactants.at(emitVec[i][0]);
-			auto& secondReactant = allReactants.at(emitVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-			std::unique_ptr<DissociationReaction> dissociationReaction(
-					new DissociationReaction(cluster, prref.first, prref.second,
-							&prref));
-			auto& drref = network.add(std::move(dissociationReaction));
-
-			// Add the reaction to the cluster
-			cluster.emitFrom(drref, &(emitVec[i][2]));
+			addEmissionReaction(network, cluster, emitVec[i]);
 		}
 	}
 }
@@ -917,6 +1286,12 @@ const std::string XFile::TimestepGroup::prevIBulkFluxAttrName =
 		"previousIBulkFlux";
 
 const std::string XFile::TimestepGroup::concDatasetName = "concs";
+const std::string XFile::TimestepGroup::concIdsDatasetName = "concIds";
+const std::string XFile::TimestepGroup::concValuesDatasetName = "concValues";
+const std::string XFile::TimestepGroup::concDeltaIdsDatasetName = "concDeltaIds";
+const std::string XFile::TimestepGroup::concDeltaBitsDatasetName =
+		"concDeltaBits";
+const std::string XFile::TimestepGroup::deltaBaseAttrName = "deltaBase";
 
 std::string XFile::TimestepGroup::makeGroupName(
 		const XFile::ConcentrationGroup& concGroup, int timeStep) {
@@ -1254,23 +1629,191 @@ void XFile::TimestepGroup::writeConcentrationDataset(int size,
 // Assumes that grid point slabs are assigned to processes in 
 // MPI rank order.
 void XFile::TimestepGroup::writeConcentrations(const XFile& file, int baseX,
-		const Concs1DType& raggedConcs) const {
+		const Concs1DType& raggedConcs, int compressionLevel) const {
 
-	// Create and write the ragged dataset.
-	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName,
-			baseX, raggedConcs);
+	if (compressionLevel <= 0) {
+		// Create and write the ragged dataset.
+		RaggedDataSet2D<ConcType> dataset(file.getComm(), *this,
+				concDatasetName, baseX, raggedConcs);
+
+		// Unlike our other DataSet types, there is no need to call a
+		// 'write' on the dataset.  The constructor above
+		// defines the dataset *and* writes the given data.
+		return;
+	}
+
+	// Split the indices and the values
+	RaggedDataSet2D<int>::Ragged2DType raggedIds(raggedConcs.size());
+	RaggedDataSet2D<double>::Ragged2DType raggedValues(raggedConcs.size());
+	for (auto i = 0; i < raggedConcs.size(); ++i) {
+		raggedIds[i].reserve(raggedConcs[i].size());
+		raggedValues[i].reserve(raggedConcs[i].size());
+		for (const auto& conc : raggedConcs[i]) {
+			raggedIds[i].emplace_back(conc.first);
+			raggedValues[i].emplace_back(conc.second);
+		}
+	}
 
-	// Unlike our other DataSet types, there is no need to call a
-	// 'write' on the dataset.  The constructor above
-	// defines the dataset *and* writes the given data.
+	// Create and write the compressed ragged datasets.
+	RaggedDataSet2D<int> idsDataset(file.getComm(), *this, concIdsDatasetName,
+			baseX, raggedIds, compressionLevel);
+	RaggedDataSet2D<double> valuesDataset(file.getComm(), *this,
+			concValuesDatasetName, baseX, raggedValues, compressionLevel);
+}
+
+void XFile::TimestepGroup::writeConcentrationDeltas(const XFile& file,
+		int baseX, const Concs1DType& concs, int baseTimeStep,
+		const Concs1DType& baseConcs, int compressionLevel) const {
+
+	assert(concs.size() == baseConcs.size());
+
+	// Save the time step we are relative to
+	XFile::ScalarDataSpace scalarDSpace;
+	Attribute<int> deltaBaseAttr(*this, deltaBaseAttrName, scalarDSpace);
+	deltaBaseAttr.setTo(baseTimeStep);
+
+	// Merge the old and new concentrations of each grid point, the
+	// indices only present on one side are XORed with 0
+	RaggedDataSet2D<int>::Ragged2DType raggedIds(concs.size());
+	RaggedDataSet2D<uint64_t>::Ragged2DType raggedBits(concs.size());
+	for (auto i = 0; i < concs.size(); ++i) {
+		const auto& newConcs = concs[i];
+		const auto& oldConcs = baseConcs[i];
+		auto newIt = newConcs.begin();
+		auto oldIt = oldConcs.begin();
+		while (newIt != newConcs.end() || oldIt != oldConcs.end()) {
+			int id = 0;
+			uint64_t bits = 0;
+			if (oldIt == oldConcs.end()
+					|| (newIt != newConcs.end() && newIt->first < oldIt->first)) {
+				id = newIt->first;
+				bits = toBits(newIt->second);
+				++newIt;
+			} else if (newIt == newConcs.end() || oldIt->first < newIt->first) {
+				id = oldIt->first;
+				bits = toBits(oldIt->second);
+				++oldIt;
+			} else {
+				id = newIt->first;
+				bits = toBits(newIt->second) ^ toBits(oldIt->second);
+				++newIt;
+				++oldIt;
+			}
+
+			// Skip the values that didn't change
+			if (bits != 0) {
+				raggedIds[i].emplace_back(id);
+				raggedBits[i].emplace_back(bits);
+			}
+		}
+	}
+
+	// Create and write the ragged datasets.
+	RaggedDataSet2D<int> idsDataset(file.getComm(), *this,
+			concDeltaIdsDatasetName, baseX, raggedIds, compressionLevel);
+	RaggedDataSet2D<uint64_t> bitsDataset(file.getComm(), *this,
+			concDeltaBitsDatasetName, baseX, raggedBits, compressionLevel);
+}
+
+bool XFile::TimestepGroup::hasConcentrations(void) const {
+
+	// Look for the first dataset of each layout
+	for (const auto& name : { concDatasetName, concIdsDatasetName,
+			concDeltaIdsDatasetName }) {
+		auto cret = H5Lexists(getId(), name.c_str(), H5P_DEFAULT);
+		if (cret < 0) {
+			std::ostringstream estr;
+			estr << "Failed to check for dataset " << name;
+			throw HDF5Exception(estr.str());
+		}
+		if (cret > 0)
+			return true;
+	}
+
+	return false;
 }
 
 XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrations(
 		const XFile& file, int baseX, int numX) const {
 
-	// Open and read the ragged dataset.
-	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName);
-	return dataset.read(baseX, numX);
+	// Rebuild the delta encoded concentrations from the ones they
+	// are relative to
+	if (H5Aexists(getId(), deltaBaseAttrName.c_str()) > 0) {
+		Attribute<int> deltaBaseAttr(*this, deltaBaseAttrName);
+		auto concGroup = file.getGroup<ConcentrationGroup>();
+		assert(concGroup);
+		TimestepGroup baseGroup(*concGroup, deltaBaseAttr.get());
+		auto baseConcs = baseGroup.readConcentrations(file, baseX, numX);
+
+		// Read the deltas
+		RaggedDataSet2D<int> idsDataset(file.getComm(), *this,
+				concDeltaIdsDatasetName);
+		auto raggedIds = idsDataset.read(baseX, numX);
+		RaggedDataSet2D<uint64_t> bitsDataset(file.getComm(), *this,
+				concDeltaBitsDatasetName);
+		auto raggedBits = bitsDataset.read(baseX, numX);
+
+		// Apply them
+		Concs1DType ret(baseConcs.size());
+		for (auto i = 0; i < baseConcs.size(); ++i) {
+			const auto& oldConcs = baseConcs[i];
+			auto oldIt = oldConcs.begin();
+			auto j = 0;
+			while (oldIt != oldConcs.end() || j < raggedIds[i].size()) {
+				if (j == raggedIds[i].size()
+						|| (oldIt != oldConcs.end()
+								&& oldIt->first < raggedIds[i][j])) {
+					// Unchanged value
+					ret[i].emplace_back(*oldIt);
+					++oldIt;
+					continue;
+				}
+
+				uint64_t bits = raggedBits[i][j];
+				if (oldIt != oldConcs.end() && oldIt->first == raggedIds[i][j]) {
+					bits ^= toBits(oldIt->second);
+					++oldIt;
+				}
+				// A zero means the index is gone
+				if (bits != 0)
+					ret[i].emplace_back(raggedIds[i][j], fromBits(bits));
+				++j;
+			}
+		}
+		return ret;
+	}
+
+	// Check which layout was used
+	auto cret = H5Lexists(getId(), concDatasetName.c_str(), H5P_DEFAULT);
+	if (cret < 0) {
+		std::ostringstream estr;
+		estr << "Failed to check for dataset " << concDatasetName;
+		throw HDF5Exception(estr.str());
+	}
+
+	if (cret > 0) {
+		// Open and read the ragged dataset.
+		RaggedDataSet2D<ConcType> dataset(file.getComm(), *this,
+				concDatasetName);
+		return dataset.read(baseX, numX);
+	}
+
+	// Open and read the compressed ragged datasets.
+	RaggedDataSet2D<int> idsDataset(file.getComm(), *this, concIdsDatasetName);
+	auto raggedIds = idsDataset.read(baseX, numX);
+	RaggedDataSet2D<double> valuesDataset(file.getComm(), *this,
+			concValuesDatasetName);
+	auto raggedValues = valuesDataset.read(baseX, numX);
+
+	// Put them back together
+	Concs1DType ret(raggedIds.size());
+	for (auto i = 0; i < raggedIds.size(); ++i) {
+		ret[i].reserve(raggedIds[i].size());
+		for (auto j = 0; j < raggedIds[i].size(); ++j) {
+			ret[i].emplace_back(raggedIds[i][j], raggedValues[i][j]);
+		}
+	}
+	return ret;
 }
 
 std::pair<double, double> XFile::TimestepGroup::readTimes(void) const {
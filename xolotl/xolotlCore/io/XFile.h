@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <array>
 #include <tuple>
 #include <set>
 #include "xolotlCore/io/HDF5File.h"
@@ -64,6 +65,18 @@ public:
 		// Name of the concentrations data set.
 		static const std::string concDatasetName;
 
+		// Names of the compressed concentrations data sets, the indices
+		// and the values are stored separately because they compress
+		// better that way.
+		static const std::string concIdsDatasetName;
+		static const std::string concValuesDatasetName;
+
+		// Names of the delta encoded concentrations data sets, and of the
+		// attribute giving the time step they are relative to.
+		static const std::string concDeltaIdsDatasetName;
+		static const std::string concDeltaBitsDatasetName;
+		static const std::string deltaBaseAttrName;
+
 		/**
 		 * Construct the group name for the given time step.
 		 *
@@ -212,17 +225,54 @@ public:
 		 *              Must have size equal to number of grid points we own.
 		 *              Element i contains concentration data for
 		 *              (baseX + i)
+		 * @param compressionLevel The deflate level, 0 to write the
+		 *              concentrations uncompressed in a single dataset.
+		 *              Otherwise the indices and values are written in
+		 *              two chunked datasets compressed with that level.
 		 */
 		// TODO measure performance gain when caller gives us
 		// flattened array instead of having us convert to/from flat
 		// representation.
 		void writeConcentrations(const XFile& file, int baseX,
-				const Concs1DType& concs) const;
+				const Concs1DType& concs, int compressionLevel = 0) const;
+
+		/**
+		 * Add the concentrations for all grid points in a 1D problem as
+		 * a delta relative to the ones of an earlier time step.
+		 * For each grid point we only store the indices whose value
+		 * changed, with the XOR of the bits of the old and new values,
+		 * so the concentrations are rebuilt exactly. The XOR of close
+		 * values has mostly zero bits which compress well.
+		 * The indices must be increasing at each grid point and the
+		 * values must be non-zero, a zero value is read as a missing index.
+		 *
+		 * @param file The HDF5 file that owns our group.
+		 * @param baseX Index of first grid point we own.
+		 * @param concs Concentrations associated with grid points we own.
+		 * @param baseTimeStep The time step the delta is relative to, its
+		 *              group must be in the same file.
+		 * @param baseConcs The concentrations of that time step for the
+		 *              same grid points.
+		 * @param compressionLevel The deflate level, 0 for no compression.
+		 */
+		void writeConcentrationDeltas(const XFile& file, int baseX,
+				const Concs1DType& concs, int baseTimeStep,
+				const Concs1DType& baseConcs, int compressionLevel = 0) const;
+
+		/**
+		 * Check whether the concentrations of a 1D problem were written
+		 * in our group, in any of the supported layouts.
+		 *
+		 * @return True iff we have the concentrations.
+		 */
+		bool hasConcentrations(void) const;
 
 		/**
 		 * Read concentration dataset for our grid points in a 1D problem.
 		 * Assumes that grid point slabs are assigned to processes in
-		 * MPI rank order.
+		 * MPI rank order. The uncompressed, compressed and delta encoded
+		 * layouts are supported, deltas are applied to the concentrations
+		 * of the time step they refer to.
 		 *
 		 * @param file The HDF5 file that owns our group.  Needed to support
 		 *              parallel file access.
@@ -385,6 +435,9 @@ public:
 		// Name of network composition dataset within our group.
 		static const std::string netCompsDatasetName;
 
+		// Name of the grid dataset within our group.
+		static const std::string gridDatasetName;
+
 		// Names of grid-specification attributes.
 		static const std::string nxAttrName;
 		static const std::string hxAttrName;
@@ -443,6 +496,14 @@ public:
 		void read(int &nx, double &hx, int &ny, double &hy, int &nz,
 				double &hz) const;
 
+		/**
+		 * Read the positions of the grid points in the x direction,
+		 * relative to the first one.
+		 *
+		 * @return The positions, empty if there is no grid in x.
+		 */
+		std::vector<double> readGrid(void) const;
+
 		/**
 		 * Read our network compositions.
 		 *
@@ -458,9 +519,71 @@ public:
 		static const std::string normalSizeAttrName;
 		static const std::string superSizeAttrName;
 		static const std::string phaseSpaceAttrName;
+		static const std::string layoutVersionAttrName;
+
+		// Names of the datasets of the columnar layout.
+		static const std::string compositionDataName;
+		static const std::string formationEnergyDataName;
+		static const std::string migrationEnergyDataName;
+		static const std::string diffusionFactorDataName;
+		static const std::string superOffsetDataName;
+		static const std::string heVListDataName;
+		static const std::array<std::string, 4> reactionDataNames;
+
+		// Name of the dataset of the legacy layout.
+		static const std::string legacyDataName;
+
+		//! The layout version of the group (1 if it was written before versions existed, 0 for the oldest files).
+		int layoutVersion;
+
+		//! The number of components in a composition, in the columnar layout.
+		mutable int compSize;
+
+		//! The compositions of the normal clusters, read on first use.
+		mutable std::vector<int> compositions;
+
+		//! The energies and diffusion factors of the normal clusters, read on first use.
+		mutable std::vector<double> formationEnergies;
+		mutable std::vector<double> migrationEnergies;
+		mutable std::vector<double> diffusionFactors;
+
+		//! The offsets of each super cluster in heVList, read on first use.
+		mutable std::vector<int> superOffsets;
+
+		//! The coordinates of the clusters in every super cluster, read on first use.
+		mutable std::vector<int> heVList;
+
+		/**
+		 * Write the network as columns, one dataset per cluster property
+		 * and one CSR table per type of reaction.
+		 *
+		 * @param network The network to write.
+		 */
+		void writeColumns(IReactionNetwork& network);
+
+		/**
+		 * Read the cluster property columns if they are not already in memory.
+		 */
+		void readColumns() const;
+
+		/**
+		 * Fill the cluster property columns from the single dataset of the
+		 * legacy layout, where each row is [He, V, I, formation energy,
+		 * migration energy, diffusion factor].
+		 */
+		void readLegacyColumns() const;
 
 	public:
 
+		//! The layout where the normal clusters are the rows of a single dataset, without reactions.
+		static const int legacyLayout = 0;
+
+		//! The layout where each cluster has its own group.
+		static const int groupLayout = 1;
+
+		//! The layout where each cluster property is a dataset over all the clusters.
+		static const int columnarLayout = 2;
+
 		// Path to the network group within our HDF5 file.
 		static const fs::path path;
 
@@ -491,6 +614,46 @@ public:
 		 */
 		Array<int, 5> readNetworkSize(int &normalSize, int &superSize) const;
 
+		/**
+		 * Get the layout version of the group.
+		 *
+		 * @return The layout version
+		 */
+		int getLayoutVersion() const {
+			return layoutVersion;
+		}
+
+		/**
+		 * Does the group store the reactions? When it doesn't the network
+		 * has to create them.
+		 *
+		 * @return True if readReactions() sets them
+		 */
+		bool hasReactions() const {
+			return layoutVersion != legacyLayout;
+		}
+
+		/**
+		 * Read the properties of a normal cluster, whatever the layout.
+		 *
+		 * @param id The id of the cluster.
+		 * @param formationEnergy The formation energy.
+		 * @param migrationEnergy The migration energy.
+		 * @param diffusionFactor The diffusion factor.
+		 * @return The cluster composition.
+		 */
+		std::vector<int> readCluster(int id, double &formationEnergy,
+				double &migrationEnergy, double &diffusionFactor) const;
+
+		/**
+		 * Read the properties of a PSI super cluster, whatever the layout.
+		 *
+		 * @param id The id of the cluster.
+		 * @return The list of clusters that it contains.
+		 */
+		std::set<std::tuple<int, int, int, int> > readPSISuperCluster(
+				int id) const;
+
 		/**
 		 * Read the reactions for every cluster.
 		 *
@@ -114,8 +114,31 @@ public:
 	 * with time, depending on the total helium concentration.
 	 *
 	 * @param conc The concentration of helium
+	 * @param yj The index of the local column in the Y direction
+	 * @param zk The index of the local column in the Z direction
 	 */
-	virtual void updateDisappearingRate(double conc) = 0;
+	virtual void updateDisappearingRate(double conc, int yj = 0, int zk = 0) = 0;
+
+	/**
+	 * To know if the disappearing rates were computed from the given state of
+	 * the solution, identified by an id and a state counter that changes
+	 * whenever the solution is modified.
+	 *
+	 * @param id The id of the solution
+	 * @param state The state of the solution
+	 * @return True if they were
+	 */
+	virtual bool isDisappearingRateUpToDate(long long id,
+			long long state) const = 0;
+
+	/**
+	 * Remember from which state of the solution the disappearing rates
+	 * were computed.
+	 *
+	 * @param id The id of the solution
+	 * @param state The state of the solution
+	 */
+	virtual void setDisappearingRateState(long long id, long long state) = 0;
 
 	/**
 	 * Compute the flux due to the modified trap-mutation for all the cluster,
@@ -65,6 +65,8 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network, int nx,
 			// Give the 2D vector to the final vector
 			tmBubbles.emplace_back(temp2DVector);
 		}
+		resizeDisappearingRates(ny, nz);
+
 		// Inform the user
 		int procId;
 		MPI_Comm_rank(MPI_COMM_WORLD, &procId);
@@ -191,6 +193,9 @@ void TrapMutationHandler::initializeIndex1D(int surfacePos,
 	// Give the 2D vector to the final vector
 	tmBubbles.emplace_back(temp2DVector);
 
+	// A single column in 1D
+	resizeDisappearingRates(1, 1);
+
 	return;
 }
 
@@ -317,6 +322,9 @@ void TrapMutationHandler::initializeIndex2D(std::vector<int> surfacePos,
 	// Give the 2D vector to the final vector
 	tmBubbles.push_back(temp2DVector);
 
+	// One column for each Y
+	resizeDisappearingRates(ny, 1);
+
 	// Clear the memory
 	delete sigma3Handler;
 
@@ -453,6 +461,9 @@ void TrapMutationHandler::initializeIndex3D(
 		tmBubbles.push_back(temp2DVector);
 	}
 
+	// One column for each (Y, Z)
+	resizeDisappearingRates(ny, nz);
+
 	// Clear the memory
 	delete sigma3Handler;
 
@@ -474,10 +485,20 @@ void TrapMutationHandler::setAttenuation(bool isAttenuation) {
 	return;
 }
 
-void TrapMutationHandler::updateDisappearingRate(double conc) {
+void TrapMutationHandler::resizeDisappearingRates(int ny, int nz) {
+	kDis.resize(nz);
+	for (auto& column : kDis) {
+		column.resize(ny, 1.0);
+	}
+
+	return;
+}
+
+void TrapMutationHandler::updateDisappearingRate(double conc, int yj,
+		int zk) {
 	// Set the rate to have an exponential decrease
 	if (attenuation)
-		kDis = exp(-4.0 * conc);
+		kDis[zk][yj] = exp(-4.0 * conc);
 
 	return;
 }
@@ -517,9 +538,10 @@ void TrapMutationHandler::computeTrapMutation(const IReactionNetwork& network,
 			// Get the left side rate (combination + emission)
 			double totalRate = heCluster->getLeftSideRate(xi + 1);
 			// Define the trap-mutation rate taking into account the desorption
-			rate = kDis * totalRate * (1.0 - desorp.portion) / desorp.portion;
+			rate = kDis[zk][yj] * totalRate * (1.0 - desorp.portion)
+					/ desorp.portion;
 		} else {
-			rate = kDis * kMutation;
+			rate = kDis[zk][yj] * kMutation;
 		}
 
 		// Update the concentrations (the helium cluster loses its concentration)
@@ -567,9 +589,10 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 			// Get the left side rate (combination + emission)
 			double totalRate = heCluster->getLeftSideRate(xi + 1);
 			// Define the trap-mutation rate taking into account the desorption
-			rate = kDis * totalRate * (1.0 - desorp.portion) / desorp.portion;
+			rate = kDis[zk][yj] * totalRate * (1.0 - desorp.portion)
+					/ desorp.portion;
 		} else {
-			rate = kDis * kMutation;
+			rate = kDis[zk][yj] * kMutation;
 		}
 
 		// Set the helium cluster partial derivative
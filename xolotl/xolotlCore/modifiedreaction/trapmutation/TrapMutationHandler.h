@@ -49,8 +49,11 @@ protected:
 	//! The trap-mutation rate
 	double kMutation;
 
-	//! The disappearing rate
-	double kDis;
+	//! The disappearing rate of each local (Y, Z) column, as kDis[zk][yj]
+	std::vector<std::vector<double> > kDis;
+
+	//! The id and state of the solution the disappearing rates come from
+	long long kDisId, kDisState;
 
 	//! To know if we want attenuation or not
 	bool attenuation;
@@ -85,13 +88,23 @@ protected:
 		return;
 	}
 
+	/**
+	 * Resize the disappearing rates to the local columns, keeping the
+	 * existing values and starting the new ones at 1.0.
+	 *
+	 * @param ny The number of local columns in the Y direction
+	 * @param nz The number of local columns in the Z direction
+	 */
+	void resizeDisappearingRates(int ny, int nz);
+
 public:
 
 	/**
 	 * The constructor
 	 */
 	TrapMutationHandler() :
-			kMutation(0.0), kDis(1.0), attenuation(true), desorp(0, 0.0) {
+			kMutation(0.0), kDis(1, std::vector<double>(1, 1.0)), kDisId(-1), kDisState(
+					-1), attenuation(true), desorp(0, 0.0) {
 	}
 
 	/**
@@ -169,8 +182,25 @@ public:
 	 * with time, depending on the total helium concentration.
 	 *
 	 * @param conc The concentration of helium
+	 * @param yj The index of the local column in the Y direction
+	 * @param zk The index of the local column in the Z direction
 	 */
-	void updateDisappearingRate(double conc);
+	void updateDisappearingRate(double conc, int yj = 0, int zk = 0);
+
+	/**
+	 * \see ITrapMutationHandler.h
+	 */
+	bool isDisappearingRateUpToDate(long long id, long long state) const {
+		return id == kDisId && state == kDisState;
+	}
+
+	/**
+	 * \see ITrapMutationHandler.h
+	 */
+	void setDisappearingRateState(long long id, long long state) {
+		kDisId = id;
+		kDisState = state;
+	}
 
 	/**
 	 * Compute the flux due to the modified trap-mutation for all the cluster,
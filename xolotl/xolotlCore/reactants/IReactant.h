@@ -298,6 +298,23 @@ public:
 	 */
 	virtual void addGridPoints(int i) = 0;
 
+	/**
+	 * Get the memory used by this reactant and the lists of reactions it
+	 * takes part in. The values per grid point and the coefficients of the
+	 * super clusters are accounted by the network.
+	 *
+	 * @return The number of bytes
+	 */
+	virtual std::size_t getMemorySize() const = 0;
+
+	/**
+	 * Get the memory used by the diffusion coefficient and the temperature
+	 * of each grid point, nothing for the clusters that don't keep them.
+	 *
+	 * @return The number of bytes
+	 */
+	virtual std::size_t getGridPointMemorySize() const = 0;
+
 	/**
 	 * This operation returns a list that represents the connectivity
 	 * between this reactant and other reactants in the network.
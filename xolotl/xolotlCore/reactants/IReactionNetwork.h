@@ -38,6 +38,28 @@ public:
 	 */
 	using SparseFillMap = std::unordered_map<int, std::vector<int>>;
 
+	/**
+	 * Concise name for a sparse weight vector over the degrees of freedom,
+	 * made of (index, weight) pairs.
+	 */
+	using WeightVector = std::vector<std::pair<int, double> >;
+
+	/**
+	 * Sum the concentrations of a grid point with a weight vector.
+	 *
+	 * @param weights The weight vector
+	 * @param concs The concentrations at the grid point
+	 * @return The weighted sum
+	 */
+	static double sumWeights(const WeightVector& weights,
+			const double* concs) {
+		double sum = 0.0;
+		for (auto const& weight : weights) {
+			sum += concs[weight.first] * weight.second;
+		}
+		return sum;
+	}
+
 	/**
 	 * The destructor.
 	 */
@@ -273,6 +295,41 @@ public:
 	 */
 	virtual double getTotalIConcentration() = 0;
 
+	/**
+	 * Get the weights giving the total concentration of atoms from the
+	 * concentrations of a grid point, the same total as
+	 * getTotalAtomConcentration() without updating the network.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight vector
+	 */
+	virtual const WeightVector& getTotalAtomWeights(int i = 0) = 0;
+
+	/**
+	 * Get the weights giving the total concentration of atoms contained in
+	 * bubbles, as getTotalTrappedAtomConcentration().
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight vector
+	 */
+	virtual const WeightVector& getTotalTrappedAtomWeights(int i = 0) = 0;
+
+	/**
+	 * Get the weights giving the total concentration of vacancies, as
+	 * getTotalVConcentration().
+	 *
+	 * @return The weight vector
+	 */
+	virtual const WeightVector& getTotalVWeights() = 0;
+
+	/**
+	 * Get the weights giving the total concentration of material
+	 * interstitials, as getTotalIConcentration().
+	 *
+	 * @return The weight vector
+	 */
+	virtual const WeightVector& getTotalIWeights() = 0;
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations of the network.
 	 * Need to be called only when the temperature changes.
@@ -288,6 +345,48 @@ public:
 	 */
 	virtual void addGridPoints(int i) = 0;
 
+	/**
+	 * Get the number of grid points of the rates and diffusion coefficients.
+	 *
+	 * @return The number of grid points
+	 */
+	virtual int getNumberOfGridPoints() const = 0;
+
+	/**
+	 * Set the number of OpenMP threads that compute the diffusion
+	 * coefficients and the rates of a grid point. The grid points added
+	 * afterwards are allocated by the threads that update them.
+	 *
+	 * @param n The number of threads
+	 */
+	virtual void setNumThreads(int n) = 0;
+
+	/**
+	 * Get the number of OpenMP threads that compute the diffusion
+	 * coefficients and the rates of a grid point.
+	 *
+	 * @return The number of threads
+	 */
+	virtual int getNumThreads() const = 0;
+
+	/**
+	 * Get the most memory the rates and diffusion coefficients can use for
+	 * a given number of grid points, counting every cluster and the room
+	 * the vectors keep when they grow.
+	 *
+	 * @param nGridPoints The number of grid points
+	 * @return The number of bytes
+	 */
+	virtual std::size_t getGridPointMemorySize(int nGridPoints) const = 0;
+
+	/**
+	 * Report the memory used by the clusters, the reactions, and the
+	 * coefficients of the super clusters to the memory tracker of
+	 * xolotlPerf, replacing what was reported before. It is called once
+	 * the network is built.
+	 */
+	virtual void trackMemory() = 0;
+
 	/**
 	 * Compute the fluxes generated by all the reactions
 	 * for all the clusters and their momentum.
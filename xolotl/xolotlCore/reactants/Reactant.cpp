@@ -51,6 +51,19 @@ void Reactant::addGridPoints(int i) {
 	return;
 }
 
+std::size_t Reactant::getMemorySize() const {
+	// The connectivity sets, the subclasses add their lists of reactions
+	return sizeof(Reactant) + name.capacity()
+			+ (reactionConnectivitySet.size()
+					+ dissociationConnectivitySet.size())
+					* xolotlPerf::getTreeNodeMemorySize<int>();
+}
+
+std::size_t Reactant::getGridPointMemorySize() const {
+	return xolotlPerf::getVectorMemorySize(diffusionCoefficient)
+			+ xolotlPerf::getVectorMemorySize(temperature);
+}
+
 std::vector<int> Reactant::getConnectivity() const {
 	// The connectivity array by default is filled with
 	// zeros.
@@ -527,6 +527,22 @@ public:
 	 */
 	virtual void addGridPoints(int i) override;
 
+	/**
+	 * Get the memory used by this reactant and the lists of reactions it
+	 * takes part in. The values per grid point and the coefficients of the
+	 * super clusters are accounted by the network.
+	 *
+	 * @return The number of bytes
+	 */
+	virtual std::size_t getMemorySize() const override;
+
+	/**
+	 * Get the memory used by the diffusion coefficient and the temperature
+	 * of each grid point.
+	 * \see IReactant.h
+	 */
+	virtual std::size_t getGridPointMemorySize() const override;
+
 	/**
 	 * This operation returns a list that represents the connectivity
 	 * between this reactant and other reactants in the network.
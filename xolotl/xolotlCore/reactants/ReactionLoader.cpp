@@ -0,0 +1,88 @@
+#include "ReactionLoader.h"
+#include "ProductionReaction.h"
+#include "DissociationReaction.h"
+
+namespace xolotlCore {
+
+void addProductionReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row) {
+	// Get pointers to the 2 reactants
+	auto& allReactants = network.getAll();
+	auto& firstReactant = allReactants.at(row[0]);
+	auto& secondReactant = allReactants.at(row[1]);
+
+	// Create and add the reaction to the network
+	std::unique_ptr<ProductionReaction> reaction(
+			new ProductionReaction(firstReactant, secondReactant));
+	auto& prref = network.add(std::move(reaction));
+
+	// Add the reaction to the cluster
+	cluster.resultFrom(prref, &(row[2]));
+
+	return;
+}
+
+void addCombinationReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row) {
+	// Get pointers to the combining reactant
+	auto& firstReactant = network.getAll().at(row[0]);
+
+	// Create and add the reaction to the network
+	std::unique_ptr<ProductionReaction> reaction(
+			new ProductionReaction(firstReactant, cluster));
+	auto& prref = network.add(std::move(reaction));
+
+	// Add the reaction to the cluster
+	cluster.participateIn(prref, &(row[1]));
+
+	return;
+}
+
+void addDissociationReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row) {
+	// Get pointers to the other reactants
+	auto& allReactants = network.getAll();
+	auto& emittingReactant = allReactants.at(row[0]);
+	auto& secondReactant = allReactants.at(row[1]);
+
+	// Create and add the reaction to the network
+	std::unique_ptr<ProductionReaction> reaction(
+			new ProductionReaction(cluster, secondReactant));
+	auto& prref = network.add(std::move(reaction));
+	std::unique_ptr<DissociationReaction> dissociationReaction(
+			new DissociationReaction(emittingReactant, prref.first,
+					prref.second, &prref));
+	auto& drref = network.add(std::move(dissociationReaction));
+
+	// Add the reaction to the cluster
+	cluster.participateIn(drref, &(row[2]));
+
+	return;
+}
+
+void addEmissionReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row) {
+	// Get pointers to the other reactants
+	auto& allReactants = network.getAll();
+	auto& firstReactant = allReactants.at(row[0]);
+	auto& secondReactant = allReactants.at(row[1]);
+
+	// Create and add the reaction to the network
+	std::unique_ptr<ProductionReaction> reaction(
+			new ProductionReaction(firstReactant, secondReactant));
+	auto& prref = network.add(std::move(reaction));
+	std::unique_ptr<DissociationReaction> dissociationReaction(
+			new DissociationReaction(cluster, prref.first, prref.second,
+					&prref));
+	auto& drref = network.add(std::move(dissociationReaction));
+
+	// Add the reaction to the cluster
+	cluster.emitFrom(drref, &(row[2]));
+
+	return;
+}
+
+const std::array<ReactionAdder, 4> reactionAdders { { addProductionReaction,
+		addCombinationReaction, addDissociationReaction, addEmissionReaction } };
+
+} /* namespace xolotlCore */
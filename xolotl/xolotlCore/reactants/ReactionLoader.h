@@ -0,0 +1,61 @@
+#ifndef REACTIONLOADER_H_
+#define REACTIONLOADER_H_
+
+#include <array>
+#include "IReactionNetwork.h"
+#include "IReactant.h"
+
+namespace xolotlCore {
+
+/**
+ * Add a production reaction read from a network file or buffer, the row is
+ * [first id, second id, coefficients...].
+ *
+ * @param network The network that needs the reaction.
+ * @param cluster The cluster produced by the reaction.
+ * @param row The row describing the reaction.
+ */
+void addProductionReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row);
+
+/**
+ * Add a combination reaction read from a network file or buffer, the row is
+ * [other id, coefficients...].
+ *
+ * @param network The network that needs the reaction.
+ * @param cluster The cluster combining in the reaction.
+ * @param row The row describing the reaction.
+ */
+void addCombinationReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row);
+
+/**
+ * Add a dissociation reaction read from a network file or buffer, the row is
+ * [emitting id, other emitted id, coefficients...].
+ *
+ * @param network The network that needs the reaction.
+ * @param cluster The cluster emitted by the reaction.
+ * @param row The row describing the reaction.
+ */
+void addDissociationReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row);
+
+/**
+ * Add an emission reaction read from a network file or buffer, the row is
+ * [first emitted id, second emitted id, coefficients...].
+ *
+ * @param network The network that needs the reaction.
+ * @param cluster The cluster dissociating in the reaction.
+ * @param row The row describing the reaction.
+ */
+void addEmissionReaction(IReactionNetwork& network, IReactant& cluster,
+		double* row);
+
+//! The functions adding each type of reaction, in the order they are
+//! written: production, combination, dissociation, and emission.
+using ReactionAdder = void (*)(IReactionNetwork&, IReactant&, double*);
+extern const std::array<ReactionAdder, 4> reactionAdders;
+
+} /* namespace xolotlCore */
+
+#endif /* REACTIONLOADER_H_ */
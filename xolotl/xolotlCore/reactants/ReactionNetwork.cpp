@@ -9,7 +9,11 @@ ReactionNetwork::ReactionNetwork(
 		const std::set<ReactantType>& _knownReactantTypes,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> _registry) :
 		knownReactantTypes(_knownReactantTypes), handlerRegistry(_registry), temperature(
-				0.0), dissociationsEnabled(true) {
+				0.0), dissociationsEnabled(true), nRateGridPoints(0), nThreads(1), reactantMemory(
+				xolotlPerf::MemoryCategory::Reactants), reactionMemory(
+				xolotlPerf::MemoryCategory::Reactions), coefficientMemory(
+				xolotlPerf::MemoryCategory::Coefficients), gridPointMemory(
+				xolotlPerf::MemoryCategory::GridPointRates) {
 
 	// Ensure our per-type cluster map can store Reactants of the types
 	// we support.
@@ -54,6 +58,9 @@ void ReactionNetwork::add(std::unique_ptr<IReactant> reactant) {
 		// Give reactant to the appropriate per-type map.
 		currTypeMap.emplace(composition, std::move(reactant));
 
+		// The weights of the totals don't know about it
+		resetTotalWeights();
+
 	} else {
 		std::stringstream errStream;
 		errStream << "ReactionNetwork: not adding duplicate "
@@ -106,6 +113,34 @@ double ReactionNetwork::calculateReactionRateConstant(
 	return k_plus;
 }
 
+const IReactionNetwork::WeightVector& ReactionNetwork::getTotalWeights(
+		int idx) {
+	// Compute the weights the first time
+	if (totalWeights.empty()) {
+		totalWeights.resize(iWeightsIdx + 1);
+		computeTotalWeights();
+	}
+
+	return totalWeights[idx];
+}
+
+const IReactionNetwork::WeightVector& ReactionNetwork::getTotalAtomWeights(
+		int i) {
+	if (i < 0 || i >= trappedWeightsIdx)
+		throw std::string("\nType not defined for getTotalAtomWeights()");
+
+	return getTotalWeights(i);
+}
+
+const IReactionNetwork::WeightVector& ReactionNetwork::getTotalTrappedAtomWeights(
+		int i) {
+	if (i < 0 || i >= trappedWeightsIdx)
+		throw std::string(
+				"\nType not defined for getTotalTrappedAtomWeights()");
+
+	return getTotalWeights(trappedWeightsIdx + i);
+}
+
 void ReactionNetwork::fillConcentrationsArray(double * concentrations) {
 
 	// Fill the array
@@ -133,14 +168,16 @@ void ReactionNetwork::setTemperature(double temp, int i) {
 	// Set the temperature
 	temperature = temp;
 
-	// Update the temperature for all of the clusters
-	std::for_each(allReactants.begin(), allReactants.end(),
-			[&temp,&i](IReactant& currReactant) {
-
-				// This part will set the temperature in each reactant
-				// and recompute the diffusion coefficient
-				currReactant.setTemperature(temp, i);
-			});
+	// Update the temperature for all of the clusters, with the same static
+	// schedule as addGridPoints() so that each thread updates the
+	// diffusion coefficients it allocated
+	int nReactants = allReactants.size();
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+	for (int n = 0; n < nReactants; n++) {
+		// This part will set the temperature in each reactant
+		// and recompute the diffusion coefficient
+		allReactants[n].get().setTemperature(temp, i);
+	}
 
 	return;
 }
@@ -216,6 +253,7 @@ void ReactionNetwork::removeReactants(
 	}
 
 	allReactants.erase(result, allReactants.end());
+	resetTotalWeights();
 
 	// ...Next, examine each type's collection of clusters and remove the
 	// doomed reactants.
@@ -232,19 +270,41 @@ void ReactionNetwork::removeReactants(
 	return;
 }
 
+void ReactionNetwork::updateReactionLists() {
+	// Reactions are never removed from the maps so it is enough to check
+	// the sizes
+	if (productionReactions.size() != productionReactionMap.size()) {
+		productionReactions.clear();
+		for (auto& currReactionInfo : productionReactionMap) {
+			productionReactions.push_back(currReactionInfo.second.get());
+		}
+	}
+	if (dissociationReactions.size() != dissociationReactionMap.size()) {
+		dissociationReactions.clear();
+		for (auto& currReactionInfo : dissociationReactionMap) {
+			dissociationReactions.push_back(currReactionInfo.second.get());
+		}
+	}
+
+	return;
+}
+
 void ReactionNetwork::computeRateConstants(int i) {
-	// Local declarations
-	double rate = 0.0;
+	// Make sure the lists know about all the reactions
+	updateReactionLists();
 	// Initialize the value for the biggest production rate
 	double biggestProductionRate = 0.0;
 
 	// Loop on all the production reactions
-	for (auto& currReactionInfo : productionReactionMap) {
+	int nReactions = productionReactions.size();
+#pragma omp parallel for num_threads(nThreads) schedule(static) \
+		reduction(max:biggestProductionRate)
+	for (int n = 0; n < nReactions; n++) {
 
-		auto& currReaction = currReactionInfo.second;
+		auto currReaction = productionReactions[n];
 
 		// Compute the rate
-		rate = calculateReactionRateConstant(*currReaction, i);
+		double rate = calculateReactionRateConstant(*currReaction, i);
 		// Set it in the reaction
 		currReaction->kConstant[i] = rate;
 
@@ -253,16 +313,17 @@ void ReactionNetwork::computeRateConstants(int i) {
 			biggestProductionRate = rate;
 	}
 
-	// Loop on all the dissociation reactions
-	for (auto& currReactionInfo : dissociationReactionMap) {
+	// Loop on all the dissociation reactions, they need the rates of the
+	// production reactions
+	nReactions = dissociationReactions.size();
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+	for (int n = 0; n < nReactions; n++) {
 
-		auto& currReaction = currReactionInfo.second;
+		auto currReaction = dissociationReactions[n];
 
-		// Compute the rate
-		rate = calculateDissociationConstant(*currReaction, i);
-
-		// Set it in the reaction
-		currReaction->kConstant[i] = rate;
+		// Compute the rate and set it in the reaction
+		currReaction->kConstant[i] = calculateDissociationConstant(
+				*currReaction, i);
 	}
 
 	// Set the biggest rate
@@ -272,24 +333,38 @@ void ReactionNetwork::computeRateConstants(int i) {
 }
 
 void ReactionNetwork::addGridPoints(int i) {
-	// Add grid points to the diffusing clusters first
-	for (IReactant& currReactant : allReactants) {
-		currReactant.addGridPoints(i);
-	}
-
 	// Add grid points
 	if (i > 0) {
+		// Grow the rows with the static schedules of setTemperature() and
+		// computeRateConstants(), so that each row is allocated and first
+		// touched by the thread that updates it. A row is smaller than a
+		// page, but the allocator serves each thread from its own arena so
+		// the rows of a thread end up on the pages of its NUMA node.
+		updateReactionLists();
+		int nReactants = allReactants.size();
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+		for (int n = 0; n < nReactants; n++) {
+			allReactants[n].get().addGridPoints(i);
+		}
 		// Loop on all the production reactions
-		for (auto& currReactionInfo : productionReactionMap) {
-			int size = currReactionInfo.second->kConstant.size();
-			currReactionInfo.second->kConstant.resize(size + i, 0.0);
+		int nReactions = productionReactions.size();
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+		for (int n = 0; n < nReactions; n++) {
+			auto& kConstant = productionReactions[n]->kConstant;
+			kConstant.resize(kConstant.size() + i, 0.0);
 		}
 		// Loop on all the dissociation reactions
-		for (auto& currReactionInfo : dissociationReactionMap) {
-			int size = currReactionInfo.second->kConstant.size();
-			currReactionInfo.second->kConstant.resize(size + i, 0.0);
+		nReactions = dissociationReactions.size();
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+		for (int n = 0; n < nReactions; n++) {
+			auto& kConstant = dissociationReactions[n]->kConstant;
+			kConstant.resize(kConstant.size() + i, 0.0);
 		}
 	} else {
+		// Remove grid points from the clusters
+		for (IReactant& currReactant : allReactants) {
+			currReactant.addGridPoints(i);
+		}
 		// Loop on all the production reactions
 		for (auto& currReactionInfo : productionReactionMap) {
 			currReactionInfo.second->kConstant.erase(
@@ -304,6 +379,65 @@ void ReactionNetwork::addGridPoints(int i) {
 		}
 	}
 
+	// Report what the rates and diffusion coefficients allocated
+	nRateGridPoints += i;
+	std::size_t bytes = 0;
+	for (auto const& currReactionInfo : productionReactionMap) {
+		bytes += xolotlPerf::getVectorMemorySize(
+				currReactionInfo.second->kConstant);
+	}
+	for (auto const& currReactionInfo : dissociationReactionMap) {
+		bytes += xolotlPerf::getVectorMemorySize(
+				currReactionInfo.second->kConstant);
+	}
+	for (IReactant const& currReactant : allReactants) {
+		bytes += currReactant.getGridPointMemorySize();
+	}
+	gridPointMemory.set(bytes);
+
+	return;
+}
+
+std::size_t ReactionNetwork::getGridPointMemorySize(int nGridPoints) const {
+	// A rate per reaction and a diffusion coefficient and a temperature per
+	// cluster, each in a vector that may have doubled past the size
+	return xolotlPerf::getGrownCapacity(nGridPoints) * sizeof(double)
+			* (productionReactionMap.size() + dissociationReactionMap.size()
+					+ 2 * allReactants.size());
+}
+
+void ReactionNetwork::trackMemory() {
+	using xolotlPerf::getHashNodeMemorySize;
+	using xolotlPerf::getVectorMemorySize;
+
+	// The clusters, and the maps owning them
+	std::size_t bytes = getVectorMemorySize(allReactants);
+	for (auto const& currTypeMap : clusterTypeMap) {
+		bytes += currTypeMap.second.size()
+				* getHashNodeMemorySize<ReactantMap::value_type>()
+				+ currTypeMap.second.bucket_count() * sizeof(void*);
+	}
+	for (IReactant const& currReactant : allReactants) {
+		bytes += currReactant.getMemorySize();
+	}
+	reactantMemory.set(bytes);
+
+	// The reactions, the maps owning them, and their flat lists
+	bytes = productionReactionMap.size()
+			* (sizeof(ProductionReaction)
+					+ getHashNodeMemorySize<ProductionReactionMap::value_type>())
+			+ productionReactionMap.bucket_count() * sizeof(void*)
+			+ dissociationReactionMap.size()
+					* (sizeof(DissociationReaction)
+							+ getHashNodeMemorySize<
+									DissociationReactionMap::value_type>())
+			+ dissociationReactionMap.bucket_count() * sizeof(void*)
+			+ getVectorMemorySize(productionReactions)
+			+ getVectorMemorySize(dissociationReactions);
+	reactionMemory.set(bytes);
+
+	coefficientMemory.set(getCoefficientMemorySize());
+
 	return;
 }
 
@@ -9,6 +9,7 @@
 #include <Constants.h>
 #include "IReactionNetwork.h"
 #include "Reactant.h"
+#include "xolotlPerf/MemoryTracker.h"
 
 namespace xolotlPerf {
 class IHandlerRegistry;
@@ -139,6 +140,19 @@ protected:
 	std::unique_ptr<DissociationReaction> >;
 	DissociationReactionMap dissociationReactionMap;
 
+	/**
+	 * Flat lists of the reactions, in a fixed order, so that the threads
+	 * share the rate computation with a static schedule and always update
+	 * the rows they allocated.
+	 */
+	std::vector<ProductionReaction*> productionReactions;
+	std::vector<DissociationReaction*> dissociationReactions;
+
+	/**
+	 * Add the new reactions to the flat lists of reactions.
+	 */
+	void updateReactionLists();
+
 	/**
 	 * A map for storing the dfill configuration and accelerating the formation of
 	 * the Jacobian. Its keys are reactant/cluster ids and its values are integer
@@ -183,6 +197,36 @@ protected:
 	 */
 	bool dissociationsEnabled;
 
+	/**
+	 * The number of grid points of the rates and diffusion coefficients.
+	 */
+	int nRateGridPoints;
+
+	/**
+	 * The number of OpenMP threads of setTemperature() and
+	 * computeRateConstants(), 1 unless setNumThreads() asks for more.
+	 */
+	int nThreads;
+
+	/**
+	 * The memory reported for the clusters, the reactions, the
+	 * coefficients, and the values per grid point.
+	 */
+	xolotlPerf::TrackedMemory reactantMemory;
+	xolotlPerf::TrackedMemory reactionMemory;
+	xolotlPerf::TrackedMemory coefficientMemory;
+	xolotlPerf::TrackedMemory gridPointMemory;
+
+	/**
+	 * Get the memory used by the coefficients of the super clusters.
+	 * The networks without super cluster coefficients don't have any.
+	 *
+	 * @return The number of bytes
+	 */
+	virtual std::size_t getCoefficientMemorySize() const {
+		return 0;
+	}
+
 	/**
 	 * Maximum cluster sizes currently in the network for each
 	 * of the reactant types we support.
@@ -204,6 +248,49 @@ protected:
 	 */
 	std::unordered_map<ReactantType, ReactantMap> clusterTypeMap;
 
+	/**
+	 * The weight vectors of the totals: the three atoms, the three trapped
+	 * atoms, the vacancies and the interstitials. They are computed the
+	 * first time they are needed and cleared whenever the ids change.
+	 */
+	std::vector<WeightVector> totalWeights;
+
+	/**
+	 * Index of the vacancy and interstitial weights in totalWeights,
+	 * the trapped atoms start at 3.
+	 */
+	static constexpr int trappedWeightsIdx = 3;
+	static constexpr int vWeightsIdx = 6;
+	static constexpr int iWeightsIdx = 7;
+
+	/**
+	 * Fill the weight vectors of the totals, totalWeights already has the
+	 * right size and empty vectors.
+	 *
+	 * Leaves them empty here, the same as the totals returning 0.0, and
+	 * needs to be implemented by the daughter classes.
+	 */
+	virtual void computeTotalWeights() {
+		return;
+	}
+
+	/**
+	 * Get one of the weight vectors of the totals, computing them if needed.
+	 *
+	 * @param idx The index in totalWeights
+	 * @return The weight vector
+	 */
+	const WeightVector& getTotalWeights(int idx);
+
+	/**
+	 * Forget the weight vectors of the totals, they will be computed again
+	 * the next time they are needed. Has to be called when the ids or the
+	 * moment ids change.
+	 */
+	void resetTotalWeights() {
+		totalWeights.clear();
+	}
+
 	/**
 	 * Calculate the reaction constant dependent on the
 	 * reaction radii and the diffusion coefficients for the
@@ -574,6 +661,42 @@ public:
 		return 0.0;
 	}
 
+	/**
+	 * Get the weights giving the total concentration of atoms.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight vector
+	 */
+	const WeightVector& getTotalAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights giving the total concentration of atoms contained in
+	 * bubbles.
+	 *
+	 * @param i Index to switch between the different types of atoms
+	 * @return The weight vector
+	 */
+	const WeightVector& getTotalTrappedAtomWeights(int i = 0) override;
+
+	/**
+	 * Get the weights giving the total concentration of vacancies.
+	 *
+	 * @return The weight vector
+	 */
+	const WeightVector& getTotalVWeights() override {
+		return getTotalWeights(vWeightsIdx);
+	}
+
+	/**
+	 * Get the weights giving the total concentration of material
+	 * interstitials.
+	 *
+	 * @return The weight vector
+	 */
+	const WeightVector& getTotalIWeights() override {
+		return getTotalWeights(iWeightsIdx);
+	}
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations of the network.
 	 * Need to be called only when the temperature changes.
@@ -591,6 +714,47 @@ public:
 	 */
 	virtual void addGridPoints(int i) override;
 
+	/**
+	 * Set the number of OpenMP threads.
+	 * \see IReactionNetwork.h
+	 */
+	void setNumThreads(int n) override {
+		nThreads = std::max(n, 1);
+	}
+
+	/**
+	 * Get the number of grid points of the rates and diffusion coefficients.
+	 * \see IReactionNetwork.h
+	 */
+	int getNumberOfGridPoints() const override {
+		return nRateGridPoints;
+	}
+
+	/**
+	 * Get the number of OpenMP threads.
+	 * \see IReactionNetwork.h
+	 */
+	int getNumThreads() const override {
+		return nThreads;
+	}
+
+	/**
+	 * Get the most memory the rates and diffusion coefficients can use for
+	 * a given number of grid points, counting every cluster and the room
+	 * the vectors keep when they grow.
+	 *
+	 * @param nGridPoints The number of grid points
+	 * @return The number of bytes
+	 */
+	std::size_t getGridPointMemorySize(int nGridPoints) const override;
+
+	/**
+	 * Report the memory used by the clusters, the reactions, and the
+	 * coefficients of the super clusters to the memory tracker, replacing
+	 * what was reported before.
+	 */
+	void trackMemory() override;
+
 	/**
 	 * Compute the fluxes generated by all the reactions
 	 * for all the clusters and their momentum.
@@ -812,3 +812,13 @@ std::vector<int> AlloyCluster::getConnectivity() const {
 
 	return connectivity;
 }
+
+std::size_t AlloyCluster::getMemorySize() const {
+	using xolotlPerf::getVectorMemorySize;
+
+	return Reactant::getMemorySize() + sizeof(AlloyCluster) - sizeof(Reactant)
+			+ getVectorMemorySize(reactingPairs)
+			+ getVectorMemorySize(combiningReactants)
+			+ getVectorMemorySize(dissociatingPairs)
+			+ getVectorMemorySize(emissionPairs);
+}
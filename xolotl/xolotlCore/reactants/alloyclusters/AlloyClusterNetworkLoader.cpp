@@ -133,13 +133,10 @@ std::unique_ptr<IReactionNetwork> AlloyClusterNetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
+			auto comp = networkGroup->readCluster(i, formationEnergy,
 					migrationEnergy, diffusionFactor);
 			numV = comp[toCompIdx(Species::V)];
 			numI = comp[toCompIdx(Species::I)];
@@ -161,7 +158,8 @@ std::unique_ptr<IReactionNetwork> AlloyClusterNetworkLoader::load(
 			// Save it in the network
 			pushAlloyCluster(network, reactants, nextCluster);
 		} else {
-			// Super cluster
+			// Super cluster, only written in its own group
+			XFile::ClusterGroup clusterGroup(*networkGroup, i);
 			int nTot = 0, maxAtom = 0;
 			ReactantType type;
 			clusterGroup.readAlloySuperCluster(nTot, maxAtom, type);
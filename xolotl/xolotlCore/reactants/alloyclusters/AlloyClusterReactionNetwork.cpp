@@ -363,6 +363,9 @@ void AlloyClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids changed
+	resetTotalWeights();
+
 	return;
 }
 
@@ -1115,6 +1115,16 @@ std::vector<int> FeCluster::getConnectivity() const {
 	return connectivity;
 }
 
+std::size_t FeCluster::getMemorySize() const {
+	using xolotlPerf::getVectorMemorySize;
+
+	return Reactant::getMemorySize() + sizeof(FeCluster) - sizeof(Reactant)
+			+ getVectorMemorySize(reactingPairs)
+			+ getVectorMemorySize(combiningReactants)
+			+ getVectorMemorySize(dissociatingPairs)
+			+ getVectorMemorySize(emissionPairs);
+}
+
 void FeCluster::dumpCoefficients(std::ostream& os,
 		FeCluster::ClusterPair const& curr) const {
 
@@ -688,6 +688,14 @@ public:
 	 */
 	std::vector<int> getConnectivity() const override;
 
+	/**
+	 * Get the memory used by this cluster and the lists of reactions it
+	 * takes part in.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t getMemorySize() const override;
+
 	/**
 	 * Tell reactant to output a representation of its reaction coefficients
 	 * to the given output stream.
@@ -137,13 +137,10 @@ std::unique_ptr<IReactionNetwork> FeClusterNetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
+			auto comp = networkGroup->readCluster(i, formationEnergy,
 					migrationEnergy, diffusionFactor);
 			numHe = comp[toCompIdx(Species::He)];
 			numV = comp[toCompIdx(Species::V)];
@@ -165,7 +162,8 @@ std::unique_ptr<IReactionNetwork> FeClusterNetworkLoader::load(
 			// Give the cluster to the network
 			network->add(std::move(nextCluster));
 		} else {
-			// Super cluster
+			// Super cluster, only written in its own group
+			XFile::ClusterGroup clusterGroup(*networkGroup, i);
 			auto bounds = clusterGroup.readFeSuperCluster();
 
 			// Create the cluster
@@ -585,6 +585,9 @@ void FeClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids changed
+	resetTotalWeights();
+
 	return;
 }
 
@@ -837,6 +840,51 @@ double FeClusterReactionNetwork::getTotalIConcentration() {
 	return iConc;
 }
 
+void FeClusterReactionNetwork::computeTotalWeights() {
+	auto& heWeights = totalWeights[0];
+	auto& trappedWeights = totalWeights[trappedWeightsIdx];
+	auto& vWeights = totalWeights[vWeightsIdx];
+	auto& iWeights = totalWeights[iWeightsIdx];
+
+	// The single-species clusters
+	for (auto const& currMapItem : getAll(ReactantType::He)) {
+		auto const& cluster = *(currMapItem.second);
+		heWeights.emplace_back(cluster.getId() - 1, (double) cluster.getSize());
+	}
+	for (auto const& currMapItem : getAll(ReactantType::V)) {
+		auto const& cluster = *(currMapItem.second);
+		vWeights.emplace_back(cluster.getId() - 1, (double) cluster.getSize());
+	}
+	for (auto const& currMapItem : getAll(ReactantType::I)) {
+		auto const& cluster = *(currMapItem.second);
+		iWeights.emplace_back(cluster.getId() - 1, (double) cluster.getSize());
+	}
+
+	// The HeV clusters
+	for (auto const& currMapItem : getAll(ReactantType::HeV)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		trappedWeights.emplace_back(cluster.getId() - 1,
+				(double) comp[toCompIdx(Species::He)]);
+		vWeights.emplace_back(cluster.getId() - 1,
+				(double) comp[toCompIdx(Species::V)]);
+	}
+
+	// The super clusters
+	for (auto const& currMapItem : getAll(ReactantType::FeSuper)) {
+		auto const& cluster =
+				static_cast<FeSuperCluster&>(*(currMapItem.second));
+		cluster.addTotalAtomWeights(0, trappedWeights);
+		cluster.addTotalAtomWeights(1, vWeights);
+	}
+
+	// The total includes the trapped helium
+	heWeights.insert(heWeights.end(), trappedWeights.begin(),
+			trappedWeights.end());
+
+	return;
+}
+
 void FeClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int i) {
 
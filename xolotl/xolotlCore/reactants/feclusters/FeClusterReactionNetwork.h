@@ -197,6 +197,12 @@ private:
 	void checkForDissociation(IReactant& emittingReactant,
 			ProductionReaction& reaction, int a[4] = { }, int b[4] = { });
 
+	/**
+	 * Fill the weight vectors of the totals, the atoms being helium and only
+	 * using the index 0.
+	 */
+	void computeTotalWeights() override;
+
 public:
 
 	/**
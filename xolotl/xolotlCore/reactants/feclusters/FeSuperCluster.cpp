@@ -1240,6 +1240,26 @@ double FeSuperCluster::getTotalVacancyConcentration() const {
 	return conc;
 }
 
+void FeSuperCluster::addTotalAtomWeights(int axis,
+		IReactionNetwork::WeightVector& weights) const {
+	// The concentration is linear in the moments, so is the total
+	double zerothWeight = 0.0, heWeight = 0.0, vWeight = 0.0;
+	for (auto const& i : heBounds) {
+		for (auto const& j : vBounds) {
+			double size = (axis == 0) ? (double) i : (double) j;
+			zerothWeight += size;
+			heWeight += getHeDistance(i) * size;
+			vWeight += getVDistance(j) * size;
+		}
+	}
+
+	weights.emplace_back(id - 1, zerothWeight);
+	weights.emplace_back(momId[0] - 1, heWeight);
+	weights.emplace_back(momId[1] - 1, vWeight);
+
+	return;
+}
+
 void FeSuperCluster::resetConnectivities() {
 	// Clear both sets
 	reactionConnectivitySet.clear();
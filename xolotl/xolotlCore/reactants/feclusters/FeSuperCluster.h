@@ -571,6 +571,16 @@ public:
 	 */
 	double getTotalVacancyConcentration() const;
 
+	/**
+	 * This operation adds the weights of the moments of the group to a weight
+	 * vector giving its total concentration of helium or vacancies.
+	 *
+	 * @param axis 0 for helium, 1 for vacancies
+	 * @param weights The weight vector
+	 */
+	void addTotalAtomWeights(int axis,
+			IReactionNetwork::WeightVector& weights) const;
+
 	/**
 	 * This operation returns the distance to the mean.
 	 *
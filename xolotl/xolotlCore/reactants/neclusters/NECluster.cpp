@@ -757,3 +757,13 @@ std::vector<int> NECluster::getConnectivity() const {
 
 	return connectivity;
 }
+
+std::size_t NECluster::getMemorySize() const {
+	using xolotlPerf::getVectorMemorySize;
+
+	return Reactant::getMemorySize() + sizeof(NECluster) - sizeof(Reactant)
+			+ getVectorMemorySize(reactingPairs)
+			+ getVectorMemorySize(combiningReactants)
+			+ getVectorMemorySize(dissociatingPairs)
+			+ getVectorMemorySize(emissionPairs);
+}
@@ -548,6 +548,14 @@ public:
 	 */
 	std::vector<int> getConnectivity() const override;
 
+	/**
+	 * Get the memory used by this cluster and the lists of reactions it
+	 * takes part in.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t getMemorySize() const override;
+
 	/**
 	 * This operation returns the section width.
 	 *
@@ -130,13 +130,10 @@ std::unique_ptr<IReactionNetwork> NEClusterNetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
+			auto comp = networkGroup->readCluster(i, formationEnergy,
 					migrationEnergy, diffusionFactor);
 			numXe = comp[toCompIdx(Species::Xe)];
 
@@ -161,7 +158,8 @@ std::unique_ptr<IReactionNetwork> NEClusterNetworkLoader::load(
 			// Save it in the network
 			pushNECluster(network, reactants, nextCluster);
 		} else {
-			// Super cluster
+			// Super cluster, only written in its own group
+			XFile::ClusterGroup clusterGroup(*networkGroup, i);
 			int nTot = 0, maxXe = 0;
 			clusterGroup.readNESuperCluster(nTot, maxXe);
 
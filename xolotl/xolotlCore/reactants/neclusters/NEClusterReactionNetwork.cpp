@@ -198,6 +198,9 @@ void NEClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids changed
+	resetTotalWeights();
+
 	return;
 }
 
@@ -371,6 +374,25 @@ double NEClusterReactionNetwork::getTotalAtomConcentration(int i) {
 	return atomConc;
 }
 
+void NEClusterReactionNetwork::computeTotalWeights() {
+	auto& xeWeights = totalWeights[0];
+
+	// The xenon clusters
+	for (auto const& currMapItem : getAll(ReactantType::Xe)) {
+		auto const& cluster = *(currMapItem.second);
+		xeWeights.emplace_back(cluster.getId() - 1, (double) cluster.getSize());
+	}
+
+	// The super clusters
+	for (auto const& currMapItem : getAll(ReactantType::NESuper)) {
+		auto const& cluster =
+				static_cast<NESuperCluster&>(*(currMapItem.second));
+		cluster.addTotalXenonWeights(xeWeights);
+	}
+
+	return;
+}
+
 void NEClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int i) {
 
@@ -103,6 +103,12 @@ private:
 		return true;
 	}
 
+	/**
+	 * Fill the weight vectors of the totals, the atoms being xenon and only
+	 * using the index 0.
+	 */
+	void computeTotalWeights() override;
+
 public:
 
 	/**
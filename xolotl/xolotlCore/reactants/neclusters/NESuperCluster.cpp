@@ -433,6 +433,25 @@ double NESuperCluster::getTotalXenonConcentration() const {
 	return conc;
 }
 
+void NESuperCluster::addTotalXenonWeights(
+		IReactionNetwork::WeightVector& weights) const {
+	// The concentration is linear in the moments, so is the total
+	int index = 0;
+	double zerothWeight = 0.0, firstWeight = 0.0;
+	for (int k = 0; k < nTot; k++) {
+		// Compute the xenon index
+		index = (int) (numXe - (double) nTot / 2.0) + k + 1;
+
+		zerothWeight += (double) index;
+		firstWeight += getDistance(index) * (double) index;
+	}
+
+	weights.emplace_back(id - 1, zerothWeight);
+	weights.emplace_back(momId[0] - 1, firstWeight);
+
+	return;
+}
+
 double NESuperCluster::getDistance(int xe) const {
 	if (nTot == 1)
 		return 0.0;
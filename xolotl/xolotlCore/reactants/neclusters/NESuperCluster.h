@@ -297,6 +297,14 @@ public:
 	 */
 	double getTotalXenonConcentration() const;
 
+	/**
+	 * This operation adds the weights of the moments of the group to a weight
+	 * vector giving its total concentration of xenon.
+	 *
+	 * @param weights The weight vector
+	 */
+	void addTotalXenonWeights(IReactionNetwork::WeightVector& weights) const;
+
 	/**
 	 * This operation returns the distance to the mean.
 	 *
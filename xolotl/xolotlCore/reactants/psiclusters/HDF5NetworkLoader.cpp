@@ -3,28 +3,17 @@
 #include <limits>
 #include <algorithm>
 #include <vector>
+#include <sstream>
 #include "PSIClusterReactionNetwork.h"
+#include "PSISuperCluster.h"
+#include "ReactionLoader.h"
 #include <xolotlPerf.h>
 #include "xolotlCore/io/XFile.h"
 
 namespace xolotlCore {
 
-std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
+std::unique_ptr<PSIClusterReactionNetwork> HDF5NetworkLoader::createNetwork(
 		const IOptions& options) {
-	// Get the dataset from the HDF5 files
-	int normalSize = 0, superSize = 0;
-	XFile networkFile(fileName);
-	auto networkGroup = networkFile.getGroup<XFile::NetworkGroup>();
-	assert(networkGroup);
-	auto list = networkGroup->readNetworkSize(normalSize, superSize);
-
-	// Initialization
-	int numHe = 0, numV = 0, numI = 0, numD = 0, numT = 0;
-	double formationEnergy = 0.0, migrationEnergy = 0.0;
-	double diffusionFactor = 0.0;
-	std::vector<std::reference_wrapper<Reactant> > reactants;
-
-	// Prepare the network
 	std::unique_ptr<PSIClusterReactionNetwork> network(
 			new PSIClusterReactionNetwork(handlerRegistry));
 
@@ -46,15 +35,33 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	// Set the hydrogan radius factor
 	hydrogenRadiusFactor = options.getHydrogenFactor();
 
+	return network;
+}
+
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
+		const IOptions& options) {
+	// Get the dataset from the HDF5 files
+	int normalSize = 0, superSize = 0;
+	XFile networkFile(fileName);
+	auto networkGroup = networkFile.getGroup<XFile::NetworkGroup>();
+	assert(networkGroup);
+	auto list = networkGroup->readNetworkSize(normalSize, superSize);
+
+	// Initialization
+	int numHe = 0, numV = 0, numI = 0, numD = 0, numT = 0;
+	double formationEnergy = 0.0, migrationEnergy = 0.0;
+	double diffusionFactor = 0.0;
+	std::vector<std::reference_wrapper<Reactant> > reactants;
+
+	// Prepare the network
+	auto network = createNetwork(options);
+
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
+			auto comp = networkGroup->readCluster(i, formationEnergy,
 					migrationEnergy, diffusionFactor);
 			numHe = comp[toCompIdx(Species::He)];
 			numD = comp[toCompIdx(Species::D)];
@@ -76,7 +83,7 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 			pushPSICluster(network, reactants, nextCluster);
 		} else {
 			// Super cluster
-			auto list = clusterGroup.readPSISuperCluster();
+			auto list = networkGroup->readPSISuperCluster(i);
 
 			// Create the cluster
 			auto nextCluster = createPSISuperCluster(list, *network);
@@ -102,8 +109,11 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	// Give the information on the phase space to the network
 	network->setPhaseSpace(nDim, list);
 
-	// Set the reactions
-	networkGroup->readReactions(*network);
+	// Set the reactions, the oldest files don't have them
+	if (networkGroup->hasReactions())
+		networkGroup->readReactions(*network);
+	else
+		network->createReactionConnectivity();
 
 	// Recompute Ids and network size
 	network->reinitializeNetwork();
@@ -115,5 +125,175 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	return std::move(network);
 }
 
+std::vector<double> HDF5NetworkLoader::packNetwork(
+		IReactionNetwork& network) {
+	// Get the sizes information
+	int totalSize = network.size(), superSize = network.getSuperSize(),
+			normalSize = totalSize - superSize;
+
+	// Order the clusters by id, as in the HDF5 file
+	auto& allReactants = network.getAll();
+	std::vector<IReactant*> clusters(allReactants.size(), nullptr);
+	for (IReactant& currReactant : allReactants) {
+		clusters[currReactant.getId() - 1] = &currReactant;
+	}
+
+	// Start with the sizes and the phase space
+	std::vector<double> buffer;
+	buffer.push_back(normalSize);
+	buffer.push_back(superSize);
+	auto list = network.getPhaseSpaceList();
+	for (int i = 0; i < 5; i++)
+		buffer.push_back(list[i]);
+
+	// Add the definition of each cluster
+	for (int i = 0; i < totalSize; i++) {
+		auto& cluster = *(clusters[i]);
+		if (i < normalSize) {
+			// Normal cluster
+			auto& comp = cluster.getComposition();
+			buffer.push_back(comp.size());
+			buffer.insert(buffer.end(), comp.begin(), comp.end());
+			buffer.push_back(cluster.getFormationEnergy());
+			buffer.push_back(cluster.getMigrationEnergy());
+			buffer.push_back(cluster.getDiffusionFactor());
+		} else {
+			// Super cluster, save the coordinates of the clusters it contains
+			auto& superCluster = static_cast<PSISuperCluster&>(cluster);
+			auto& heVList = superCluster.getCoordList();
+			buffer.push_back(heVList.size());
+			for (auto const& pair : heVList) {
+				buffer.push_back(std::get<0>(pair));
+				buffer.push_back(std::get<1>(pair));
+				buffer.push_back(std::get<2>(pair));
+				buffer.push_back(std::get<3>(pair));
+			}
+		}
+	}
+
+	// Add the production, combination, dissociation, and emission
+	// reactions of each cluster
+	auto packReactions =
+			[&buffer](const std::vector<std::vector<double> >& reactVec) {
+				buffer.push_back(reactVec.size());
+				buffer.push_back(reactVec.size() > 0 ? reactVec[0].size() : 0);
+				for (auto const& row : reactVec) {
+					buffer.insert(buffer.end(), row.begin(), row.end());
+				}
+			};
+	for (int i = 0; i < totalSize; i++) {
+		auto& cluster = *(clusters[i]);
+		packReactions(cluster.getProdVector());
+		packReactions(cluster.getCombVector());
+		packReactions(cluster.getDissoVector());
+		packReactions(cluster.getEmitVector());
+	}
+
+	return buffer;
+}
+
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::unpackNetwork(
+		const IOptions& options, double* buffer) {
+	// Read the sizes and the phase space
+	std::size_t pos = 0;
+	int normalSize = buffer[pos++];
+	int superSize = buffer[pos++];
+	Array<int, 5> list;
+	for (int i = 0; i < 5; i++)
+		list[i] = buffer[pos++];
+
+	// Prepare the network
+	auto network = createNetwork(options);
+	std::vector<std::reference_wrapper<Reactant> > reactants;
+
+	// Loop on the clusters
+	for (int i = 0; i < normalSize + superSize; i++) {
+		if (i < normalSize) {
+			// Normal cluster
+			int compSize = buffer[pos++];
+			std::vector<int> comp(buffer + pos, buffer + pos + compSize);
+			pos += compSize;
+
+			// Create the cluster
+			auto nextCluster = createPSICluster(comp[toCompIdx(Species::He)],
+					comp[toCompIdx(Species::D)], comp[toCompIdx(Species::T)],
+					comp[toCompIdx(Species::V)], comp[toCompIdx(Species::I)],
+					*network);
+
+			// Set the energies and the diffusion factor
+			nextCluster->setFormationEnergy(buffer[pos++]);
+			nextCluster->setMigrationEnergy(buffer[pos++]);
+			nextCluster->setDiffusionFactor(buffer[pos++]);
+
+			// Save it in the network
+			pushPSICluster(network, reactants, nextCluster);
+		} else {
+			// Super cluster
+			int nTot = buffer[pos++];
+			std::set<std::tuple<int, int, int, int> > heVList;
+			for (int j = 0; j < nTot; j++, pos += 4) {
+				heVList.emplace(buffer[pos], buffer[pos + 1], buffer[pos + 2],
+						buffer[pos + 3]);
+			}
+
+			// Create the cluster
+			auto nextCluster = createPSISuperCluster(heVList, *network);
+
+			// Save it in the network
+			pushPSICluster(network, reactants, nextCluster);
+		}
+	}
+
+	// Ask reactants to update now that they are in network.
+	for (IReactant& currReactant : reactants) {
+		currReactant.updateFromNetwork();
+	}
+
+	// Define the phase space for the network
+	int nDim = 1;
+	// Loop on the list for the phase space
+	for (int i = 1; i < 5; i++)
+		if (list[i] > 0)
+			nDim++;
+	network->setPhaseSpace(nDim, list);
+
+	// Set the reactions the same way they are read from the HDF5 file:
+	// for each cluster and each type of reaction, the number of reactions
+	// and the size of a row, then the rows
+	for (IReactant& cluster : reactants) {
+		for (int k = 0; k < reactionAdders.size(); k++) {
+			int nReact = buffer[pos++], dataSize = buffer[pos++];
+			for (int i = 0; i < nReact; i++, pos += dataSize) {
+				reactionAdders[k](*network, cluster, &(buffer[pos]));
+			}
+		}
+	}
+
+	// Recompute Ids and network size
+	network->reinitializeNetwork();
+
+	return std::move(network);
+}
+
+std::string HDF5NetworkLoader::describeNetwork(
+		const IOptions& options) const {
+	std::ostringstream desc;
+	// The version of the packed layout
+	desc << "PSI packed network 1";
+	// The network parameters
+	desc << " netParam " << options.getMaxImpurity() << " "
+			<< options.getMaxD() << " " << options.getMaxT() << " "
+			<< options.getMaxV() << " " << options.getMaxI() << " "
+			<< options.usePhaseCut();
+	// The grouping
+	desc << " grouping " << vMin;
+	for (int i = 0; i < 4; i++)
+		desc << " " << sectionWidth[i];
+	// The reactions
+	desc << " dummy " << dummyReactions;
+
+	return desc.str();
+}
+
 } // namespace xolotlCore
 
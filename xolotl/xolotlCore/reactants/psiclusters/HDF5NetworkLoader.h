@@ -19,6 +19,15 @@ private:
 	HDF5NetworkLoader() {
 	}
 
+	/**
+	 * Create an empty network and set the parameters given by the options.
+	 *
+	 * @param options The options.
+	 * @return The empty network.
+	 */
+	std::unique_ptr<PSIClusterReactionNetwork> createNetwork(
+			const IOptions& options);
+
 public:
 
 	/**
@@ -43,6 +52,48 @@ public:
 	 */
 	std::unique_ptr<IReactionNetwork> load(const IOptions& options) override;
 
+	/**
+	 * This operation packs a finalized network in a flat buffer, following
+	 * the layout of the network group in the HDF5 files: the sizes and phase
+	 * space, the definition of each cluster, and the reaction coefficients
+	 * of each cluster. Integers are stored as doubles.
+	 *
+	 * @param network The network to pack.
+	 * @return The buffer.
+	 */
+	static std::vector<double> packNetwork(IReactionNetwork& network);
+
+	/**
+	 * This operation rebuilds the reaction network from a buffer created
+	 * by packNetwork(), without redoing the grouping or the connectivity.
+	 *
+	 * @param options The options.
+	 * @param buffer The first value of the buffer, the coefficients are
+	 * copied by the clusters so it doesn't need to outlive the network.
+	 * @return The reaction network.
+	 */
+	std::unique_ptr<IReactionNetwork> unpackNetwork(const IOptions& options,
+			double* buffer);
+
+	/**
+	 * \see unpackNetwork(const IOptions&, double*)
+	 */
+	std::unique_ptr<IReactionNetwork> unpackNetwork(const IOptions& options,
+			std::vector<double>& buffer) {
+		return unpackNetwork(options, buffer.data());
+	}
+
+	/**
+	 * This operation describes everything that defines the network
+	 * generate() builds: the network parameters, the grouping and
+	 * whether the reactions are dummy. Two runs with the same description
+	 * get the same packed network.
+	 *
+	 * @param options The options.
+	 * @return The description.
+	 */
+	std::string describeNetwork(const IOptions& options) const;
+
 };
 
 } /* namespace xolotlCore */
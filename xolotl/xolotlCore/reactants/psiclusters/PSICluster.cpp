@@ -1153,6 +1153,16 @@ std::vector<int> PSICluster::getConnectivity() const {
 	return connectivity;
 }
 
+std::size_t PSICluster::getMemorySize() const {
+	using xolotlPerf::getVectorMemorySize;
+
+	return Reactant::getMemorySize() + sizeof(PSICluster) - sizeof(Reactant)
+			+ getVectorMemorySize(reactingPairs)
+			+ getVectorMemorySize(combiningReactants)
+			+ getVectorMemorySize(dissociatingPairs)
+			+ getVectorMemorySize(emissionPairs);
+}
+
 void PSICluster::dumpCoefficients(std::ostream& os,
 		PSICluster::ClusterPair const& curr) const {
 
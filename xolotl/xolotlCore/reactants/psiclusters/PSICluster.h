@@ -705,6 +705,14 @@ public:
 	 */
 	std::vector<int> getConnectivity() const override;
 
+	/**
+	 * Get the memory used by this cluster and the lists of reactions it
+	 * takes part in.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t getMemorySize() const override;
+
 	/**
 	 * Set the phase space to save time and memory
 	 *
@@ -9,8 +9,9 @@
 
 namespace xolotlCore {
 
-// Timer
+// Timers
 std::shared_ptr<xolotlPerf::ITimer> setTempTimer;
+std::shared_ptr<xolotlPerf::ITimer> connectivityTimer;
 
 PSIClusterReactionNetwork::PSIClusterReactionNetwork(
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
@@ -21,12 +22,108 @@ PSIClusterReactionNetwork::PSIClusterReactionNetwork(
 	// Initialize default properties
 	dissociationsEnabled = true;
 
-	// Get the timer
+	// Get the timers
 	setTempTimer = handlerRegistry->getTimer("setTemperature");
+	connectivityTimer = handlerRegistry->getTimer("loadNetwork:connectivity");
 
 	return;
 }
 
+PSIClusterReactionNetwork::~PSIClusterReactionNetwork() {
+	// Free the shared memory window if MPI is still around
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	if (coefWindow != MPI_WIN_NULL && !finalized)
+		MPI_Win_free(&coefWindow);
+}
+
+void PSIClusterReactionNetwork::shareCoefficients() {
+	// Get the processes sharing memory with this one
+	MPI_Comm nodeComm;
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+			MPI_INFO_NULL, &nodeComm);
+	int nodeRank, nodeSize;
+	MPI_Comm_rank(nodeComm, &nodeRank);
+	MPI_Comm_size(nodeComm, &nodeSize);
+
+	// Get the super clusters in a deterministic order
+	std::vector<PSISuperCluster*> superClusters;
+	for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
+		superClusters.push_back(
+				static_cast<PSISuperCluster*>(superMapItem.second.get()));
+	}
+	std::sort(superClusters.begin(), superClusters.end(),
+			[](PSISuperCluster* a, PSISuperCluster* b) {
+				return a->getId() < b->getId();
+			});
+
+	// Count the coefficients
+	unsigned long nCoefs = 0;
+	for (auto superCluster : superClusters)
+		nCoefs += superCluster->getNCoefficients();
+
+	// Every process must have the same network
+	unsigned long minCoefs = 0, maxCoefs = 0;
+	MPI_Allreduce(&nCoefs, &minCoefs, 1, MPI_UNSIGNED_LONG, MPI_MIN, nodeComm);
+	MPI_Allreduce(&nCoefs, &maxCoefs, 1, MPI_UNSIGNED_LONG, MPI_MAX, nodeComm);
+	if (minCoefs != maxCoefs) {
+		MPI_Comm_free(&nodeComm);
+		throw std::string(
+				"\nPSIClusterReactionNetwork Exception: the processes of a "
+						"node do not have the same network, the coefficients "
+						"can't be shared.");
+	}
+
+	// Nothing to gain if the process is alone on its node
+	if (nodeSize == 1 || nCoefs == 0 || coefWindow != MPI_WIN_NULL) {
+		MPI_Comm_free(&nodeComm);
+		return;
+	}
+
+	// The first process of the node allocates the whole segment
+	double *pool = nullptr;
+	MPI_Aint windowSize = (nodeRank == 0) ? nCoefs * sizeof(double) : 0;
+	sharedCoefficientBytes = windowSize;
+	MPI_Win_allocate_shared(windowSize, sizeof(double), MPI_INFO_NULL,
+			nodeComm, &pool, &coefWindow);
+	int dispUnit = 0;
+	MPI_Win_shared_query(coefWindow, 0, &windowSize, &dispUnit, &pool);
+
+	// It fills it with its coefficients
+	MPI_Win_fence(0, coefWindow);
+	if (nodeRank == 0) {
+		double *current = pool;
+		for (auto superCluster : superClusters)
+			superCluster->shareCoefficients(current, true);
+	}
+	MPI_Win_fence(0, coefWindow);
+
+	// The other ones release their own copy
+	if (nodeRank != 0) {
+		double *current = pool;
+		for (auto superCluster : superClusters)
+			superCluster->shareCoefficients(current, false);
+	}
+
+	MPI_Comm_free(&nodeComm);
+
+	// The copies were released
+	trackMemory();
+
+	return;
+}
+
+std::size_t PSIClusterReactionNetwork::getCoefficientMemorySize() const {
+	std::size_t bytes = sharedCoefficientBytes;
+	for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
+		auto const& superCluster =
+				static_cast<PSISuperCluster&>(*(superMapItem.second));
+		bytes += superCluster.getCoefficientMemorySize();
+	}
+
+	return bytes;
+}
+
 double PSIClusterReactionNetwork::calculateDissociationConstant(
 		const DissociationReaction& reaction, int i) {
 
@@ -171,7 +268,92 @@ void PSIClusterReactionNetwork::defineAnaDissociationReactions(
 	emitting.emitFrom(drref, emitting);
 }
 
+std::vector<std::vector<PSIClusterReactionNetwork::PendingSuperProduction> > PSIClusterReactionNetwork::findSuperProductions(
+		IReactant& reactant, const int shift[4]) {
+	// Get the super clusters in the order of the map so that the
+	// reactions can be defined in the same order as a serial loop
+	std::vector<PSISuperCluster*> superClusters;
+	for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
+		superClusters.push_back(
+				&static_cast<PSISuperCluster&>(*(superMapItem.second)));
+	}
+
+	// Each reacting super cluster gets its own list
+	std::vector<std::vector<PendingSuperProduction> > pendingLists(
+			superClusters.size());
+	auto& cluster = static_cast<PSICluster&>(reactant);
+	bool reactantDiffuses = reactant.getDiffusionFactor() > 0.0;
+
+	// Only const methods are called on the clusters in this loop
+#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < (int) superClusters.size(); i++) {
+		auto& superCluster = *(superClusters[i]);
+		auto& pending = pendingLists[i];
+
+		// Loop on the potential products
+		for (auto superProdPtr : superClusters) {
+			auto& superProd = *superProdPtr;
+
+			// Skip if the reactions don't overlap
+			if (!checkOverlap(cluster, superCluster, superProd))
+				continue;
+
+			// Check if the super clusters are full
+			if (superCluster.isFull() && superProd.isFull()) {
+				pending.push_back( { &superCluster, &superProd, true, { } });
+				continue;
+			}
+
+			std::vector<PendingProductionReactionInfo> prInfos;
+
+			// Loop on the coordinates of the reactant
+			for (auto const& pair : superCluster.getCoordList()) {
+				// Assume the product can only be a super cluster here
+				int newNumHe = std::get<0>(pair) + shift[0];
+				int newNumD = std::get<1>(pair) + shift[1];
+				int newNumT = std::get<2>(pair) + shift[2];
+				int newNumV = std::get<3>(pair) + shift[3];
+				if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
+						&& (reactantDiffuses
+								|| superCluster.getDiffusionFactor() > 0.0)) {
+					// Note that current reactant reacts with
+					// current superCluster to produce product,
+					// according to current parameters.
+					int a[4] = { newNumHe, newNumD, newNumT, newNumV };
+					int b[4] = { std::get<0>(pair), std::get<1>(pair),
+							std::get<2>(pair), std::get<3>(pair) };
+					prInfos.emplace_back(superProd, a, b);
+				}
+			}
+
+			if (prInfos.size() > 0)
+				pending.push_back(
+						{ &superCluster, &superProd, false, std::move(prInfos) });
+		}
+	}
+
+	return pendingLists;
+}
+
+void PSIClusterReactionNetwork::defineSuperProductions(IReactant& reactant,
+		std::vector<PendingSuperProduction>& pending) {
+	for (auto& currPending : pending) {
+		if (currPending.full) {
+			// This method will check if the reaction is possible and then add it to the list
+			defineAnaProductionReactions(reactant, *(currPending.reactant),
+					*(currPending.product));
+		} else {
+			// Create the production reaction(s) for them.
+			defineProductionReactions(reactant, *(currPending.reactant),
+					currPending.prInfos);
+		}
+	}
+}
+
 void PSIClusterReactionNetwork::createReactionConnectivity() {
+	// Time the whole connectivity construction
+	xolotlPerf::ScopedTimer myTimer(connectivityTimer);
+
 	// Initial declarations
 	IReactant::SizeType firstSize = 0, secondSize = 0, productSize = 0, maxI =
 			getAll(ReactantType::I).size();
@@ -267,61 +449,12 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 			}
 		}
 
-		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& heCluster = static_cast<PSICluster&>(heReactant);
-				bool overlap = checkOverlap(heCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(heReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair) + firstSize;
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair);
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (heReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(heReactant, superCluster,
-								prInfos);
-				}
-			}
+		// Consider product with each super cluster, the search is threaded
+		// and the reactions are then defined in the serial order
+		int shift[4] = { (int) firstSize, 0, 0, 0 };
+		auto pendingSuper = findSuperProductions(heReactant, shift);
+		for (auto& pending : pendingSuper) {
+			defineSuperProductions(heReactant, pending);
 		}
 	}
 
@@ -372,60 +505,12 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 			}
 		}
 
-		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& vCluster = static_cast<PSICluster&>(vReactant);
-				bool overlap = checkOverlap(vCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(vReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair) + firstSize;
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (vReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(vReactant, superCluster,
-								prInfos);
-				}
-			}
+		// Consider product with each super cluster, the search is threaded
+		// and the reactions are then defined in the serial order
+		int shift[4] = { 0, 0, 0, (int) firstSize };
+		auto pendingSuper = findSuperProductions(vReactant, shift);
+		for (auto& pending : pendingSuper) {
+			defineSuperProductions(vReactant, pending);
 		}
 	}
 
@@ -524,61 +609,21 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 			}
 		}
 
+		// Find the reactions producing super clusters, the search is threaded
+		// and the reactions are then defined in the serial order
+		int shift[4] = { 0, 0, 0, -(int) firstSize };
+		auto pendingSuper = findSuperProductions(iReactant, shift);
+		int superIdx = 0;
+
 		// Consider product with all super clusters.
 		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
 			auto& superCluster =
 					static_cast<PSISuperCluster&>(*(superMapItem.second));
 			std::vector<PendingProductionReactionInfo> prInfos;
-			// Loop on the potential super products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& iCluster = static_cast<PSICluster&>(iReactant);
-				bool overlap = checkOverlap(iCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
 
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(iReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair) - firstSize;
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (iReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(iReactant, superCluster,
-								prInfos);
-				}
-			}
+			// Define the reactions producing super clusters
+			defineSuperProductions(iReactant, pendingSuper[superIdx]);
+			superIdx++;
 
 			// Get the coordinates of the reactant and loop on them
 			auto coords = superCluster.getCoordList();
@@ -928,60 +973,12 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 			}
 		}
 
-		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& dCluster = static_cast<PSICluster&>(dReactant);
-				bool overlap = checkOverlap(dCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(dReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair) + firstSize;
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair);
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (dReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(dReactant, superCluster,
-								prInfos);
-				}
-			}
+		// Consider product with each super cluster, the search is threaded
+		// and the reactions are then defined in the serial order
+		int shift[4] = { 0, (int) firstSize, 0, 0 };
+		auto pendingSuper = findSuperProductions(dReactant, shift);
+		for (auto& pending : pendingSuper) {
+			defineSuperProductions(dReactant, pending);
 		}
 	}
 
@@ -1029,60 +1026,12 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 			}
 		}
 
-		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& tCluster = static_cast<PSICluster&>(tReactant);
-				bool overlap = checkOverlap(tCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(tReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair) + firstSize;
-						int newNumV = std::get<3>(pair);
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (tReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(tReactant, superCluster,
-								prInfos);
-				}
-			}
+		// Consider product with each super cluster, the search is threaded
+		// and the reactions are then defined in the serial order
+		int shift[4] = { 0, 0, (int) firstSize, 0 };
+		auto pendingSuper = findSuperProductions(tReactant, shift);
+		for (auto& pending : pendingSuper) {
+			defineSuperProductions(tReactant, pending);
 		}
 	}
 
@@ -1419,6 +1368,9 @@ void PSIClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids changed
+	resetTotalWeights();
+
 	return;
 }
 
@@ -1717,6 +1669,73 @@ double PSIClusterReactionNetwork::getTotalIConcentration() {
 	return iConc;
 }
 
+void PSIClusterReactionNetwork::computeTotalWeights() {
+	// The atom types, in the order of getTotalAtomConcentration()
+	ReactantType atomTypes[3] = { ReactantType::He, ReactantType::D,
+			ReactantType::T };
+
+	// Loop on the atoms
+	for (int i = 0; i < 3; i++) {
+		auto& atomWeights = totalWeights[i];
+		auto& trappedWeights = totalWeights[trappedWeightsIdx + i];
+		auto compIdx = toCompIdx(toSpecies(atomTypes[i]));
+
+		// All the single-species clusters
+		for (auto const& currMapItem : getAll(atomTypes[i])) {
+			auto const& cluster = *(currMapItem.second);
+			atomWeights.emplace_back(cluster.getId() - 1,
+					(double) cluster.getSize());
+		}
+
+		// All the Mixed clusters, they are trapped
+		for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+			auto const& cluster = *(currMapItem.second);
+			auto& comp = cluster.getComposition();
+			if (comp[compIdx] > 0)
+				trappedWeights.emplace_back(cluster.getId() - 1,
+						(double) comp[compIdx]);
+		}
+
+		// All the super clusters, they are trapped too
+		for (auto const& currMapItem : getAll(ReactantType::PSISuper)) {
+			auto const& cluster =
+					static_cast<PSISuperCluster&>(*(currMapItem.second));
+			cluster.addTotalAtomWeights(i, trappedWeights);
+		}
+
+		// The total includes the trapped atoms
+		atomWeights.insert(atomWeights.end(), trappedWeights.begin(),
+				trappedWeights.end());
+	}
+
+	// The vacancies
+	auto& vWeights = totalWeights[vWeightsIdx];
+	for (auto const& currMapItem : getAll(ReactantType::V)) {
+		auto const& cluster = *(currMapItem.second);
+		vWeights.emplace_back(cluster.getId() - 1, (double) cluster.getSize());
+	}
+	for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		vWeights.emplace_back(cluster.getId() - 1,
+				(double) comp[toCompIdx(Species::V)]);
+	}
+	for (auto const& currMapItem : getAll(ReactantType::PSISuper)) {
+		auto const& cluster =
+				static_cast<PSISuperCluster&>(*(currMapItem.second));
+		cluster.addTotalAtomWeights(3, vWeights);
+	}
+
+	// The interstitials
+	auto& iWeights = totalWeights[iWeightsIdx];
+	for (auto const& currMapItem : getAll(ReactantType::I)) {
+		auto const& cluster = *(currMapItem.second);
+		iWeights.emplace_back(cluster.getId() - 1, (double) cluster.getSize());
+	}
+
+	return;
+}
+
 void PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int xi) {
 
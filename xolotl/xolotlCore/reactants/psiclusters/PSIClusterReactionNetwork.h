@@ -10,6 +10,7 @@
 #include <map>
 #include <unordered_map>
 #include <algorithm>
+#include <mpi.h>
 #include "ReactionNetwork.h"
 #include "PSISuperCluster.h"
 #include "ReactantType.h"
@@ -60,6 +61,20 @@ private:
 	//! The indexList.
 	Array<int, 5> indexList;
 
+	//! The shared memory window holding the super cluster coefficients
+	MPI_Win coefWindow = MPI_WIN_NULL;
+
+	//! The size of the part of the shared window this process allocated
+	std::size_t sharedCoefficientBytes = 0;
+
+	/**
+	 * Get the memory used by the coefficients of the super clusters, with
+	 * the part of the shared window this process allocated.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t getCoefficientMemorySize() const override;
+
 	/**
 	 * Calculate the dissociation constant of the first cluster with respect to
 	 * the single-species cluster of the same type based on the current clusters
@@ -98,6 +113,43 @@ private:
 			IReactant::SizeType nD, IReactant::SizeType nT,
 			IReactant::SizeType nV) const override;
 
+	/**
+	 * A production reaction between a reactant and a super cluster,
+	 * producing another super cluster, found before being defined.
+	 */
+	struct PendingSuperProduction {
+		//! The reacting super cluster
+		PSISuperCluster* reactant;
+		//! The product super cluster
+		PSISuperCluster* product;
+		//! If both super clusters are full
+		bool full;
+		//! The reactions to define if they are not full
+		std::vector<PendingProductionReactionInfo> prInfos;
+	};
+
+	/**
+	 * Find the production reactions of the given reactant with every super
+	 * cluster that produce another super cluster. The reacting super clusters
+	 * are shared between the threads, each one filling its own list.
+	 *
+	 * @param reactant The reactant
+	 * @param shift The change in composition (He, D, T, V) due to the reactant
+	 * @return The lists of pending reactions, one for each super cluster in
+	 * the order of getAll(ReactantType::PSISuper)
+	 */
+	std::vector<std::vector<PendingSuperProduction> > findSuperProductions(
+			IReactant& reactant, const int shift[4]);
+
+	/**
+	 * Define the pending production reactions in the order they were found.
+	 *
+	 * @param reactant The reactant
+	 * @param pending The pending reactions for one super cluster
+	 */
+	void defineSuperProductions(IReactant& reactant,
+			std::vector<PendingSuperProduction>& pending);
+
 	ProductionReaction& defineReactionBase(IReactant& r1, IReactant& r2,
 			int a[4] = defaultInit, bool secondProduct = false)
 					__attribute__((always_inline)) {
@@ -346,6 +398,12 @@ private:
 		return iSizeToReturn;
 	}
 
+	/**
+	 * Fill the weight vectors of the totals from the single-species, mixed
+	 * and super clusters.
+	 */
+	void computeTotalWeights() override;
+
 public:
 
 	/**
@@ -366,11 +424,26 @@ public:
 	 */
 	PSIClusterReactionNetwork(const PSIClusterReactionNetwork& other) = delete;
 
+	/**
+	 * The destructor, frees the shared memory window.
+	 */
+	~PSIClusterReactionNetwork();
+
 	/**
 	 * Computes the full reaction connectivity matrix for this network.
 	 */
 	void createReactionConnectivity();
 
+	/**
+	 * Moves the coefficients of the super clusters to a memory segment
+	 * shared by the processes of the same node, so that each node holds
+	 * them only once. Every process must have built the same network and
+	 * the reactions must not change afterwards.
+	 *
+	 * This method blocks until it is called by all processes.
+	 */
+	void shareCoefficients();
+
 	/**
 	 * This operation sets the temperature at which the reactants currently
 	 * exists. It calls setTemperature() on each reactant.
@@ -524,6 +597,9 @@ public:
 					auto& currCluster = static_cast<PSICluster&>(currReactant);
 					currCluster.setPhaseSpace(dim, list);
 				});
+
+		// The moments used by the totals changed
+		resetTotalWeights();
 	}
 
 	/**
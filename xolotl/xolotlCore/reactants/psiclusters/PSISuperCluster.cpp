@@ -1053,6 +1053,36 @@ double PSISuperCluster::getTotalVacancyConcentration() const {
 	return getTotalAtomConcHelper<3>();
 }
 
+void PSISuperCluster::addTotalAtomWeights(int axis,
+		IReactionNetwork::WeightVector& weights) const {
+	// The concentration is linear in the moments, so is the total
+	double zerothWeight = 0.0;
+	double firstWeights[4] = { };
+	for (auto const& pair : heVList) {
+		int comp[4] = { std::get<0>(pair), std::get<1>(pair), std::get<2>(
+				pair), std::get<3>(pair) };
+		zerothWeight += (double) comp[axis];
+
+		// Loop on the used moments
+		for (int i = 1; i < psDim; i++) {
+			int momAxis = indexList[i] - 1;
+			firstWeights[momAxis] += getDistance(comp[momAxis], momAxis)
+					* (double) comp[axis];
+		}
+	}
+
+	// Skip the null weights
+	if (zerothWeight != 0.0)
+		weights.emplace_back(id - 1, zerothWeight);
+	for (int i = 1; i < psDim; i++) {
+		int momAxis = indexList[i] - 1;
+		if (firstWeights[momAxis] != 0.0)
+			weights.emplace_back(momId[momAxis] - 1, firstWeights[momAxis]);
+	}
+
+	return;
+}
+
 double PSISuperCluster::getIntegratedVConcentration(int v) const {
 	// Initial declarations
 	double heDistance = 0.0, dDistance = 0.0, tDistance = 0.0, vDistance = 0.0,
@@ -1077,6 +1107,30 @@ double PSISuperCluster::getIntegratedVConcentration(int v) const {
 	return conc;
 }
 
+std::size_t PSISuperCluster::getMemorySize() const {
+	using xolotlPerf::getHashNodeMemorySize;
+	using xolotlPerf::getTreeNodeMemorySize;
+	using xolotlPerf::getVectorMemorySize;
+
+	return PSICluster::getMemorySize() + sizeof(PSISuperCluster)
+			- sizeof(PSICluster)
+			+ heVList.size() * getTreeNodeMemorySize<HeVListType::value_type>()
+			+ getVectorMemorySize(effReactingList)
+			+ effReactingListMap.size()
+					* getHashNodeMemorySize<ProductionPairListMap::value_type>()
+			+ getVectorMemorySize(effCombiningList)
+			+ effCombiningListMap.size()
+					* getHashNodeMemorySize<CombiningClusterListMap::value_type>()
+			+ getVectorMemorySize(effDissociatingList)
+			+ effDissociatingListMap.size()
+					* getHashNodeMemorySize<
+							DissociationPairListMap::value_type>()
+			+ getVectorMemorySize(effEmissionList)
+			+ effEmissionListMap.size()
+					* getHashNodeMemorySize<
+							DissociationPairListMap::value_type>();
+}
+
 void PSISuperCluster::resetConnectivities() {
 	// Clear both sets
 	reactionConnectivitySet.clear();
@@ -1603,6 +1657,73 @@ std::vector<std::vector<double> > PSISuperCluster::getEmitVector() const {
 	return toReturn;
 }
 
+std::size_t PSISuperCluster::getNCoefficients() const {
+	// Initial declarations
+	std::size_t nCoefs = 0;
+
+	// The production coefficients are dim^3 arrays
+	for (auto const& currPair : effReactingList)
+		nCoefs += currPair.dim * currPair.dim * currPair.dim;
+	for (auto const& currComb : effCombiningList)
+		nCoefs += currComb.dim * currComb.dim * currComb.dim;
+	// The dissociation coefficients are dim^2 arrays
+	for (auto const& currPair : effDissociatingList)
+		nCoefs += currPair.dim * currPair.dim;
+	for (auto const& currPair : effEmissionList)
+		nCoefs += currPair.dim * currPair.dim;
+
+	return nCoefs;
+}
+
+std::size_t PSISuperCluster::getCoefficientMemorySize() const {
+	// Initial declarations
+	std::size_t bytes = 0;
+
+	// The production coefficients are dim^3 arrays reached through dim^2
+	// pointers, only the arrays can be shared
+	for (auto const& currPair : effReactingList) {
+		int dim = currPair.dim;
+		bytes += dim * (dim + 1) * sizeof(double*);
+		if (!currPair.shared)
+			bytes += dim * dim * dim * sizeof(double);
+	}
+	for (auto const& currComb : effCombiningList) {
+		int dim = currComb.dim;
+		bytes += dim * (dim + 1) * sizeof(double*);
+		if (!currComb.shared)
+			bytes += dim * dim * dim * sizeof(double);
+	}
+	// The dissociation coefficients are dim^2 arrays
+	for (auto const& currPair : effDissociatingList) {
+		int dim = currPair.dim;
+		bytes += dim * sizeof(double*);
+		if (!currPair.shared)
+			bytes += dim * dim * sizeof(double);
+	}
+	for (auto const& currPair : effEmissionList) {
+		int dim = currPair.dim;
+		bytes += dim * sizeof(double*);
+		if (!currPair.shared)
+			bytes += dim * dim * sizeof(double);
+	}
+
+	return bytes;
+}
+
+void PSISuperCluster::shareCoefficients(double*& pool, bool copy) {
+	// Same order as getNCoefficients()
+	for (auto& currPair : effReactingList)
+		currPair.share(pool, copy);
+	for (auto& currComb : effCombiningList)
+		currComb.share(pool, copy);
+	for (auto& currPair : effDissociatingList)
+		currPair.share(pool, copy);
+	for (auto& currPair : effEmissionList)
+		currPair.share(pool, copy);
+
+	return;
+}
+
 void PSISuperCluster::dumpCoefficients(std::ostream& os,
 		PSISuperCluster::ProductionCoefficientBase const& curr) const {
 
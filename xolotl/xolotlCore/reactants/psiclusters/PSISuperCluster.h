@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 #include <cassert>
+#include <algorithm>
 #include <Constants.h>
 #include "PSICluster.h"
 #include "ReactionNetwork.h"
@@ -101,6 +102,9 @@ protected:
 		double ***coefs;
 		const int dim;
 
+		//! True if the innermost arrays live in a shared memory segment
+		bool shared = false;
+
 		//! The constructor, disallowed
 		ProductionCoefficientBase() = delete;
 
@@ -144,12 +148,33 @@ protected:
 		~ProductionCoefficientBase() {
 			for (int i = 0; i < dim; i++) {
 				for (int j = 0; j < dim; j++) {
-					delete[] coefs[i][j];
+					if (!shared)
+						delete[] coefs[i][j];
 				}
 				delete[] coefs[i];
 			}
 			delete[] coefs;
 		}
+
+		/**
+		 * Move the coefficients to memory shared with other processes.
+		 *
+		 * @param pool Where to put the coefficients, moved past them on return
+		 * @param copy Whether to copy our coefficients there
+		 */
+		void share(double*& pool, bool copy) {
+			for (int i = 0; i < dim; i++) {
+				for (int j = 0; j < dim; j++) {
+					if (copy)
+						std::copy(coefs[i][j], coefs[i][j] + dim, pool);
+					if (!shared)
+						delete[] coefs[i][j];
+					coefs[i][j] = pool;
+					pool += dim;
+				}
+			}
+			shared = true;
+		}
 	};
 
 	/**
@@ -257,6 +282,9 @@ protected:
 		double **coefs;
 		const int dim;
 
+		//! True if the innermost arrays live in a shared memory segment
+		bool shared = false;
+
 		//! The constructor
 		SuperClusterDissociationPair(Reaction& _reaction, PSICluster& _first,
 				PSICluster& _second, int _dim) :
@@ -295,10 +323,29 @@ protected:
 		//! The destructor
 		~SuperClusterDissociationPair() {
 			for (int i = 0; i < dim; i++) {
-				delete[] coefs[i];
+				if (!shared)
+					delete[] coefs[i];
 			}
 			delete[] coefs;
 		}
+
+		/**
+		 * Move the coefficients to memory shared with other processes.
+		 *
+		 * @param pool Where to put the coefficients, moved past them on return
+		 * @param copy Whether to copy our coefficients there
+		 */
+		void share(double*& pool, bool copy) {
+			for (int i = 0; i < dim; i++) {
+				if (copy)
+					std::copy(coefs[i], coefs[i] + dim, pool);
+				if (!shared)
+					delete[] coefs[i];
+				coefs[i] = pool;
+				pool += dim;
+			}
+			shared = true;
+		}
 	};
 
 	/**
@@ -693,6 +740,17 @@ public:
 	 */
 	double getTotalVacancyConcentration() const;
 
+	/**
+	 * This operation adds the weights of the zeroth and first moments of the
+	 * group to a weight vector giving the total concentration of the given
+	 * atom, as getTotalAtomConcentration() does.
+	 *
+	 * @param axis The given atom, 3 for the vacancies
+	 * @param weights The weight vector
+	 */
+	void addTotalAtomWeights(int axis,
+			IReactionNetwork::WeightVector& weights) const;
+
 	/**
 	 * This operation returns the current concentration for a vacancy number.
 	 *
@@ -737,6 +795,33 @@ public:
 	 */
 	virtual std::vector<std::vector<double> > getEmitVector() const override;
 
+	/**
+	 * This operation returns the number of coefficients stored in the
+	 * effective reaction lists of this cluster.
+	 *
+	 * @return The number of coefficients
+	 */
+	std::size_t getNCoefficients() const;
+
+	/**
+	 * This operation returns the memory used by the coefficients of the
+	 * effective reaction lists of this cluster, the ones moved to shared
+	 * memory excluded.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t getCoefficientMemorySize() const;
+
+	/**
+	 * This operation moves the coefficients of the effective reaction lists
+	 * to memory shared with the other processes of the node. The reaction
+	 * lists must not change afterwards.
+	 *
+	 * @param pool Where to put the coefficients, moved past them on return
+	 * @param copy Whether to copy our coefficients there
+	 */
+	void shareCoefficients(double*& pool, bool copy);
+
 	/**
 	 * This operation returns the distance to the mean.
 	 *
@@ -790,6 +875,14 @@ public:
 	 */
 	void resetConnectivities() override;
 
+	/**
+	 * Get the memory used by this cluster and its effective reaction
+	 * lists, their coefficients excluded.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t getMemorySize() const override;
+
 	/**
 	 * Add grid points to the vector of diffusion coefficients or remove
 	 * them if the value is negative.
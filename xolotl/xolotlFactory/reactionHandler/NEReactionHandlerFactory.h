@@ -64,6 +64,8 @@ public:
 			theNetworkHandler = theNetworkLoaderHandler->load(options);
 		else
 			theNetworkHandler = theNetworkLoaderHandler->generate(options);
+		// Account for its memory
+		theNetworkHandler->trackMemory();
 
 		if (procId == 0) {
 			std::cout << "\nFactory Message: "
@@ -4,6 +4,8 @@
 #include <memory>
 #include "IReactionHandlerFactory.h"
 #include <HDF5NetworkLoader.h>
+#include <MPIUtils.h>
+#include <NetworkCache.h>
 
 namespace xolotlFactory {
 
@@ -41,9 +43,10 @@ public:
 	 */
 	void initializeReactionNetwork(const xolotlCore::Options &options,
 			std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) {
-		// Get the current process ID
-		int procId;
+		// Get the current process ID and the number of processes
+		int procId, nProcs;
 		MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+		MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
 
 		// Create a HDF5NetworkLoader
 		auto tempNetworkLoader =
@@ -62,16 +65,77 @@ public:
 		auto map = options.getProcesses();
 		if (!map["reaction"])
 			theNetworkLoaderHandler->setDummyReactions();
-		// Load the network
-		if (options.useHDF5())
-			theNetworkHandler = theNetworkLoaderHandler->load(options);
-		else
-			theNetworkHandler = theNetworkLoaderHandler->generate(options);
+
+		// Look for the generated network in the cache, every process maps
+		// the file itself so it is only used if all of them can
+		std::unique_ptr<xolotlCore::NetworkCache> cache;
+		int cacheHit = 0;
+		if (!options.useHDF5()
+				&& !options.getNetworkCacheDirectory().empty()) {
+			cache.reset(
+					new xolotlCore::NetworkCache(
+							options.getNetworkCacheDirectory(),
+							tempNetworkLoader->describeNetwork(options)));
+			int localHit = cache->map();
+			MPI_Allreduce(&localHit, &cacheHit, 1, MPI_INT, MPI_MIN,
+					MPI_COMM_WORLD);
+		}
+
+		if (cacheHit) {
+			// Rebuild the network from the cached file
+			theNetworkHandler = tempNetworkLoader->unpackNetwork(options,
+					cache->getData());
+		} else {
+			// Only the master loads or generates the network, the other
+			// processes rebuild it from the packed network it broadcasts
+			std::vector<double> networkBuffer;
+			xolotlPerf::TrackedMemory bufferMemory(
+					xolotlPerf::MemoryCategory::IO);
+			if (procId == 0) {
+				// Load the network
+				if (options.useHDF5())
+					theNetworkHandler = theNetworkLoaderHandler->load(options);
+				else
+					theNetworkHandler = theNetworkLoaderHandler->generate(
+							options);
+
+				// Pack it
+				if (nProcs > 1 || cache)
+					networkBuffer = xolotlCore::HDF5NetworkLoader::packNetwork(
+							*theNetworkHandler);
+
+				// Save it for the next runs
+				if (cache && cache->store(networkBuffer))
+					std::cout << "\nFactory Message: " << "Network cached in "
+							<< cache->getFileName() << "." << std::endl;
+			}
+			if (nProcs > 1) {
+				xolotlCore::MPIUtils::broadcastBuffer(networkBuffer, 0);
+				bufferMemory.set(
+						xolotlPerf::getVectorMemorySize(networkBuffer));
+				if (procId != 0)
+					theNetworkHandler = tempNetworkLoader->unpackNetwork(
+							options, networkBuffer);
+			}
+		}
+		// Account for its memory, the coefficients are counted on every
+		// process until they are shared
+		theNetworkHandler->trackMemory();
+		// The mapping is not needed once the network is built
+		cache.reset();
+
+		if (nProcs > 1) {
+			// Keep a single copy of the super cluster coefficients per node
+			auto& psiNetwork =
+					static_cast<xolotlCore::PSIClusterReactionNetwork&>(*theNetworkHandler);
+			psiNetwork.shareCoefficients();
+		}
 
 		if (procId == 0) {
 			std::cout << "\nFactory Message: "
-					<< "Master loaded network of size "
-					<< theNetworkHandler->size() << "." << std::endl;
+					<< (cacheHit ? "Cached" : "Master loaded")
+					<< " network of size " << theNetworkHandler->size() << "."
+					<< std::endl;
 		}
 	}
 
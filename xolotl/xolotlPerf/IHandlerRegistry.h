@@ -26,6 +26,8 @@ public:
 		std,        //< Use the best available API.
 		os,         //< Use operating system/runtime API.
 		papi,       //< Use PAPI to collect performance data.
+		trace,      //< Use operating system/runtime API and record a timeline.
+		perf,       //< Use operating system/runtime API and count the hardware events of each phase.
 	};
 
 	/**
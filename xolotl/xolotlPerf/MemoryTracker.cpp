@@ -0,0 +1,68 @@
+#include <sys/resource.h>
+#include "xolotlPerf/MemoryTracker.h"
+
+namespace xolotlPerf {
+
+const char* getMemoryCategoryName(MemoryCategory category) {
+	static const char* names[(int) MemoryCategory::Count] = { "reactants",
+			"reactions", "coefficients", "gridPointRates", "jacobian", "io" };
+
+	return names[(int) category];
+}
+
+MemoryTracker::MemoryTracker() {
+	reset();
+}
+
+void MemoryTracker::raise(std::atomic<long long>& mark, long long value) {
+	long long previous = mark;
+	while (previous < value && !mark.compare_exchange_weak(previous, value)) {
+		// previous was updated, try again
+	}
+
+	return;
+}
+
+void MemoryTracker::add(MemoryCategory category, long long bytes) {
+	if (bytes == 0)
+		return;
+
+	raise(peak[(int) category], current[(int) category] += bytes);
+	raise(totalPeak, total += bytes);
+
+	return;
+}
+
+void MemoryTracker::reset() {
+	for (int i = 0; i < (int) MemoryCategory::Count; i++) {
+		current[i] = 0;
+		peak[i] = 0;
+	}
+	total = 0;
+	totalPeak = 0;
+
+	return;
+}
+
+MemoryTracker& getMemoryTracker() {
+	// Never destroyed, the objects releasing their memory when the
+	// program exits can still use it
+	static MemoryTracker* theTracker = new MemoryTracker();
+	return *theTracker;
+}
+
+long long getProcessPeakMemory() {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#ifdef __APPLE__
+	// In bytes
+	return usage.ru_maxrss;
+#else
+	// In kilobytes
+	return 1024LL * usage.ru_maxrss;
+#endif
+}
+
+} // namespace xolotlPerf
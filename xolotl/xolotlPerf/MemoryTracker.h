@@ -0,0 +1,252 @@
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace xolotlPerf {
+
+/**
+ * What the memory accounted by the tracker is used for. They are used as
+ * indices so a category is found without looking up its name.
+ */
+enum class MemoryCategory {
+	Reactants, //< The clusters and the lists of reactions they take part in
+	Reactions, //< The production and dissociation reactions and their maps
+	Coefficients, //< The coefficients of the super cluster reactions
+	GridPointRates, //< The rates and diffusion coefficients per grid point
+	Jacobian, //< The PETSc Jacobian matrix
+	IO, //< The buffers of the HDF5 files and of the network broadcast
+	Count //< The number of categories, not a category
+};
+
+/**
+ * Get the name of a memory category.
+ *
+ * @param category The category
+ * @return Its name
+ */
+const char* getMemoryCategoryName(MemoryCategory category);
+
+/**
+ * The memory of this process accounted by category. The parts of the code
+ * that hold large data structures report the bytes they allocate and
+ * release, the tracker keeps the current use and the high-water mark of
+ * each category and of their total.
+ *
+ * What is reported is computed from the sizes of the data structures, the
+ * overhead of the allocator is not accounted. The reports can come from
+ * several threads.
+ */
+class MemoryTracker {
+private:
+
+	//! The bytes currently used by each category.
+	std::atomic<long long> current[(int) MemoryCategory::Count];
+
+	//! The high-water mark of each category.
+	std::atomic<long long> peak[(int) MemoryCategory::Count];
+
+	//! The bytes currently used by all the categories.
+	std::atomic<long long> total;
+
+	//! The high-water mark of the total.
+	std::atomic<long long> totalPeak;
+
+	/**
+	 * Raise a high-water mark to a new value if it is below.
+	 *
+	 * @param mark The high-water mark
+	 * @param value The new value
+	 */
+	static void raise(std::atomic<long long>& mark, long long value);
+
+public:
+
+	/**
+	 * The constructor, nothing is accounted yet.
+	 */
+	MemoryTracker();
+
+	MemoryTracker(const MemoryTracker& other) = delete;
+	MemoryTracker& operator=(const MemoryTracker& other) = delete;
+
+	/**
+	 * Account for bytes allocated or released.
+	 *
+	 * @param category The category
+	 * @param bytes The number of bytes, negative when they are released
+	 */
+	void add(MemoryCategory category, long long bytes);
+
+	/**
+	 * Get the bytes currently used by a category.
+	 *
+	 * @param category The category
+	 * @return The number of bytes
+	 */
+	long long getCurrent(MemoryCategory category) const {
+		return current[(int) category];
+	}
+
+	/**
+	 * Get the high-water mark of a category.
+	 *
+	 * @param category The category
+	 * @return The number of bytes
+	 */
+	long long getPeak(MemoryCategory category) const {
+		return peak[(int) category];
+	}
+
+	/**
+	 * Get the bytes currently used by all the categories.
+	 *
+	 * @return The number of bytes
+	 */
+	long long getTotal() const {
+		return total;
+	}
+
+	/**
+	 * Get the high-water mark of the total. It is reached at a single
+	 * moment so it can be lower than the sum of the high-water marks of
+	 * the categories.
+	 *
+	 * @return The number of bytes
+	 */
+	long long getTotalPeak() const {
+		return totalPeak;
+	}
+
+	/**
+	 * Forget everything that was accounted.
+	 */
+	void reset();
+};
+
+/**
+ * Get the memory tracker of this process.
+ *
+ * @return The tracker
+ */
+MemoryTracker& getMemoryTracker();
+
+/**
+ * Get the high-water mark of the resident memory of this process, as the
+ * operating system sees it. It includes everything the tracker doesn't
+ * account, like the PETSc vectors and the libraries.
+ *
+ * @return The number of bytes, 0 if it is not known
+ */
+long long getProcessPeakMemory();
+
+/**
+ * A class reporting the size of a data structure to the memory tracker.
+ * Setting a new size accounts for the difference with the previous one,
+ * and what was reported is released when the object is destroyed.
+ */
+class TrackedMemory {
+private:
+
+	//! The category of the data structure.
+	MemoryCategory category;
+
+	//! The size reported to the tracker.
+	std::size_t bytes;
+
+public:
+
+	/**
+	 * The constructor, nothing is reported yet.
+	 *
+	 * @param _category The category of the data structure
+	 */
+	explicit TrackedMemory(MemoryCategory _category) :
+			category(_category), bytes(0) {
+	}
+
+	TrackedMemory(const TrackedMemory& other) = delete;
+	TrackedMemory& operator=(const TrackedMemory& other) = delete;
+
+	/**
+	 * The destructor releases what was reported.
+	 */
+	~TrackedMemory() {
+		set(0);
+	}
+
+	/**
+	 * Set the size of the data structure.
+	 *
+	 * @param newBytes The number of bytes
+	 */
+	void set(std::size_t newBytes) {
+		getMemoryTracker().add(category,
+				(long long) newBytes - (long long) bytes);
+		bytes = newBytes;
+	}
+
+	/**
+	 * Get the size that was reported.
+	 *
+	 * @return The number of bytes
+	 */
+	std::size_t get() const {
+		return bytes;
+	}
+};
+
+/**
+ * Get the memory allocated by a vector for its elements.
+ *
+ * @param v The vector
+ * @return The number of bytes
+ */
+template<typename T>
+std::size_t getVectorMemorySize(const std::vector<T>& v) {
+	return v.capacity() * sizeof(T);
+}
+
+/**
+ * Get the capacity a vector reaches when it grows to a size a few elements
+ * at a time, the next power of two with the doubling of the standard
+ * libraries.
+ *
+ * @param size The size of the vector
+ * @return The number of elements it has room for
+ */
+inline std::size_t getGrownCapacity(std::size_t size) {
+	std::size_t capacity = 1;
+	while (capacity < size)
+		capacity *= 2;
+	return (size > 0) ? capacity : 0;
+}
+
+/**
+ * Get the memory used by a node of a std::set or std::map: the color and
+ * the three links of the tree, then the value.
+ *
+ * @return The number of bytes
+ */
+template<typename T>
+constexpr std::size_t getTreeNodeMemorySize() {
+	return 4 * sizeof(void*) + sizeof(T);
+}
+
+/**
+ * Get the memory used by a node of a std::unordered_set or
+ * std::unordered_map: the link to the next node, the value, and the cached
+ * hash, plus its bucket.
+ *
+ * @return The number of bytes
+ */
+template<typename T>
+constexpr std::size_t getHashNodeMemorySize() {
+	return 3 * sizeof(void*) + sizeof(T);
+}
+
+} // namespace xolotlPerf
+
+#endif // MEMORYTRACKER_H
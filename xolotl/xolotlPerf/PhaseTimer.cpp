@@ -0,0 +1,114 @@
+#include <stdexcept>
+#include "xolotlPerf/PhaseTimer.h"
+#include "xolotlPerf/trace/TraceRecorder.h"
+
+namespace xolotlPerf {
+
+const char* getPhaseName(Phase phase) {
+	static const char* names[(int) Phase::Count] = { "RHSFunction",
+			"RHSJacobian", "ghostExchange", "updateConcentration",
+			"offDiagonalJacobian", "diagonalJacobian", "attenuation", "flux",
+			"heatEquation", "diffusion", "advection", "trapMutation",
+			"reSolution", "nucleation", "reactions", "setTemperature",
+			"matrixAssembly" };
+
+	return names[(int) phase];
+}
+
+PhaseTree::PhaseTree() :
+		current(0), enabled(false), traceDepth(0), nCounters(0) {
+	addNode(Phase::Count, -1);
+}
+
+int PhaseTree::addNode(Phase phase, int parent) {
+	Node node;
+	node.phase = phase;
+	node.parent = parent;
+	node.depth = parent < 0 ? 0 : nodes[parent].depth + 1;
+	for (auto& child : node.children) {
+		child = -1;
+	}
+	node.calls = 0;
+	node.inclusive = Clock::duration::zero();
+	node.counts.assign(nCounters, 0);
+	nodes.push_back(node);
+
+	return nodes.size() - 1;
+}
+
+void PhaseTree::trace(int node, Clock::time_point start,
+		Clock::time_point end) const {
+	getTraceRecorder().record(getPhaseName(nodes[node].phase), "phase", start,
+			end);
+
+	return;
+}
+
+std::vector<PhaseTree::Record> PhaseTree::getRecords() const {
+	std::vector<Record> records;
+
+	// Depth-first walk from the root, the path of each node is kept
+	// with one character per phase so that sorting the keys gives the
+	// same order back
+	std::vector<std::pair<int, std::string> > stack;
+	for (int i = (int) Phase::Count - 1; i >= 0; i--) {
+		if (nodes[0].children[i] >= 0)
+			stack.emplace_back(nodes[0].children[i], std::string());
+	}
+	while (!stack.empty()) {
+		auto index = stack.back().first;
+		auto key = stack.back().second + (char) ('A' + (int) nodes[index].phase);
+		stack.pop_back();
+		auto const& node = nodes[index];
+
+		// The time spent in the children
+		auto childTime = Clock::duration::zero();
+		for (int i = (int) Phase::Count - 1; i >= 0; i--) {
+			if (node.children[i] < 0)
+				continue;
+			childTime += nodes[node.children[i]].inclusive;
+			stack.emplace_back(node.children[i], key);
+		}
+
+		using Seconds = std::chrono::duration<double>;
+		Record record;
+		record.key = key;
+		record.phase = node.phase;
+		record.calls = node.calls;
+		record.inclusive = std::chrono::duration_cast<Seconds>(node.inclusive)
+				.count();
+		record.self = std::chrono::duration_cast<Seconds>(
+				node.inclusive - childTime).count();
+		record.counts.assign(node.counts.begin(), node.counts.end());
+		records.push_back(record);
+	}
+
+	return records;
+}
+
+void PhaseTree::reset() {
+	nodes.clear();
+	current = 0;
+	addNode(Phase::Count, -1);
+
+	return;
+}
+
+void PhaseTree::setCounters(std::shared_ptr<IPhaseCounters> _counters) {
+	nCounters = _counters ? _counters->getSpecification().size() : 0;
+	if (nCounters > maxCounters) {
+		throw std::invalid_argument(
+				"PhaseTree: too many hardware counters for the phases.");
+	}
+	counters = _counters;
+	reset();
+
+	return;
+}
+
+PhaseTree& getPhaseTree() {
+	static PhaseTree theTree;
+	return theTree;
+}
+
+} // namespace xolotlPerf
@@ -0,0 +1,405 @@
+#ifndef PHASETIMER_H
+#define PHASETIMER_H
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "xolotlPerf/IHardwareCounter.h"
+
+namespace xolotlPerf {
+
+/**
+ * The phases of the RHS function and Jacobian that are timed. They are
+ * used as indices so a phase is found without looking up its name.
+ */
+enum class Phase {
+	RHSFunction,
+	RHSJacobian,
+	GhostExchange,
+	UpdateConcentration,
+	OffDiagonalJacobian,
+	DiagonalJacobian,
+	Attenuation,
+	Flux,
+	HeatEquation,
+	Diffusion,
+	Advection,
+	TrapMutation,
+	ReSolution,
+	Nucleation,
+	Reactions,
+	SetTemperature,
+	MatrixAssembly,
+	Count //< The number of phases, not a phase
+};
+
+/**
+ * Get the name of a phase.
+ *
+ * @param phase The phase
+ * @return Its name
+ */
+const char* getPhaseName(Phase phase);
+
+/**
+ * Hardware counters read every time a phase is entered or left. The counts
+ * only go up, what a phase counted is the difference between the values
+ * read when it was left and when it was entered.
+ */
+class IPhaseCounters {
+public:
+
+	virtual ~IPhaseCounters() {
+	}
+
+	/**
+	 * Get the hardware counters that are read.
+	 *
+	 * @return The counters
+	 */
+	virtual const IHardwareCounter::SpecType& getSpecification() const = 0;
+
+	/**
+	 * Get the name of a hardware counter.
+	 *
+	 * @param cs The counter
+	 * @return Its name
+	 */
+	virtual std::string getCounterName(
+			IHardwareCounter::CounterSpec cs) const = 0;
+
+	/**
+	 * Read the current counts.
+	 *
+	 * @param values One value for each counter of the specification
+	 */
+	virtual void read(IHardwareCounter::CounterType* values) = 0;
+};
+
+/**
+ * The tree of the phases timed by this process. A phase entered while
+ * another one is running is its child, so the same phase can appear at
+ * several places in the tree, for instance the matrix assembly below both
+ * parts of the Jacobian. Each node keeps the number of times it was entered
+ * and the time spent in it, its children included; the time spent in the
+ * node itself is what its children don't account for.
+ *
+ * The phases have to be entered and left by the same thread, in order.
+ */
+class PhaseTree {
+public:
+
+	//! The clock used to time the phases.
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * What a node measured, with the path that identifies it.
+	 */
+	struct Record {
+		//! The phases from the root to the node, one character each.
+		std::string key;
+
+		//! The hardware counts of the phase, children included.
+		std::vector<double> counts;
+
+		//! The phase of the node.
+		Phase phase;
+
+		//! The number of times the phase was entered here.
+		unsigned long calls;
+
+		//! The time spent in the phase, children included, in seconds.
+		double inclusive;
+
+		//! The time spent in the phase itself, in seconds.
+		double self;
+	};
+
+private:
+
+	//! A node of the tree.
+	struct Node {
+		//! The phase.
+		Phase phase;
+
+		//! The parent node.
+		int parent;
+
+		//! The number of nodes above it, the root included.
+		int depth;
+
+		//! The child node for each phase, -1 if there is none yet.
+		int children[(int) Phase::Count];
+
+		//! The number of times the phase was entered here.
+		unsigned long calls;
+
+		//! The time spent in the phase, children included.
+		Clock::duration inclusive;
+
+		//! The hardware counts of the phase, children included.
+		std::vector<IHardwareCounter::CounterType> counts;
+	};
+
+	//! The nodes, the root being the first one.
+	std::vector<Node> nodes;
+
+	//! The node of the phase currently running.
+	int current;
+
+	//! Are the phases timed?
+	bool enabled;
+
+	//! The deepest nodes whose phases are also traced, 0 for none.
+	int traceDepth;
+
+	//! The hardware counters read at each phase change, if any.
+	std::shared_ptr<IPhaseCounters> counters;
+
+	//! The number of hardware counters.
+	int nCounters;
+
+	/**
+	 * Add a node.
+	 *
+	 * @param phase The phase
+	 * @param parent The parent node
+	 * @return The new node
+	 */
+	int addNode(Phase phase, int parent);
+
+	/**
+	 * Give a phase that was left to the trace recorder.
+	 *
+	 * @param node The node of the phase
+	 * @param start When it was entered
+	 * @param end When it was left
+	 */
+	void trace(int node, Clock::time_point start, Clock::time_point end) const;
+
+public:
+
+	//! The largest number of hardware counters.
+	static const int maxCounters = 8;
+
+	/**
+	 * The constructor creates the root of the tree, disabled.
+	 */
+	PhaseTree();
+
+	/**
+	 * Whether the phases are timed.
+	 *
+	 * @param isEnabled True to time them
+	 */
+	void setEnabled(bool isEnabled) {
+		enabled = isEnabled;
+	}
+
+	/**
+	 * Are the phases timed?
+	 *
+	 * @return True if they are
+	 */
+	bool isEnabled() const {
+		return enabled;
+	}
+
+	/**
+	 * Set how deep in the tree the phases are also recorded on the
+	 * timeline of the trace recorder. The phases of the RHS function and
+	 * Jacobian are at depth 1, their parts at depth 2, and so on.
+	 *
+	 * @param depth The deepest phases that are traced, 0 for none
+	 */
+	void setTraceDepth(int depth) {
+		traceDepth = depth;
+	}
+
+	/**
+	 * Set the hardware counters read at each phase change, forgetting
+	 * everything that was measured.
+	 *
+	 * @param _counters The counters, null for none
+	 */
+	void setCounters(std::shared_ptr<IPhaseCounters> _counters);
+
+	/**
+	 * Get the hardware counters read at each phase change.
+	 *
+	 * @return The counters, null if there are none
+	 */
+	std::shared_ptr<IPhaseCounters> getCounters() const {
+		return counters;
+	}
+
+	/**
+	 * Get the number of hardware counters read at each phase change.
+	 *
+	 * @return The number of counters
+	 */
+	int getNumberOfCounters() const {
+		return nCounters;
+	}
+
+	/**
+	 * Read the hardware counters, if any.
+	 *
+	 * @param values One value for each counter
+	 */
+	void readCounters(IHardwareCounter::CounterType* values) {
+		if (counters)
+			counters->read(values);
+	}
+
+	/**
+	 * Enter a phase below the one currently running.
+	 *
+	 * @param phase The phase
+	 * @return The node of the phase
+	 */
+	int enter(Phase phase) {
+		int child = nodes[current].children[(int) phase];
+		if (child < 0) {
+			// Adding the node can move the others
+			child = addNode(phase, current);
+			nodes[current].children[(int) phase] = child;
+		}
+		current = child;
+		nodes[current].calls++;
+		return current;
+	}
+
+	/**
+	 * Leave a phase, its parent becomes the running one.
+	 *
+	 * @param node The node of the phase
+	 * @param start When it was entered
+	 * @param end When it was left
+	 * @param startCounts The hardware counts when it was entered
+	 * @param endCounts The hardware counts when it was left
+	 */
+	void leave(int node, Clock::time_point start, Clock::time_point end,
+			const IHardwareCounter::CounterType* startCounts,
+			const IHardwareCounter::CounterType* endCounts) {
+		nodes[node].inclusive += end - start;
+		for (int i = 0; i < nCounters; i++) {
+			nodes[node].counts[i] += endCounts[i] - startCounts[i];
+		}
+		current = nodes[node].parent;
+		if (nodes[node].depth <= traceDepth)
+			trace(node, start, end);
+	}
+
+	/**
+	 * Get what every node measured, the root excluded. A node comes right
+	 * before its children and the children are in the order of the phases.
+	 *
+	 * @return The records
+	 */
+	std::vector<Record> getRecords() const;
+
+	/**
+	 * Forget everything that was measured.
+	 */
+	void reset();
+};
+
+/**
+ * Get the phase tree of this process.
+ *
+ * @return The tree
+ */
+PhaseTree& getPhaseTree();
+
+/**
+ * A class timing phases for the duration of a scope. The phases entered one
+ * after the other with the same object are siblings, leaving the previous
+ * one and entering the next one only reads the clock once. The running
+ * phase is left when the object is destroyed, whichever way the scope is
+ * left.
+ */
+class ScopedPhase {
+private:
+
+	//! The tree of the process.
+	PhaseTree& tree;
+
+	//! The node of the running phase, -1 if there is none.
+	int node;
+
+	//! When it was entered.
+	PhaseTree::Clock::time_point startTime;
+
+	//! The hardware counts when it was entered.
+	IHardwareCounter::CounterType startCounts[PhaseTree::maxCounters];
+
+public:
+
+	/**
+	 * The constructor, without entering any phase.
+	 */
+	ScopedPhase() :
+			tree(getPhaseTree()), node(-1) {
+	}
+
+	/**
+	 * The constructor entering a phase.
+	 *
+	 * @param phase The phase
+	 */
+	explicit ScopedPhase(Phase phase) :
+			ScopedPhase() {
+		enter(phase);
+	}
+
+	ScopedPhase(const ScopedPhase& other) = delete;
+	ScopedPhase& operator=(const ScopedPhase& other) = delete;
+
+	/**
+	 * The destructor leaves the running phase.
+	 */
+	~ScopedPhase() {
+		leave();
+	}
+
+	/**
+	 * Leave the running phase, if any, and enter another one.
+	 *
+	 * @param phase The phase
+	 */
+	void enter(Phase phase) {
+		if (!tree.isEnabled())
+			return;
+
+		auto now = PhaseTree::Clock::now();
+		IHardwareCounter::CounterType counts[PhaseTree::maxCounters];
+		tree.readCounters(counts);
+		if (node >= 0)
+			tree.leave(node, startTime, now, startCounts, counts);
+		node = tree.enter(phase);
+		startTime = now;
+		std::copy(counts, counts + tree.getNumberOfCounters(), startCounts);
+	}
+
+	/**
+	 * Leave the running phase, if any. The time until the next phase is
+	 * spent in the parent.
+	 */
+	void leave() {
+		if (node < 0)
+			return;
+
+		auto now = PhaseTree::Clock::now();
+		IHardwareCounter::CounterType counts[PhaseTree::maxCounters];
+		tree.readCounters(counts);
+		tree.leave(node, startTime, now, startCounts, counts);
+		node = -1;
+	}
+};
+
+} // namespace xolotlPerf
+
+#endif // PHASETIMER_H
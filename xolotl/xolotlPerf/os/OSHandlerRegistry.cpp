@@ -2,6 +2,9 @@
 #include "xolotlPerf/os/OSTimer.h"
 #include "xolotlPerf/standard/EventCounter.h"
 #include "xolotlPerf/dummy/DummyHardwareCounter.h"
+#if defined(HAVE_PERF_EVENT)
+#include "xolotlPerf/os/PerfEventHardwareCounter.h"
+#endif // defined(HAVE_PERF_EVENT)
 
 namespace xolotlPerf {
 
@@ -38,8 +41,13 @@ std::shared_ptr<IHardwareCounter> OSHandlerRegistry::getHardwareCounter(
 	} else {
 		// We have not yet created a hw counter set with this name.
 		// Build one and keep track of it.
-		// Note with the OSHandlerRegistry it is always a dummy.
+		// Note with the OSHandlerRegistry it is a dummy unless the
+		// kernel counters can be used.
+#if defined(HAVE_PERF_EVENT)
+		ret = std::make_shared<PerfEventHardwareCounter>(name, ctrSpec);
+#else
 		ret = std::make_shared<DummyHardwareCounter>(name, ctrSpec);
+#endif // defined(HAVE_PERF_EVENT)
 		allHWCounterSets[name] = ret;
 	}
 	return ret;
@@ -1,14 +1,16 @@
 #ifndef OSHANDLERREGISTRY_H
 #define OSHANDLERREGISTRY_H
 
+#include "xolotlPerf/perfConfig.h"
 #include "xolotlPerf/standard/StdHandlerRegistry.h"
 
 namespace xolotlPerf {
 
 /**
  * Factory for building performance data collection objects that 
- * use an OS/runtime timer API.  No hardware performance counters
- * are available.
+ * use an OS/runtime timer API.  The hardware performance counters
+ * use the Linux perf_event interface when it is available, and are
+ * dummies otherwise.
  */
 class OSHandlerRegistry: public StdHandlerRegistry {
 public:
@@ -0,0 +1,193 @@
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "xolotlPerf/os/PerfEventCounterGroup.h"
+#include "xolotlPerf/RuntimeError.h"
+
+namespace xolotlPerf {
+
+/// How a hardware counter is read with perf_event_open.
+struct PerfEventInfo {
+	const char* name;       ///< Common name for the counter.
+	const char* perfName;   ///< perf's name for it, null if there is none.
+	__u32 type;             ///< The type of perf event.
+	__u64 config;           ///< The perf event in its type.
+};
+
+/**
+ * Get how a hardware counter is read.
+ *
+ * @param cs The counter
+ * @return Its information
+ */
+static PerfEventInfo getEventInfo(IHardwareCounter::CounterSpec cs) {
+	switch (cs) {
+	case IHardwareCounter::Instructions:
+		return {"Instructions", "instructions", PERF_TYPE_HARDWARE,
+			PERF_COUNT_HW_INSTRUCTIONS};
+	case IHardwareCounter::Cycles:
+		return {"Total cycles", "cycles", PERF_TYPE_HARDWARE,
+			PERF_COUNT_HW_CPU_CYCLES};
+	case IHardwareCounter::L1CacheMisses:
+		return {"L1 cache misses", "L1-dcache-load-misses",
+			PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+					| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+					| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+	case IHardwareCounter::L3CacheMisses:
+		// The last level cache
+		return {"L3 cache misses", "cache-misses", PERF_TYPE_HARDWARE,
+			PERF_COUNT_HW_CACHE_MISSES};
+	case IHardwareCounter::BranchMispredictions:
+		return {"Branch mispredictions", "branch-misses", PERF_TYPE_HARDWARE,
+			PERF_COUNT_HW_BRANCH_MISSES};
+	// The kernel has no generic event for these ones, they depend
+	// on the processor
+	case IHardwareCounter::FPOps:
+		return {"Floating point operations", nullptr, 0, 0};
+	case IHardwareCounter::FPInstructions:
+		return {"Floating point instructions", nullptr, 0, 0};
+	case IHardwareCounter::L2CacheMisses:
+		return {"L2 cache misses", nullptr, 0, 0};
+	default:
+		return {"Unknown", nullptr, 0, 0};
+	}
+}
+
+PerfEventCounterGroup::PerfEventCounterGroup(
+		const IHardwareCounter::SpecType& cset, bool allThreads) :
+		spec(cset), threads(1) {
+#ifdef _OPENMP
+	if (allThreads && omp_get_max_threads() > 1) {
+		// Each thread of the pool opens its own counters, the calling
+		// one is the master of the region
+		threads.resize(omp_get_max_threads());
+#pragma omp parallel num_threads(threads.size())
+		open(threads[omp_get_thread_num()]);
+	} else
+		open(threads[0]);
+#else
+	open(threads[0]);
+#endif
+
+	// The number of counters, the times, and the counts
+	buffer.resize(3 + spec.size(), 0);
+}
+
+void PerfEventCounterGroup::open(ThreadCounters& counters) const {
+	counters.fds.assign(spec.size(), -1);
+	counters.positions.assign(spec.size(), -1);
+	for (std::size_t i = 0; i < spec.size(); i++) {
+		auto info = getEventInfo(spec[i]);
+		if (!info.perfName)
+			continue;
+
+		// Count the calling thread, in user space only, from now on
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = info.type;
+		attr.config = info.config;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+				| PERF_FORMAT_TOTAL_TIME_RUNNING;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		// The first counter that opens leads the group
+		int fd = syscall(__NR_perf_event_open, &attr, 0, -1,
+				counters.leaderFd, 0);
+		if (fd < 0)
+			continue;
+		if (counters.leaderFd < 0)
+			counters.leaderFd = fd;
+		counters.fds[i] = fd;
+		counters.positions[i] = counters.nAvailable;
+		counters.nAvailable++;
+	}
+
+	return;
+}
+
+PerfEventCounterGroup::~PerfEventCounterGroup(void) {
+	for (auto const& counters : threads) {
+		// Close the leader last
+		for (auto fd : counters.fds) {
+			if (fd >= 0 && fd != counters.leaderFd)
+				close(fd);
+		}
+		if (counters.leaderFd >= 0)
+			close(counters.leaderFd);
+	}
+}
+
+int PerfEventCounterGroup::getNumberOfThreads(void) const {
+	int nThreads = 0;
+	for (auto const& counters : threads) {
+		if (counters.leaderFd >= 0)
+			nThreads++;
+	}
+	return nThreads;
+}
+
+std::string PerfEventCounterGroup::getCounterName(
+		IHardwareCounter::CounterSpec cs) const {
+	auto info = getEventInfo(cs);
+	std::string ret = info.name;
+
+	// Is it one of ours, and does it count?
+	for (std::size_t i = 0; i < spec.size(); i++) {
+		if (spec[i] == cs) {
+			if (!isAvailable(i)) {
+				ret += "(unavailable)";
+				break;
+			}
+
+			// Say when the counts are summed over several threads
+			ret += std::string("(") + info.perfName;
+			if (threads.size() > 1)
+				ret += ", " + std::to_string(getNumberOfThreads())
+						+ " threads";
+			ret += ')';
+			break;
+		}
+	}
+	return ret;
+}
+
+void PerfEventCounterGroup::read(IHardwareCounter::CounterType* values) {
+	for (std::size_t i = 0; i < spec.size(); i++) {
+		values[i] = 0;
+	}
+
+	for (auto const& counters : threads) {
+		if (counters.leaderFd < 0)
+			continue;
+
+		auto nBytes = (3 + counters.nAvailable) * sizeof(buffer[0]);
+		if (::read(counters.leaderFd, buffer.data(), nBytes)
+				!= (ssize_t) nBytes) {
+			throw xolotlPerf::runtime_error(
+					"Failed to read the perf_event counters", errno);
+		}
+
+		// Make up for the time the kernel gave the hardware to other
+		// counters
+		double timeEnabled = buffer[1], timeRunning = buffer[2];
+		double scale = 0.0;
+		if (timeRunning > 0.0)
+			scale = timeEnabled / timeRunning;
+		for (std::size_t i = 0; i < spec.size(); i++) {
+			if (counters.positions[i] >= 0)
+				values[i] += (IHardwareCounter::CounterType) (scale
+						* buffer[3 + counters.positions[i]]);
+		}
+	}
+
+	return;
+}
+
+} // namespace xolotlPerf
@@ -0,0 +1,128 @@
+#ifndef PERFEVENTCOUNTERGROUP_H
+#define PERFEVENTCOUNTERGROUP_H
+
+#include "xolotlPerf/perfConfig.h"
+#if !defined(HAVE_PERF_EVENT)
+#  error "Using perf_event-based hardware counters but linux/perf_event.h was not found when configured."
+#endif // !defined(HAVE_PERF_EVENT)
+
+#include <string>
+#include <vector>
+#include "xolotlPerf/IHardwareCounter.h"
+#include "xolotlPerf/PhaseTimer.h"
+
+namespace xolotlPerf {
+
+/**
+ * A group of hardware counters of the calling thread, or of all the threads
+ * of the OpenMP pool, read through the Linux perf_event_open interface. The counters run from the creation of
+ * the group to its destruction and are read together so ratios like the
+ * instructions per cycle are consistent. When the kernel has to share the
+ * hardware between more counters than it has, the counts are scaled by
+ * the fraction of the time the group was actually counting.
+ *
+ * The counters without a generic perf event (the floating point ones and
+ * the L2 cache misses) or that the kernel refuses to open (no hardware
+ * counters in a virtual machine, perf_event_paranoid too high) are
+ * unavailable, they always read zero and their name says so.
+ *
+ * Counting the OpenMP threads opens a group in each thread of a parallel
+ * region and sums them, the name of the counters gives the number of
+ * threads. The threads the OpenMP runtime creates afterwards are not
+ * counted, and the workers count their waits as well.
+ */
+class PerfEventCounterGroup: public IPhaseCounters {
+private:
+
+	/// The counters of one thread.
+	struct ThreadCounters {
+		/// The file descriptor of each counter, -1 if it is unavailable.
+		std::vector<int> fds;
+
+		/// The file descriptor of the group leader, -1 if nothing is
+		/// available.
+		int leaderFd;
+
+		/// The position of each counter in what the leader reads, -1 if it
+		/// is unavailable.
+		std::vector<int> positions;
+
+		/// The number of counters that are available.
+		int nAvailable;
+
+		ThreadCounters() :
+				leaderFd(-1), nAvailable(0) {
+		}
+	};
+
+	/// The counters we were asked for.
+	IHardwareCounter::SpecType spec;
+
+	/// The counters of each thread, the calling one first.
+	std::vector<ThreadCounters> threads;
+
+	/// What a leader reads.
+	std::vector<unsigned long long> buffer;
+
+	/// Open the counters of the calling thread.
+	///
+	/// @param counters Where to keep them.
+	void open(ThreadCounters& counters) const;
+
+public:
+
+	/// Open the counters.
+	///
+	/// @param cset The hardware counters to read.
+	/// @param allThreads Whether to count the threads of the OpenMP pool
+	///                   as well as the calling one.
+	PerfEventCounterGroup(const IHardwareCounter::SpecType& cset,
+			bool allThreads = false);
+
+	/// Close the counters.
+	virtual ~PerfEventCounterGroup(void);
+
+	PerfEventCounterGroup(const PerfEventCounterGroup& other) = delete;
+	PerfEventCounterGroup& operator=(const PerfEventCounterGroup& other) = delete;
+
+	///
+	/// Is a counter available?
+	///
+	/// @param i The index of the counter in the specification.
+	/// @return True if it counts in the calling thread.
+	///
+	bool isAvailable(int i) const {
+		return threads[0].fds[i] >= 0;
+	}
+
+	///
+	/// Retrieve the number of threads that are counted.
+	///
+	/// @return The number of threads with counters.
+	///
+	int getNumberOfThreads(void) const;
+
+	///
+	/// Retrieve the hardware counters we read.
+	///
+	/// @return The hardware counters the group was configured to read.
+	///
+	const IHardwareCounter::SpecType& getSpecification(void) const override {
+		return spec;
+	}
+
+	/// Retrieve the name of the given hardware counter.
+	/// @return The name of the given hardware counter.
+	std::string getCounterName(IHardwareCounter::CounterSpec cs) const
+			override;
+
+	/// Read the current counts, from the creation of the group, summed
+	/// over the threads.
+	///
+	/// @param values One value for each counter of the specification.
+	void read(IHardwareCounter::CounterType* values) override;
+};
+
+} // namespace xolotlPerf
+
+#endif // PERFEVENTCOUNTERGROUP_H
@@ -0,0 +1,33 @@
+#include <stdexcept>
+#include "xolotlPerf/os/PerfEventHardwareCounter.h"
+
+namespace xolotlPerf {
+
+void PerfEventHardwareCounter::start(void) {
+	if (running) {
+		throw std::runtime_error(
+				"Attempting to start a hardware counter that is already running.");
+	}
+
+	// The counters never stop, remember where they were
+	if (!startVals.empty())
+		group.read(&startVals.front());
+	running = true;
+}
+
+void PerfEventHardwareCounter::stop(void) {
+	if (!running) {
+		throw std::runtime_error(
+				"Attempting to stop a hardware counter that was not running.");
+	}
+
+	IHardwareCounter::ValType endVals(vals.size(), 0);
+	if (!endVals.empty())
+		group.read(&endVals.front());
+	for (std::size_t i = 0; i < vals.size(); i++) {
+		vals[i] += endVals[i] - startVals[i];
+	}
+	running = false;
+}
+
+} // namespace xolotlPerf
@@ -0,0 +1,90 @@
+#ifndef PERFEVENTHARDWARECOUNTER_H
+#define PERFEVENTHARDWARECOUNTER_H
+
+#include "xolotlPerf/perfConfig.h"
+#if !defined(HAVE_PERF_EVENT)
+#  error "Using perf_event-based hardware counters but linux/perf_event.h was not found when configured."
+#endif // !defined(HAVE_PERF_EVENT)
+
+#include <string>
+#include "xolotlPerf/IHardwareCounter.h"
+#include "xolotlPerf/os/PerfEventCounterGroup.h"
+#include "xolotlCore/Identifiable.h"
+
+namespace xolotlPerf {
+
+/// A collection of hardware performance counters read through the Linux
+/// perf_event_open interface. Only the thread that starts and stops the
+/// collection is counted.
+class PerfEventHardwareCounter: public IHardwareCounter,
+		public xolotlCore::Identifiable {
+private:
+	/// The counters.
+	PerfEventCounterGroup group;
+
+	/// The hardware performance counter values we have collected.
+	/// These are only valid after the collection has stopped counting.
+	IHardwareCounter::ValType vals;
+
+	/// The counts when the collection was started.
+	IHardwareCounter::ValType startVals;
+
+	/// Are we counting?
+	bool running;
+
+public:
+
+	/// Construct a PerfEventHardwareCounter.
+	///
+	/// @param name The name to associate with the collected counts.
+	/// @param cset The collection of hardware counter spec values indicating
+	///             The set of hardware counters we should monitor.
+	PerfEventHardwareCounter(const std::string& name,
+			const IHardwareCounter::SpecType& cset) :
+			xolotlCore::Identifiable(name), group(cset), vals(cset.size(),
+					0), startVals(cset.size(), 0), running(false) {
+	}
+
+	/// Destroy the counter set.
+	virtual ~PerfEventHardwareCounter(void) {
+	}
+
+	/// Start counting hardware counter events.
+	/// Throws std::runtime_error if already counting.
+	void start(void) override;
+
+	/// Stop counting hardware counter events, the counts are added to
+	/// the ones of the previous collections.
+	/// Throws std::runtime_error if not counting.
+	void stop(void) override;
+
+	///
+	/// Retrieve the values of the hardware counters that have been collected.
+	/// The values are only valid if the counter set is not currently counting.
+	///
+	/// @return The current counts for our configured values.
+	///
+	const ValType& getValues(void) const override {
+		return vals;
+	}
+
+	///
+	/// Retrieve the configuration of the IHardwareCounter.
+	///
+	/// @return The hardware counters the counter set was configured to collect.
+	///
+	const SpecType& getSpecification(void) const override {
+		return group.getSpecification();
+	}
+
+	/// Retrieve the name of the given hardware counter.
+	/// @return The name of the given hardware counter.
+	std::string getCounterName(IHardwareCounter::CounterSpec cs) const
+			override {
+		return group.getCounterName(cs);
+	}
+};
+
+} // namespace xolotlPerf
+
+#endif // PERFEVENTHARDWARECOUNTER_H
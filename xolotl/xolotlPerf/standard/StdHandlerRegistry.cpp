@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <cassert>
 #include <tuple>
+#include <set>
 #include "mpi.h"
 #include <unistd.h>
 #include <float.h>
@@ -303,6 +305,174 @@ void StdHandlerRegistry::AggregateStatistics(int myRank,
 	}
 }
 
+void StdHandlerRegistry::AggregatePhaseStatistics(int myRank) {
+	phaseStats.clear();
+	auto records = getPhaseTree().getRecords();
+
+	// The hardware counters are the same on every process
+	phaseCounterSpec.clear();
+	std::vector<std::string> counterNames;
+	auto counters = getPhaseTree().getCounters();
+	if (counters) {
+		phaseCounterSpec = counters->getSpecification();
+		for (auto cs : phaseCounterSpec) {
+			counterNames.push_back(counters->getCounterName(cs));
+		}
+	}
+
+	// Share the keys of our nodes with all the processes, the nodes are
+	// not the same everywhere (a process without trap-mutation never
+	// enters that phase for instance).
+	std::vector<char> myKeys;
+	for (auto const& record : records) {
+		myKeys.insert(myKeys.end(), record.key.begin(), record.key.end());
+		myKeys.push_back('\0');
+	}
+	int nBytes = myKeys.size();
+	int cwSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+	std::vector<int> allCounts(cwSize), allDispls(cwSize, 0);
+	MPI_Allgather(&nBytes, 1, MPI_INT, allCounts.data(), 1, MPI_INT,
+			MPI_COMM_WORLD);
+	for (int i = 1; i < cwSize; ++i) {
+		allDispls[i] = allDispls[i - 1] + allCounts[i - 1];
+	}
+	std::vector<char> allKeys(allDispls[cwSize - 1] + allCounts[cwSize - 1]);
+	MPI_Allgatherv(myKeys.data(), nBytes, MPI_CHAR, allKeys.data(),
+			allCounts.data(), allDispls.data(), MPI_CHAR, MPI_COMM_WORLD);
+
+	// The sorted keys are in the order of the tree, and the same
+	// on every process
+	std::set<std::string> keySet;
+	for (auto pKey = allKeys.data(); pKey < allKeys.data() + allKeys.size();
+			pKey += strlen(pKey) + 1) {
+		keySet.insert(pKey);
+	}
+	std::vector<std::string> keys(keySet.begin(), keySet.end());
+	if (keys.empty())
+		return;
+
+	// Our calls, inclusive and self times, and hardware counts for each
+	// node, zero if we don't know it
+	const int nValues = 3 + phaseCounterSpec.size();
+	int nNodes = keys.size();
+	std::vector<int> known(nNodes, 0);
+	std::vector<double> values(nValues * nNodes, 0.0), minValues(
+			nValues * nNodes, DBL_MAX), squares(nValues * nNodes, 0.0);
+	auto recordIter = records.begin();
+	for (int i = 0; i < nNodes; ++i) {
+		// Both are sorted, our records are a subset of the keys
+		if (recordIter == records.end() || recordIter->key != keys[i])
+			continue;
+
+		known[i] = 1;
+		values[nValues * i] = recordIter->calls;
+		values[nValues * i + 1] = recordIter->inclusive;
+		values[nValues * i + 2] = recordIter->self;
+		std::copy(recordIter->counts.begin(), recordIter->counts.end(),
+				values.begin() + nValues * i + 3);
+		for (int j = nValues * i; j < nValues * (i + 1); ++j) {
+			minValues[j] = values[j];
+			squares[j] = values[j] * values[j];
+		}
+		++recordIter;
+	}
+
+	// Reduce everything at once instead of node by node
+	std::vector<int> processCounts(nNodes, 0);
+	std::vector<double> sums(nValues * nNodes, 0.0), mins(nValues * nNodes,
+			0.0), maxs(nValues * nNodes, 0.0), squaredSums(nValues * nNodes,
+			0.0);
+	MPI_Reduce(known.data(), processCounts.data(), nNodes, MPI_INT, MPI_SUM, 0,
+			MPI_COMM_WORLD);
+	MPI_Reduce(values.data(), sums.data(), nValues * nNodes, MPI_DOUBLE,
+			MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(squares.data(), squaredSums.data(), nValues * nNodes,
+			MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(minValues.data(), mins.data(), nValues * nNodes, MPI_DOUBLE,
+			MPI_MIN, 0, MPI_COMM_WORLD);
+	MPI_Reduce(values.data(), maxs.data(), nValues * nNodes, MPI_DOUBLE,
+			MPI_MAX, 0, MPI_COMM_WORLD);
+
+	if (myRank == 0) {
+		for (int i = 0; i < nNodes; ++i) {
+			PhaseStatistics stats(keys[i]);
+			for (auto const& name : counterNames) {
+				stats.counts.emplace_back(name);
+			}
+			std::vector<PerfObjStatistics<double>*> objStats = { &stats.calls,
+					&stats.inclusive, &stats.self };
+			for (auto& objStat : stats.counts) {
+				objStats.push_back(&objStat);
+			}
+			for (int j = 0; j < nValues; ++j) {
+				int idx = nValues * i + j;
+				auto& objStat = *objStats[j];
+				objStat.processCount = processCounts[i];
+				objStat.min = mins[idx];
+				objStat.max = maxs[idx];
+				objStat.average = sums[idx] / processCounts[i];
+				objStat.stdev = sqrt(
+						std::max(
+								squaredSums[idx] / processCounts[i]
+										- objStat.average * objStat.average,
+								0.0));
+			}
+			phaseStats.push_back(stats);
+		}
+	}
+}
+
+void StdHandlerRegistry::AggregateMemoryStatistics(int myRank) {
+	memoryStats.clear();
+
+	// Every process knows all the categories
+	auto const& tracker = getMemoryTracker();
+	const int nValues = (int) MemoryCategory::Count + 2;
+	std::vector<double> values(nValues), squares(nValues);
+	for (int i = 0; i < (int) MemoryCategory::Count; ++i) {
+		values[i] = tracker.getPeak((MemoryCategory) i);
+	}
+	values[nValues - 2] = tracker.getTotalPeak();
+	values[nValues - 1] = getProcessPeakMemory();
+	for (int i = 0; i < nValues; ++i) {
+		squares[i] = values[i] * values[i];
+	}
+
+	std::vector<double> sums(nValues, 0.0), mins(nValues, 0.0), maxs(nValues,
+			0.0), squaredSums(nValues, 0.0);
+	MPI_Reduce(values.data(), sums.data(), nValues, MPI_DOUBLE, MPI_SUM, 0,
+			MPI_COMM_WORLD);
+	MPI_Reduce(squares.data(), squaredSums.data(), nValues, MPI_DOUBLE,
+			MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(values.data(), mins.data(), nValues, MPI_DOUBLE, MPI_MIN, 0,
+			MPI_COMM_WORLD);
+	MPI_Reduce(values.data(), maxs.data(), nValues, MPI_DOUBLE, MPI_MAX, 0,
+			MPI_COMM_WORLD);
+
+	if (myRank == 0) {
+		int cwSize;
+		MPI_Comm_size(MPI_COMM_WORLD, &cwSize);
+		for (int i = 0; i < nValues; ++i) {
+			std::string name;
+			if (i < (int) MemoryCategory::Count)
+				name = getMemoryCategoryName((MemoryCategory) i);
+			else
+				name = (i == nValues - 2) ? "total" : "process";
+			PerfObjStatistics<double> objStat(name);
+			objStat.processCount = cwSize;
+			objStat.min = mins[i];
+			objStat.max = maxs[i];
+			objStat.average = sums[i] / cwSize;
+			objStat.stdev = sqrt(
+					std::max(
+							squaredSums[i] / cwSize
+									- objStat.average * objStat.average, 0.0));
+			memoryStats.push_back(objStat);
+		}
+	}
+}
+
 void StdHandlerRegistry::collectStatistics(
 		PerfObjStatsMap<ITimer::ValType>& timerStats,
 		PerfObjStatsMap<IEventCounter::ValType>& counterStats,
@@ -321,6 +491,12 @@ void StdHandlerRegistry::collectStatistics(
 	// ...finally hardware counters.
 	AggregateStatistics<IHardwareCounter, IHardwareCounter::CounterType>(myRank,
 			allHWCounterSets, hwCounterStats);
+
+	// ...the phase tree...
+	AggregatePhaseStatistics(myRank);
+
+	// ...and the memory high-water marks.
+	AggregateMemoryStatistics(myRank);
 }
 
 void StdHandlerRegistry::reportStatistics(std::ostream& os,
@@ -332,6 +508,14 @@ void StdHandlerRegistry::reportStatistics(std::ostream& os,
 		iter->second.outputTo(os);
 	}
 
+	// The memory high-water marks of each process, in bytes
+	if (!memoryStats.empty()) {
+		os << "\nMemory:\n";
+	}
+	for (auto const& objStats : memoryStats) {
+		objStats.outputTo(os);
+	}
+
 	os << "\nCounters:\n";
 	for (auto iter = counterStats.begin(); iter != counterStats.end(); ++iter) {
 		iter->second.outputTo(os);
@@ -342,6 +526,37 @@ void StdHandlerRegistry::reportStatistics(std::ostream& os,
 			++iter) {
 		iter->second.outputTo(os);
 	}
+
+	// The phase tree, each node indented below its parent
+	if (!phaseStats.empty()) {
+		os << "\nPhases:\n";
+	}
+	for (auto const& stats : phaseStats) {
+		std::string indent(2 * stats.key.size(), ' ');
+		os << indent << getPhaseName(stats.getPhase()) << ":\n" << indent
+				<< "  " << "process_count: " << stats.calls.processCount
+				<< '\n';
+		for (auto objStats : { &stats.calls, &stats.inclusive, &stats.self }) {
+			os << indent << "  " << objStats->name << ": min " << objStats->min
+					<< ", max " << objStats->max << ", average "
+					<< objStats->average << '\n';
+		}
+		double instructions = 0.0, cycles = 0.0;
+		for (std::size_t i = 0; i < stats.counts.size(); ++i) {
+			auto const& objStats = stats.counts[i];
+			os << indent << "  " << objStats.name << ": min " << objStats.min
+					<< ", max " << objStats.max << ", average "
+					<< objStats.average << '\n';
+			if (phaseCounterSpec[i] == IHardwareCounter::Instructions)
+				instructions = objStats.average;
+			else if (phaseCounterSpec[i] == IHardwareCounter::Cycles)
+				cycles = objStats.average;
+		}
+		if (cycles > 0.0) {
+			os << indent << "  " << "instructions_per_cycle: "
+					<< instructions / cycles << '\n';
+		}
+	}
 }
 
 } // namespace xolotlPerf
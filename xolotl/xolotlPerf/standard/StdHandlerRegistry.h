@@ -5,6 +5,8 @@
 #include <memory>
 #include "xolotlPerf/IHandlerRegistry.h"
 #include "xolotlPerf/PerfObjStatistics.h"
+#include "xolotlPerf/MemoryTracker.h"
+#include "xolotlPerf/PhaseTimer.h"
 
 namespace xolotlPerf {
 
@@ -13,7 +15,84 @@ namespace xolotlPerf {
  * collect data (as opposed to low-overhead stubs).
  */
 class StdHandlerRegistry: public IHandlerRegistry {
+public:
+
+	/**
+	 * Statistics of a node of the phase tree across all the processes.
+	 */
+	struct PhaseStatistics {
+		//! The path of the node, as in PhaseTree::Record.
+		std::string key;
+
+		//! The number of times the phase was entered.
+		PerfObjStatistics<double> calls;
+
+		//! The time spent in the phase, children included.
+		PerfObjStatistics<double> inclusive;
+
+		//! The time spent in the phase itself.
+		PerfObjStatistics<double> self;
+
+		//! The hardware counts of the phase, children included, one for
+		//! each counter of the phase tree.
+		std::vector<PerfObjStatistics<double> > counts;
+
+		/**
+		 * Construct statistics with default values.
+		 * @param _key The path of the node.
+		 */
+		PhaseStatistics(const std::string& _key) :
+				key(_key), calls("calls"), inclusive("inclusive"), self(
+						"self") {
+		}
+
+		/**
+		 * Get the phase of the node.
+		 * @return The phase.
+		 */
+		Phase getPhase() const {
+			return (Phase) (key.back() - 'A');
+		}
+	};
+
 private:
+
+	/**
+	 * Statistics of the phase tree, in the order of the tree.
+	 * Only meaningful in process with MPI rank 0.
+	 */
+	std::vector<PhaseStatistics> phaseStats;
+
+	/**
+	 * The hardware counters of the phase tree, if any.
+	 */
+	IHardwareCounter::SpecType phaseCounterSpec;
+
+	/**
+	 * Statistics of the memory high-water marks in bytes, one for each
+	 * category of the memory tracker, then their total and the resident
+	 * memory of the whole process.
+	 * Only meaningful in process with MPI rank 0.
+	 */
+	std::vector<PerfObjStatistics<double> > memoryStats;
+
+	/**
+	 * Collect the memory high-water marks from all program processes.
+	 * In the process with rank 0, compute statistics for each category
+	 * and populate memoryStats with them.
+	 *
+	 * @param myRank This process' MPI rank.
+	 */
+	void AggregateMemoryStatistics(int myRank);
+
+	/**
+	 * Collect the phase trees from all program processes.
+	 * In the process with rank 0, compute statistics for each node
+	 * known by any process and populate phaseStats with them.
+	 *
+	 * @param myRank This process' MPI rank.
+	 */
+	void AggregatePhaseStatistics(int myRank);
 	/**
 	 * Collect performance data from all program processes.
 	 * In the process with rank 0, compute statistics for each
@@ -145,6 +224,29 @@ public:
         const PerfObjStatsMap<IEventCounter::ValType>& counterStats,
         const PerfObjStatsMap<IHardwareCounter::CounterType>& hwStats) const override;
 
+	/**
+	 * Access the statistics of the phase tree computed by the last
+	 * call to collectStatistics.
+	 * Only meaningful in process with MPI rank 0.
+	 *
+	 * @return The statistics of each node, in the order of the tree.
+	 */
+	const std::vector<PhaseStatistics>& getPhaseStatistics() const {
+		return phaseStats;
+	}
+
+	/**
+	 * Access the statistics of the memory high-water marks computed by
+	 * the last call to collectStatistics.
+	 * Only meaningful in process with MPI rank 0.
+	 *
+	 * @return The statistics of each category, then of the total and of
+	 * the process.
+	 */
+	const std::vector<PerfObjStatistics<double> >& getMemoryStatistics() const {
+		return memoryStats;
+	}
+
 };
 
 } // namespace xolotlPerf
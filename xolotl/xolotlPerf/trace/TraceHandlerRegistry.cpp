@@ -0,0 +1,49 @@
+#include "xolotlPerf/trace/TraceHandlerRegistry.h"
+#include "xolotlPerf/trace/TraceTimer.h"
+#include "xolotlPerf/PhaseTimer.h"
+
+namespace xolotlPerf {
+
+const std::string TraceHandlerRegistry::traceFileName = "xolotlTrace.json";
+
+TraceHandlerRegistry::TraceHandlerRegistry(void) {
+	getTraceRecorder().start(MPI_COMM_WORLD, traceFileName, traceCapacity);
+	getPhaseTree().setTraceDepth(traceDepth);
+}
+
+TraceHandlerRegistry::~TraceHandlerRegistry(void) {
+	getPhaseTree().setTraceDepth(0);
+}
+
+std::shared_ptr<ITimer> TraceHandlerRegistry::getTimer(
+		const std::string& name) {
+	std::shared_ptr<ITimer> ret;
+
+	// check if we have already created a timer with this name
+	auto iter = allTimers.find(name);
+	if (iter != allTimers.end()) {
+		// We have already created a timer with this name.
+		// Return it.
+		ret = iter->second;
+	} else {
+		// We have not yet created a timer with this name.
+		// Build one, and keep track of it.
+		ret = std::make_shared<TraceTimer>(name);
+		allTimers[name] = ret;
+	}
+	return ret;
+}
+
+void TraceHandlerRegistry::collectStatistics(
+		PerfObjStatsMap<ITimer::ValType>& timerStats,
+		PerfObjStatsMap<IEventCounter::ValType>& counterStats,
+		PerfObjStatsMap<IHardwareCounter::CounterType>& hwStats) {
+	StdHandlerRegistry::collectStatistics(timerStats, counterStats, hwStats);
+
+	// Nothing else will be recorded
+	getTraceRecorder().finish();
+
+	return;
+}
+
+} // namespace xolotlPerf
@@ -0,0 +1,59 @@
+#ifndef TRACEHANDLERREGISTRY_H
+#define TRACEHANDLERREGISTRY_H
+
+#include "xolotlPerf/os/OSHandlerRegistry.h"
+
+namespace xolotlPerf {
+
+/**
+ * Factory for building performance data collection objects that use an
+ * OS/runtime timer API and also record every interval the timers and the
+ * outer phases measure on a timeline. The timeline of every process is
+ * written to a Chrome trace event file when the statistics are collected,
+ * or before if the solver is asked to.
+ */
+class TraceHandlerRegistry: public OSHandlerRegistry {
+public:
+
+	/// The file the trace is written to.
+	static const std::string traceFileName;
+
+	/// The number of events each thread keeps between two writes.
+	static const std::size_t traceCapacity = 1 << 16;
+
+	/// The deepest phases that are traced.
+	static const int traceDepth = 2;
+
+	/// Construct a handler registry and start recording the trace.
+	/// Must be called by every process.
+	TraceHandlerRegistry(void);
+
+	/// Destroy the handler registry.
+	virtual ~TraceHandlerRegistry(void);
+
+	/**
+	 * Look up and return a named timer.
+	 * Create the timer if it does not already exist.
+	 *
+	 * @param name The object's name.
+	 * @return The object with the given name.
+	 */
+	std::shared_ptr<ITimer> getTimer(const std::string& name) override;
+
+	/**
+	 * Collect statistics about any performance data collected by
+	 * processes of the program, then write the end of the trace.
+	 * Must be called by every process.
+	 *
+	 * @param timerStats Map of timer statistics, keyed by timer name.
+	 * @param counterStats Map of counter statistics, keyed by counter name.
+	 * @param hwStats Map of hardware counter statistics, keyed by IHardwareCounter name + ':' + hardware counter name.
+	 */
+	void collectStatistics(PerfObjStatsMap<ITimer::ValType>& timerStats,
+			PerfObjStatsMap<IEventCounter::ValType>& counterStats,
+			PerfObjStatsMap<IHardwareCounter::CounterType>& hwStats) override;
+};
+
+} // namespace xolotlPerf
+
+#endif // TRACEHANDLERREGISTRY_H
@@ -0,0 +1,220 @@
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "xolotlPerf/trace/TraceRecorder.h"
+
+namespace xolotlPerf {
+
+/**
+ * Write a string in JSON.
+ *
+ * @param os The stream
+ * @param str The string
+ */
+static void writeJSONString(std::ostream& os, const char* str) {
+	os << '"';
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			os << '\\';
+		os << *str;
+	}
+	os << '"';
+
+	return;
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::getThreadBuffer() {
+	// There is only one recorder so each thread only needs to remember
+	// its own buffer
+	static thread_local ThreadBuffer* threadBuffer = nullptr;
+	if (!threadBuffer) {
+		std::lock_guard<std::mutex> lock(recorderMutex);
+		buffers.emplace_back(new ThreadBuffer());
+		threadBuffer = buffers.back().get();
+		threadBuffer->tid = buffers.size() - 1;
+		threadBuffer->events.resize(capacity);
+		threadBuffer->next = 0;
+		threadBuffer->size = 0;
+		threadBuffer->dropped = 0;
+	}
+
+	return *threadBuffer;
+}
+
+void TraceRecorder::start(MPI_Comm _comm, const std::string& _fileName,
+		std::size_t _capacity) {
+	if (_capacity == 0) {
+		throw std::invalid_argument(
+				"TraceRecorder: the buffers need room for at least one event.");
+	}
+
+	// Forget what was recorded before
+	enabled = false;
+	capacity = _capacity;
+	comm = _comm;
+	fileName = _fileName;
+	for (auto& buffer : buffers) {
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		buffer->events.resize(capacity);
+		buffer->next = 0;
+		buffer->size = 0;
+		buffer->dropped = 0;
+	}
+
+	// Start the file with the name of every process
+	int rank, size;
+	MPI_Comm_rank(comm, &rank);
+	MPI_Comm_size(comm, &size);
+	if (rank == 0) {
+		std::ofstream outputFile(fileName);
+		if (!outputFile) {
+			throw std::runtime_error(
+					"TraceRecorder: unable to open " + fileName + ".");
+		}
+		outputFile << "[";
+		for (int i = 0; i < size; i++) {
+			outputFile << (i == 0 ? "\n" : ",\n")
+					<< "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << i
+					<< ",\"args\":{\"name\":\"rank " << i << "\"}}";
+		}
+	}
+
+	// All the timelines start here
+	MPI_Barrier(comm);
+	origin = Clock::now();
+	enabled = true;
+
+	return;
+}
+
+const char* TraceRecorder::intern(const std::string& name) {
+	std::lock_guard<std::mutex> lock(recorderMutex);
+	return names.insert(name).first->c_str();
+}
+
+void TraceRecorder::record(const char* name, const char* category,
+		Clock::time_point start, Clock::time_point end, const char* argName,
+		long arg) {
+	if (!enabled)
+		return;
+
+	auto& buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+
+	// Overwrite the oldest event if the ring is full
+	auto& event = buffer.events[buffer.next];
+	event.name = name;
+	event.category = category;
+	event.argName = argName;
+	event.arg = arg;
+	event.start = start;
+	event.end = end;
+	buffer.next = (buffer.next + 1) % capacity;
+	if (buffer.size < capacity)
+		buffer.size++;
+	else
+		buffer.dropped++;
+
+	return;
+}
+
+std::string TraceRecorder::formatEvents(int rank) {
+	using Microseconds = std::chrono::duration<double, std::micro>;
+
+	std::ostringstream os;
+	os << std::fixed << std::setprecision(3);
+
+	std::lock_guard<std::mutex> lock(recorderMutex);
+	for (auto& buffer : buffers) {
+		std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+		// From the oldest event to the newest
+		std::size_t first = (buffer->next + capacity - buffer->size)
+				% capacity;
+		for (std::size_t i = 0; i < buffer->size; i++) {
+			auto const& event = buffer->events[(first + i) % capacity];
+			os << ",\n{\"name\":";
+			writeJSONString(os, event.name);
+			os << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":"
+					<< rank << ",\"tid\":" << buffer->tid << ",\"ts\":"
+					<< Microseconds(event.start - origin).count()
+					<< ",\"dur\":"
+					<< Microseconds(event.end - event.start).count();
+			if (event.argName)
+				os << ",\"args\":{\"" << event.argName << "\":" << event.arg
+						<< "}";
+			os << "}";
+		}
+
+		// Say when events were lost
+		if (buffer->dropped > 0) {
+			os << ",\n{\"name\":\"droppedEvents\",\"cat\":\"trace\","
+					"\"ph\":\"i\",\"s\":\"t\",\"pid\":" << rank << ",\"tid\":"
+					<< buffer->tid << ",\"ts\":"
+					<< Microseconds(Clock::now() - origin).count()
+					<< ",\"args\":{\"count\":" << buffer->dropped << "}}";
+		}
+
+		buffer->size = 0;
+		buffer->dropped = 0;
+	}
+
+	return os.str();
+}
+
+void TraceRecorder::write() {
+	if (!enabled)
+		return;
+
+	int rank, size;
+	MPI_Comm_rank(comm, &rank);
+	MPI_Comm_size(comm, &size);
+
+	// Gather the events of every process on the first one
+	std::string events = formatEvents(rank);
+	int length = events.size();
+	std::vector<int> lengths(size, 0), displs(size, 0);
+	MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, comm);
+	int totalLength = 0;
+	for (int i = 0; i < size; i++) {
+		displs[i] = totalLength;
+		totalLength += lengths[i];
+	}
+	std::vector<char> allEvents(rank == 0 ? totalLength : 0);
+	MPI_Gatherv(&events[0], length, MPI_CHAR, allEvents.data(),
+			lengths.data(), displs.data(), MPI_CHAR, 0, comm);
+
+	// Append them to the file
+	if (rank == 0 && totalLength > 0) {
+		std::ofstream outputFile(fileName, std::ios::app);
+		outputFile.write(allEvents.data(), totalLength);
+	}
+
+	return;
+}
+
+void TraceRecorder::finish() {
+	if (!enabled)
+		return;
+
+	write();
+	enabled = false;
+
+	// Close the array
+	int rank;
+	MPI_Comm_rank(comm, &rank);
+	if (rank == 0) {
+		std::ofstream outputFile(fileName, std::ios::app);
+		outputFile << "\n]\n";
+	}
+
+	return;
+}
+
+TraceRecorder& getTraceRecorder() {
+	static TraceRecorder theRecorder;
+	return theRecorder;
+}
+
+} // namespace xolotlPerf
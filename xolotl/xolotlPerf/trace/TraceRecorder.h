@@ -0,0 +1,192 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <mpi.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace xolotlPerf {
+
+/**
+ * This class records what the timers and phases measured as events on a
+ * timeline and writes them in the Chrome trace event format, which can be
+ * opened with chrome://tracing or Perfetto. Every process writes its
+ * events to the same file, one process per MPI rank and one thread per
+ * thread that recorded events.
+ *
+ * Each thread records its events in its own ring buffer, when it is full
+ * the oldest events are dropped. The buffers are emptied every time the
+ * events are written.
+ */
+class TraceRecorder {
+public:
+
+	//! The clock used for the timeline.
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * An event, something that started and ended.
+	 */
+	struct Event {
+		//! The name of the event.
+		const char* name;
+
+		//! Its category.
+		const char* category;
+
+		//! The name of its argument, null if there is none.
+		const char* argName;
+
+		//! The value of its argument.
+		long arg;
+
+		//! When it started.
+		Clock::time_point start;
+
+		//! When it ended.
+		Clock::time_point end;
+	};
+
+private:
+
+	/**
+	 * The events recorded by a thread.
+	 */
+	struct ThreadBuffer {
+		//! The number of the thread in the trace.
+		int tid;
+
+		//! Protects the events from the writer.
+		std::mutex mutex;
+
+		//! The ring of events.
+		std::vector<Event> events;
+
+		//! Where the next event goes.
+		std::size_t next;
+
+		//! The number of events in the ring.
+		std::size_t size;
+
+		//! The number of events dropped since the last write.
+		unsigned long dropped;
+	};
+
+	//! Protects the list of buffers and the names.
+	std::mutex recorderMutex;
+
+	//! The buffer of each thread.
+	std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+
+	//! The names of the events that are not string literals.
+	std::set<std::string> names;
+
+	//! Are the events recorded?
+	bool enabled;
+
+	//! The number of events each thread can keep.
+	std::size_t capacity;
+
+	//! The beginning of the timeline.
+	Clock::time_point origin;
+
+	//! The communicator of the processes writing to the file.
+	MPI_Comm comm;
+
+	//! The file to write.
+	std::string fileName;
+
+	/**
+	 * Get the buffer of the calling thread, creating it if needed.
+	 *
+	 * @return The buffer
+	 */
+	ThreadBuffer& getThreadBuffer();
+
+	/**
+	 * Format the events of this process and empty the buffers.
+	 *
+	 * @param rank The MPI rank of this process
+	 * @return The events in JSON, each one starting with a comma
+	 */
+	std::string formatEvents(int rank);
+
+public:
+
+	/**
+	 * The constructor, the events are not recorded.
+	 */
+	TraceRecorder() :
+			enabled(false), capacity(0), comm(MPI_COMM_NULL) {
+	}
+
+	/**
+	 * Start recording. Every process has to call it at the same time,
+	 * this is where the timelines of the processes are aligned.
+	 *
+	 * @param _comm The communicator of the processes writing to the file
+	 * @param _fileName The file to write
+	 * @param _capacity The number of events each thread can keep between
+	 * two writes
+	 */
+	void start(MPI_Comm _comm, const std::string& _fileName,
+			std::size_t _capacity);
+
+	/**
+	 * Are the events recorded?
+	 *
+	 * @return True if they are
+	 */
+	bool isEnabled() const {
+		return enabled;
+	}
+
+	/**
+	 * Get a name that stays valid as long as the recorder, to name events
+	 * with strings that are not literals.
+	 *
+	 * @param name The name
+	 * @return The same name
+	 */
+	const char* intern(const std::string& name);
+
+	/**
+	 * Record an event.
+	 *
+	 * @param name The name of the event, it has to stay valid
+	 * @param category Its category, it has to stay valid
+	 * @param start When it started
+	 * @param end When it ended
+	 * @param argName The name of its argument, if any
+	 * @param arg The value of its argument
+	 */
+	void record(const char* name, const char* category, Clock::time_point start,
+			Clock::time_point end, const char* argName = nullptr, long arg = 0);
+
+	/**
+	 * Write the events recorded by every process since the last write,
+	 * appending them to the file. Every process has to call it.
+	 */
+	void write();
+
+	/**
+	 * Write the last events, close the file and stop recording. Every
+	 * process has to call it.
+	 */
+	void finish();
+};
+
+/**
+ * Get the trace recorder of this process.
+ *
+ * @return The recorder
+ */
+TraceRecorder& getTraceRecorder();
+
+} // namespace xolotlPerf
+
+#endif // TRACERECORDER_H
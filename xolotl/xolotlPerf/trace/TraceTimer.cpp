@@ -0,0 +1,16 @@
+#include "xolotlPerf/trace/TraceTimer.h"
+
+namespace xolotlPerf {
+
+void TraceTimer::start(void) {
+	OSTimer::start();
+	traceStartTime = TraceRecorder::Clock::now();
+}
+
+void TraceTimer::stop(void) {
+	OSTimer::stop();
+	getTraceRecorder().record(traceName, "timer", traceStartTime,
+			TraceRecorder::Clock::now());
+}
+
+} // namespace xolotlPerf
@@ -0,0 +1,49 @@
+#ifndef TRACETIMER_H
+#define TRACETIMER_H
+
+#include "xolotlPerf/os/OSTimer.h"
+#include "xolotlPerf/trace/TraceRecorder.h"
+
+namespace xolotlPerf {
+
+/// A timer that also records each interval it measures on the timeline
+/// of the trace recorder.
+class TraceTimer: public OSTimer {
+private:
+	/// The name of the timer in the trace.
+	const char* traceName;
+
+	/// When the timer was started, on the clock of the trace.
+	TraceRecorder::Clock::time_point traceStartTime;
+
+public:
+	///
+	/// Construct a timer.
+	///
+	/// @param name The name to associate with the timer.
+	TraceTimer(const std::string& name) :
+			OSTimer(name), traceName(getTraceRecorder().intern(name)) {
+	}
+
+	///
+	/// Destroy the timer.
+	///
+	virtual ~TraceTimer(void) {
+	}
+
+	///
+	/// Start the timer.
+	/// Throws std::runtime_error if starting a timer that was already started.
+	///
+	void start(void) override;
+
+	///
+	/// Stop the timer and record the interval.
+	/// Throws std::runtime_error if stopping a timer that was not running.
+	///
+	void stop(void) override;
+};
+
+} // namespace xolotlPerf
+
+#endif // TRACETIMER_H
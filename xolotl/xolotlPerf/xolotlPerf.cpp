@@ -4,17 +4,25 @@
 #include "xolotlPerf/xolotlPerf.h"
 #include "xolotlPerf/dummy/DummyHandlerRegistry.h"
 #include "xolotlPerf/os/OSHandlerRegistry.h"
+#include "xolotlPerf/trace/TraceHandlerRegistry.h"
 
 #if defined(HAVE_PAPI)
 #include "xolotlPerf/papi/PAPIHandlerRegistry.h"
 #endif // defined(HAVE_PAPI)
 
+#if defined(HAVE_PERF_EVENT)
+#include "xolotlPerf/os/PerfEventCounterGroup.h"
+#endif // defined(HAVE_PERF_EVENT)
+
 namespace xolotlPerf {
 
 static std::shared_ptr<IHandlerRegistry> theHandlerRegistry;
 
 // Create the desired type of handler registry.
 void initialize(IHandlerRegistry::RegistryType rtype) {
+	// Only the perf registry counts the hardware events of the phases
+	getPhaseTree().setCounters(nullptr);
+
 	switch (rtype) {
 	case IHandlerRegistry::dummy:
 		theHandlerRegistry = std::make_shared<DummyHandlerRegistry>();
@@ -37,11 +45,37 @@ void initialize(IHandlerRegistry::RegistryType rtype) {
 #endif // defined(HAVE_PAPI)
 		break;
 
+	case IHandlerRegistry::trace:
+		theHandlerRegistry = std::make_shared<TraceHandlerRegistry>();
+		break;
+
+	case IHandlerRegistry::perf:
+#if defined(HAVE_PERF_EVENT)
+		theHandlerRegistry = std::make_shared<OSHandlerRegistry>();
+		// The OpenMP threads of the network work inside the phases of
+		// the master thread, count them too
+		getPhaseTree().setCounters(
+				std::make_shared<PerfEventCounterGroup>(
+						IHardwareCounter::SpecType { IHardwareCounter::Instructions,
+								IHardwareCounter::Cycles,
+								IHardwareCounter::L1CacheMisses,
+								IHardwareCounter::L3CacheMisses,
+								IHardwareCounter::BranchMispredictions },
+						true));
+#else
+		throw std::invalid_argument(
+				"perf handler registry requested but no perf_event support was found when the program was built.");
+#endif // defined(HAVE_PERF_EVENT)
+		break;
+
 	default:
 		throw std::invalid_argument(
 				"unrecognized performance handler registry type requested");
 		break;
 	}
+
+	// Only time the phases when the data is collected
+	getPhaseTree().setEnabled(rtype != IHandlerRegistry::dummy);
 }
 
 // Provide access to our handler registry.
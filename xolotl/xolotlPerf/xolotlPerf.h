@@ -5,7 +5,10 @@
 #include <sstream>
 #include "IHandlerRegistry.h"
 #include "ITimer.h"
+#include "MemoryTracker.h"
+#include "PhaseTimer.h"
 #include "RuntimeError.h"
+#include "trace/TraceRecorder.h"
 
 namespace xolotlPerf {
 
@@ -34,6 +37,10 @@ inline IHandlerRegistry::RegistryType toPerfRegistryType(
 		ret = IHandlerRegistry::os;
 	} else if (arg == "papi") {
 		ret = IHandlerRegistry::papi;
+	} else if (arg == "trace") {
+		ret = IHandlerRegistry::trace;
+	} else if (arg == "perf") {
+		ret = IHandlerRegistry::perf;
 	} else {
 		std::ostringstream estr;
 		estr << "Invalid performance handler argument \"" << arg << "\" seen.";
@@ -98,6 +98,41 @@ public:
 	virtual void computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			PetscReal ftime) = 0;
 
+	/**
+	 * Compute the concentration of trapped atoms near the surface and give
+	 * it to the trap-mutation handler for the attenuation. Nothing is done
+	 * without attenuation or if it was already computed for this state of
+	 * the solution.
+	 *
+	 * @param ts The PETSc time stepper
+	 * @param C The PETSc global solution vector
+	 */
+	virtual void updateAttenuation(TS &ts, Vec &C) = 0;
+
+	/**
+	 * Create a new distributed array where the active grid points are evenly
+	 * shared between the processes, migrate the solution vector to it, and
+	 * rebuild everything that depends on the locally owned grid points.
+	 *
+	 * @param da The PETSc distributed array, replaced by the new one
+	 * @param C The PETSc solution vector, replaced by the migrated one
+	 */
+	virtual void repartitionSolverContext(DM &da, Vec &C) = 0;
+
+	/**
+	 * Set whether the solver should repartition the grid before continuing.
+	 *
+	 * @param flag True if the grid should be repartitioned
+	 */
+	virtual void setRepartitionNeeded(bool flag) = 0;
+
+	/**
+	 * To know if the grid should be repartitioned.
+	 *
+	 * @return True if the grid should be repartitioned
+	 */
+	virtual bool repartitionNeeded() const = 0;
+
 	/**
 	 * Get the grid in the x direction.
 	 *
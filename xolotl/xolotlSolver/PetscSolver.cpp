@@ -1,11 +1,16 @@
 // Includes
 #include <cassert>
 #include <PetscSolver.h>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include "xolotlCore/io/XFile.h"
+#include "xolotlSolver/monitor/TelemetrySink.h"
+#include <xolotlPerf.h>
 
 using namespace xolotlCore;
+namespace xperf = xolotlPerf;
 
 /*
  C_t =  -D*C_xx + A*C_x + F(C) + R(C) + D(C) from Brian Wirth's SciDAC project.
@@ -32,6 +37,27 @@ std::shared_ptr<xolotlPerf::ITimer> RHSFunctionTimer;
 ////Timer for RHSJacobian()
 std::shared_ptr<xolotlPerf::ITimer> RHSJacobianTimer;
 
+//! Whether the attenuation is only updated once per time step.
+static bool attenuationLag = false;
+
+//! The number of time steps between two writes of the trace, 0 for the end only.
+static PetscInt traceInterval = 0;
+
+//! The number of time steps between two gathers of the solver health, 0 if it is not recorded.
+static PetscInt healthInterval = 0;
+
+//! The number of RHS function calls since the last time step.
+static unsigned long nRHSFunction = 0;
+
+//! The number of RHS Jacobian calls since the last time step.
+static unsigned long nRHSJacobian = 0;
+
+//! The time this process spent in the RHS function since the last time step.
+static double rhsFunctionTime = 0.0;
+
+//! The memory reported for the Jacobian.
+static xperf::TrackedMemory jacobianMemory(xperf::MemoryCategory::Jacobian);
+
 //! Help message
 static char help[] =
 		"Solves C_t =  -D*C_xx + A*C_x + F(C) + R(C) + D(C) from Brian Wirth's SciDAC project.\n";
@@ -42,6 +68,9 @@ extern PetscErrorCode setupPetsc1DMonitor(TS,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry>);
 extern PetscErrorCode setupPetsc2DMonitor(TS);
 extern PetscErrorCode setupPetsc3DMonitor(TS);
+extern void finalizeCheckpoints();
+extern void finalizeTelemetry();
+extern TelemetrySink& getTelemetry();
 
 void PetscSolver::setupInitialConditions(DM da, Vec C) {
 	// Initialize the concentrations in the solution vector
@@ -71,6 +100,8 @@ void PetscSolver::setupInitialConditions(DM da, Vec C) {
 PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F, void *) {
 	// Start the RHSFunction Timer
 	RHSFunctionTimer->start();
+	auto functionStart = std::chrono::steady_clock::now();
+	xperf::ScopedPhase functionPhase(xperf::Phase::RHSFunction);
 
 	PetscErrorCode ierr;
 
@@ -87,21 +118,32 @@ PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F, void *) {
 	// DMGlobalToLocalBegin(),DMGlobalToLocalEnd().
 	// By placing code between these two statements, computations can be
 	// done while messages are in transition.
+	xperf::ScopedPhase phase(xperf::Phase::GhostExchange);
 	ierr = DMGlobalToLocalBegin(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
 	ierr = DMGlobalToLocalEnd(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
+	phase.leave();
 
 	// Set the initial values of F
 	ierr = VecSet(F, 0.0);
 	CHKERRQ(ierr);
 
-	// Compute the new concentrations
+	// Update the attenuation for this solution
 	auto& solverHandler = Solver::getSolverHandler();
+	if (!attenuationLag)
+		solverHandler.updateAttenuation(ts, C);
+
+	// Compute the new concentrations
+	phase.enter(xperf::Phase::UpdateConcentration);
 	solverHandler.updateConcentration(ts, localC, F, ftime);
+	phase.leave();
 
 	// Stop the RHSFunction Timer
 	RHSFunctionTimer->stop();
+	nRHSFunction++;
+	rhsFunctionTime += std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - functionStart).count();
 
 	// Return the local vector
 	ierr = DMRestoreLocalVector(da, &localC);
@@ -119,6 +161,7 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 		void *) {
 	// Start the RHSJacobian timer
 	RHSJacobianTimer->start();
+	xperf::ScopedPhase functionPhase(xperf::Phase::RHSJacobian);
 
 	PetscErrorCode ierr;
 
@@ -134,29 +177,40 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 	CHKERRQ(ierr);
 
 	// Get the complete data array
+	xperf::ScopedPhase phase(xperf::Phase::GhostExchange);
 	ierr = DMGlobalToLocalBegin(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
 	ierr = DMGlobalToLocalEnd(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
+	phase.leave();
 
 	// Get the solver handler
 	auto& solverHandler = Solver::getSolverHandler();
 
+	// Update the attenuation for this solution
+	if (!attenuationLag)
+		solverHandler.updateAttenuation(ts, C);
+
 	/* ----- Compute the off-diagonal part of the Jacobian ----- */
+	phase.enter(xperf::Phase::OffDiagonalJacobian);
 	solverHandler.computeOffDiagonalJacobian(ts, localC, J, ftime);
 
+	phase.enter(xperf::Phase::MatrixAssembly);
 	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
 	CHKERRQ(ierr);
 	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
 	CHKERRQ(ierr);
 
 	/* ----- Compute the partial derivatives for the reaction term ----- */
+	phase.enter(xperf::Phase::DiagonalJacobian);
 	solverHandler.computeDiagonalJacobian(ts, localC, J, ftime);
+	phase.leave();
 
 	// Return the local vector
 	ierr = DMRestoreLocalVector(da, &localC);
 	CHKERRQ(ierr);
 
+	phase.enter(xperf::Phase::MatrixAssembly);
 	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
 	CHKERRQ(ierr);
 	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
@@ -168,11 +222,215 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 		ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
 		CHKERRQ(ierr);
 	}
+	phase.leave();
+
+	// Report the size of the matrix, it changes when the grid is
+	// repartitioned
+	MatInfo info;
+	ierr = MatGetInfo(J, MAT_LOCAL, &info);
+	CHKERRQ(ierr);
+	PetscInt nRows;
+	ierr = MatGetLocalSize(J, &nRows, NULL);
+	CHKERRQ(ierr);
+	jacobianMemory.set(
+			PetscSolver::getJacobianMemorySize(nRows,
+					(std::size_t) info.nz_allocated));
 
 //	ierr = MatView(J, PETSC_VIEWER_STDOUT_WORLD);
 
 	// Stop the RHSJacobian timer
 	RHSJacobianTimer->stop();
+	nRHSJacobian++;
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorAttenuation")
+/*
+ Update the attenuation with the accepted solution of each time step when
+ it is lagged (-attenuation_lag).
+ */
+PetscErrorCode monitorAttenuation(TS ts, PetscInt, PetscReal, Vec solution,
+		void *) {
+	PetscFunctionBeginUser;
+
+	auto& solverHandler = Solver::getSolverHandler();
+	solverHandler.updateAttenuation(ts, solution);
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorTrace")
+/*
+ Record each time step on the timeline of the trace, and write the trace
+ every traceInterval time steps (-trace_interval).
+ */
+PetscErrorCode monitorTrace(TS, PetscInt timestep, PetscReal, Vec, void *) {
+	PetscFunctionBeginUser;
+
+	// The monitor is called again with the same time step when the solver
+	// is restarted
+	static PetscInt lastTimestep = -1;
+	static xperf::TraceRecorder::Clock::time_point stepStart;
+	auto now = xperf::TraceRecorder::Clock::now();
+	auto& recorder = xperf::getTraceRecorder();
+	if (timestep > lastTimestep && lastTimestep >= 0) {
+		recorder.record("timestep", "solver", stepStart, now, "step",
+				timestep);
+	}
+	lastTimestep = timestep;
+	stepStart = now;
+
+	// Write what was recorded so far
+	if (traceInterval > 0 && timestep > 0 && timestep % traceInterval == 0)
+		recorder.write();
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorTraceSNES")
+/*
+ Record each nonlinear iteration on the timeline of the trace.
+ */
+PetscErrorCode monitorTraceSNES(SNES, PetscInt its, PetscReal, void *) {
+	PetscFunctionBeginUser;
+
+	static xperf::TraceRecorder::Clock::time_point iterationStart;
+	auto now = xperf::TraceRecorder::Clock::now();
+	if (its > 0) {
+		xperf::getTraceRecorder().record("SNESIteration", "solver",
+				iterationStart, now, "iteration", its);
+	}
+	iterationStart = now;
+
+	PetscFunctionReturn(0);
+}
+
+/**
+ * The solver health of the time steps that were not gathered yet.
+ */
+struct SolverHealth {
+	//! The time step number, time, and size of each time step.
+	std::vector<double> steps;
+
+	//! The nonlinear and linear iterations, rejected steps, RHS function and
+	//! Jacobian calls of each time step.
+	std::vector<double> counts;
+
+	//! The time this process spent in the RHS function at each time step.
+	std::vector<double> rhsTimes;
+};
+
+//! The number of values in SolverHealth::steps and SolverHealth::counts for each time step.
+static const int nHealthSteps = 3, nHealthCounts = 5;
+
+//! The buffered solver health.
+static SolverHealth solverHealth;
+
+/**
+ * Gather the RHS function time of every process for the buffered time
+ * steps on the master process, with a single collective, and push one
+ * record per time step to the "solverHealth.txt" telemetry stream. The
+ * imbalance is the ratio of the maximum to the mean RHS function time.
+ * Every process has to call it.
+ */
+static void writeSolverHealth() {
+	int nSteps = solverHealth.rhsTimes.size();
+	int procId, worldSize;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+	std::vector<double> allTimes(procId == 0 ? nSteps * worldSize : 0);
+	MPI_Gather(solverHealth.rhsTimes.data(), nSteps, MPI_DOUBLE,
+			allTimes.data(), nSteps, MPI_DOUBLE, 0, PETSC_COMM_WORLD);
+
+	if (procId == 0) {
+		for (int i = 0; i < nSteps; i++) {
+			// The RHS function time of each process
+			std::vector<double> times(worldSize);
+			for (int j = 0; j < worldSize; j++) {
+				times[j] = allTimes[j * nSteps + i];
+			}
+			double maxTime = *std::max_element(times.begin(), times.end());
+			double meanTime = 0.0;
+			for (auto time : times) {
+				meanTime += time / worldSize;
+			}
+
+			std::vector<double> record(
+					solverHealth.steps.begin() + i * nHealthSteps,
+					solverHealth.steps.begin() + (i + 1) * nHealthSteps);
+			record.insert(record.end(),
+					solverHealth.counts.begin() + i * nHealthCounts,
+					solverHealth.counts.begin() + (i + 1) * nHealthCounts);
+			record.push_back(maxTime);
+			record.push_back(meanTime);
+			record.push_back(meanTime > 0.0 ? maxTime / meanTime : 1.0);
+			record.insert(record.end(), times.begin(), times.end());
+			getTelemetry().push("solverHealth.txt", record);
+		}
+	}
+
+	solverHealth.steps.clear();
+	solverHealth.counts.clear();
+	solverHealth.rhsTimes.clear();
+
+	return;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorSolverHealth")
+/*
+ Buffer the size of each time step, its nonlinear and linear iterations,
+ rejected steps, RHS function and Jacobian calls and the time this process
+ spent in the RHS function, and write them every healthInterval time steps
+ (-solver_health).
+ */
+PetscErrorCode monitorSolverHealth(TS ts, PetscInt timestep, PetscReal time,
+		Vec, void *) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// The iterations and rejections are counted from the beginning of
+	// TSSolve, the monitor is called again with the same time step when
+	// the solver is restarted
+	static PetscInt lastTimestep = -1;
+	static PetscReal lastTime = 0.0;
+	static PetscInt lastSNESIterations = 0, lastKSPIterations = 0,
+			lastRejections = 0;
+	PetscInt snesIterations, kspIterations, rejections;
+	ierr = TSGetSNESIterations(ts, &snesIterations);
+	CHKERRQ(ierr);
+	ierr = TSGetKSPIterations(ts, &kspIterations);
+	CHKERRQ(ierr);
+	ierr = TSGetStepRejections(ts, &rejections);
+	CHKERRQ(ierr);
+
+	if (timestep > lastTimestep && lastTimestep >= 0) {
+		solverHealth.steps.insert(solverHealth.steps.end(), { (double) timestep,
+				time, time - lastTime });
+		solverHealth.counts.insert(solverHealth.counts.end(), {
+				(double) (snesIterations - lastSNESIterations),
+				(double) (kspIterations - lastKSPIterations),
+				(double) (rejections - lastRejections), (double) nRHSFunction,
+				(double) nRHSJacobian });
+		solverHealth.rhsTimes.push_back(rhsFunctionTime);
+	}
+	lastTimestep = timestep;
+	lastTime = time;
+	lastSNESIterations = snesIterations;
+	lastKSPIterations = kspIterations;
+	lastRejections = rejections;
+	nRHSFunction = 0;
+	nRHSJacobian = 0;
+	rhsFunctionTime = 0.0;
+
+	// Gather them every healthInterval time steps
+	if (solverHealth.rhsTimes.size() >= (std::size_t) healthInterval)
+		writeSolverHealth();
 
 	PetscFunctionReturn(0);
 }
@@ -308,6 +566,72 @@ void PetscSolver::solve() {
 				"to set the monitors.");
 	}
 
+	// Check the option -attenuation_lag, the attenuation is then computed
+	// from the solution at the beginning of each time step instead of
+	// from every solution the RHS function and Jacobian are evaluated at
+	PetscBool flagLag;
+	ierr = PetscOptionsHasName(NULL, NULL, "-attenuation_lag", &flagLag);
+	checkPetscError(ierr,
+			"PetscSolver::solve: PetscOptionsHasName (-attenuation_lag) failed.");
+	attenuationLag = flagLag;
+	if (attenuationLag) {
+		ierr = TSMonitorSet(ts, monitorAttenuation, NULL, NULL);
+		checkPetscError(ierr, "PetscSolver::solve: TSMonitorSet failed.");
+	}
+
+	// Put the time steps and nonlinear iterations on the timeline when the
+	// trace is recorded (-perfHandler trace), the option -trace_interval
+	// sets how often it is written
+	if (xperf::getTraceRecorder().isEnabled()) {
+		PetscBool flagInterval;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-trace_interval",
+				&traceInterval, &flagInterval);
+		checkPetscError(ierr,
+				"PetscSolver::solve: PetscOptionsGetInt (-trace_interval) failed.");
+		ierr = TSMonitorSet(ts, monitorTrace, NULL, NULL);
+		checkPetscError(ierr, "PetscSolver::solve: TSMonitorSet failed.");
+		SNES snes;
+		ierr = TSGetSNES(ts, &snes);
+		checkPetscError(ierr, "PetscSolver::solve: TSGetSNES failed.");
+		ierr = SNESMonitorSet(snes, monitorTraceSNES, NULL, NULL);
+		checkPetscError(ierr, "PetscSolver::solve: SNESMonitorSet failed.");
+	}
+
+	// Check the option -solver_health, it records the size, iterations and
+	// RHS function time imbalance of each time step, gathering them every
+	// N time steps (-solver_health N, 1 by default)
+	PetscBool flagHealth;
+	ierr = PetscOptionsHasName(NULL, NULL, "-solver_health", &flagHealth);
+	checkPetscError(ierr,
+			"PetscSolver::solve: PetscOptionsHasName (-solver_health) failed.");
+	if (flagHealth) {
+		PetscBool flagInterval;
+		ierr = PetscOptionsGetInt(NULL, NULL, "-solver_health",
+				&healthInterval, &flagInterval);
+		checkPetscError(ierr,
+				"PetscSolver::solve: PetscOptionsGetInt (-solver_health) failed.");
+		if (!flagInterval || healthInterval < 1)
+			healthInterval = 1;
+
+		// Master process
+		int procId, worldSize;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+		MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+		if (procId == 0) {
+			std::vector<std::string> columns = { "step", "time", "dt",
+					"SNESIterations", "KSPIterations", "rejectedSteps",
+					"RHSFunctionCalls", "RHSJacobianCalls", "maxRHSTime",
+					"meanRHSTime", "imbalance" };
+			for (int i = 0; i < worldSize; i++) {
+				columns.push_back("RHSTime" + std::to_string(i));
+			}
+			getTelemetry().addStream("solverHealth.txt", columns, true);
+		}
+
+		ierr = TSMonitorSet(ts, monitorSolverHealth, NULL, NULL);
+		checkPetscError(ierr, "PetscSolver::solve: TSMonitorSet failed.");
+	}
+
 	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	 Set initial conditions
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -320,9 +644,75 @@ void PetscSolver::solve() {
 	 Solve the ODE system
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 	if (ts != NULL && C != NULL) {
+		// Close the checkpoint file on the way out, even if the solve fails
+		struct CheckpointCloser {
+			~CheckpointCloser() {
+				finalizeCheckpoints();
+				finalizeTelemetry();
+			}
+		} checkpointCloser;
+
 		ierr = TSSolve(ts, C);
 		checkPetscError(ierr, "PetscSolver::solve: TSSolve failed.");
 
+		// The monitors stop the solver when the grid needs to be repartitioned
+		TSConvergedReason reason;
+		ierr = TSGetConvergedReason(ts, &reason);
+		checkPetscError(ierr,
+				"PetscSolver::solve: TSGetConvergedReason failed.");
+		while (reason == TS_CONVERGED_USER
+				&& getSolverHandler().repartitionNeeded()) {
+			getSolverHandler().setRepartitionNeeded(false);
+
+			// Save where the solver stopped
+			PetscInt steps;
+			ierr = TSGetStepNumber(ts, &steps);
+			checkPetscError(ierr, "PetscSolver::solve: TSGetStepNumber failed.");
+			ierr = TSGetTime(ts, &time);
+			checkPetscError(ierr, "PetscSolver::solve: TSGetTime failed.");
+			ierr = TSGetTimeStep(ts, &deltaTime);
+			checkPetscError(ierr, "PetscSolver::solve: TSGetTimeStep failed.");
+
+			// Create the new distributed array and migrate the solution
+			ierr = TSReset(ts);
+			checkPetscError(ierr, "PetscSolver::solve: TSReset failed.");
+			getSolverHandler().repartitionSolverContext(da, C);
+
+			// Give them to the time stepper, the RHS function and Jacobian
+			// are attached to the distributed array so they are set again
+			ierr = TSSetDM(ts, da);
+			checkPetscError(ierr, "PetscSolver::solve: TSSetDM failed.");
+			ierr = TSSetRHSFunction(ts, NULL, RHSFunction, NULL);
+			checkPetscError(ierr,
+					"PetscSolver::solve: TSSetRHSFunction failed.");
+			ierr = TSSetRHSJacobian(ts, NULL, NULL, RHSJacobian, NULL);
+			checkPetscError(ierr,
+					"PetscSolver::solve: TSSetRHSJacobian failed.");
+			ierr = TSSetSolution(ts, C);
+			checkPetscError(ierr, "PetscSolver::solve: TSSetSolution failed.");
+			ierr = TSSetStepNumber(ts, steps);
+			checkPetscError(ierr, "PetscSolver::solve: TSSetStepNumber failed.");
+			ierr = TSSetTime(ts, time);
+			checkPetscError(ierr, "PetscSolver::solve: TSSetTime failed.");
+			ierr = TSSetTimeStep(ts, deltaTime);
+			checkPetscError(ierr, "PetscSolver::solve: TSSetTimeStep failed.");
+
+			// Continue solving
+			ierr = TSSolve(ts, C);
+			checkPetscError(ierr, "PetscSolver::solve: TSSolve failed.");
+			ierr = TSGetConvergedReason(ts, &reason);
+			checkPetscError(ierr,
+					"PetscSolver::solve: TSGetConvergedReason failed.");
+		}
+
+		// Write the solver health of the last time steps
+		if (healthInterval > 0)
+			writeSolverHealth();
+
+		// Wait for the last checkpoint to be written
+		finalizeCheckpoints();
+		finalizeTelemetry();
+
 		/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 		 Write in a file if everything went well or not.
 		 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -336,13 +726,7 @@ void PetscSolver::solve() {
 			std::ofstream outputFile;
 			outputFile.open("solverStatus.txt");
 
-			// Get the converged reason from PETSc
-			TSConvergedReason reason;
-			ierr = TSGetConvergedReason(ts, &reason);
-			checkPetscError(ierr,
-					"PetscSolver::solve: TSGetConvergedReason failed.");
-
-			// Write it
+			// Write the converged reason from PETSc
 			if (reason == TS_CONVERGED_EVENT)
 				outputFile << "collapsed" << std::endl;
 			else if (reason == TS_DIVERGED_NONLINEAR_SOLVE
@@ -367,6 +751,7 @@ void PetscSolver::solve() {
 	checkPetscError(ierr, "PetscSolver::solve: TSDestroy failed.");
 	ierr = DMDestroy(&da);
 	checkPetscError(ierr, "PetscSolver::solve: DMDestroy failed.");
+	jacobianMemory.set(0);
 
 	return;
 }
@@ -374,10 +759,22 @@ void PetscSolver::solve() {
 void PetscSolver::finalize() {
 	PetscErrorCode ierr;
 
+	// The checkpoint writer uses MPI, release it first
+	finalizeCheckpoints();
+	finalizeTelemetry();
+
 	ierr = PetscFinalize();
 	checkPetscError(ierr, "PetscSolver::finalize: PetscFinalize failed.");
 
 	return;
 }
 
+std::size_t PetscSolver::getJacobianMemorySize(std::size_t nRows,
+		std::size_t nNonzeros) {
+	// The row offsets, lengths, allocated lengths, diagonal positions, and
+	// the column map of the off-process part
+	return nNonzeros * (sizeof(PetscScalar) + sizeof(PetscInt))
+			+ 5 * nRows * sizeof(PetscInt);
+}
+
 } /* end namespace xolotlSolver */
@@ -90,6 +90,18 @@ public:
 	 */
 	void finalize() override;
 
+	/**
+	 * Get the memory used by the AIJ Jacobian matrix PETSc creates for the
+	 * DMDA: a value and a column index for each nonzero, and a few indices
+	 * for each row.
+	 *
+	 * @param nRows The number of local rows
+	 * @param nNonzeros The number of local nonzeros
+	 * @return The number of bytes
+	 */
+	static std::size_t getJacobianMemorySize(std::size_t nRows,
+			std::size_t nNonzeros);
+
 };
 //end class PetscSolver
 
@@ -0,0 +1,221 @@
+// Includes
+#include <iostream>
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+
+namespace xolotlSolver {
+
+CheckpointWriter::CheckpointWriter(const std::string& name, MPI_Comm comm,
+		bool useThread, int flushEvery, int compression, int keyframeEvery) :
+		fileName(name), ioComm(MPI_COMM_NULL), flushStride(flushEvery), nWritten(
+				0), compressionLevel(compression), keyframeStride(keyframeEvery), nSinceKeyframe(
+				0), previousTimeStep(-1), previousBaseX(-1), async(useThread), bufferMemory(
+				xolotlPerf::MemoryCategory::IO), previousMemory(
+				xolotlPerf::MemoryCategory::IO), currentBuffer(0), jobBuffer(0), hasJob(
+				false), stop(false) {
+	// The jobs communicate on their own communicator
+	MPI_Comm_dup(comm, &ioComm);
+
+	// The I/O thread needs full thread support from MPI
+	if (async) {
+		int provided;
+		MPI_Query_thread(&provided);
+		if (provided < MPI_THREAD_MULTIPLE) {
+			int procId;
+			MPI_Comm_rank(ioComm, &procId);
+			if (procId == 0)
+				std::cout << "CheckpointWriter: MPI_THREAD_MULTIPLE is not "
+						"available, the checkpoints will be written "
+						"synchronously." << std::endl;
+			async = false;
+		}
+	}
+
+	// The I/O thread calls HDF5 while the monitors may call it too, which
+	// a library built without thread safety doesn't survive
+	if (async) {
+		hbool_t threadSafe = false;
+#if H5_VERSION_GE(1, 8, 16)
+		H5is_library_threadsafe(&threadSafe);
+#endif
+		if (!threadSafe) {
+			int procId;
+			MPI_Comm_rank(ioComm, &procId);
+			if (procId == 0)
+				std::cout << "CheckpointWriter: HDF5 is not thread safe, "
+						"the checkpoints will be written synchronously."
+						<< std::endl;
+			async = false;
+		}
+	}
+
+	// Start the I/O thread
+	if (async)
+		ioThread = std::thread(&CheckpointWriter::run, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+	// Wait for the last checkpoint
+	try {
+		fence();
+	} catch (const std::exception& e) {
+		std::cerr << "CheckpointWriter: " << e.what() << std::endl;
+	} catch (const std::string& e) {
+		std::cerr << "CheckpointWriter: " << e << std::endl;
+	}
+
+	// Stop the I/O thread
+	if (ioThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		condition.notify_all();
+		ioThread.join();
+	}
+
+	// Close the checkpoint file
+	file.reset();
+
+	// Free the communicator if MPI is still there
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	if (!finalized)
+		MPI_Comm_free(&ioComm);
+}
+
+void CheckpointWriter::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		// Wait for a job or for the end
+		condition.wait(lock, [this] {return hasJob || stop;});
+		if (!hasJob)
+			break;
+
+		// Run it without holding the lock
+		lock.unlock();
+		std::exception_ptr jobError;
+		try {
+			execute(pendingJob, buffers[jobBuffer]);
+		} catch (...) {
+			jobError = std::current_exception();
+		}
+		lock.lock();
+
+		// Signal the completion
+		error = jobError;
+		pendingJob = nullptr;
+		hasJob = false;
+		condition.notify_all();
+	}
+
+	return;
+}
+
+void CheckpointWriter::execute(const Job& job,
+		const std::vector<double>& buffer) {
+	// Open the existing checkpoint file the first time
+	if (!file) {
+		file.reset(
+				new xolotlCore::XFile(fileName, ioComm,
+						xolotlCore::XFile::AccessMode::OpenReadWrite));
+	}
+
+	// Write the checkpoint
+	job(*file, buffer);
+
+	// Flush it if it is time to
+	nWritten++;
+	if (flushStride > 0 && nWritten % flushStride == 0)
+		file->Flush();
+
+	return;
+}
+
+void CheckpointWriter::writeConcentrations(const xolotlCore::XFile& file,
+		const xolotlCore::XFile::TimestepGroup& tsGroup, int timeStep,
+		int baseX, const xolotlCore::XFile::TimestepGroup::Concs1DType& concs) {
+	// Is it time for a delta?
+	bool useDelta = (keyframeStride > 1 && nSinceKeyframe > 0
+			&& nSinceKeyframe < keyframeStride);
+
+	// The deltas need the same grid points as the previous checkpoint,
+	// which is not the case after a repartition
+	if (useDelta) {
+		int changed = (baseX != previousBaseX
+				|| concs.size() != previousConcs.size()) ? 1 : 0;
+		MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, ioComm);
+		useDelta = (changed == 0);
+	}
+
+	if (useDelta) {
+		tsGroup.writeConcentrationDeltas(file, baseX, concs, previousTimeStep,
+				previousConcs, compressionLevel);
+		nSinceKeyframe++;
+	} else {
+		tsGroup.writeConcentrations(file, baseX, concs, compressionLevel);
+		nSinceKeyframe = 1;
+	}
+
+	// Keep them for the next delta
+	if (keyframeStride > 1) {
+		previousConcs = concs;
+		previousTimeStep = timeStep;
+		previousBaseX = baseX;
+
+		std::size_t bytes = xolotlPerf::getVectorMemorySize(previousConcs);
+		for (auto const& gridPointConcs : previousConcs) {
+			bytes += xolotlPerf::getVectorMemorySize(gridPointConcs);
+		}
+		previousMemory.set(bytes);
+	}
+
+	return;
+}
+
+void CheckpointWriter::submit(Job job) {
+	// Only one job in flight
+	fence();
+
+	// The next snapshot goes in the other buffer
+	int buffer = currentBuffer;
+	currentBuffer = 1 - currentBuffer;
+	bufferMemory.set(
+			xolotlPerf::getVectorMemorySize(buffers[0])
+					+ xolotlPerf::getVectorMemorySize(buffers[1]));
+
+	if (!async) {
+		execute(job, buffers[buffer]);
+		return;
+	}
+
+	// Give the job to the I/O thread
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pendingJob = std::move(job);
+		jobBuffer = buffer;
+		hasJob = true;
+	}
+	condition.notify_all();
+
+	return;
+}
+
+void CheckpointWriter::fence() {
+	if (!async)
+		return;
+
+	// Wait for the I/O thread to be done
+	std::unique_lock<std::mutex> lock(mutex);
+	condition.wait(lock, [this] {return !hasJob;});
+
+	// Report its failure
+	if (error) {
+		auto jobError = error;
+		error = nullptr;
+		std::rethrow_exception(jobError);
+	}
+
+	return;
+}
+
+} // namespace xolotlSolver
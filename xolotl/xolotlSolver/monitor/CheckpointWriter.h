@@ -0,0 +1,228 @@
+#ifndef XSOLVER_CHECKPOINTWRITER_H
+#define XSOLVER_CHECKPOINTWRITER_H
+
+// Includes
+#include <mpi.h>
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "xolotlCore/io/XFile.h"
+#include "xolotlPerf/MemoryTracker.h"
+
+namespace xolotlSolver {
+
+/**
+ * This class writes the checkpoint files for the startStop monitors.
+ *
+ * The monitors copy the part of the solution they own in a snapshot buffer
+ * and submit a job that builds the checkpoint from it. When asynchronous
+ * writing is requested, the jobs run on a dedicated I/O thread with its
+ * own duplicate of the communicator while the solver continues. There are
+ * two snapshot buffers so the next snapshot never overwrites the one being
+ * written, and a single job is in flight at a time: submitting a new job
+ * or calling fence() waits for the previous one.
+ *
+ * Asynchronous writing needs MPI_THREAD_MULTIPLE and a thread safe HDF5
+ * library, without them the jobs run on the calling thread. Even then the
+ * other threads must call fence() before their collective HDF5 calls: the
+ * library lock would be held by one of them while it waits for the other
+ * processes, whose I/O thread can't get the lock.
+ *
+ * The checkpoint file is opened by the first job and stays open until the
+ * writer is destroyed, which avoids a collective open and close at each
+ * checkpoint. It is flushed every given number of checkpoints so that it
+ * can still be used if the run is killed.
+ *
+ * The 0D and 1D concentrations can be delta encoded: a full keyframe is
+ * written every given number of checkpoints and the checkpoints in between
+ * only store what changed since the previous one.
+ */
+class CheckpointWriter {
+public:
+
+	/**
+	 * The type of the jobs, they get the open checkpoint file and the
+	 * snapshot of the solution.
+	 */
+	using Job = std::function<void(xolotlCore::XFile&, const std::vector<double>&)>;
+
+private:
+
+	//! The name of the checkpoint file.
+	std::string fileName;
+
+	//! The communicator used to write the file.
+	MPI_Comm ioComm;
+
+	//! The open checkpoint file.
+	std::unique_ptr<xolotlCore::XFile> file;
+
+	//! The number of checkpoints between two flushes, 0 to never flush.
+	int flushStride;
+
+	//! The number of checkpoints written so far.
+	int nWritten;
+
+	//! The deflate level for the concentrations, 0 for no compression.
+	int compressionLevel;
+
+	//! The number of checkpoints between two keyframes, 0 for no deltas.
+	int keyframeStride;
+
+	//! The number of checkpoints written since the last keyframe.
+	int nSinceKeyframe;
+
+	//! The time step of the previous concentrations.
+	int previousTimeStep;
+
+	//! The first grid point of the previous concentrations.
+	int previousBaseX;
+
+	//! The previous concentrations, the next delta is relative to them.
+	xolotlCore::XFile::TimestepGroup::Concs1DType previousConcs;
+
+	//! Are the jobs run on the I/O thread?
+	bool async;
+
+	//! The snapshot buffers.
+	std::array<std::vector<double>, 2> buffers;
+
+	//! The memory reported for the snapshot buffers.
+	xolotlPerf::TrackedMemory bufferMemory;
+
+	//! The memory reported for the previous concentrations.
+	xolotlPerf::TrackedMemory previousMemory;
+
+	//! The index of the buffer to fill next.
+	int currentBuffer;
+
+	//! The index of the buffer used by the pending job.
+	int jobBuffer;
+
+	//! The job waiting for or being run by the I/O thread.
+	Job pendingJob;
+
+	//! Is there a job waiting for or being run by the I/O thread?
+	bool hasJob;
+
+	//! Should the I/O thread stop?
+	bool stop;
+
+	//! The exception thrown by the last job on the I/O thread.
+	std::exception_ptr error;
+
+	//! Protects the job, the flags and the exception.
+	std::mutex mutex;
+
+	//! Signals the job submissions and completions.
+	std::condition_variable condition;
+
+	//! The I/O thread.
+	std::thread ioThread;
+
+	/**
+	 * The loop of the I/O thread.
+	 */
+	void run();
+
+	/**
+	 * Open the checkpoint file if needed, run a job on it and flush it
+	 * according to the flush stride.
+	 *
+	 * @param job The job
+	 * @param buffer The snapshot of the solution
+	 */
+	void execute(const Job& job, const std::vector<double>& buffer);
+
+public:
+
+	CheckpointWriter() = delete;
+	CheckpointWriter(const CheckpointWriter& other) = delete;
+
+	/**
+	 * The constructor. It is collective on the given communicator.
+	 *
+	 * @param name The name of the checkpoint file
+	 * @param comm The communicator of the processes writing the file
+	 * @param useThread Whether the jobs should run on the I/O thread
+	 * @param flushEvery The number of checkpoints between two flushes
+	 * @param compression The deflate level for the concentrations
+	 * @param keyframeEvery The number of checkpoints between two keyframes
+	 */
+	CheckpointWriter(const std::string& name, MPI_Comm comm, bool useThread,
+			int flushEvery, int compression, int keyframeEvery);
+
+	/**
+	 * The destructor waits for the pending job, stops the I/O thread and
+	 * closes the checkpoint file. It is collective.
+	 */
+	~CheckpointWriter();
+
+	/**
+	 * Are the jobs run on the I/O thread?
+	 *
+	 * @return True if the writing is asynchronous
+	 */
+	bool isAsync() const {
+		return async;
+	}
+
+	/**
+	 * Write the concentrations of a 0D or 1D checkpoint, either in full or
+	 * as a delta relative to the previous checkpoint. It is collective and
+	 * must only be called by the jobs.
+	 *
+	 * @param file The checkpoint file
+	 * @param tsGroup The group of the current time step
+	 * @param timeStep The current time step
+	 * @param baseX Index of the first grid point we own
+	 * @param concs The concentrations of the grid points we own
+	 */
+	void writeConcentrations(const xolotlCore::XFile& file,
+			const xolotlCore::XFile::TimestepGroup& tsGroup, int timeStep,
+			int baseX,
+			const xolotlCore::XFile::TimestepGroup::Concs1DType& concs);
+
+	/**
+	 * Get the communicator used by the jobs. The collective calls made
+	 * by a job must go through it instead of PETSC_COMM_WORLD.
+	 *
+	 * @return The communicator
+	 */
+	MPI_Comm getComm() const {
+		return ioComm;
+	}
+
+	/**
+	 * Get the buffer to fill with the next snapshot. It is never the one
+	 * being written.
+	 *
+	 * @return The buffer
+	 */
+	std::vector<double>& getBuffer() {
+		return buffers[currentBuffer];
+	}
+
+	/**
+	 * Submit a job using the buffer from getBuffer(). Waits for the
+	 * previous job first.
+	 *
+	 * @param job The job
+	 */
+	void submit(Job job);
+
+	/**
+	 * Wait for the pending job, if any. Rethrows the exception it threw.
+	 */
+	void fence();
+};
+
+} // namespace xolotlSolver
+
+#endif // XSOLVER_CHECKPOINTWRITER_H
@@ -14,6 +14,8 @@
 #include <memory>
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/TelemetrySink.h"
 
 namespace xolotlSolver {
 
@@ -24,6 +26,10 @@ std::shared_ptr<xolotlViz::IPlot> perfPlot;
 double previousTime = 0.0;
 //! The variable to store the threshold on time step defined by the user.
 double timeStepThreshold = 0.0;
+//! The writer of the checkpoint file used in the startStop monitors.
+std::unique_ptr<CheckpointWriter> checkpointWriter;
+//! The sink of the time series written by the monitors.
+std::unique_ptr<TelemetrySink> telemetry;
 
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkTimeStep")
@@ -234,5 +240,140 @@ void writeNetwork(MPI_Comm _comm, std::string srcFileName,
 	}
 }
 
+void createCheckpointWriter(const std::string& fileName) {
+	// Check the option -async_checkpoint
+	PetscBool flagAsync;
+	PetscErrorCode ierr = PetscOptionsHasName(NULL, NULL, "-async_checkpoint",
+			&flagAsync);
+	checkPetscError(ierr,
+			"createCheckpointWriter: PetscOptionsHasName (-async_checkpoint) failed.");
+
+	// Check the option -checkpoint_flush
+	PetscInt flushStride;
+	PetscBool flagFlush;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-checkpoint_flush", &flushStride,
+			&flagFlush);
+	checkPetscError(ierr,
+			"createCheckpointWriter: PetscOptionsGetInt (-checkpoint_flush) failed.");
+	if (!flagFlush)
+		flushStride = 1;
+
+	// Check the option -checkpoint_compression
+	PetscInt compressionLevel;
+	PetscBool flagCompression;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-checkpoint_compression",
+			&compressionLevel, &flagCompression);
+	checkPetscError(ierr,
+			"createCheckpointWriter: PetscOptionsGetInt (-checkpoint_compression) failed.");
+	if (!flagCompression)
+		compressionLevel = 0;
+	if (compressionLevel < 0 || compressionLevel > 9)
+		throw std::string(
+				"createCheckpointWriter: the -checkpoint_compression level "
+				"must be between 0 and 9.");
+
+	// Check the option -checkpoint_keyframe
+	PetscInt keyframeStride;
+	PetscBool flagKeyframe;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-checkpoint_keyframe",
+			&keyframeStride, &flagKeyframe);
+	checkPetscError(ierr,
+			"createCheckpointWriter: PetscOptionsGetInt (-checkpoint_keyframe) failed.");
+	if (!flagKeyframe)
+		keyframeStride = 0;
+
+	checkpointWriter.reset(
+			new CheckpointWriter(fileName, PETSC_COMM_WORLD, flagAsync,
+					flushStride, compressionLevel, keyframeStride));
+}
+
+void fenceCheckpoints() {
+	// Wait for the checkpoint being written
+	if (checkpointWriter)
+		checkpointWriter->fence();
+}
+
+void finalizeCheckpoints() {
+	// Wait for the last checkpoint, stop the I/O thread and close the file
+	checkpointWriter.reset();
+}
+
+TelemetrySink& getTelemetry() {
+	if (telemetry)
+		return *telemetry;
+
+	// Check the option -telemetry_backend
+	char backendName[PETSC_MAX_PATH_LEN];
+	PetscBool flagBackend;
+	PetscErrorCode ierr = PetscOptionsGetString(NULL, NULL,
+			"-telemetry_backend", backendName, PETSC_MAX_PATH_LEN,
+			&flagBackend);
+	checkPetscError(ierr,
+			"getTelemetry: PetscOptionsGetString (-telemetry_backend) failed.");
+	auto backend = TelemetrySink::Backend::Text;
+	if (flagBackend)
+		backend = TelemetrySink::getBackend(backendName);
+
+	// Check the option -telemetry_buffer
+	PetscInt bufferSize;
+	PetscBool flagBuffer;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-telemetry_buffer", &bufferSize,
+			&flagBuffer);
+	checkPetscError(ierr,
+			"getTelemetry: PetscOptionsGetInt (-telemetry_buffer) failed.");
+	if (!flagBuffer)
+		bufferSize = 64;
+
+	// Check the option -telemetry_interval
+	PetscReal interval;
+	PetscBool flagInterval;
+	ierr = PetscOptionsGetReal(NULL, NULL, "-telemetry_interval", &interval,
+			&flagInterval);
+	checkPetscError(ierr,
+			"getTelemetry: PetscOptionsGetReal (-telemetry_interval) failed.");
+	if (!flagInterval)
+		interval = 30.0;
+
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+
+	telemetry.reset(
+			new TelemetrySink(backend, bufferSize * 1024, interval, procId));
+
+	return *telemetry;
+}
+
+void finalizeTelemetry() {
+	// Write what is left and close the files
+	telemetry.reset();
+}
+
+std::vector<double> gatherOnMaster(const std::vector<double>& localValues,
+		MPI_Comm comm) {
+	int procId, worldSize;
+	MPI_Comm_rank(comm, &procId);
+	MPI_Comm_size(comm, &worldSize);
+
+	// Get the number of values of each process
+	int localSize = localValues.size();
+	std::vector<int> sizes(procId == 0 ? worldSize : 0);
+	MPI_Gather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+
+	// Compute where they go
+	std::vector<int> offsets(sizes.size(), 0);
+	int totalSize = 0;
+	for (std::size_t i = 0; i < sizes.size(); i++) {
+		offsets[i] = totalSize;
+		totalSize += sizes[i];
+	}
+
+	// Gather them all at once
+	std::vector<double> allValues(totalSize);
+	MPI_Gatherv(localValues.data(), localSize, MPI_DOUBLE, allValues.data(),
+			sizes.data(), offsets.data(), MPI_DOUBLE, 0, comm);
+
+	return allValues;
+}
+
 }
 /* end namespace xolotlSolver */
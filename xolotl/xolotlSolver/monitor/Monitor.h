@@ -2,7 +2,9 @@
 #define XSOLVER_MONITOR_H
 
 // Includes
+#include <vector>
 #include <IReactionNetwork.h>
+#include "xolotlSolver/monitor/TelemetrySink.h"
 
 namespace xolotlSolver {
 
@@ -22,6 +24,63 @@ namespace xolotlSolver {
 void writeNetwork(MPI_Comm _comm, std::string srcFileName,
 		std::string targetFileName, IReactionNetwork& network);
 
+/**
+ * Create the writer used by the startStop monitors for the given checkpoint
+ * file. The checkpoints are written on a separate thread if the
+ * -async_checkpoint option is used and HDF5 is thread safe, and the file
+ * is flushed every
+ * -checkpoint_flush checkpoints (1 by default, 0 to only flush when
+ * it is closed). The 1D concentrations are compressed with the
+ * -checkpoint_compression deflate level (0, the default, for none), and
+ * -checkpoint_keyframe N writes them in full every N checkpoints and as
+ * deltas from the previous checkpoint in between (0, the default, to
+ * always write them in full).
+ *
+ * @param fileName The path to the checkpoint file.
+ */
+void createCheckpointWriter(const std::string& fileName);
+
+/**
+ * Wait for the checkpoint being written, if any. Must be called before the
+ * monitors make collective HDF5 calls while the I/O thread may be writing.
+ */
+void fenceCheckpoints();
+
+/**
+ * Wait for the checkpoint being written, if any, close the checkpoint file
+ * and release the checkpoint writer. Must be called before MPI is finalized.
+ */
+void finalizeCheckpoints();
+
+/**
+ * Get the sink the monitors push their time series into, creating it on
+ * first use. The records are written with the -telemetry_backend backend
+ * (text, the default, csv or hdf5) when more than -telemetry_buffer
+ * kilobytes are buffered (64 by default) or every -telemetry_interval
+ * seconds (30 by default).
+ *
+ * @return The sink
+ */
+TelemetrySink& getTelemetry();
+
+/**
+ * Write what is left in the telemetry sink and release it. Must be called
+ * before the end of the run.
+ */
+void finalizeTelemetry();
+
+/**
+ * Gather the values of all the processes on the master process, in the
+ * order of the ranks, with a single collective instead of sending them one
+ * by one. Each process can give a different number of values.
+ *
+ * @param localValues The values of this process
+ * @param comm The communicator
+ * @return All the values on the master process, nothing on the others
+ */
+std::vector<double> gatherOnMaster(const std::vector<double>& localValues,
+		MPI_Comm comm);
+
 } // namespace xolotlSolver
 
 #endif // XSOLVER_MONITOR_H
@@ -25,6 +25,7 @@
 #include <AlloySuperCluster.h>
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
 
 namespace xolotlSolver {
 
@@ -41,6 +42,7 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
 
 //! The pointer to the plot used in monitorScatter0D.
 std::shared_ptr<xolotlViz::IPlot> scatterPlot0D;
@@ -67,7 +69,7 @@ PetscErrorCode startStop0D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declaration
 	PetscErrorCode ierr;
-	const double **solutionArray, *gridPointSolution;
+	const double **solutionArray;
 
 	PetscFunctionBeginUser;
 
@@ -99,49 +101,47 @@ PetscErrorCode startStop0D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName0D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	// Determine the concentration values we will write.
-	// We only examine and collect the grid points we own.
-	// TODO measure impact of us building the flattened representation
-	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(1);
-
-	// Access the solution data for the current grid point.
-	gridPointSolution = solutionArray[0];
-
-	for (auto l = 0; l < dof; ++l) {
-		if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-			concs[0].emplace_back(l, gridPointSolution[l]);
-		}
-	}
-
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, 0, concs);
+	// Snapshot the solution so that the solver can continue
+	// while the checkpoint is written
+	auto& snapshot = checkpointWriter->getBuffer();
+	snapshot.assign(solutionArray[0], solutionArray[0] + dof);
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Write the checkpoint
+	double prevTime = previousTime;
+	auto writer = checkpointWriter.get();
+	checkpointWriter->submit(
+			[=](xolotlCore::XFile& checkpointFile,
+					const std::vector<double>& buffer) {
+				// Add a concentration time step group for the current time step.
+				auto concGroup = checkpointFile.getGroup<
+						xolotlCore::XFile::ConcentrationGroup>();
+				assert(concGroup);
+				auto tsGroup = concGroup->addTimestepGroup(timestep, time, prevTime,
+						currentTimeStep);
+
+				// Determine the concentration values we will write.
+				XFile::TimestepGroup::Concs1DType concs(1);
+				for (auto l = 0; l < dof; ++l) {
+					if (std::fabs(buffer[l]) > 1.0e-16) {
+						concs[0].emplace_back(l, buffer[l]);
+					}
+				}
+
+				// Write our concentration data to the current timestep group
+				// in the HDF5 file.
+				writer->writeConcentrations(checkpointFile, *tsGroup, timestep, 0,
+						concs);
+			});
+
 	PetscFunctionReturn(0);
 }
 
@@ -235,13 +235,10 @@ PetscErrorCode computeXenonRetention0D(TS ts, PetscInt, PetscReal time,
 		averagePartialRadius = minRadius;
 
 	// Uncomment to write the retention and the fluence in a file
-	std::ofstream outputFile;
-	outputFile.open("retentionOut.txt", ios::app);
-	outputFile << time << " " << xeConcentration << " "
-			<< radii / bubbleConcentration << " " << averagePartialRadius << " "
-			<< partialBubbleConcentration << " "
-			<< partialSize / partialBubbleConcentration << std::endl;
-	outputFile.close();
+	getTelemetry().push("retentionOut.txt",
+			{ time, xeConcentration, radii / bubbleConcentration,
+					averagePartialRadius, partialBubbleConcentration, partialSize
+							/ partialBubbleConcentration });
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -437,9 +434,6 @@ PetscErrorCode computeAlloy0D(TS ts, PetscInt timestep, PetscReal time,
 		}
 	}
 
-	// Set the output precision
-	const int outputPrecision = 5;
-
 	// Average the diameters
 	iDiameter = iDiameter / iDensity;
 	vDiameter = vDiameter / vDensity;
@@ -452,24 +446,16 @@ PetscErrorCode computeAlloy0D(TS ts, PetscInt timestep, PetscReal time,
 	faultedPartialDiameter = faultedPartialDiameter / faultedPartialDensity;
 	frankPartialDiameter = frankPartialDiameter / frankPartialDensity;
 
-	// Open the output file
-	std::fstream outputFile;
-	outputFile.open("Alloy.dat", std::fstream::out | std::fstream::app);
-	outputFile << std::setprecision(outputPrecision);
-
 	// Output the data
-	outputFile << timestep << " " << time << " " << iDensity << " " << iDiameter
-			<< " " << vDensity << " " << vDiameter << " " << voidDensity << " "
-			<< voidDiameter << " " << faultedDensity << " " << faultedDiameter
-			<< " " << perfectDensity << " " << perfectDiameter << " "
-			<< frankDensity << " " << frankDiameter << " " << voidPartialDensity
-			<< " " << voidPartialDiameter << " " << faultedPartialDensity << " "
-			<< faultedPartialDiameter << " " << perfectPartialDensity << " "
-			<< perfectPartialDiameter << " " << frankPartialDensity << " "
-			<< frankPartialDiameter << std::endl;
-
-	// Close the output file
-	outputFile.close();
+	getTelemetry().push("Alloy.dat",
+			{ (double) timestep, time, iDensity, iDiameter, vDensity,
+					vDiameter, voidDensity, voidDiameter, faultedDensity,
+					faultedDiameter, perfectDensity, perfectDiameter,
+					frankDensity, frankDiameter, voidPartialDensity,
+					voidPartialDiameter, faultedPartialDensity,
+					faultedPartialDiameter, perfectPartialDensity,
+					perfectPartialDiameter, frankPartialDensity,
+					frankPartialDiameter });
 
 	// Restore the PETSC solution array
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -831,6 +817,9 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 					hdf5OutputName0D, network);
 		}
 
+		// Create the writer for the checkpoints
+		createCheckpointWriter(hdf5OutputName0D);
+
 		// startStop0D will be called at each timestep
 		ierr = TSMonitorSet(ts, startStop0D, NULL, NULL);
 		checkPetscError(ierr,
@@ -905,10 +894,16 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 
 	// Set the monitor to output data for Alloy
 	if (flagAlloy) {
-		// Create/open the output files
-		std::fstream outputFile;
-		outputFile.open("Alloy.dat", std::fstream::out);
-		outputFile.close();
+		// Clear the file where the data will be written
+		getTelemetry().addStream("Alloy.dat",
+				{ "timestep", "time", "iDensity", "iDiameter", "vDensity",
+					"vDiameter", "voidDensity", "voidDiameter",
+					"faultedDensity", "faultedDiameter", "perfectDensity",
+					"perfectDiameter", "frankDensity", "frankDiameter",
+					"voidPartialDensity", "voidPartialDiameter",
+					"faultedPartialDensity", "faultedPartialDiameter",
+					"perfectPartialDensity", "perfectPartialDiameter",
+					"frankPartialDensity", "frankPartialDiameter" }, true);
 
 		// computeAlloy0D will be called at each timestep
 		ierr = TSMonitorSet(ts, computeAlloy0D, NULL, NULL);
@@ -960,9 +955,9 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 				"setupPetsc0DMonitor: TSMonitorSet (computeXenonRetention0D) failed.");
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		getTelemetry().addStream("retentionOut.txt",
+				{ "time", "Xe", "radius", "partialRadius", "partialBubbles",
+						"partialSize" }, true);
 	}
 
 	// Set the monitor to simply change the previous time to the new time
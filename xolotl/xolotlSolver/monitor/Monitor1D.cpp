@@ -14,6 +14,7 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <array>
 #include <memory>
 #include <NESuperCluster.h>
 #include <PSISuperCluster.h>
@@ -27,6 +28,8 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/MonitorSweep.h"
 
 namespace xperf = xolotlPerf;
 
@@ -45,6 +48,7 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
 
 //! The pointer to the plot used in monitorScatter1D.
 std::shared_ptr<xolotlViz::IPlot> scatterPlot1D;
@@ -95,14 +99,17 @@ std::vector<int> weights1D;
 std::vector<double> radii1D;
 // The vector of depths at which bursting happens
 std::vector<int> depthPositions1D;
+//! The load imbalance above which the grid is repartitioned (0.0 means never)
+PetscReal repartitionThreshold1D = 0.0;
+//! The observables computed together by monitorSweep1D.
+MonitorSweep sweep1D;
 
 // Timers
 std::shared_ptr<xperf::ITimer> initTimer;
 std::shared_ptr<xperf::ITimer> checkNegativeTimer;
 std::shared_ptr<xperf::ITimer> tridynTimer;
 std::shared_ptr<xperf::ITimer> startStopTimer;
-std::shared_ptr<xperf::ITimer> heRetentionTimer;
-std::shared_ptr<xperf::ITimer> xeRetentionTimer;
+std::shared_ptr<xperf::ITimer> sweepTimer;
 std::shared_ptr<xperf::ITimer> scatterTimer;
 std::shared_ptr<xperf::ITimer> seriesTimer;
 std::shared_ptr<xperf::ITimer> surfaceTimer;
@@ -237,6 +244,9 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 
 	// Save current concentrations as an HDF5 file.
 	//
+	// The checkpoint of this time step may still be written
+	fenceCheckpoints();
+
 	// First create the file for parallel file access.
 	std::ostringstream tdFileStr;
 	tdFileStr << "TRIDYN_" << timestep << ".h5";
@@ -267,6 +277,13 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 	xolotlCore::HDF5File::DataSet<double>::DataType2D<numValsPerGridpoint> myConcs(
 			myNumPointsToWrite);
 
+	// Get the weights of the totals
+	auto const& heWeights = network.getTotalAtomWeights(0);
+	auto const& dWeights = network.getTotalAtomWeights(1);
+	auto const& tWeights = network.getTotalAtomWeights(2);
+	auto const& vWeights = network.getTotalVWeights();
+	auto const& iWeights = network.getTotalIWeights();
+
 	for (auto xi = myFirstIdxToWrite; xi < myEndIdx; ++xi) {
 
 		if (xi >= firstIdxToWrite) {
@@ -277,17 +294,19 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 			// Access the solution data for this grid point.
 			auto gridPointSolution = solutionArray[xi];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
-
 			// Get the total concentrations at this grid point
 			auto currIdx = xi - myFirstIdxToWrite;
 			myConcs[currIdx][0] = (x - (grid[surfacePos + 1] - grid[1]));
-			myConcs[currIdx][1] = network.getTotalAtomConcentration(0);
-			myConcs[currIdx][2] = network.getTotalAtomConcentration(1);
-			myConcs[currIdx][3] = network.getTotalAtomConcentration(2);
-			myConcs[currIdx][4] = network.getTotalVConcentration();
-			myConcs[currIdx][5] = network.getTotalIConcentration();
+			myConcs[currIdx][1] = xolotlCore::IReactionNetwork::sumWeights(
+					heWeights, gridPointSolution);
+			myConcs[currIdx][2] = xolotlCore::IReactionNetwork::sumWeights(
+					dWeights, gridPointSolution);
+			myConcs[currIdx][3] = xolotlCore::IReactionNetwork::sumWeights(
+					tWeights, gridPointSolution);
+			myConcs[currIdx][4] = xolotlCore::IReactionNetwork::sumWeights(
+					vWeights, gridPointSolution);
+			myConcs[currIdx][5] = xolotlCore::IReactionNetwork::sumWeights(
+					iWeights, gridPointSolution);
 			myConcs[currIdx][6] = gridPointSolution[dof - 1];
 		}
 	}
@@ -368,299 +387,265 @@ PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the position of the surface
 	int surfacePos = solverHandler.getSurfacePosition();
 
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName1D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface1D(surfacePos, nInterstitial1D, previousIFlux1D);
-	}
-
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom1D(nHelium1D, previousHeFlux1D, nDeuterium1D,
-				previousDFlux1D, nTritium1D, previousTFlux1D, nVacancy1D,
-				previousVFlux1D, nIBulk1D, previousIBulkFlux1D);
-
-	// Determine the concentration values we will write.
-	// We only examine and collect the grid points we own.
-	// TODO measure impact of us building the flattened representation
-	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(xm);
+	// Snapshot the grid points we own so that the solver can continue
+	// while the checkpoint is written
+	auto& snapshot = checkpointWriter->getBuffer();
+	snapshot.resize(xm * dof);
 	for (auto i = 0; i < xm; ++i) {
-
-		// Access the solution data for the current grid point.
-		auto gridPointSolution = solutionArray[xs + i];
-
-		for (auto l = 0; l < dof; ++l) {
-			if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-				concs[i].emplace_back(l, gridPointSolution[l]);
-			}
-		}
+		std::copy(solutionArray[xs + i], solutionArray[xs + i] + dof,
+				snapshot.begin() + i * dof);
 	}
 
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, xs, concs);
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Copy everything the checkpoint needs, the globals change while
+	// it is written
+	double prevTime = previousTime;
+	bool moveSurface = solverHandler.moveSurface();
+	double nInter = nInterstitial1D, previousIFlux = previousIFlux1D;
+	bool writeBottom = (solverHandler.getRightOffset() == 1);
+	std::array<double, 10> bottom = { nHelium1D, previousHeFlux1D,
+			nDeuterium1D, previousDFlux1D, nTritium1D, previousTFlux1D,
+			nVacancy1D, previousVFlux1D, nIBulk1D, previousIBulkFlux1D };
+	auto writer = checkpointWriter.get();
+
+	// Write the checkpoint
+	checkpointWriter->submit(
+			[=](xolotlCore::XFile& checkpointFile,
+					const std::vector<double>& buffer) {
+				// Add a concentration time step group for the current time step.
+				auto concGroup = checkpointFile.getGroup<
+						xolotlCore::XFile::ConcentrationGroup>();
+				assert(concGroup);
+				auto tsGroup = concGroup->addTimestepGroup(timestep, time, prevTime,
+						currentTimeStep);
+
+				if (moveSurface) {
+					// Write the surface positions and the associated interstitial quantities
+					// in the concentration sub group
+					tsGroup->writeSurface1D(surfacePos, nInter, previousIFlux);
+				}
+
+				// Write the bottom impurity information if the bottom is a free surface
+				if (writeBottom)
+					tsGroup->writeBottom1D(bottom[0], bottom[1], bottom[2],
+							bottom[3], bottom[4], bottom[5], bottom[6],
+							bottom[7], bottom[8], bottom[9]);
+
+				// Determine the concentration values we will write.
+				// We only examine and collect the grid points we own.
+				XFile::TimestepGroup::Concs1DType concs(xm);
+				for (auto i = 0; i < xm; ++i) {
+					// Access the snapshot data for the current grid point.
+					auto gridPointSolution = buffer.data() + i * dof;
+
+					for (auto l = 0; l < dof; ++l) {
+						if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
+							concs[i].emplace_back(l, gridPointSolution[l]);
+						}
+					}
+				}
+
+				// Write our concentration data to the current timestep group
+				// in the HDF5 file.
+				// We only write the data for the grid points we own.
+				writer->writeConcentrations(checkpointFile, *tsGroup, timestep,
+						xs, concs);
+			});
+
 	ierr = computeTRIDYN1D(ts, timestep, time, solution, NULL);
 	CHKERRQ(ierr);
 
 	PetscFunctionReturn(0);
 }
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumDesorption1D")
+namespace {
+
 /**
- * This is a monitoring method that will compute the helium desorption at the surface
+ * This accumulator computes the helium desorption at the surface.
  */
-PetscErrorCode computeHeliumDesorption1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
-
-	PetscFunctionBeginUser;
-
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the flux handler that will be used to know the fluence
-	auto fluxHandler = solverHandler.getFluxHandler();
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
+class HeliumDesorption1D: public MonitorAccumulator {
+private:
 
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
+	//! The first local grid point.
+	PetscInt xs;
 
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
+	//! The position of the surface.
+	int surfacePos;
 
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
+	//! The index of the helium monomer.
+	int heIndex;
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
+	//! The rank of this process.
+	int procId;
 
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+public:
 
-	// Store the He concentration at the surface
-	double heConc = 0.0, diffCoeff = 0.0;
-	int heIndex = network.get(Species::He, 1)->getId() - 1;
+	HeliumDesorption1D() :
+			xs(0), surfacePos(0), heIndex(0), procId(0) {
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	}
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+	int start(PetscInt, PetscReal, PetscInt xStart, PetscInt,
+			PetscInt) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		xs = xStart;
+		surfacePos = solverHandler.getSurfacePosition();
+		heIndex = solverHandler.getNetwork().get(Species::He, 1)->getId() - 1;
 
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
+		// The He concentration times the diffusion coefficient at the surface
+		return 1;
+	}
 
+	void accumulate(PetscInt xi, const double* gridPointSolution,
+			double* values) override {
 		// Check if we are next to the surface
-		if (xi == surfacePos + 1) {
-			heConc = gridPointSolution[heIndex];
-			diffCoeff = network.get(Species::He, 1)->getDiffusionCoefficient(
-					xi - xs);
-		}
-	}
+		if (xi != surfacePos + 1)
+			return;
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+		values[0] += gridPointSolution[heIndex]
+				* network.get(Species::He, 1)->getDiffusionCoefficient(
+						xi - xs);
+	}
 
-	// Send the concentration to proc Id 0
-	double localFactor = heConc * diffCoeff, factor = 0.0;
-	MPI_Reduce(&localFactor, &factor, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
+	void finish(const double* totals) override {
+		// Master process
+		if (procId != 0)
+			return;
 
-	// Master process
-	if (procId == 0) {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		auto grid = solverHandler.getXGrid();
 		double hxLeft = 0.0;
 		if (surfacePos < 0) {
 			hxLeft = grid[surfacePos + 2] - grid[surfacePos + 1];
 		} else {
 			hxLeft = (grid[surfacePos + 2] - grid[surfacePos]) / 2.0;
 		}
-		double surfaceFlux = factor * hxLeft;
+		double surfaceFlux = totals[0] * hxLeft;
 		// Write the flux at the boundary and temperature in a file
-		std::ofstream outputFile;
-		outputFile.open("thds.txt", ios::app);
-		outputFile << network.getTemperature() << " " << surfaceFlux
-				<< std::endl;
-		outputFile.close();
+		getTelemetry().push("thds.txt",
+				{ solverHandler.getNetwork().getTemperature(), surfaceFlux });
 	}
+};
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumRetention1D")
 /**
- * This is a monitoring method that will compute the helium retention
+ * This accumulator computes the helium retention and, if the bottom is a
+ * free surface, the impurities going in the bulk.
  */
-PetscErrorCode computeHeliumRetention1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
+class HeliumRetention1D: public MonitorAccumulator {
+private:
 
-	xperf::ScopedTimer myTimer(heRetentionTimer);
+	//! The current time.
+	PetscReal time;
 
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
-
-	PetscFunctionBeginUser;
+	//! The first local grid point.
+	PetscInt xs;
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the flux handler that will be used to know the fluence
-	auto fluxHandler = solverHandler.getFluxHandler();
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the total size of the grid
+	//! The total number of grid points.
 	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
 
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	//! The position of the surface.
+	int surfacePos;
 
-	// Store the concentration over the grid
-	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0,
-			vConcentration = 0.0, iConcentration = 0.0;
+	//! Is the bottom a free surface?
+	bool freeBottom;
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+	//! The physical grid.
+	std::vector<double> grid;
 
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
-
-		// Boundary conditions
-		if (xi < surfacePos + solverHandler.getLeftOffset()
-				|| xi >= Mx - solverHandler.getRightOffset())
-			continue;
-
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
-
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
+	//! The rank of this process.
+	int procId;
 
-		double hx = grid[xi + 1] - grid[xi];
+	//! The weights of the He, D, T, V and I totals.
+	const xolotlCore::IReactionNetwork::WeightVector* weights[5];
+
+	/**
+	 * Compute the flux of a type of clusters going to the right.
+	 *
+	 * @param type The type of clusters
+	 * @param xi The grid point
+	 * @param gridPointSolution The solution at this grid point
+	 * @param factor The finite difference factor
+	 * @param hxRight The step size on the right
+	 * @return The flux
+	 */
+	double computeBottomFlux(ReactantType type, PetscInt xi,
+			const double* gridPointSolution, double factor,
+			double hxRight) const {
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+
+		// Initialize the value for the flux
+		double newFlux = 0.0;
+		// Consider each cluster of this type
+		for (auto const& mapItem : network.getAll(type)) {
+			// Get the cluster
+			auto const& cluster = *(mapItem.second);
+			// Get its diffusion coefficient
+			double coef = cluster.getDiffusionCoefficient(xi - xs);
+			if (coef <= 0.0)
+				continue;
+			// Get its id and concentration
+			int id = cluster.getId() - 1;
+			double conc = gridPointSolution[id];
+			// Get its size
+			int size = cluster.getSize();
+			// Compute the flux going to the right
+			newFlux += (double) size * factor * coef * conc * hxRight;
+		}
 
-		// Get the total atoms concentration at this grid point
-		heConcentration += network.getTotalAtomConcentration(0) * hx;
-		dConcentration += network.getTotalAtomConcentration(1) * hx;
-		tConcentration += network.getTotalAtomConcentration(2) * hx;
-		vConcentration += network.getTotalVConcentration() * hx;
-		iConcentration += network.getTotalIConcentration() * hx;
+		return newFlux;
 	}
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Determine total concentrations for He, D, T.
-	std::array<double, 5> myConcData { heConcentration, dConcentration,
-			tConcentration, vConcentration, iConcentration };
-	std::array<double, 5> totalConcData;
+public:
 
-	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
-	MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-
-	// Extract total He, D, T concentrations.  Values are valid only on rank 0.
-	double totalHeConcentration = totalConcData[0];
-	double totalDConcentration = totalConcData[1];
-	double totalTConcentration = totalConcData[2];
-	double totalVConcentration = totalConcData[3];
-	double totalIConcentration = totalConcData[4];
+	HeliumRetention1D() :
+			time(0.0), xs(0), Mx(0), surfacePos(0), freeBottom(false), procId(
+					0) {
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	}
 
-	// Look at the fluxes going in the bulk if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1) {
-		// Set the bottom surface position
-		int xi = Mx - 2;
+	int start(PetscInt, PetscReal currentTime, PetscInt xStart, PetscInt,
+			PetscInt xSize) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		time = currentTime;
+		xs = xStart;
+		Mx = xSize;
+		surfacePos = solverHandler.getSurfacePosition();
+		freeBottom = (solverHandler.getRightOffset() == 1);
+		grid = solverHandler.getXGrid();
+
+		// Get the weights of the totals
+		auto& network = solverHandler.getNetwork();
+		weights[0] = &network.getTotalAtomWeights(0);
+		weights[1] = &network.getTotalAtomWeights(1);
+		weights[2] = &network.getTotalAtomWeights(2);
+		weights[3] = &network.getTotalVWeights();
+		weights[4] = &network.getTotalIWeights();
+
+		// The He, D, T, V and I contents, then the 5 impurity counts and
+		// fluxes at the bottom
+		return freeBottom ? 15 : 5;
+	}
 
-		// Value to know on which processor is the bottom
-		int bottomProc = 0;
+	void accumulate(PetscInt xi, const double* gridPointSolution,
+			double* values) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
 
-		// Check we are on the right proc
-		if (xi >= xs && xi < xs + xm) {
+		// Look at the fluxes going in the bulk if the bottom is a free surface
+		if (freeBottom && xi == Mx - 2) {
 			// Get the delta time from the previous timestep to this timestep
 			double dt = time - previousTime;
-			// Compute the total number of impurities that went in the bulk
-			nHelium1D += previousHeFlux1D * dt;
-			nDeuterium1D += previousDFlux1D * dt;
-			nTritium1D += previousTFlux1D * dt;
-			nVacancy1D += previousVFlux1D * dt;
-			nIBulk1D += previousIBulkFlux1D * dt;
-
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
 
 			// Factor for finite difference
 			double hxLeft = 0.0, hxRight = 0.0;
@@ -676,230 +661,122 @@ PetscErrorCode computeHeliumRetention1D(TS ts, PetscInt, PetscReal time,
 			}
 			double factor = 2.0 / (hxRight * (hxLeft + hxRight));
 
-			// Initialize the value for the flux
-			double newFlux = 0.0;
-			// Consider each helium cluster.
-			for (auto const& heMapItem : network.getAll(ReactantType::He)) {
-				// Get the cluster
-				auto const& cluster = *(heMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the helium flux
-			previousHeFlux1D = newFlux;
-
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each deuterium cluster.
-			for (auto const& dMapItem : network.getAll(ReactantType::D)) {
-				// Get the cluster
-				auto const& cluster = *(dMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the deuterium flux
-			previousDFlux1D = newFlux;
-
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each tritium cluster.
-			for (auto const& tMapItem : network.getAll(ReactantType::T)) {
-				// Get the cluster
-				auto const& cluster = *(tMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the tritium flux
-			previousTFlux1D = newFlux;
+			// Only this process knows them, the others add zeros
+			values[5] = nHelium1D + previousHeFlux1D * dt;
+			values[6] = computeBottomFlux(ReactantType::He, xi,
+					gridPointSolution, factor, hxRight);
+			values[7] = nDeuterium1D + previousDFlux1D * dt;
+			values[8] = computeBottomFlux(ReactantType::D, xi,
+					gridPointSolution, factor, hxRight);
+			values[9] = nTritium1D + previousTFlux1D * dt;
+			values[10] = computeBottomFlux(ReactantType::T, xi,
+					gridPointSolution, factor, hxRight);
+			values[11] = nVacancy1D + previousVFlux1D * dt;
+			values[12] = computeBottomFlux(ReactantType::V, xi,
+					gridPointSolution, factor, hxRight);
+			values[13] = nIBulk1D + previousIBulkFlux1D * dt;
+			values[14] = computeBottomFlux(ReactantType::I, xi,
+					gridPointSolution, factor, hxRight);
+		}
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each vacancy cluster.
-			for (auto const& vMapItem : network.getAll(ReactantType::V)) {
-				// Get the cluster
-				auto const& cluster = *(vMapItem.second);
-				// Get it diffusion coefficient
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				if (coef <= 0.0)
-					continue;
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size
-				int size = cluster.getSize();
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the tritium flux
-			previousVFlux1D = newFlux;
+		// Boundary conditions
+		if (xi < surfacePos + solverHandler.getLeftOffset()
+				|| xi >= Mx - solverHandler.getRightOffset())
+			return;
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each int cluster.
-			for (auto const& iMapItem : network.getAll(ReactantType::I)) {
-				// Get the cluster
-				auto const& cluster = *(iMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the tritium flux
-			previousIBulkFlux1D = newFlux;
+		double hx = grid[xi + 1] - grid[xi];
 
-			// Set the bottom processor
-			bottomProc = procId;
+		// Get the total atoms concentration at this grid point
+		for (int i = 0; i < 5; i++) {
+			values[i] += xolotlCore::IReactionNetwork::sumWeights(*weights[i],
+					gridPointSolution) * hx;
 		}
+	}
 
-		// Get which processor will send the information
-		// TODO do we need to do this allreduce just to figure out
-		// who owns the data?
-		// And is it supposed to be a sum?   Why not a min?
-		int bottomId = 0;
-		MPI_Allreduce(&bottomProc, &bottomId, 1, MPI_INT, MPI_SUM,
-				PETSC_COMM_WORLD);
+	void finish(const double* totals) override {
+		// Every process keeps the impurity data for the checkpoints
+		if (freeBottom) {
+			nHelium1D = totals[5];
+			previousHeFlux1D = totals[6];
+			nDeuterium1D = totals[7];
+			previousDFlux1D = totals[8];
+			nTritium1D = totals[9];
+			previousTFlux1D = totals[10];
+			nVacancy1D = totals[11];
+			previousVFlux1D = totals[12];
+			nIBulk1D = totals[13];
+			previousIBulkFlux1D = totals[14];
+		}
 
-		// Send the information about impurities
-		// to the other processes
-		std::array<double, 10> countFluxData { nHelium1D, previousHeFlux1D,
-				nDeuterium1D, previousDFlux1D, nTritium1D, previousTFlux1D,
-				nVacancy1D, previousVFlux1D, nIBulk1D, previousIBulkFlux1D };
-		MPI_Bcast(countFluxData.data(), countFluxData.size(), MPI_DOUBLE,
-				bottomId, PETSC_COMM_WORLD);
-
-		// Extract inpurity data from broadcast buffer.
-		nHelium1D = countFluxData[0];
-		previousHeFlux1D = countFluxData[1];
-		nDeuterium1D = countFluxData[2];
-		previousDFlux1D = countFluxData[3];
-		nTritium1D = countFluxData[4];
-		previousTFlux1D = countFluxData[5];
-		nVacancy1D = countFluxData[6];
-		previousVFlux1D = countFluxData[7];
-		nIBulk1D = countFluxData[8];
-		previousIBulkFlux1D = countFluxData[9];
-	}
+		// Master process
+		if (procId != 0)
+			return;
 
-	// Master process
-	if (procId == 0) {
 		// Get the fluence
-		double fluence = fluxHandler->getFluence();
+		double fluence =
+				PetscSolver::getSolverHandler().getFluxHandler()->getFluence();
 
 		// Print the result
 		std::cout << "\nTime: " << time << std::endl;
-		std::cout << "Helium content = " << totalHeConcentration << std::endl;
-		std::cout << "Deuterium content = " << totalDConcentration << std::endl;
-		std::cout << "Tritium content = " << totalTConcentration << std::endl;
-		std::cout << "Vacancy content = " << totalVConcentration << std::endl;
-		std::cout << "Interstitial content = " << totalIConcentration
-				<< std::endl;
+		std::cout << "Helium content = " << totals[0] << std::endl;
+		std::cout << "Deuterium content = " << totals[1] << std::endl;
+		std::cout << "Tritium content = " << totals[2] << std::endl;
+		std::cout << "Vacancy content = " << totals[3] << std::endl;
+		std::cout << "Interstitial content = " << totals[4] << std::endl;
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration << " "
-				<< totalVConcentration << " " << totalIConcentration << " "
-				<< nHelium1D << " " << nDeuterium1D << " " << nTritium1D << " "
-				<< nVacancy1D << " " << nIBulk1D << std::endl;
-		outputFile.close();
+		// Write the retention and the fluence in a file
+		getTelemetry().push("retentionOut.txt",
+				{ fluence, totals[0], totals[1], totals[2], totals[3],
+						totals[4], nHelium1D, nDeuterium1D, nTritium1D,
+						nVacancy1D, nIBulk1D });
 	}
+};
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeXenonRetention1D")
 /**
- * This is a monitoring method that will compute the xenon retention
+ * This accumulator computes the xenon retention and the average bubble
+ * radii.
  */
-PetscErrorCode computeXenonRetention1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
+class XenonRetention1D: public MonitorAccumulator {
+private:
 
-	xperf::ScopedTimer myTimer(xeRetentionTimer);
+	//! The current time.
+	PetscReal time;
 
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
+	//! The physical grid.
+	std::vector<double> grid;
 
-	PetscFunctionBeginUser;
-
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
+	//! The minimum size for the partial radius.
+	int minSize;
 
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	//! The rank of this process.
+	int procId;
 
-	// Store the concentration and other values over the grid
-	double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0,
-			partialBubbleConcentration = 0.0, partialRadii = 0.0;
+public:
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+	XenonRetention1D() :
+			time(0.0), minSize(0), procId(0) {
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	}
 
-	// Get the minimum size for the radius
-	auto minSizes = solverHandler.getMinSizes();
+	int start(PetscInt, PetscReal currentTime, PetscInt, PetscInt, PetscInt)
+			override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		time = currentTime;
+		grid = solverHandler.getXGrid();
+		minSize = solverHandler.getMinSizes()[0];
 
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
+		// The xenon, bubble and partial bubble concentrations and radii
+		return 5;
+	}
 
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
+	bool needsNetwork() const override {
+		return true;
+	}
 
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
+	void accumulate(PetscInt xi, const double* gridPointSolution,
+			double* values) override {
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
 
 		double hx = grid[xi + 1] - grid[xi];
 
@@ -908,12 +785,12 @@ PetscErrorCode computeXenonRetention1D(TS ts, PetscInt, PetscReal time,
 			// Add the current concentration times the number of xenon in the cluster
 			// (from the weight vector)
 			double conc = gridPointSolution[indices1D[i]];
-			xeConcentration += conc * weights1D[i] * hx;
-			bubbleConcentration += conc * hx;
-			radii += conc * radii1D[i] * hx;
-			if (weights1D[i] >= minSizes[0] && conc > 1.0e-16) {
-				partialBubbleConcentration += conc * hx;
-				partialRadii += conc * radii1D[i] * hx;
+			values[0] += conc * weights1D[i] * hx;
+			values[1] += conc * hx;
+			values[2] += conc * radii1D[i] * hx;
+			if (weights1D[i] >= minSize && conc > 1.0e-16) {
+				values[3] += conc * hx;
+				values[4] += conc * radii1D[i] * hx;
 			}
 		}
 
@@ -922,197 +799,275 @@ PetscErrorCode computeXenonRetention1D(TS ts, PetscInt, PetscReal time,
 			auto const& cluster =
 					static_cast<NESuperCluster&>(*(superMapItem.second));
 			double conc = cluster.getTotalConcentration();
-			xeConcentration += cluster.getTotalXenonConcentration() * hx;
-			bubbleConcentration += conc * hx;
-			radii += conc * cluster.getReactionRadius() * hx;
-			if (cluster.getSize() >= minSizes[0] && conc > 1.0e-16) {
-				partialBubbleConcentration += conc * hx;
-				partialRadii += conc * cluster.getReactionRadius() * hx;
+			values[0] += cluster.getTotalXenonConcentration() * hx;
+			values[1] += conc * hx;
+			values[2] += conc * cluster.getReactionRadius() * hx;
+			if (cluster.getSize() >= minSize && conc > 1.0e-16) {
+				values[3] += conc * hx;
+				values[4] += conc * cluster.getReactionRadius() * hx;
 			}
 		}
 	}
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Sum all the concentrations through MPI reduce
-	std::array<double, 5> myConcData { xeConcentration, bubbleConcentration,
-			radii, partialBubbleConcentration, partialRadii };
-	std::array<double, 5> totalConcData { 0.0, 0.0, 0.0, 0.0, 0.0 };
-	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
-	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+	void finish(const double* totals) override {
+		// Master process
+		if (procId != 0)
+			return;
 
-	// Master process
-	if (procId == 0) {
 		// Print the result
 		std::cout << "\nTime: " << time << std::endl;
-		std::cout << "Xenon concentration = " << totalConcData[0] << std::endl
+		std::cout << "Xenon concentration = " << totals[0] << std::endl
 				<< std::endl;
 
 		// Make sure the average partial radius makes sense
-		double averagePartialRadius = totalConcData[4] / totalConcData[3];
+		double averagePartialRadius = totals[4] / totals[3];
 		double minRadius = pow(
-				(3.0 * (double) minSizes[0])
-						/ (4.0 * xolotlCore::pi * network.getDensity()),
+				(3.0 * (double) minSize)
+						/ (4.0 * xolotlCore::pi
+								* PetscSolver::getSolverHandler().getNetwork().getDensity()),
 				(1.0 / 3.0));
-		if (totalConcData[4] < 1.e-16 || averagePartialRadius < minRadius)
+		if (totals[4] < 1.e-16 || averagePartialRadius < minRadius)
 			averagePartialRadius = minRadius;
 
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << totalConcData[0] << " "
-				<< totalConcData[2] / totalConcData[1] << " "
-				<< averagePartialRadius << std::endl;
-		outputFile.close();
+		// Write the retention and the fluence in a file
+		getTelemetry().push("retentionOut.txt",
+				{ time, totals[0], totals[2] / totals[1], averagePartialRadius });
 	}
+};
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
-}
-
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "profileTemperature1D")
 /**
- * This is a monitoring method that will store the temperature profile
+ * This accumulator stores the temperature profile.
  */
-PetscErrorCode profileTemperature1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *ictx) {
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
+class TemperatureProfile1D: public MonitorAccumulator {
+private:
 
-	PetscFunctionBeginUser;
+	//! The current time.
+	PetscReal time;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
+	//! The first grid point of the profile.
+	PetscInt first;
 
-	// Gets the process ID
+	//! The number of grid points of the profile.
+	PetscInt size;
+
+	//! The number of degrees of freedom.
+	int dof;
+
+	//! The rank of this process.
 	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
+public:
+
+	TemperatureProfile1D() :
+			time(0.0), first(0), size(0), dof(0), procId(0) {
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	}
+
+	int start(PetscInt, PetscReal currentTime, PetscInt, PetscInt,
+			PetscInt Mx) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		time = currentTime;
+		first = solverHandler.getSurfacePosition()
+				+ solverHandler.getLeftOffset();
+		size = std::max(Mx - solverHandler.getRightOffset() - first,
+				(PetscInt) 0);
+		dof = solverHandler.getNetwork().getDOF();
+
+		// The temperature at each grid point below the surface
+		return size;
+	}
+
+	void accumulate(PetscInt xi, const double* gridPointSolution,
+			double* values) override {
+		if (xi < first || xi >= first + size)
+			return;
+
+		// Get the local temperature
+		values[xi - first] = gridPointSolution[dof - 1];
+	}
 
-	// Get the network and dof
-	auto& network = solverHandler.getNetwork();
-	const int dof = network.getDOF();
+	void finish(const double* totals) override {
+		// Master process
+		if (procId != 0)
+			return;
 
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
+		// The record starts with the time
+		std::vector<double> record(1, time);
+		record.insert(record.end(), totals, totals + size);
+		getTelemetry().push("tempProf.txt", record);
+	}
+};
 
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
+/**
+ * This accumulator computes the average density and diameter of the alloy
+ * clusters.
+ */
+class Alloy1D: public MonitorAccumulator {
+private:
 
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
+	//! The current time step.
+	PetscInt timestep;
 
-	// Get the total size of the grid
+	//! The current time.
+	PetscReal time;
+
+	//! The total number of grid points.
 	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
 
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
+	//! The position of the surface.
+	int surfacePos;
 
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	//! The minimum sizes for the partial values of the loops.
+	xolotlCore::Array<int, 4> minSizes;
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+	//! The rank of this process.
+	int procId;
 
-	// Create the output file
-	std::ofstream outputFile;
-	if (procId == 0) {
-		outputFile.open("tempProf.txt", ios::app);
-		outputFile << time;
+	//! The number of values of each type: density, diameter, partial ones.
+	static constexpr int nValues = 4;
+
+	/**
+	 * Add the clusters of a type.
+	 *
+	 * @param type The type of the clusters
+	 * @param superType The type of their super clusters
+	 * @param minSize The minimum size for the partial values, -1 for none
+	 * @param gridPointSolution The solution at this grid point
+	 * @param values Where to add the density, the diameter and the partial ones
+	 */
+	void addClusters(ReactantType type, ReactantType superType, int minSize,
+			const double* gridPointSolution, double* values) const {
+		auto& network = PetscSolver::getSolverHandler().getNetwork();
+
+		for (auto const& mapItem : network.getAll(type)) {
+			// Get the cluster
+			auto const& cluster = *(mapItem.second);
+			double conc = gridPointSolution[cluster.getId() - 1];
+			values[0] += conc;
+			values[1] += conc * cluster.getReactionRadius() * 2.0;
+			if (minSize >= 0 && cluster.getSize() >= minSize) {
+				values[2] += conc;
+				values[3] += conc * cluster.getReactionRadius() * 2.0;
+			}
+		}
+		if (superType == type)
+			return;
+		for (auto const& mapItem : network.getAll(superType)) {
+			// Get the cluster
+			auto const& cluster =
+					static_cast<AlloySuperCluster&>(*(mapItem.second));
+			double conc = cluster.getTotalConcentration();
+			values[0] += conc;
+			values[1] += conc * cluster.getReactionRadius() * 2.0;
+			if (cluster.getSize() >= minSize) {
+				values[2] += conc;
+				values[3] += conc * cluster.getReactionRadius() * 2.0;
+			}
+		}
 	}
 
-	// Loop on the entire grid
-	for (int xi = surfacePos + solverHandler.getLeftOffset();
-			xi < Mx - solverHandler.getRightOffset(); xi++) {
-		// Set x
-		double x = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
-
-		double localTemp = 0.0;
-		// Check if this process is in charge of xi
-		if (xi >= xs && xi < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
+public:
 
-			// Get the local temperature
-			localTemp = gridPointSolution[dof - 1];
-		}
+	Alloy1D() :
+			timestep(0), time(0.0), Mx(0), surfacePos(0), procId(0) {
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	}
 
-		// Get the value on procId = 0
-		double temperature = 0.0;
-		MPI_Reduce(&localTemp, &temperature, 1, MPI_DOUBLE,
-		MPI_SUM, 0, PETSC_COMM_WORLD);
+	int start(PetscInt currentTimestep, PetscReal currentTime, PetscInt,
+			PetscInt, PetscInt xSize) override {
+		timestep = currentTimestep;
+		time = currentTime;
+		Mx = xSize;
+		auto& solverHandler = PetscSolver::getSolverHandler();
+		surfacePos = solverHandler.getSurfacePosition();
+		minSizes = solverHandler.getMinSizes();
+
+		// I, V, void, faulted, perfect and frank
+		return 6 * nValues;
+	}
 
-		// The master process writes in the file
-		if (procId == 0) {
-			outputFile << " " << temperature;
-		}
+	bool needsNetwork() const override {
+		return true;
 	}
 
-	// Close the file
-	if (procId == 0) {
-		outputFile << std::endl;
-		outputFile.close();
+	void accumulate(PetscInt xi, const double* gridPointSolution,
+			double* values) override {
+		auto& solverHandler = PetscSolver::getSolverHandler();
+
+		// Boundary conditions
+		if (xi < surfacePos + solverHandler.getLeftOffset()
+				|| xi == Mx - solverHandler.getRightOffset())
+			return;
+
+		addClusters(ReactantType::I, ReactantType::I, -1, gridPointSolution,
+				values);
+		addClusters(ReactantType::V, ReactantType::V, -1, gridPointSolution,
+				values + nValues);
+		addClusters(ReactantType::Void, ReactantType::VoidSuper, minSizes[0],
+				gridPointSolution, values + 2 * nValues);
+		addClusters(ReactantType::Faulted, ReactantType::FaultedSuper,
+				minSizes[1], gridPointSolution, values + 3 * nValues);
+		addClusters(ReactantType::Perfect, ReactantType::PerfectSuper,
+				minSizes[2], gridPointSolution, values + 4 * nValues);
+		addClusters(ReactantType::Frank, ReactantType::FrankSuper, minSizes[3],
+				gridPointSolution, values + 5 * nValues);
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	void finish(const double* totals) override {
+		// Master process
+		if (procId != 0)
+			return;
+
+		// Average the data
+		auto grid = PetscSolver::getSolverHandler().getXGrid();
+		double length = grid[Mx] - grid[surfacePos + 1];
+		std::array<double, 6 * nValues> averages;
+		for (int i = 0; i < 6; i++) {
+			const double* values = totals + i * nValues;
+			double* average = averages.data() + i * nValues;
+			average[0] = values[0] / length;
+			average[1] = values[1] / (average[0] * length);
+			average[2] = values[2] / length;
+			average[3] = values[3] / (average[2] * length);
+		}
+
+		// Output the data: the densities and diameters of I, V, void,
+		// faulted, perfect and frank, then the partial ones of void,
+		// faulted, perfect and frank
+		std::vector<double> record { (double) timestep, time };
+		for (int i = 0; i < 6; i++) {
+			record.push_back(averages[i * nValues]);
+			record.push_back(averages[i * nValues + 1]);
+		}
+		for (int i = 2; i < 6; i++) {
+			record.push_back(averages[i * nValues + 2]);
+			record.push_back(averages[i * nValues + 3]);
+		}
+		getTelemetry().push("Alloy.dat", record);
+	}
+};
 
-	PetscFunctionReturn(0);
-}
+} // namespace
 
 #undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeAlloy1D")
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorSweep1D")
 /**
- * This is a monitoring method that will compute average density and diameter
+ * This is a monitoring method that goes once through the solution to compute
+ * all the observables registered in sweep1D (retention, desorption,
+ * temperature profile, ...) and sums them with a single reduction.
  */
-PetscErrorCode computeAlloy1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *ictx) {
+PetscErrorCode monitorSweep1D(TS ts, PetscInt timestep, PetscReal time,
+		Vec solution, void *) {
+
+	xperf::ScopedTimer myTimer(sweepTimer);
 
 	// Initial declarations
 	PetscErrorCode ierr;
-	PetscInt xs, xm;
+	double **solutionArray, *gridPointSolution;
+	PetscInt xs, xm, Mx;
 
 	PetscFunctionBeginUser;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the physical grid and its length
-	auto grid = solverHandler.getXGrid();
-	int xSize = grid.size();
-
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
@@ -1123,309 +1078,40 @@ PetscErrorCode computeAlloy1D(TS ts, PetscInt timestep, PetscReal time,
 	CHKERRQ(ierr);
 
 	// Get the total size of the grid
-	PetscInt Mx;
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
 	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
 	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
 	PETSC_IGNORE);
 	CHKERRQ(ierr);
 
+	// Get the network
+	auto& network = PetscSolver::getSolverHandler().getNetwork();
+
 	// Get the array of concentration
-	PetscReal **solutionArray;
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
-	// Initial declarations for the density and diameter
-	double iDensity = 0.0, vDensity = 0.0, voidDensity = 0.0,
-			frankDensity = 0.0, faultedDensity = 0.0, perfectDensity = 0.0,
-			voidPartialDensity = 0.0, frankPartialDensity = 0.0,
-			faultedPartialDensity = 0.0, perfectPartialDensity = 0.0,
-			iDiameter = 0.0, vDiameter = 0.0, voidDiameter = 0.0,
-			frankDiameter = 0.0, faultedDiameter = 0.0, perfectDiameter = 0.0,
-			voidPartialDiameter = 0.0, frankPartialDiameter = 0.0,
-			faultedPartialDiameter = 0.0, perfectPartialDiameter = 0.0;
-
-	// Get the minimum size for the loop densities and diameters
-	auto minSizes = solverHandler.getMinSizes();
-
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
-
-	// Loop on the grid
+	// Loop on the local grid
+	sweep1D.start(timestep, time, xs, xm, Mx);
 	for (PetscInt xi = xs; xi < xs + xm; xi++) {
-
-		// Boundary conditions
-		if (xi < surfacePos + solverHandler.getLeftOffset()
-				|| xi == Mx - solverHandler.getRightOffset())
-			continue;
-
 		// Get the pointer to the beginning of the solution data for this grid point
 		gridPointSolution = solutionArray[xi];
 
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
-
-		// Loop on I
-		for (auto const& iMapItem : network.getAll(ReactantType::I)) {
-			// Get the cluster
-			auto const& cluster = *(iMapItem.second);
-			iDensity += gridPointSolution[cluster.getId() - 1];
-			iDiameter += gridPointSolution[cluster.getId() - 1]
-					* cluster.getReactionRadius() * 2.0;
-		}
-
-		// Loop on V
-		for (auto const& vMapItem : network.getAll(ReactantType::V)) {
-			// Get the cluster
-			auto const& cluster = *(vMapItem.second);
-			vDensity += gridPointSolution[cluster.getId() - 1];
-			vDiameter += gridPointSolution[cluster.getId() - 1]
-					* cluster.getReactionRadius() * 2.0;
-		}
-
-		// Loop on Void
-		for (auto const& voidMapItem : network.getAll(ReactantType::Void)) {
-			// Get the cluster
-			auto const& cluster = *(voidMapItem.second);
-			voidDensity += gridPointSolution[cluster.getId() - 1];
-			voidDiameter += gridPointSolution[cluster.getId() - 1]
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[0]) {
-				voidPartialDensity += gridPointSolution[cluster.getId() - 1];
-				voidPartialDiameter += gridPointSolution[cluster.getId() - 1]
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-		for (auto const& voidMapItem : network.getAll(ReactantType::VoidSuper)) {
-			// Get the cluster
-			auto const& cluster =
-					static_cast<AlloySuperCluster&>(*(voidMapItem.second));
-			voidDensity += cluster.getTotalConcentration();
-			voidDiameter += cluster.getTotalConcentration()
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[0]) {
-				voidPartialDensity += cluster.getTotalConcentration();
-				voidPartialDiameter += cluster.getTotalConcentration()
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-
-		// Loop on Faulted
-		for (auto const& faultedMapItem : network.getAll(ReactantType::Faulted)) {
-			// Get the cluster
-			auto const& cluster = *(faultedMapItem.second);
-			faultedDensity += gridPointSolution[cluster.getId() - 1];
-			faultedDiameter += gridPointSolution[cluster.getId() - 1]
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[1]) {
-				faultedPartialDensity += gridPointSolution[cluster.getId() - 1];
-				faultedPartialDiameter += gridPointSolution[cluster.getId() - 1]
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-		for (auto const& faultedMapItem : network.getAll(
-				ReactantType::FaultedSuper)) {
-			// Get the cluster
-			auto const& cluster =
-					static_cast<AlloySuperCluster&>(*(faultedMapItem.second));
-			faultedDensity += cluster.getTotalConcentration();
-			faultedDiameter += cluster.getTotalConcentration()
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[1]) {
-				faultedPartialDensity += cluster.getTotalConcentration();
-				faultedPartialDiameter += cluster.getTotalConcentration()
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-
-		// Loop on Perfect
-		for (auto const& perfectMapItem : network.getAll(ReactantType::Perfect)) {
-			// Get the cluster
-			auto const& cluster = *(perfectMapItem.second);
-			perfectDensity += gridPointSolution[cluster.getId() - 1];
-			perfectDiameter += gridPointSolution[cluster.getId() - 1]
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[2]) {
-				perfectPartialDensity += gridPointSolution[cluster.getId() - 1];
-				perfectPartialDiameter += gridPointSolution[cluster.getId() - 1]
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-		for (auto const& perfectMapItem : network.getAll(
-				ReactantType::PerfectSuper)) {
-			// Get the cluster
-			auto const& cluster =
-					static_cast<AlloySuperCluster&>(*(perfectMapItem.second));
-			perfectDensity += cluster.getTotalConcentration();
-			perfectDiameter += cluster.getTotalConcentration()
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[2]) {
-				perfectPartialDensity += cluster.getTotalConcentration();
-				perfectPartialDiameter += cluster.getTotalConcentration()
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-
-		// Loop on Frank
-		for (auto const& frankMapItem : network.getAll(ReactantType::Frank)) {
-			// Get the cluster
-			auto const& cluster = *(frankMapItem.second);
-			frankDensity += gridPointSolution[cluster.getId() - 1];
-			frankDiameter += gridPointSolution[cluster.getId() - 1]
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[3]) {
-				frankPartialDensity += gridPointSolution[cluster.getId() - 1];
-				frankPartialDiameter += gridPointSolution[cluster.getId() - 1]
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-		for (auto const& frankMapItem : network.getAll(ReactantType::FrankSuper)) {
-			// Get the cluster
-			auto const& cluster =
-					static_cast<AlloySuperCluster&>(*(frankMapItem.second));
-			frankDensity += cluster.getTotalConcentration();
-			frankDiameter += cluster.getTotalConcentration()
-					* cluster.getReactionRadius() * 2.0;
-			if (cluster.getSize() >= minSizes[3]) {
-				frankPartialDensity += cluster.getTotalConcentration();
-				frankPartialDiameter += cluster.getTotalConcentration()
-						* cluster.getReactionRadius() * 2.0;
-			}
-		}
-	}
-
-	// Sum all the concentrations through MPI reduce
-	double iTotalDensity = 0.0, vTotalDensity = 0.0, voidTotalDensity = 0.0,
-			frankTotalDensity = 0.0, faultedTotalDensity = 0.0,
-			perfectTotalDensity = 0.0, voidPartialTotalDensity = 0.0,
-			frankPartialTotalDensity = 0.0, faultedPartialTotalDensity = 0.0,
-			perfectPartialTotalDensity = 0.0, iTotalDiameter = 0.0,
-			vTotalDiameter = 0.0, voidTotalDiameter = 0.0, frankTotalDiameter =
-					0.0, faultedTotalDiameter = 0.0, perfectTotalDiameter = 0.0,
-			voidPartialTotalDiameter = 0.0, frankPartialTotalDiameter = 0.0,
-			faultedPartialTotalDiameter = 0.0,
-			perfectPartialTotalDiameter = 0.0;
-	MPI_Reduce(&iDensity, &iTotalDensity, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&vDensity, &vTotalDensity, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&voidDensity, &voidTotalDensity, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&perfectDensity, &perfectTotalDensity, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&frankDensity, &frankTotalDensity, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&faultedDensity, &faultedTotalDensity, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&voidPartialDensity, &voidPartialTotalDensity, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&perfectPartialDensity, &perfectPartialTotalDensity, 1,
-	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&frankPartialDensity, &frankPartialTotalDensity, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&faultedPartialDensity, &faultedPartialTotalDensity, 1,
-	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&iDiameter, &iTotalDiameter, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&vDiameter, &vTotalDiameter, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&voidDiameter, &voidTotalDiameter, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&perfectDiameter, &perfectTotalDiameter, 1, MPI_DOUBLE, MPI_SUM,
-			0, PETSC_COMM_WORLD);
-	MPI_Reduce(&frankDiameter, &frankTotalDiameter, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
-	MPI_Reduce(&faultedDiameter, &faultedTotalDiameter, 1, MPI_DOUBLE, MPI_SUM,
-			0, PETSC_COMM_WORLD);
-	MPI_Reduce(&voidPartialDiameter, &voidPartialTotalDiameter, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&perfectPartialDiameter, &perfectPartialTotalDiameter, 1,
-	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&frankPartialDiameter, &frankPartialTotalDiameter, 1, MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
-	MPI_Reduce(&faultedPartialDiameter, &faultedPartialTotalDiameter, 1,
-	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
-
-	// Average the data
-	if (procId == 0) {
-		iTotalDensity = iTotalDensity / (grid[Mx] - grid[surfacePos + 1]);
-		vTotalDensity = vTotalDensity / (grid[Mx] - grid[surfacePos + 1]);
-		voidTotalDensity = voidTotalDensity / (grid[Mx] - grid[surfacePos + 1]);
-		perfectTotalDensity = perfectTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		faultedTotalDensity = faultedTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		frankTotalDensity = frankTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		voidPartialTotalDensity = voidPartialTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		perfectPartialTotalDensity = perfectPartialTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		faultedPartialTotalDensity = faultedPartialTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		frankPartialTotalDensity = frankPartialTotalDensity
-				/ (grid[Mx] - grid[surfacePos + 1]);
-		iTotalDiameter = iTotalDiameter
-				/ (iTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		vTotalDiameter = vTotalDiameter
-				/ (vTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		voidTotalDiameter = voidTotalDiameter
-				/ (voidTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		perfectTotalDiameter = perfectTotalDiameter
-				/ (perfectTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		faultedTotalDiameter = faultedTotalDiameter
-				/ (faultedTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		frankTotalDiameter = frankTotalDiameter
-				/ (frankTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		voidPartialTotalDiameter = voidPartialTotalDiameter
-				/ (voidPartialTotalDensity * (grid[Mx] - grid[surfacePos + 1]));
-		perfectPartialTotalDiameter = perfectPartialTotalDiameter
-				/ (perfectPartialTotalDensity
-						* (grid[Mx] - grid[surfacePos + 1]));
-		faultedPartialTotalDiameter = faultedPartialTotalDiameter
-				/ (faultedPartialTotalDensity
-						* (grid[Mx] - grid[surfacePos + 1]));
-		frankPartialTotalDiameter =
-				frankPartialTotalDiameter
-						/ (frankPartialTotalDensity
-								* (grid[Mx] - grid[surfacePos + 1]));
-
-		// Set the output precision
-		const int outputPrecision = 5;
-
-		// Open the output file
-		std::fstream outputFile;
-		outputFile.open("Alloy.dat", std::fstream::out | std::fstream::app);
-		outputFile << std::setprecision(outputPrecision);
-
-		// Output the data
-		outputFile << timestep << " " << time << " " << iTotalDensity << " "
-				<< iTotalDiameter << " " << vTotalDensity << " "
-				<< vTotalDiameter << " " << voidTotalDensity << " "
-				<< voidTotalDiameter << " " << faultedTotalDensity << " "
-				<< faultedTotalDiameter << " " << perfectTotalDensity << " "
-				<< perfectTotalDiameter << " " << frankTotalDensity << " "
-				<< frankTotalDiameter << " " << voidPartialTotalDensity << " "
-				<< voidPartialTotalDiameter << " " << faultedPartialTotalDensity
-				<< " " << faultedPartialTotalDiameter << " "
-				<< perfectPartialTotalDensity << " "
-				<< perfectPartialTotalDiameter << " "
-				<< frankPartialTotalDensity << " " << frankPartialTotalDiameter
-				<< std::endl;
+		// Update the concentration in the network once for everybody
+		if (sweep1D.needsNetwork())
+			network.updateConcentrationsFromArray(gridPointSolution);
 
-		// Close the output file
-		outputFile.close();
+		sweep1D.accumulate(xi, gridPointSolution);
 	}
 
-	// Restore the PETSC solution array
+	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	PetscFunctionReturn(0);
+	// Sum and write everything
+	sweep1D.finish(PETSC_COMM_WORLD);
 
+	PetscFunctionReturn(0);
 }
 
 #undef __FUNCT__
@@ -1449,13 +1135,9 @@ PetscErrorCode monitorScatter1D(TS ts, PetscInt timestep, PetscReal time,
 	if (timestep % 200 != 0)
 		PetscFunctionReturn(0);
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
 	// Gets the process ID (important when it is running in parallel)
 	int procId;
-	MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 
 	// Get the da from ts
 	DM da;
@@ -1487,98 +1169,71 @@ PetscErrorCode monitorScatter1D(TS ts, PetscInt timestep, PetscReal time,
 
 	// Get the index of the middle of the grid
 	PetscInt ix = Mx / 2;
+	bool isLocal = (ix >= xs && ix < xs + xm);
 
-	if (procId == 0) {
-		// Create a Point vector to store the data to give to the data provider
-		// for the visualization
-		auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
-
-		// If the middle is on this process
-		if (ix >= xs && ix < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[ix];
+	// If the middle is on this process
+	if (isLocal) {
+		// Get the pointer to the beginning of the solution data for this grid point
+		gridPointSolution = solutionArray[ix];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
+		// Update the concentration in the network
+		network.updateConcentrationsFromArray(gridPointSolution);
+	}
 
-			for (int i = 0; i < networkSize - superClusters.size(); i++) {
-				// Create a Point with the concentration[i] as the value
-				// and add it to myPoints
-				xolotlViz::Point aPoint;
-				aPoint.value = gridPointSolution[i];
-				aPoint.t = time;
-				aPoint.x = (double) i + 1.0;
-				myPoints->push_back(aPoint);
-			}
+	// Pack the sizes and the concentrations to plot, the sizes are the same
+	// on every process but only the one with the middle knows the
+	// concentrations
+	std::vector<double> sizes, concs;
+	for (int i = 0; i < networkSize - superClusters.size(); i++) {
+		sizes.push_back((double) i + 1.0);
+		concs.push_back(isLocal ? gridPointSolution[i] : 0.0);
+	}
 
-			// Loop on the super clusters
-			auto& allReactants = network.getAll();
-			std::for_each(allReactants.begin(), allReactants.end(),
-					[&time,&myPoints](IReactant& currReactant) {
-
-						if (currReactant.getType() == ReactantType::NESuper) {
-							auto& cluster = static_cast<NESuperCluster&>(currReactant);
-							// Get the width and average
-							int width = cluster.getSectionWidth();
-							double nXe = cluster.getAverage();
-							// Loop on the width
-							for (int k = nXe + 1.0 - (double) width / 2.0;
-									k < nXe + (double) width / 2.0; k++) {
-								// Compute the distance
-								double dist = cluster.getDistance(k);
-								// Create a Point with the concentration[i] as the value
-								// and add it to myPoints
-								xolotlViz::Point aPoint;
-								aPoint.value = cluster.getConcentration(dist);
-								aPoint.t = time;
-								aPoint.x = (double) k;
-								myPoints->push_back(aPoint);
-							}
-						}
-					});
-		}
+	// Loop on the super clusters
+	auto& allReactants = network.getAll();
+	std::for_each(allReactants.begin(), allReactants.end(),
+			[&sizes,&concs,&isLocal](IReactant& currReactant) {
+
+				if (currReactant.getType() == ReactantType::NESuper) {
+					auto& cluster = static_cast<NESuperCluster&>(currReactant);
+					// Get the width and average
+					int width = cluster.getSectionWidth();
+					double nXe = cluster.getAverage();
+					// Loop on the width
+					for (int k = nXe + 1.0 - (double) width / 2.0;
+							k < nXe + (double) width / 2.0; k++) {
+						sizes.push_back((double) k);
+						// Compute the distance
+						double dist = cluster.getDistance(k);
+						concs.push_back(
+								isLocal ? cluster.getConcentration(dist) : 0.0);
+					}
+				}
+			});
+
+	// Send the whole packed buffer to the master process at once
+	if (procId == 0 && !isLocal) {
+		MPI_Recv(concs.data(), concs.size(), MPI_DOUBLE, MPI_ANY_SOURCE, 10,
+				PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
+	} else if (procId != 0 && isLocal) {
+		MPI_Send(concs.data(), concs.size(), MPI_DOUBLE, 0, 10,
+				PETSC_COMM_WORLD);
+	}
 
-		// else receive the values from another process
-		else {
-			for (int i = 0; i < networkSize - superClusters.size(); i++) {
-				double conc = 0.0;
-				MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 10,
-						MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-				// Create a Point with conc as the value
-				// and add it to myPoints
-				xolotlViz::Point aPoint;
-				aPoint.value = conc;
-				aPoint.t = time;
-				aPoint.x = (double) i + 1.0;
-				myPoints->push_back(aPoint);
-			}
+	if (procId == 0) {
+		// Create a Point vector to store the data to give to the data provider
+		// for the visualization
+		auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
 
-			// Loop on the super clusters
-			auto& allReactants = network.getAll();
-			std::for_each(allReactants.begin(), allReactants.end(),
-					[&time,&myPoints](IReactant& currReactant) {
-
-						if (currReactant.getType() == ReactantType::NESuper) {
-							auto& cluster = static_cast<NESuperCluster&>(currReactant);
-							// Get the width and average
-							int width = cluster.getSectionWidth();
-							double nXe = cluster.getAverage();
-							// Loop on the width
-							for (int k = nXe + 1.0 - (double) width / 2.0;
-									k < nXe + (double) width / 2.0; k++) {
-								double conc = 0.0;
-								MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 11,
-										MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-								// Create a Point with conc as the value
-								// and add it to myPoints
-								xolotlViz::Point aPoint;
-								aPoint.value = conc;
-								aPoint.t = time;
-								aPoint.x = (double) k;
-								myPoints->push_back(aPoint);
-							}
-						}
-					});
+		// Loop on the packed values
+		for (int i = 0; i < sizes.size(); i++) {
+			// Create a Point with the concentration[i] as the value
+			// and add it to myPoints
+			xolotlViz::Point aPoint;
+			aPoint.value = concs[i];
+			aPoint.t = time;
+			aPoint.x = sizes[i];
+			myPoints->push_back(aPoint);
 		}
 
 		// Get the data provider and give it the points
@@ -1609,41 +1264,6 @@ PetscErrorCode monitorScatter1D(TS ts, PetscInt timestep, PetscReal time,
 		scatterPlot1D->write(fileName.str());
 	}
 
-	else {
-		// If the middle is on this process
-		if (ix >= xs && ix < xs + xm) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[ix];
-
-			for (int i = 0; i < networkSize - superClusters.size(); i++) {
-				// Send the value of each concentration to the master process
-				MPI_Send(&gridPointSolution[i], 1, MPI_DOUBLE, 0, 10,
-						MPI_COMM_WORLD);
-			}
-
-			// Loop on the super clusters
-			auto& allReactants = network.getAll();
-			std::for_each(allReactants.begin(), allReactants.end(),
-					[](IReactant& currReactant) {
-
-						if (currReactant.getType() == ReactantType::NESuper) {
-							auto& cluster = static_cast<NESuperCluster&>(currReactant);
-							// Get the width and average
-							int width = cluster.getSectionWidth();
-							double nXe = cluster.getAverage();
-							// Loop on the width
-							for (int k = nXe + 1.0 - (double) width / 2.0; k < nXe + (double) width / 2.0; k++) {
-								// Compute the distance
-								double dist = cluster.getDistance(k);
-								double conc = cluster.getConcentration(dist);
-								// Send the value of each concentration to the master process
-								MPI_Send(&conc, 1, MPI_DOUBLE, 0, 11, MPI_COMM_WORLD);
-							}
-						}
-					});
-		}
-	}
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
@@ -1665,7 +1285,6 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	PetscErrorCode ierr;
 	const double **solutionArray, *gridPointSolution;
 	PetscInt xs, xm, xi;
-	double x = 0.0;
 
 	PetscFunctionBeginUser;
 
@@ -1673,10 +1292,6 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	if (timestep % 10 != 0)
 		PetscFunctionReturn(0);
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
 	// Gets the process ID (important when it is running in parallel)
 	int procId;
 	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
@@ -1707,57 +1322,41 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 	// To plot a maximum of 18 clusters of the whole benchmark
 	const int loopSize = std::min(18, networkSize);
 
+	// Pack the position and the concentrations of each local grid point
+	std::vector<double> localValues;
+	localValues.reserve(xm * (loopSize + 1));
+	for (xi = xs; xi < xs + xm; xi++) {
+		// Get the pointer to the beginning of the solution data for this grid point
+		gridPointSolution = solutionArray[xi];
+
+		// The position first, then the concentrations
+		localValues.push_back((grid[xi] + grid[xi + 1]) / 2.0 - grid[1]);
+		for (int i = 0; i < loopSize; i++) {
+			localValues.push_back(gridPointSolution[i]);
+		}
+	}
+
+	// Gather them on the master process
+	auto allValues = gatherOnMaster(localValues, PETSC_COMM_WORLD);
+
 	if (procId == 0) {
 		// Create a Point vector to store the data to give to the data provider
 		// for the visualization
 		std::vector<std::vector<xolotlViz::Point> > myPoints(loopSize);
 
-		// Loop on the grid
-		for (xi = xs; xi < xs + xm; xi++) {
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
-
+		// Loop on the grid points of all the processes
+		for (std::size_t k = 0; k < allValues.size(); k += loopSize + 1) {
 			for (int i = 0; i < loopSize; i++) {
 				// Create a Point with the concentration[i] as the value
 				// and add it to myPoints
 				xolotlViz::Point aPoint;
-				aPoint.value = gridPointSolution[i];
+				aPoint.value = allValues[k + 1 + i];
 				aPoint.t = time;
-				aPoint.x = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
+				aPoint.x = allValues[k];
 				myPoints[i].push_back(aPoint);
 			}
 		}
 
-		// Loop on the other processes
-		for (int i = 1; i < worldSize; i++) {
-			// Get the size of the local grid of that process
-			int localSize = 0;
-			MPI_Recv(&localSize, 1, MPI_INT, i, 20, PETSC_COMM_WORLD,
-					MPI_STATUS_IGNORE);
-
-			// Loop on their grid
-			for (int k = 0; k < localSize; k++) {
-				// Get the position
-				MPI_Recv(&x, 1, MPI_DOUBLE, i, 21, PETSC_COMM_WORLD,
-						MPI_STATUS_IGNORE);
-
-				for (int j = 0; j < loopSize; j++) {
-					// and the concentrations
-					double conc = 0.0;
-					MPI_Recv(&conc, 1, MPI_DOUBLE, i, 22, PETSC_COMM_WORLD,
-							MPI_STATUS_IGNORE);
-
-					// Create a Point with the concentration[i] as the value
-					// and add it to myPoints
-					xolotlViz::Point aPoint;
-					aPoint.value = conc;						// He
-					aPoint.t = time;
-					aPoint.x = x;
-					myPoints[j].push_back(aPoint);
-				}
-			}
-		}
-
 		// Get all the reactants to have access to their names
 		auto const& reactants = network.getAll();
 
@@ -1794,29 +1393,6 @@ PetscErrorCode monitorSeries1D(TS ts, PetscInt timestep, PetscReal time,
 		seriesPlot1D->write(fileName.str());
 	}
 
-	else {
-		// Send the value of the local grid size to the master process
-		MPI_Send(&xm, 1, MPI_DOUBLE, 0, 20, PETSC_COMM_WORLD);
-
-		// Loop on the grid
-		for (xi = xs; xi < xs + xm; xi++) {
-			// Dump x
-			x = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
-
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
-
-			// Send the value of the local position to the master process
-			MPI_Send(&x, 1, MPI_DOUBLE, 0, 21, PETSC_COMM_WORLD);
-
-			for (int i = 0; i < loopSize; i++) {
-				// Send the value of the concentrations to the master process
-				MPI_Send(&gridPointSolution[i], 1, MPI_DOUBLE, 0, 22,
-						PETSC_COMM_WORLD);
-			}
-		}
-	}
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
@@ -2061,11 +1637,8 @@ PetscErrorCode eventFunction1D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface position
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " " << grid[surfacePos + 1] - grid[1]
-					<< std::endl;
-			outputFile.close();
+			getTelemetry().push("surface.txt",
+					{ time, grid[surfacePos + 1] - grid[1] });
 		}
 
 		// Value to know on which processor is the location of the surface,
@@ -2305,10 +1878,7 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 				+ grid[depthPositions1D[i] + 1]) / 2.0 - grid[surfacePos + 1];
 
 		// Write the bursting information
-		std::ofstream outputFile;
-		outputFile.open("bursting.txt", ios::app);
-		outputFile << time << " " << distance << std::endl;
-		outputFile.close();
+		getTelemetry().push("bursting.txt", { time, distance });
 
 		// Pinhole case
 		// Consider each He to reset their concentration at this grid point
@@ -2541,17 +2111,53 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 
 	// Write the updated surface position
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " " << grid[surfacePos + 1] - grid[1]
-				<< std::endl;
-		outputFile.close();
+		getTelemetry().push("surface.txt",
+				{ time, grid[surfacePos + 1] - grid[1] });
 	}
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOF(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Check if the active grid points are still balanced between the processes
+	if (repartitionThreshold1D > 0.0) {
+		PetscInt Mx;
+		ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
+		PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+		PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+		PETSC_IGNORE);
+		CHKERRQ(ierr);
+
+		// Count the local active grid points
+		int firstActive = surfacePos + solverHandler.getLeftOffset();
+		int lastActive = Mx - solverHandler.getRightOffset();
+		int localActive = std::max(
+				std::min(xs + xm, lastActive) - std::max(xs, firstActive), 0);
+
+		// Compare the busiest process to the mean
+		int maxActive = 0, totalActive = 0, nProcs = 0;
+		MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+		MPI_Allreduce(&localActive, &maxActive, 1, MPI_INT, MPI_MAX,
+				PETSC_COMM_WORLD);
+		MPI_Allreduce(&localActive, &totalActive, 1, MPI_INT, MPI_SUM,
+				PETSC_COMM_WORLD);
+		double imbalance = 0.0;
+		if (totalActive > 0)
+			imbalance = (double) maxActive * (double) nProcs
+					/ (double) totalActive;
+
+		// Stop the solver so that it can continue on a new grid partition
+		if (imbalance > repartitionThreshold1D && totalActive >= nProcs) {
+			if (procId == 0) {
+				std::cout << "Repartitioning the grid at time: " << time
+						<< " s (imbalance: " << imbalance << ")." << std::endl;
+			}
+			solverHandler.setRepartitionNeeded(true);
+			ierr = TSSetConvergedReason(ts, TS_CONVERGED_USER);
+			CHKERRQ(ierr);
+		}
+	}
+
 	PetscFunctionReturn(0);
 }
 
@@ -2572,8 +2178,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	checkNegativeTimer = handlerRegistry->getTimer("monitor1D:checkNeg");
 	tridynTimer = handlerRegistry->getTimer("monitor1D:tridyn");
 	startStopTimer = handlerRegistry->getTimer("monitor1D:startStop");
-	heRetentionTimer = handlerRegistry->getTimer("monitor1D:heRet");
-	xeRetentionTimer = handlerRegistry->getTimer("monitor1D:xeRet");
+	sweepTimer = handlerRegistry->getTimer("monitor1D:sweep");
 	scatterTimer = handlerRegistry->getTimer("monitor1D:scatter");
 	seriesTimer = handlerRegistry->getTimer("monitor1D:series");
 	surfaceTimer = handlerRegistry->getTimer("monitor1D:surface");
@@ -2787,6 +2392,9 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 					hdf5OutputName1D, network);
 		}
 
+		// Create the writer for the checkpoints
+		createCheckpointWriter(hdf5OutputName1D);
+
 		// startStop1D will be called at each timestep
 		ierr = TSMonitorSet(ts, startStop1D, NULL, NULL);
 		checkPetscError(ierr,
@@ -2814,12 +2422,26 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			// Get the sputtering yield
 			sputteringYield1D = solverHandler.getSputteringYield();
 
+			// Check the option -repartition to get the allowed load imbalance
+			PetscBool flagRepartition;
+			ierr = PetscOptionsGetReal(NULL, NULL, "-repartition",
+					&repartitionThreshold1D, &flagRepartition);
+			checkPetscError(ierr,
+					"setupPetsc1DMonitor: PetscOptionsGetReal (-repartition) failed.");
+			if (!flagRepartition)
+				repartitionThreshold1D = 0.0;
+			// The imbalance is never below 1, the grid would be
+			// repartitioned at every time step
+			else if (repartitionThreshold1D <= 1.0)
+				throw std::string(
+						"\nxolotlSolver::Monitor1D: The -repartition load imbalance "
+								"must be greater than 1!");
+
 			// Master process
 			if (procId == 0) {
 				// Clear the file where the surface will be written
-				std::ofstream outputFile;
-				outputFile.open("surface.txt");
-				outputFile.close();
+				getTelemetry().addStream("surface.txt", { "time", "surface" },
+						true);
 			}
 		}
 
@@ -2844,9 +2466,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the bursting info will be written
-			std::ofstream outputFile;
-			outputFile.open("bursting.txt");
-			outputFile.close();
+			getTelemetry().addStream("bursting.txt", { "time", "depth" }, true);
 		}
 	}
 
@@ -3019,17 +2639,14 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 
 	// Set the monitor to compute the helium desorption
 	if (flagHeDesorption) {
-		// computeHeliumDesorption1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumDesorption1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumDesorption1D) failed.");
+		// The desorption will be computed by monitorSweep1D
+		sweep1D.add(std::make_shared<HeliumDesorption1D>());
 
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the desorption
-			std::ofstream outputFile;
-			outputFile.open("thds.txt");
-			outputFile.close();
+			getTelemetry().addStream("thds.txt", { "temperature", "flux" },
+					true);
 		}
 	}
 
@@ -3076,17 +2693,15 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeHeliumRetention1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumRetention1D) failed.");
+		// The retention will be computed by monitorSweep1D
+		sweep1D.add(std::make_shared<HeliumRetention1D>());
 
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			getTelemetry().addStream("retentionOut.txt",
+					{ "fluence", "He", "D", "T", "V", "I", "nHe", "nD", "nT",
+							"nV", "nI" }, true);
 		}
 	}
 
@@ -3128,17 +2743,14 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeXenonRetention1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeXenonRetention1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeXenonRetention1D) failed.");
+		// The retention will be computed by monitorSweep1D
+		sweep1D.add(std::make_shared<XenonRetention1D>());
 
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			getTelemetry().addStream("retentionOut.txt",
+					{ "time", "Xe", "radius", "partialRadius" }, true);
 		}
 	}
 
@@ -3153,16 +2765,20 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	// Set the monitor to output data for Alloy
 	if (flagAlloy) {
 		if (procId == 0) {
-			// Create/open the output files
-			std::fstream outputFile;
-			outputFile.open("Alloy.dat", std::fstream::out);
-			outputFile.close();
-		}
-
-		// computeAlloy1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeAlloy1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeAlloy1D) failed.");
+			// Clear the file where the data will be written
+			getTelemetry().addStream("Alloy.dat",
+					{ "timestep", "time", "iDensity", "iDiameter", "vDensity",
+						"vDiameter", "voidDensity", "voidDiameter",
+						"faultedDensity", "faultedDiameter", "perfectDensity",
+						"perfectDiameter", "frankDensity", "frankDiameter",
+						"voidPartialDensity", "voidPartialDiameter",
+						"faultedPartialDensity", "faultedPartialDiameter",
+						"perfectPartialDensity", "perfectPartialDiameter",
+						"frankPartialDensity", "frankPartialDiameter" }, true);
+		}
+
+		// The densities and diameters will be computed by monitorSweep1D
+		sweep1D.add(std::make_shared<Alloy1D>());
 	}
 
 	// Set the monitor to compute the temperature profile
@@ -3170,8 +2786,8 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("tempProf.txt");
+			getTelemetry().addStream("tempProf.txt",
+					{ "time", "temperature" }, true);
 
 			// Get the da from ts
 			DM da;
@@ -3191,22 +2807,27 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			// Get the position of the surface
 			int surfacePos = solverHandler.getSurfacePosition();
 
-			// Loop on the entire grid
+			// The first record is the depth of the grid points
+			std::vector<double> depths;
 			for (int xi = surfacePos + solverHandler.getLeftOffset();
 					xi < Mx - solverHandler.getRightOffset(); xi++) {
 				// Set x
 				double x = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
-				outputFile << x << " ";
-
+				depths.push_back(x);
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			getTelemetry().push("tempProf.txt", depths);
 		}
 
-		// computeCumulativeHelium1D will be called at each timestep
-		ierr = TSMonitorSet(ts, profileTemperature1D, NULL, NULL);
+		// The profile will be computed by monitorSweep1D
+		sweep1D.add(std::make_shared<TemperatureProfile1D>());
+	}
+
+	// Compute all the observables in a single pass over the solution
+	if (!sweep1D.empty()) {
+		// monitorSweep1D will be called at each timestep
+		ierr = TSMonitorSet(ts, monitorSweep1D, NULL, NULL);
 		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (profileTemperature1D) failed.");
+				"setupPetsc1DMonitor: TSMonitorSet (monitorSweep1D) failed.");
 	}
 
 	// Set the monitor to simply change the previous time to the new time
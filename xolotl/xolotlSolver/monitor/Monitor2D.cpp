@@ -21,6 +21,7 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
 
 namespace xolotlSolver {
 
@@ -37,6 +38,7 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
 
 //! How often HDF5 file is written
 PetscReal hdf5Stride2D = 0.0;
@@ -83,7 +85,7 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declaration
 	PetscErrorCode ierr;
-	const double ***solutionArray, *gridPointSolution;
+	const double ***solutionArray;
 	PetscInt xs, xm, Mx, ys, ym, My;
 
 	PetscFunctionBeginUser;
@@ -135,95 +137,26 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the vector of positions of the surface
 	std::vector<int> surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
 		surfaceIndices.push_back(solverHandler.getSurfacePosition(i));
 	}
 
-	// Open the existing checkpoint file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName2D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface2D(surfaceIndices, nInterstitial2D,
-				previousIFlux2D);
-	}
-
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom2D(nHelium2D, previousHeFlux2D, nDeuterium2D,
-				previousDFlux2D, nTritium2D, previousTFlux2D);
-
-	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Wait for all the processes
-			MPI_Barrier(PETSC_COMM_WORLD);
-
-			// Size of the concentration that will be stored
-			int concSize = -1;
-			// To save which proc has the information
-			int concId = 0;
-			// To know which process should write
-			bool write = false;
-
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				write = true;
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
-
-				// Loop on the concentrations
-				for (int l = 0; l < dof; l++) {
-					if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-						// Increase concSize
-						concSize++;
-						// Fill the concArray
-						concArray[concSize][0] = (double) l;
-						concArray[concSize][1] = gridPointSolution[l];
-					}
-				}
-
-				// Increase concSize one last time
-				concSize++;
-
-				// Save the procId
-				concId = procId;
-			}
-
-			// Get which processor will send the information
-			int concProc = 0;
-			MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-					PETSC_COMM_WORLD);
-
-			// Broadcast the size
-			MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
-
-			// Skip the grid point if the size is 0
-			if (concSize == 0)
-				continue;
-
-			// All processes create the dataset and fill it
-			tsGroup->writeConcentrationDataset(concSize, concArray, write, i,
-					j);
+	// Snapshot the grid points we own so that the solver can continue
+	// while the checkpoint is written
+	auto& snapshot = checkpointWriter->getBuffer();
+	snapshot.resize(xm * ym * dof);
+	for (PetscInt j = 0; j < ym; j++) {
+		for (PetscInt i = 0; i < xm; i++) {
+			std::copy(solutionArray[ys + j][xs + i],
+					solutionArray[ys + j][xs + i] + dof,
+					snapshot.begin() + (j * xm + i) * dof);
 		}
 	}
 
@@ -231,6 +164,103 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Copy everything the checkpoint needs, the globals change while
+	// it is written
+	double prevTime = previousTime;
+	bool moveSurface = solverHandler.moveSurface();
+	auto nInter = nInterstitial2D;
+	auto previousIFlux = previousIFlux2D;
+	bool writeBottom = (solverHandler.getRightOffset() == 1);
+	auto nHe = nHelium2D, previousHeFlux = previousHeFlux2D;
+	auto nD = nDeuterium2D, previousDFlux = previousDFlux2D;
+	auto nT = nTritium2D, previousTFlux = previousTFlux2D;
+
+	// The collective calls of the checkpoint go through its own communicator
+	MPI_Comm comm = checkpointWriter->getComm();
+
+	// Write the checkpoint
+	checkpointWriter->submit(
+			[=](xolotlCore::XFile& checkpointFile,
+					const std::vector<double>& buffer) {
+				// Add a concentration sub group
+				auto concGroup = checkpointFile.getGroup<
+						xolotlCore::XFile::ConcentrationGroup>();
+				assert(concGroup);
+				auto tsGroup = concGroup->addTimestepGroup(timestep, time, prevTime,
+						currentTimeStep);
+
+				if (moveSurface) {
+					// Write the surface positions and the associated interstitial quantities
+					// in the concentration sub group
+					tsGroup->writeSurface2D(surfaceIndices, nInter,
+							previousIFlux);
+				}
+
+				// Write the bottom impurity information if the bottom is a free surface
+				if (writeBottom)
+					tsGroup->writeBottom2D(nHe, previousHeFlux, nD, previousDFlux,
+							nT, previousTFlux);
+
+				// Create an array for the concentration
+				double concArray[dof][2];
+
+				// Loop on the full grid
+				for (PetscInt j = 0; j < My; j++) {
+					for (PetscInt i = 0; i < Mx; i++) {
+						// Wait for all the processes
+						MPI_Barrier(comm);
+
+						// Size of the concentration that will be stored
+						int concSize = -1;
+						// To save which proc has the information
+						int concId = 0;
+						// To know which process should write
+						bool write = false;
+
+						// If it is the locally owned part of the grid
+						if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
+							write = true;
+							// Get the pointer to the beginning of the snapshot data for this grid point
+							auto gridPointSolution = buffer.data()
+									+ ((j - ys) * xm + (i - xs)) * dof;
+
+							// Loop on the concentrations
+							for (int l = 0; l < dof; l++) {
+								if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
+									// Increase concSize
+									concSize++;
+									// Fill the concArray
+									concArray[concSize][0] = (double) l;
+									concArray[concSize][1] = gridPointSolution[l];
+								}
+							}
+
+							// Increase concSize one last time
+							concSize++;
+
+							// Save the procId
+							concId = procId;
+						}
+
+						// Get which processor will send the information
+						int concProc = 0;
+						MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
+								comm);
+
+						// Broadcast the size
+						MPI_Bcast(&concSize, 1, MPI_INT, concProc, comm);
+
+						// Skip the grid point if the size is 0
+						if (concSize == 0)
+							continue;
+
+						// All processes create the dataset and fill it
+						tsGroup->writeConcentrationDataset(concSize, concArray,
+								write, i, j);
+					}
+				}
+			});
+
 	PetscFunctionReturn(0);
 }
 
@@ -284,6 +314,11 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 	// Store the concentration over the grid
 	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
 
+	// Get the weights of the totals
+	auto const& heWeights = network.getTotalAtomWeights(0);
+	auto const& dWeights = network.getTotalAtomWeights(1);
+	auto const& tWeights = network.getTotalAtomWeights(2);
+
 	// Loop on the grid
 	for (PetscInt yj = ys; yj < ys + ym; yj++) {
 		// Get the surface position
@@ -301,13 +336,13 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 
 			double hx = grid[xi + 1] - grid[xi];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
-
 			// Get the total atom concentrations at this grid point
-			heConcentration += network.getTotalAtomConcentration(0) * hx * hy;
-			dConcentration += network.getTotalAtomConcentration(1) * hx * hy;
-			tConcentration += network.getTotalAtomConcentration(2) * hx * hy;
+			heConcentration += xolotlCore::IReactionNetwork::sumWeights(
+					heWeights, gridPointSolution) * hx * hy;
+			dConcentration += xolotlCore::IReactionNetwork::sumWeights(dWeights,
+					gridPointSolution) * hx * hy;
+			tConcentration += xolotlCore::IReactionNetwork::sumWeights(tWeights,
+					gridPointSolution) * hx * hy;
 		}
 	}
 
@@ -486,13 +521,10 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration << " "
-				<< totalHeBulk << " " << totalDBulk << " " << totalTBulk
-				<< std::endl;
-		outputFile.close();
+		getTelemetry().push("retentionOut.txt",
+				{ fluence, totalHeConcentration, totalDConcentration,
+						totalTConcentration, totalHeBulk, totalDBulk,
+						totalTBulk });
 	}
 
 	// Restore the solutionArray
@@ -635,12 +667,9 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 			averagePartialRadius = minRadius;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << totalConcData[0] << " "
-				<< totalConcData[2] / totalConcData[1] << " "
-				<< averagePartialRadius << std::endl;
-		outputFile.close();
+		getTelemetry().push("retentionOut.txt",
+				{ time, totalConcData[0], totalConcData[2] / totalConcData[1],
+						averagePartialRadius });
 	}
 
 	// Restore the solutionArray
@@ -732,15 +761,17 @@ PetscErrorCode computeTRIDYN2D(TS ts, PetscInt timestep, PetscReal time,
 				// Get the pointer to the beginning of the solution data for this grid point
 				gridPointSolution = solutionArray[yj][xi];
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
-
-				// Get the total helium concentration at this grid point
-				heLocalConc += network.getTotalAtomConcentration(0);
-				dLocalConc += network.getTotalAtomConcentration(1);
-				tLocalConc += network.getTotalAtomConcentration(2);
-				vLocalConc += network.getTotalVConcentration();
-				iLocalConc += network.getTotalIConcentration();
+				// Get the total concentrations at this grid point
+				heLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+						network.getTotalAtomWeights(0), gridPointSolution);
+				dLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+						network.getTotalAtomWeights(1), gridPointSolution);
+				tLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+						network.getTotalAtomWeights(2), gridPointSolution);
+				vLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+						network.getTotalVWeights(), gridPointSolution);
+				iLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+						network.getTotalIWeights(), gridPointSolution);
 			}
 		}
 
@@ -788,7 +819,6 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 	PetscErrorCode ierr;
 	const double ***solutionArray, *gridPointSolution;
 	PetscInt xs, xm, Mx, ys, ym, My;
-	double x = 0.0, y = 0.0;
 
 	PetscFunctionBeginUser;
 
@@ -833,69 +863,45 @@ PetscErrorCode monitorSurface2D(TS ts, PetscInt timestep, PetscReal time,
 	// Choice of the cluster to be plotted
 	int iCluster = 0;
 
+	// Pack the index and the concentration of each local grid point
+	std::vector<double> localValues;
+	localValues.reserve(2 * xm * ym);
+	for (PetscInt j = ys; j < ys + ym; j++) {
+		for (PetscInt i = xs; i < xs + xm; i++) {
+			// Get the pointer to the beginning of the solution data for this grid point
+			gridPointSolution = solutionArray[j][i];
+			localValues.push_back((double) (j * Mx + i));
+			localValues.push_back(gridPointSolution[iCluster]);
+		}
+	}
+
+	// Gather them on the master process
+	auto allValues = gatherOnMaster(localValues, PETSC_COMM_WORLD);
+
 	// Create a Point vector to store the data to give to the data provider
 	// for the visualization
 	auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
-	// Create a point here so that it is not created and deleted in the loop
-	xolotlViz::Point thePoint;
+	if (procId == 0) {
+		// Put the concentrations back on the full grid
+		std::vector<double> concs(Mx * My, 0.0);
+		for (std::size_t k = 0; k < allValues.size(); k += 2) {
+			concs[(int) allValues[k]] = allValues[k + 1];
+		}
 
-	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
-				// Compute x and y
-				x = (grid[i] + grid[i + 1]) / 2.0 - grid[1];
-				y = (double) j * hy;
-
-				// If it is procId 0 just store the value in the myPoints vector
-				if (procId == 0) {
-					// Modify the Point with the gridPointSolution[iCluster] as the value
-					// and add it to myPoints
-					thePoint.value = gridPointSolution[iCluster];
-					thePoint.t = time;
-					thePoint.x = x;
-					thePoint.y = y;
-					myPoints->push_back(thePoint);
-				}
-				// Else, the values must be sent to procId 0
-				else {
-					// Send the value of the local position to the master process
-					MPI_Send(&x, 1, MPI_DOUBLE, 0, 10, PETSC_COMM_WORLD);
-					// Send the value of the local position to the master process
-					MPI_Send(&y, 1, MPI_DOUBLE, 0, 11, PETSC_COMM_WORLD);
-
-					// Send the value of the concentration to the master process
-					MPI_Send(&gridPointSolution[iCluster], 1, MPI_DOUBLE, 0, 12,
-							PETSC_COMM_WORLD);
-				}
-			}
-			// Else if it is NOT the locally owned part of the grid but still procId == 0,
-			// it should receive the values for the point and add them to myPoint
-			else if (procId == 0) {
-				// Get the position
-				MPI_Recv(&x, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 10,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-				MPI_Recv(&y, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 11,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-
-				// and the concentration
-				double conc = 0.0;
-				MPI_Recv(&conc, 1, MPI_DOUBLE, MPI_ANY_SOURCE, 12,
-						PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
-
-				// Modify the Point with the received values and add it to myPoints
-				thePoint.value = conc;
+		// Create a point here so that it is not created and deleted in the loop
+		xolotlViz::Point thePoint;
+
+		// Loop on the full grid
+		for (PetscInt j = 0; j < My; j++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Modify the Point with the concentration as the value
+				// and add it to myPoints
+				thePoint.value = concs[j * Mx + i];
 				thePoint.t = time;
-				thePoint.x = x;
-				thePoint.y = y;
+				thePoint.x = (grid[i] + grid[i + 1]) / 2.0 - grid[1];
+				thePoint.y = (double) j * hy;
 				myPoints->push_back(thePoint);
 			}
-
-			// Wait for everybody at each grid point
-			MPI_Barrier(PETSC_COMM_WORLD);
 		}
 	}
 
@@ -1002,18 +1008,15 @@ PetscErrorCode eventFunction2D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface positions
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " ";
+			std::vector<double> record = { time };
 
 			// Loop on the possible yj
 			for (yj = 0; yj < My; yj++) {
 				// Get the position of the surface at yj
 				int surfacePos = solverHandler.getSurfacePosition(yj);
-				outputFile << grid[surfacePos + 1] - grid[1] << " ";
+				record.push_back(grid[surfacePos + 1] - grid[1]);
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			getTelemetry().push("surface.txt", record);
 		}
 
 		// Get the initial vacancy concentration
@@ -1543,18 +1546,15 @@ PetscErrorCode postEventFunction2D(TS ts, PetscInt nevents,
 
 	// Write the surface positions
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " ";
+		std::vector<double> record = { time };
 
 		// Loop on the possible yj
 		for (yj = 0; yj < My; yj++) {
 			// Get the position of the surface at yj
 			int surfacePos = solverHandler.getSurfacePosition(yj);
-			outputFile << grid[surfacePos + 1] - grid[1] << " ";
+			record.push_back(grid[surfacePos + 1] - grid[1]);
 		}
-		outputFile << std::endl;
-		outputFile.close();
+		getTelemetry().push("surface.txt", record);
 	}
 
 	// Restore the solutionArray
@@ -1727,6 +1727,9 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 					hdf5OutputName2D, network);
 		}
 
+		// Create the writer for the checkpoints
+		createCheckpointWriter(hdf5OutputName2D);
+
 		// startStop2D will be called at each timestep
 		ierr = TSMonitorSet(ts, startStop2D, NULL, NULL);
 		checkPetscError(ierr,
@@ -1763,9 +1766,8 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			// Master process
 			if (procId == 0) {
 				// Clear the file where the surface will be written
-				std::ofstream outputFile;
-				outputFile.open("surface.txt");
-				outputFile.close();
+				getTelemetry().addStream("surface.txt", { "time", "surface" },
+						true);
 			}
 		}
 
@@ -1875,9 +1877,8 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			getTelemetry().addStream("retentionOut.txt",
+					{ "fluence", "He", "D", "T", "HeBulk", "DBulk", "TBulk" }, true);
 		}
 	}
 
@@ -1927,9 +1928,8 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			getTelemetry().addStream("retentionOut.txt",
+					{ "time", "Xe", "radius", "partialRadius" }, true);
 		}
 	}
 
@@ -21,6 +21,7 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
 
 namespace xolotlSolver {
 
@@ -37,6 +38,7 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
 
 //! How often HDF5 file is written
 PetscReal hdf5Stride3D = 0.0;
@@ -73,7 +75,7 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declarations
 	PetscErrorCode ierr;
-	const double ****solutionArray, *gridPointSolution;
+	const double ****solutionArray;
 	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
 
 	PetscFunctionBeginUser;
@@ -125,9 +127,6 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the vector of positions of the surface
 	std::vector<std::vector<int> > surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
@@ -140,82 +139,21 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		surfaceIndices.push_back(temp);
 	}
 
-	// Open the existing HDF5 file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName3D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions in the concentration sub group
-		tsGroup->writeSurface3D(surfaceIndices, nInterstitial3D,
-				previousIFlux3D);
-	}
-
-	// Loop on the full grid
-	for (PetscInt k = 0; k < Mz; k++) {
-		for (PetscInt j = 0; j < My; j++) {
-			for (PetscInt i = 0; i < Mx; i++) {
-				// Wait for all the processes
-				MPI_Barrier(PETSC_COMM_WORLD);
-
-				// Size of the concentration that will be stored
-				int concSize = -1;
-				// To save which proc has the information
-				int concId = 0;
-				// To know which process should write
-				bool write = false;
-
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					write = true;
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Loop on the concentrations
-					for (int l = 0; l < dof; l++) {
-						if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-							// Increase concSize
-							concSize++;
-							// Fill the concArray
-							concArray[concSize][0] = (double) l;
-							concArray[concSize][1] = gridPointSolution[l];
-						}
-					}
-
-					// Increase concSize one last time
-					concSize++;
-
-					// Save the procId
-					concId = procId;
-				}
-
-				// Get which processor will send the information
-				int concProc = 0;
-				MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-						PETSC_COMM_WORLD);
-
-				// Broadcast the size
-				MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
-
-				// Skip the grid point if the size is 0
-				if (concSize == 0)
-					continue;
-
-				// All processes create the dataset and fill it
-				tsGroup->writeConcentrationDataset(concSize, concArray, write,
-						i, j, k);
+	// Snapshot the grid points we own so that the solver can continue
+	// while the checkpoint is written
+	auto& snapshot = checkpointWriter->getBuffer();
+	snapshot.resize(xm * ym * zm * dof);
+	for (PetscInt k = 0; k < zm; k++) {
+		for (PetscInt j = 0; j < ym; j++) {
+			for (PetscInt i = 0; i < xm; i++) {
+				std::copy(solutionArray[zs + k][ys + j][xs + i],
+						solutionArray[zs + k][ys + j][xs + i] + dof,
+						snapshot.begin() + ((k * ym + j) * xm + i) * dof);
 			}
 		}
 	}
@@ -224,6 +162,99 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Copy everything the checkpoint needs, the globals change while
+	// it is written
+	double prevTime = previousTime;
+	bool moveSurface = solverHandler.moveSurface();
+	auto nInter = nInterstitial3D;
+	auto previousIFlux = previousIFlux3D;
+
+	// The collective calls of the checkpoint go through its own communicator
+	MPI_Comm comm = checkpointWriter->getComm();
+
+	// Write the checkpoint
+	checkpointWriter->submit(
+			[=](xolotlCore::XFile& checkpointFile,
+					const std::vector<double>& buffer) {
+				// Add a concentration sub group
+				auto concGroup = checkpointFile.getGroup<
+						xolotlCore::XFile::ConcentrationGroup>();
+				assert(concGroup);
+				auto tsGroup = concGroup->addTimestepGroup(timestep, time, prevTime,
+						currentTimeStep);
+
+				if (moveSurface) {
+					// Write the surface positions in the concentration sub group
+					tsGroup->writeSurface3D(surfaceIndices, nInter,
+							previousIFlux);
+				}
+
+				// Create an array for the concentration
+				double concArray[dof][2];
+
+				// Loop on the full grid
+				for (PetscInt k = 0; k < Mz; k++) {
+					for (PetscInt j = 0; j < My; j++) {
+						for (PetscInt i = 0; i < Mx; i++) {
+							// Wait for all the processes
+							MPI_Barrier(comm);
+
+							// Size of the concentration that will be stored
+							int concSize = -1;
+							// To save which proc has the information
+							int concId = 0;
+							// To know which process should write
+							bool write = false;
+
+							// If it is the locally owned part of the grid
+							if (i >= xs && i < xs + xm && j >= ys && j < ys + ym
+									&& k >= zs && k < zs + zm) {
+								write = true;
+								// Get the pointer to the beginning of the snapshot data for this grid point
+								auto gridPointSolution = buffer.data()
+										+ (((k - zs) * ym + (j - ys)) * xm
+												+ (i - xs)) * dof;
+
+								// Loop on the concentrations
+								for (int l = 0; l < dof; l++) {
+									if (std::fabs(gridPointSolution[l])
+											> 1.0e-16) {
+										// Increase concSize
+										concSize++;
+										// Fill the concArray
+										concArray[concSize][0] = (double) l;
+										concArray[concSize][1] =
+												gridPointSolution[l];
+									}
+								}
+
+								// Increase concSize one last time
+								concSize++;
+
+								// Save the procId
+								concId = procId;
+							}
+
+							// Get which processor will send the information
+							int concProc = 0;
+							MPI_Allreduce(&concId, &concProc, 1, MPI_INT,
+									MPI_SUM, comm);
+
+							// Broadcast the size
+							MPI_Bcast(&concSize, 1, MPI_INT, concProc, comm);
+
+							// Skip the grid point if the size is 0
+							if (concSize == 0)
+								continue;
+
+							// All processes create the dataset and fill it
+							tsGroup->writeConcentrationDataset(concSize,
+									concArray, write, i, j, k);
+						}
+					}
+				}
+			});
+
 	PetscFunctionReturn(0);
 }
 
@@ -278,6 +309,11 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 	// Store the concentration over the grid
 	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
 
+	// Get the weights of the totals
+	auto const& heWeights = network.getTotalAtomWeights(0);
+	auto const& dWeights = network.getTotalAtomWeights(1);
+	auto const& tWeights = network.getTotalAtomWeights(2);
+
 	// Loop on the grid
 	for (PetscInt zk = zs; zk < zs + zm; zk++) {
 		for (PetscInt yj = ys; yj < ys + ym; yj++) {
@@ -298,16 +334,13 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 
 				double hx = grid[xi + 1] - grid[xi];
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
-
 				// Get the total helium concentration at this grid point
-				heConcentration += network.getTotalAtomConcentration(0) * hx
-						* hy * hz;
-				dConcentration += network.getTotalAtomConcentration(1) * hx * hy
-						* hz;
-				tConcentration += network.getTotalAtomConcentration(2) * hx * hy
-						* hz;
+				heConcentration += xolotlCore::IReactionNetwork::sumWeights(
+						heWeights, gridPointSolution) * hx * hy * hz;
+				dConcentration += xolotlCore::IReactionNetwork::sumWeights(
+						dWeights, gridPointSolution) * hx * hy * hz;
+				tConcentration += xolotlCore::IReactionNetwork::sumWeights(
+						tWeights, gridPointSolution) * hx * hy * hz;
 			}
 		}
 	}
@@ -359,12 +392,9 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration
-				<< std::endl;
-		outputFile.close();
+		getTelemetry().push("retentionOut.txt",
+				{ fluence, totalHeConcentration, totalDConcentration,
+						totalTConcentration });
 	}
 
 	// Restore the solutionArray
@@ -510,12 +540,9 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 			averagePartialRadius = minRadius;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << totalConcData[0] << " "
-				<< totalConcData[2] / totalConcData[1] << " "
-				<< averagePartialRadius << std::endl;
-		outputFile.close();
+		getTelemetry().push("retentionOut.txt",
+				{ time, totalConcData[0], totalConcData[2] / totalConcData[1],
+						averagePartialRadius });
 	}
 
 	// Restore the solutionArray
@@ -609,15 +636,15 @@ PetscErrorCode computeTRIDYN3D(TS ts, PetscInt timestep, PetscReal time,
 					// Get the pointer to the beginning of the solution data for this grid point
 					gridPointSolution = solutionArray[zk][yj][xi];
 
-					// Update the concentration in the network
-					network.updateConcentrationsFromArray(gridPointSolution);
-
 					// Get the total helium concentration at this grid point
 					heLocalConc += gridPointSolution[0];
 					dLocalConc += gridPointSolution[1];
-					tLocalConc += network.getTotalAtomConcentration(2);
-					vLocalConc += network.getTotalVConcentration();
-					iLocalConc += network.getTotalIConcentration();
+					tLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+							network.getTotalAtomWeights(2), gridPointSolution);
+					vLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+							network.getTotalVWeights(), gridPointSolution);
+					iLocalConc += xolotlCore::IReactionNetwork::sumWeights(
+							network.getTotalIWeights(), gridPointSolution);
 				}
 			}
 		}
@@ -668,7 +695,6 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 	PetscErrorCode ierr;
 	const double ****solutionArray, *gridPointSolution;
 	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
-	double x, y;
 
 	PetscFunctionBeginUser;
 
@@ -713,47 +739,38 @@ PetscErrorCode monitorSurfaceXY3D(TS ts, PetscInt timestep, PetscReal time,
 	// Choice of the cluster to be plotted
 	int iCluster = 0;
 
+	// Integrate the local part of the grid over Z
+	std::vector<double> localConcs(My * Mx, 0.0);
+	for (PetscInt k = zs; k < zs + zm; k++) {
+		for (PetscInt j = ys; j < ys + ym; j++) {
+			for (PetscInt i = xs; i < xs + xm; i++) {
+				// Get the pointer to the beginning of the solution data for this grid point
+				gridPointSolution = solutionArray[k][j][i];
+				localConcs[j * Mx + i] += gridPointSolution[iCluster];
+			}
+		}
+	}
+
+	// Sum all the concentrations on Z with a single reduction
+	std::vector<double> totalConcs(procId == 0 ? localConcs.size() : 0);
+	MPI_Reduce(localConcs.data(), totalConcs.data(), localConcs.size(),
+			MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+
 	// Create a Point vector to store the data to give to the data provider
 	// for the visualization
 	auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
-	// Create a point here so that it is not created and deleted in the loop
-	xolotlViz::Point thePoint;
-
-	// Loop on the full grid, Y and X first because they are the axis of the plot
-	for (PetscInt j = 0; j < My; j++) {
-		// Compute y
-		y = (double) j * hy;
-
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Compute x
-			x = (grid[i] + grid[i + 1]) / 2.0 - grid[1];
-
-			// Initialize the value of the concentration to integrate over Z
-			double conc = 0.0;
-
-			for (PetscInt k = 0; k < Mz; k++) {
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Integrate over Z
-					conc += gridPointSolution[iCluster];
-				}
-			} // End of the loop on Z
-
-			// Sum all the concentration on Z
-			double totalConc = 0.0;
-			MPI_Reduce(&conc, &totalConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-					PETSC_COMM_WORLD);
+	if (procId == 0) {
+		// Create a point here so that it is not created and deleted in the loop
+		xolotlViz::Point thePoint;
 
-			// If it is procId == 0 just store the integrated value in the myPoints vector
-			if (procId == 0) {
-				thePoint.value = totalConc;
+		// Loop on the full grid, Y and X first because they are the axis of the plot
+		for (PetscInt j = 0; j < My; j++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Store the integrated value in the myPoints vector
+				thePoint.value = totalConcs[j * Mx + i];
 				thePoint.t = time;
-				thePoint.x = x;
-				thePoint.y = y;
+				thePoint.x = (grid[i] + grid[i + 1]) / 2.0 - grid[1];
+				thePoint.y = (double) j * hy;
 				myPoints->push_back(thePoint);
 			}
 		}
@@ -813,7 +830,6 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 	PetscErrorCode ierr;
 	const double ****solutionArray, *gridPointSolution;
 	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
-	double x, z;
 
 	PetscFunctionBeginUser;
 
@@ -858,47 +874,38 @@ PetscErrorCode monitorSurfaceXZ3D(TS ts, PetscInt timestep, PetscReal time,
 	// Choice of the cluster to be plotted
 	int iCluster = 0;
 
+	// Integrate the local part of the grid over Y
+	std::vector<double> localConcs(Mz * Mx, 0.0);
+	for (PetscInt k = zs; k < zs + zm; k++) {
+		for (PetscInt j = ys; j < ys + ym; j++) {
+			for (PetscInt i = xs; i < xs + xm; i++) {
+				// Get the pointer to the beginning of the solution data for this grid point
+				gridPointSolution = solutionArray[k][j][i];
+				localConcs[k * Mx + i] += gridPointSolution[iCluster];
+			}
+		}
+	}
+
+	// Sum all the concentrations on Y with a single reduction
+	std::vector<double> totalConcs(procId == 0 ? localConcs.size() : 0);
+	MPI_Reduce(localConcs.data(), totalConcs.data(), localConcs.size(),
+			MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+
 	// Create a Point vector to store the data to give to the data provider
 	// for the visualization
 	auto myPoints = std::make_shared<std::vector<xolotlViz::Point> >();
-	// Create a point here so that it is not created and deleted in the loop
-	xolotlViz::Point thePoint;
-
-	// Loop on the full grid, Z and X first because they are the axis of the plot
-	for (PetscInt k = 0; k < Mz; k++) {
-		// Compute z
-		z = (double) k * hz;
-
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Compute x
-			x = (grid[i] + grid[i + 1]) / 2.0 - grid[1];
-
-			// Initialize the value of the concentration to integrate over Y
-			double conc = 0.0;
-
-			for (PetscInt j = 0; j < My; j++) {
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Integrate over Y
-					conc += gridPointSolution[iCluster];
-				}
-			} // End of the loop on Y
-
-			// Sum all the concentration on Y
-			double totalConc = 0.0;
-			MPI_Reduce(&conc, &totalConc, 1, MPI_DOUBLE, MPI_SUM, 0,
-					PETSC_COMM_WORLD);
+	if (procId == 0) {
+		// Create a point here so that it is not created and deleted in the loop
+		xolotlViz::Point thePoint;
 
-			// If it is procId == 0 just store the integrated value in the myPoints vector
-			if (procId == 0) {
-				thePoint.value = totalConc;
+		// Loop on the full grid, Z and X first because they are the axis of the plot
+		for (PetscInt k = 0; k < Mz; k++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Store the integrated value in the myPoints vector
+				thePoint.value = totalConcs[k * Mx + i];
 				thePoint.t = time;
-				thePoint.x = x;
-				thePoint.y = z;
+				thePoint.x = (grid[i] + grid[i + 1]) / 2.0 - grid[1];
+				thePoint.y = (double) k * hz;
 				myPoints->push_back(thePoint);
 			}
 		}
@@ -1006,21 +1013,19 @@ PetscErrorCode eventFunction3D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface positions
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " ";
+			std::vector<double> record = { time };
 
 			// Loop on the possible yj
 			for (yj = 0; yj < My; yj++) {
 				for (zk = 0; zk < Mz; zk++) {
 					// Get the position of the surface at yj, zk
 					int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-					outputFile << (double) yj * hy << " " << (double) zk * hz
-							<< " " << grid[surfacePos + 1] - grid[1] << " ";
+					record.push_back((double) yj * hy);
+					record.push_back((double) zk * hz);
+					record.push_back(grid[surfacePos + 1] - grid[1]);
 				}
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			getTelemetry().push("surface.txt", record);
 		}
 
 		// Get the initial vacancy concentration
@@ -1522,21 +1527,19 @@ PetscErrorCode postEventFunction3D(TS ts, PetscInt nevents,
 
 	// Write the surface positions
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " ";
+		std::vector<double> record = { time };
 
 		// Loop on the possible yj
 		for (yj = 0; yj < My; yj++) {
 			for (zk = 0; zk < Mz; zk++) {
 				// Get the position of the surface at yj, zk
 				int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-				outputFile << (double) yj * hy << " " << (double) zk * hz << " "
-						<< grid[surfacePos + 1] - grid[1] << " ";
+				record.push_back((double) yj * hy);
+				record.push_back((double) zk * hz);
+				record.push_back(grid[surfacePos + 1] - grid[1]);
 			}
 		}
-		outputFile << std::endl;
-		outputFile.close();
+		getTelemetry().push("surface.txt", record);
 	}
 
 	// Restore the solutionArray
@@ -1719,6 +1722,9 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 					hdf5OutputName3D, network);
 		}
 
+		// Create the writer for the checkpoints
+		createCheckpointWriter(hdf5OutputName3D);
+
 		// startStop3D will be called at each timestep
 		ierr = TSMonitorSet(ts, startStop3D, NULL, NULL);
 		checkPetscError(ierr,
@@ -1759,9 +1765,8 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			// Master process
 			if (procId == 0) {
 				// Clear the file where the surface will be written
-				std::ofstream outputFile;
-				outputFile.open("surface.txt");
-				outputFile.close();
+				getTelemetry().addStream("surface.txt",
+						{ "time", "y", "z", "surface" }, true);
 			}
 		}
 
@@ -1845,9 +1850,8 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			getTelemetry().addStream("retentionOut.txt",
+					{ "fluence", "He", "D", "T" }, true);
 		}
 	}
 
@@ -1897,9 +1901,8 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			getTelemetry().addStream("retentionOut.txt",
+					{ "time", "Xe", "radius", "partialRadius" }, true);
 		}
 	}
 
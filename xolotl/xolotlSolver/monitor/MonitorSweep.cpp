@@ -0,0 +1,54 @@
+// Includes
+#include "xolotlSolver/monitor/MonitorSweep.h"
+
+namespace xolotlSolver {
+
+void MonitorSweep::add(std::shared_ptr<MonitorAccumulator> accumulator) {
+	accumulators.push_back(accumulator);
+	if (accumulator->needsNetwork())
+		updateNetwork = true;
+
+	return;
+}
+
+void MonitorSweep::start(PetscInt timestep, PetscReal time, PetscInt xs,
+		PetscInt xm, PetscInt Mx) {
+	// Ask each accumulator how many values it needs this time
+	offsets.clear();
+	int size = 0;
+	for (auto& accumulator : accumulators) {
+		offsets.push_back(size);
+		size += accumulator->start(timestep, time, xs, xm, Mx);
+	}
+	offsets.push_back(size);
+
+	localValues.assign(size, 0.0);
+
+	return;
+}
+
+void MonitorSweep::accumulate(PetscInt xi, const double* gridPointSolution) {
+	// Loop on the accumulators
+	for (std::size_t i = 0; i < accumulators.size(); i++) {
+		accumulators[i]->accumulate(xi, gridPointSolution,
+				localValues.data() + offsets[i]);
+	}
+
+	return;
+}
+
+void MonitorSweep::finish(MPI_Comm comm) {
+	// Sum everything at once
+	totalValues.resize(localValues.size());
+	MPI_Allreduce(localValues.data(), totalValues.data(), localValues.size(),
+			MPI_DOUBLE, MPI_SUM, comm);
+
+	// Loop on the accumulators
+	for (std::size_t i = 0; i < accumulators.size(); i++) {
+		accumulators[i]->finish(totalValues.data() + offsets[i]);
+	}
+
+	return;
+}
+
+} // namespace xolotlSolver
@@ -0,0 +1,157 @@
+#ifndef XSOLVER_MONITORSWEEP_H
+#define XSOLVER_MONITORSWEEP_H
+
+// Includes
+#include <mpi.h>
+#include <petscsys.h>
+#include <memory>
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * An observable computed by the monitor sweep, for instance the retention
+ * or the temperature profile. At each time step it is given every local
+ * grid point, adds their contribution to its values, and gets back the sum
+ * of these values over all the processes.
+ */
+class MonitorAccumulator {
+public:
+
+	virtual ~MonitorAccumulator() {
+	}
+
+	/**
+	 * Prepare for a new sweep. The number of values has to be the same on
+	 * every process.
+	 *
+	 * @param timestep The current time step
+	 * @param time The current time
+	 * @param xs The first local grid point
+	 * @param xm The number of local grid points
+	 * @param Mx The total number of grid points
+	 * @return The number of values to sum over the processes
+	 */
+	virtual int start(PetscInt timestep, PetscReal time, PetscInt xs,
+			PetscInt xm, PetscInt Mx) = 0;
+
+	/**
+	 * Does the network need to be updated with the concentrations of each
+	 * grid point before calling accumulate?
+	 *
+	 * @return True if it does
+	 */
+	virtual bool needsNetwork() const {
+		return false;
+	}
+
+	/**
+	 * Add the contribution of a local grid point.
+	 *
+	 * @param xi The grid point
+	 * @param gridPointSolution The solution at this grid point
+	 * @param values The local values of this accumulator
+	 */
+	virtual void accumulate(PetscInt xi, const double* gridPointSolution,
+			double* values) = 0;
+
+	/**
+	 * Use the values summed over all the processes, called on every
+	 * process.
+	 *
+	 * @param totals The summed values of this accumulator
+	 */
+	virtual void finish(const double* totals) = 0;
+};
+
+/**
+ * This class runs all the accumulators registered by the monitors in a
+ * single pass over the solution, instead of each monitor getting the
+ * solution array, looping on the grid and updating the network on its own.
+ * The values of all the accumulators are packed in a single vector summed
+ * with one MPI_Allreduce.
+ */
+class MonitorSweep {
+private:
+
+	//! The accumulators.
+	std::vector<std::shared_ptr<MonitorAccumulator> > accumulators;
+
+	//! Where the values of each accumulator start, and the total size last.
+	std::vector<int> offsets;
+
+	//! The local values of all the accumulators.
+	std::vector<double> localValues;
+
+	//! The values summed over the processes.
+	std::vector<double> totalValues;
+
+	//! Does one of the accumulators need the network?
+	bool updateNetwork;
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	MonitorSweep() :
+			updateNetwork(false) {
+	}
+
+	/**
+	 * Register an accumulator.
+	 *
+	 * @param accumulator The accumulator
+	 */
+	void add(std::shared_ptr<MonitorAccumulator> accumulator);
+
+	/**
+	 * Is there any accumulator?
+	 *
+	 * @return True if there is none
+	 */
+	bool empty() const {
+		return accumulators.empty();
+	}
+
+	/**
+	 * Does the network need to be updated at each grid point?
+	 *
+	 * @return True if one of the accumulators needs it
+	 */
+	bool needsNetwork() const {
+		return updateNetwork;
+	}
+
+	/**
+	 * Start a new sweep.
+	 *
+	 * @param timestep The current time step
+	 * @param time The current time
+	 * @param xs The first local grid point
+	 * @param xm The number of local grid points
+	 * @param Mx The total number of grid points
+	 */
+	void start(PetscInt timestep, PetscReal time, PetscInt xs, PetscInt xm,
+			PetscInt Mx);
+
+	/**
+	 * Give a local grid point to all the accumulators.
+	 *
+	 * @param xi The grid point
+	 * @param gridPointSolution The solution at this grid point
+	 */
+	void accumulate(PetscInt xi, const double* gridPointSolution);
+
+	/**
+	 * Sum the values over the processes and give them back to the
+	 * accumulators. Must be called by every process.
+	 *
+	 * @param comm The communicator
+	 */
+	void finish(MPI_Comm comm);
+};
+
+} // namespace xolotlSolver
+
+#endif // XSOLVER_MONITORSWEEP_H
@@ -0,0 +1,278 @@
+// Includes
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "xolotlSolver/monitor/TelemetrySink.h"
+
+namespace xolotlSolver {
+
+namespace {
+
+/**
+ * Append values to a one dimensional dataset of a group, creating it if
+ * needed.
+ *
+ * @param groupId The group
+ * @param name The name of the dataset
+ * @param fileType The type of the values in the file
+ * @param memType The type of the values in memory
+ * @param data The values
+ * @param count The number of values
+ * @return The size of the dataset before appending
+ */
+hsize_t appendToDataset(hid_t groupId, const std::string& name,
+		hid_t fileType, hid_t memType, const void* data, hsize_t count) {
+	// Open or create the dataset
+	hid_t datasetId;
+	if (H5Lexists(groupId, name.c_str(), H5P_DEFAULT) > 0) {
+		datasetId = H5Dopen(groupId, name.c_str(), H5P_DEFAULT);
+	} else {
+		hsize_t dims = 0, maxDims = H5S_UNLIMITED, chunkDims = 1024;
+		hid_t spaceId = H5Screate_simple(1, &dims, &maxDims);
+		hid_t propId = H5Pcreate(H5P_DATASET_CREATE);
+		H5Pset_chunk(propId, 1, &chunkDims);
+		datasetId = H5Dcreate2(groupId, name.c_str(), fileType, spaceId,
+		H5P_DEFAULT, propId, H5P_DEFAULT);
+		H5Pclose(propId);
+		H5Sclose(spaceId);
+	}
+	if (datasetId < 0)
+		throw std::string(
+				"TelemetrySink: could not open the " + name + " dataset.");
+
+	// Get its current size
+	hid_t spaceId = H5Dget_space(datasetId);
+	hsize_t size = 0;
+	H5Sget_simple_extent_dims(spaceId, &size, nullptr);
+	H5Sclose(spaceId);
+
+	// Extend it and write at the end
+	herr_t status = 0;
+	if (count > 0) {
+		hsize_t newSize = size + count;
+		status = H5Dset_extent(datasetId, &newSize);
+		hid_t fileSpaceId = H5Dget_space(datasetId);
+		H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, &size, nullptr,
+				&count, nullptr);
+		hid_t memSpaceId = H5Screate_simple(1, &count, nullptr);
+		if (status >= 0)
+			status = H5Dwrite(datasetId, memType, memSpaceId, fileSpaceId,
+			H5P_DEFAULT, data);
+		H5Sclose(memSpaceId);
+		H5Sclose(fileSpaceId);
+	}
+	H5Dclose(datasetId);
+	if (status < 0)
+		throw std::string(
+				"TelemetrySink: could not write the " + name + " dataset.");
+
+	return size;
+}
+
+} // namespace
+
+TelemetrySink::Backend TelemetrySink::getBackend(const std::string& name) {
+	if (name == "text")
+		return Backend::Text;
+	if (name == "csv")
+		return Backend::CSV;
+	if (name == "hdf5")
+		return Backend::HDF5;
+
+	throw std::string(
+			"TelemetrySink: unknown backend " + name
+					+ ", use text, csv or hdf5.");
+}
+
+TelemetrySink::TelemetrySink(Backend backendType, std::size_t bufferBytes,
+		double interval, int procId) :
+		backend(backendType), bufferSize(bufferBytes), flushInterval(
+				interval), rank(procId), bufferedBytes(0), lastFlush(
+				std::chrono::steady_clock::now()), fileId(-1) {
+}
+
+TelemetrySink::~TelemetrySink() {
+	// Write what is left
+	try {
+		flush();
+	} catch (const std::string& e) {
+		std::cerr << e << std::endl;
+	}
+
+	// Close the HDF5 file
+	if (fileId >= 0)
+		H5Fclose(fileId);
+}
+
+std::string TelemetrySink::getFileName(const std::string& name) const {
+	if (backend != Backend::CSV)
+		return name;
+
+	// Replace the extension
+	return name.substr(0, name.rfind('.')) + ".csv";
+}
+
+void TelemetrySink::openFile() {
+	if (fileId >= 0)
+		return;
+
+	std::ostringstream fileName;
+	fileName << "telemetry";
+	if (rank > 0)
+		fileName << "_" << rank;
+	fileName << ".h5";
+
+	// Append to the file of the previous run if there is one, like the
+	// text files, otherwise create it
+	if (std::ifstream(fileName.str()).good()) {
+		fileId = H5Fopen(fileName.str().c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+		if (fileId < 0)
+			throw std::string(
+					"TelemetrySink: could not open " + fileName.str() + ".");
+	} else {
+		fileId = H5Fcreate(fileName.str().c_str(), H5F_ACC_TRUNC,
+		H5P_DEFAULT, H5P_DEFAULT);
+		if (fileId < 0)
+			throw std::string(
+					"TelemetrySink: could not create " + fileName.str() + ".");
+	}
+
+	return;
+}
+
+void TelemetrySink::addStream(const std::string& name,
+		const std::vector<std::string>& columns, bool clear) {
+	auto& stream = streams[name];
+	stream.columns = columns;
+	if (!clear)
+		return;
+
+	// Forget what was buffered
+	bufferedBytes -= stream.values.size() * sizeof(double);
+	stream.values.clear();
+	stream.rowEnds.clear();
+
+	// Clear what was written
+	if (backend == Backend::HDF5) {
+		openFile();
+		if (H5Lexists(fileId, name.c_str(), H5P_DEFAULT) > 0)
+			H5Ldelete(fileId, name.c_str(), H5P_DEFAULT);
+	} else {
+		std::ofstream outputFile(getFileName(name));
+		if (backend == Backend::CSV) {
+			for (std::size_t i = 0; i < columns.size(); i++) {
+				outputFile << (i > 0 ? "," : "") << columns[i];
+			}
+			outputFile << std::endl;
+		}
+	}
+
+	return;
+}
+
+void TelemetrySink::push(const std::string& name,
+		const std::vector<double>& record) {
+	// Buffer the record
+	auto& stream = streams[name];
+	stream.values.insert(stream.values.end(), record.begin(), record.end());
+	stream.rowEnds.push_back(stream.values.size());
+	bufferedBytes += record.size() * sizeof(double);
+
+	// Write the buffers if they are too big or too old
+	if (bufferedBytes >= bufferSize
+			|| std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - lastFlush).count()
+					>= flushInterval)
+		flush();
+
+	return;
+}
+
+void TelemetrySink::flush() {
+	// Loop on the streams
+	for (auto& entry : streams) {
+		auto& stream = entry.second;
+		if (stream.rowEnds.empty())
+			continue;
+
+		if (backend == Backend::HDF5)
+			writeHDF5(entry.first, stream);
+		else
+			writeText(entry.first, stream);
+
+		stream.values.clear();
+		stream.rowEnds.clear();
+	}
+	bufferedBytes = 0;
+	lastFlush = std::chrono::steady_clock::now();
+
+	return;
+}
+
+void TelemetrySink::writeText(const std::string& name,
+		const Stream& stream) const {
+	const char* separator = (backend == Backend::CSV) ? "," : " ";
+
+	std::ofstream outputFile(getFileName(name), std::ios::app);
+	std::size_t start = 0;
+	for (auto end : stream.rowEnds) {
+		for (std::size_t i = start; i < end; i++) {
+			if (i > start)
+				outputFile << separator;
+			outputFile << stream.values[i];
+		}
+		outputFile << std::endl;
+		start = end;
+	}
+
+	return;
+}
+
+void TelemetrySink::writeHDF5(const std::string& name, const Stream& stream) {
+	openFile();
+
+	// Open or create the group of the stream
+	hid_t groupId;
+	if (H5Lexists(fileId, name.c_str(), H5P_DEFAULT) > 0) {
+		groupId = H5Gopen2(fileId, name.c_str(), H5P_DEFAULT);
+	} else {
+		groupId = H5Gcreate2(fileId, name.c_str(), H5P_DEFAULT, H5P_DEFAULT,
+		H5P_DEFAULT);
+
+		// Save the column names
+		if (groupId >= 0 && !stream.columns.empty()) {
+			std::string columns;
+			for (std::size_t i = 0; i < stream.columns.size(); i++) {
+				columns += (i > 0 ? "," : "") + stream.columns[i];
+			}
+			hid_t typeId = H5Tcopy(H5T_C_S1);
+			H5Tset_size(typeId, columns.size());
+			hid_t spaceId = H5Screate(H5S_SCALAR);
+			hid_t attrId = H5Acreate2(groupId, "columns", typeId, spaceId,
+			H5P_DEFAULT, H5P_DEFAULT);
+			H5Awrite(attrId, typeId, columns.c_str());
+			H5Aclose(attrId);
+			H5Sclose(spaceId);
+			H5Tclose(typeId);
+		}
+	}
+	if (groupId < 0)
+		throw std::string(
+				"TelemetrySink: could not open the " + name + " group.");
+
+	// Append the values, then where the records stop
+	auto base = appendToDataset(groupId, "values", H5T_IEEE_F64LE,
+	H5T_NATIVE_DOUBLE, stream.values.data(), stream.values.size());
+	std::vector<unsigned long long> rowEnds;
+	for (auto end : stream.rowEnds) {
+		rowEnds.push_back(base + end);
+	}
+	appendToDataset(groupId, "rowEnds", H5T_STD_U64LE, H5T_NATIVE_ULLONG,
+			rowEnds.data(), rowEnds.size());
+
+	H5Gclose(groupId);
+
+	return;
+}
+
+} // namespace xolotlSolver
@@ -0,0 +1,170 @@
+#ifndef XSOLVER_TELEMETRYSINK_H
+#define XSOLVER_TELEMETRYSINK_H
+
+// Includes
+#include <hdf5.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * This class collects the small records the monitors write at each time
+ * step (retention, surface position, temperature profile, ...) and writes
+ * them in batches instead of opening and closing a file for every line.
+ *
+ * Each stream has a name, the name of the text file it used to be written
+ * to, and a list of column names; the last column may repeat when the
+ * records don't all have the same length. The records are buffered in
+ * memory and written when the buffers get bigger than the given size, when
+ * the given time has passed since the last write, and when the sink is
+ * destroyed.
+ *
+ * The backends are:
+ *   - Text: the records are appended to the file named after the stream,
+ *     separated by spaces, exactly as the monitors used to write them.
+ *   - CSV: the same with commas, in a file with the .csv extension starting
+ *     with the column names.
+ *   - HDF5: each stream is a group of telemetry.h5 (telemetry_<rank>.h5 on
+ *     the other processes) with the "values" of all the records one after
+ *     the other and the "rowEnds" index where each record stops. An
+ *     existing file is appended to, like the text files.
+ *
+ * Every process has its own sink and only writes its own records.
+ */
+class TelemetrySink {
+public:
+
+	//! The ways to write the records.
+	enum class Backend {
+		Text, CSV, HDF5
+	};
+
+	/**
+	 * Get the backend from its name.
+	 *
+	 * @param name "text", "csv" or "hdf5"
+	 * @return The backend
+	 */
+	static Backend getBackend(const std::string& name);
+
+private:
+
+	//! A named stream of records.
+	struct Stream {
+		//! The names of the columns.
+		std::vector<std::string> columns;
+
+		//! The values of the buffered records.
+		std::vector<double> values;
+
+		//! Where each buffered record stops in values.
+		std::vector<std::size_t> rowEnds;
+	};
+
+	//! The backend.
+	Backend backend;
+
+	//! The size of the buffers, in bytes, that triggers a write.
+	std::size_t bufferSize;
+
+	//! The time, in seconds, after which the buffers are written.
+	double flushInterval;
+
+	//! The rank of our process.
+	int rank;
+
+	//! The streams, by name.
+	std::map<std::string, Stream> streams;
+
+	//! The size of the buffered records, in bytes.
+	std::size_t bufferedBytes;
+
+	//! When the buffers were last written.
+	std::chrono::steady_clock::time_point lastFlush;
+
+	//! The HDF5 file, opened on the first write or clear.
+	hid_t fileId;
+
+	/**
+	 * Open the HDF5 file if it is not open yet, appending to the one of a
+	 * previous run if it exists.
+	 */
+	void openFile();
+
+	/**
+	 * Get the name of the file of a stream for the text backends.
+	 *
+	 * @param name The name of the stream
+	 * @return The file name
+	 */
+	std::string getFileName(const std::string& name) const;
+
+	/**
+	 * Write the buffered records of a stream in its text file.
+	 *
+	 * @param name The name of the stream
+	 * @param stream The stream
+	 */
+	void writeText(const std::string& name, const Stream& stream) const;
+
+	/**
+	 * Append the buffered records of a stream to its HDF5 group.
+	 *
+	 * @param name The name of the stream
+	 * @param stream The stream
+	 */
+	void writeHDF5(const std::string& name, const Stream& stream);
+
+public:
+
+	TelemetrySink() = delete;
+	TelemetrySink(const TelemetrySink& other) = delete;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param backendType The backend
+	 * @param bufferBytes The size of the buffers that triggers a write
+	 * @param interval The number of seconds between two writes
+	 * @param procId The rank of our process
+	 */
+	TelemetrySink(Backend backendType, std::size_t bufferBytes,
+			double interval, int procId);
+
+	/**
+	 * The destructor writes what is left.
+	 */
+	~TelemetrySink();
+
+	/**
+	 * Declare a stream. The process in charge of the stream clears what
+	 * was written before, the other processes only append to it.
+	 *
+	 * @param name The name of the stream
+	 * @param columns The names of the columns
+	 * @param clear Whether to clear the stream
+	 */
+	void addStream(const std::string& name,
+			const std::vector<std::string>& columns, bool clear);
+
+	/**
+	 * Add a record to a stream, declaring it without clearing it if needed.
+	 * The buffers are written if they are too big or too old.
+	 *
+	 * @param name The name of the stream
+	 * @param record The values of the record
+	 */
+	void push(const std::string& name, const std::vector<double>& record);
+
+	/**
+	 * Write all the buffered records.
+	 */
+	void flush();
+};
+
+} // namespace xolotlSolver
+
+#endif // XSOLVER_TELEMETRYSINK_H
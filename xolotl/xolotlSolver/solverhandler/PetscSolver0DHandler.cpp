@@ -2,6 +2,9 @@
 #include <PetscSolver0DHandler.h>
 #include <MathUtils.h>
 #include <Constants.h>
+#include <xolotlPerf.h>
+
+namespace xperf = xolotlPerf;
 
 namespace xolotlSolver {
 
@@ -145,6 +148,11 @@ void PetscSolver0DHandler::initializeConcentration(DM &da, Vec &C) {
 		assert(tsGroup);
 		auto myConcs = tsGroup->readConcentrations(*xfile, 0, 1);
 
+		// Match the clusters of the file with ours
+		auto remap = createRestartRemap(*xfile);
+		if (not remap->isIdentity())
+			myConcs = remap->apply(myConcs, 0, 0, 1);
+
 		// Apply the concentrations we just read.
 		concOffset = concentrations[0];
 
@@ -208,6 +216,8 @@ void PetscSolver0DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	concOffset = concs[0];
 	updatedConcOffset = updatedConcs[0];
 
+	xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 	// Get the temperature from the temperature handler
 	temperatureHandler->setTemperature(concOffset);
 	double temperature = temperatureHandler->getTemperature(gridPosition,
@@ -219,6 +229,8 @@ void PetscSolver0DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		lastTemperature[0] = temperature;
 	}
 
+	phase.leave();
+
 	// Copy data into the ReactionNetwork so that it can
 	// compute the fluxes properly. The network is only used to compute the
 	// fluxes and hold the state data from the last time step. I'm reusing
@@ -227,17 +239,21 @@ void PetscSolver0DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	network.updateConcentrationsFromArray(concOffset);
 
 	// ----- Account for flux of incoming particles -----
+	phase.enter(xperf::Phase::Flux);
 	fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, 0, 0);
 
 	// ----- Compute the re-solution -----
+	phase.enter(xperf::Phase::ReSolution);
 	resolutionHandler->computeReSolution(network, concOffset, updatedConcOffset,
 			0, 0);
 
 	// ----- Compute the heterogeneous nucleation -----
+	phase.enter(xperf::Phase::Nucleation);
 	nucleationHandler->computeHeterogeneousNucleation(network, concOffset,
 			updatedConcOffset, 0, 0);
 
 	// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+	phase.enter(xperf::Phase::Reactions);
 	network.computeAllFluxes(updatedConcOffset);
 
 	/*
@@ -291,6 +307,8 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	// Set the grid position
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
 
+	xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 	// Get the temperature from the temperature handler
 	concOffset = concs[0];
 	temperatureHandler->setTemperature(concOffset);
@@ -303,6 +321,8 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		lastTemperature[0] = temperature;
 	}
 
+	phase.leave();
+
 	// Copy data into the ReactionNetwork so that it can
 	// compute the new concentrations.
 	network.updateConcentrationsFromArray(concOffset);
@@ -310,10 +330,12 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	// ----- Take care of the reactions for all the reactants -----
 
 	// Compute all the partial derivatives for the reactions
+	phase.enter(xperf::Phase::Reactions);
 	network.computeAllPartials(reactionStartingIdx, reactionIndices,
 			reactionVals);
 
 	// Update the column in the Jacobian that represents each DOF
+	phase.enter(xperf::Phase::MatrixAssembly);
 	for (int i = 0; i < dof - 1; i++) {
 		// Set grid coordinate and component number for the row
 		rowId.i = 0;
@@ -349,9 +371,12 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	MatStencil rowIds[5];
 
 	// Compute the partial derivative from re-solution at this grid point
+	phase.enter(xperf::Phase::ReSolution);
 	int nResoluting = resolutionHandler->computePartialsForReSolution(network,
 			resolutionVals, resolutionIndices, 0, 0);
 
+	phase.enter(xperf::Phase::MatrixAssembly);
+
 	// Loop on the number of xenon to set the values in the Jacobian
 	for (int i = 0; i < nResoluting; i++) {
 		// Set grid coordinate and component number for the row and column
@@ -383,9 +408,12 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	PetscInt nucleationIndices[2];
 
 	// Compute the partial derivative from nucleation at this grid point
+	phase.enter(xperf::Phase::Nucleation);
 	if (nucleationHandler->computePartialsForHeterogeneousNucleation(network,
 			nucleationVals, nucleationIndices, 0, 0)) {
 
+		phase.enter(xperf::Phase::MatrixAssembly);
+
 		// Set grid coordinate and component number for the row and column
 		// corresponding to the clusters involved in re-solution
 		rowIds[0].i = 0;
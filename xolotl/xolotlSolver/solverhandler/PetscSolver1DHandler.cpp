@@ -2,8 +2,10 @@
 #include <PetscSolver1DHandler.h>
 #include <MathUtils.h>
 #include <Constants.h>
+#include <xolotlPerf.h>
 
 namespace xcore = xolotlCore;
+namespace xperf = xolotlPerf;
 
 namespace xolotlSolver {
 
@@ -34,7 +36,10 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 		if (concGroup and concGroup->hasTimesteps()) {
 			auto tsGroup = concGroup->getLastTimestepGroup();
 			assert(tsGroup);
-			surfacePosition = tsGroup->readSurface1D();
+			// The file may have been written with another grid
+			auto remap = createRestartRemap(xfile);
+			surfacePosition = remap->getClosestPoint(
+					tsGroup->readSurface1D());
 		}
 	}
 
@@ -112,9 +117,9 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 	network.getDiagonalFill(dfill);
 
 	// Load up the block fills
-	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
-	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
-	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
+	ofillSparse = ConvertToPetscSparseFillMap(dof, ofill);
+	dfillSparse = ConvertToPetscSparseFillMap(dof, dfill);
+	ierr = DMDASetBlockFillsSparse(da, dfillSparse.data(), ofillSparse.data());
 	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
 			"DMDASetBlockFills failed.");
 
@@ -221,7 +226,18 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 		assert(concGroup);
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
-		auto myConcs = tsGroup->readConcentrations(*xfile, xs, xm);
+		xolotlCore::XFile::TimestepGroup::Concs1DType myConcs;
+		auto remap = createRestartRemap(*xfile);
+		if (remap->isIdentity()) {
+			myConcs = tsGroup->readConcentrations(*xfile, xs, xm);
+		} else {
+			// Read the grid points of the file covering ours and move
+			// them onto our grid and network
+			auto source = remap->getSourceRange(xs, xm);
+			auto fileConcs = tsGroup->readConcentrations(*xfile, source.first,
+					source.second);
+			myConcs = remap->apply(fileConcs, source.first, xs, xm);
+		}
 
 		// Apply the concentrations we just read.
 		for (auto i = 0; i < xm; ++i) {
@@ -288,42 +304,6 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
-	// Computing the trapped atom concentration is only needed for the attenuation
-	if (useAttenuation) {
-		// Compute the total concentration of atoms contained in bubbles
-		double atomConc = 0.0;
-
-		// Loop over grid points to get the atom concentration
-		// near the surface
-		for (int xi = xs; xi < xs + xm; xi++) {
-			// Boundary conditions
-			if (xi < surfacePosition + leftOffset || xi > nX - 1 - rightOffset)
-				continue;
-
-			// We are only interested in the helium near the surface
-			if ((grid[xi] + grid[xi + 1]) / 2.0 - grid[surfacePosition + 1]
-					> 2.0)
-				continue;
-
-			// Get the concentrations at this grid point
-			concOffset = concs[xi];
-			// Copy data into the PSIClusterReactionNetwork
-			network.updateConcentrationsFromArray(concOffset);
-
-			// Sum the total atom concentration
-			atomConc += network.getTotalTrappedAtomConcentration()
-					* (grid[xi + 1] - grid[xi]);
-		}
-
-		// Share the concentration with all the processes
-		double totalAtomConc = 0.0;
-		MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-		MPI_COMM_WORLD);
-
-		// Set the disappearing rate in the modified TM handler
-		mutationHandler->updateDisappearingRate(totalAtomConc);
-	}
-
 	// Declarations for variables used in the loop
 	double **concVector = new double*[3];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
@@ -354,6 +334,7 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 		// Heat condition
 		if (xi == surfacePosition) {
+			xperf::ScopedPhase phase(xperf::Phase::HeatEquation);
 			temperatureHandler->computeTemperature(concVector,
 					updatedConcOffset, hxLeft, hxRight, xi);
 		}
@@ -374,6 +355,8 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		if (skip)
 			continue;
 
+		xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 		// Update the network if the temperature changed
 		// left
 		double temperature = concs[xi - 1][dof - 1];
@@ -405,6 +388,8 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			lastTemperature[xi + 1 - xs] = temperature;
 		}
 
+		phase.leave();
+
 		// Copy data into the ReactionNetwork so that it can
 		// compute the fluxes properly. The network is only used to compute the
 		// fluxes and hold the state data from the last time step. I'm reusing
@@ -413,18 +398,22 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		network.updateConcentrationsFromArray(concOffset);
 
 		// ----- Account for flux of incoming particles -----
+		phase.enter(xperf::Phase::Flux);
 		fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 				surfacePosition);
 
 		// ---- Compute the temperature over the locally owned part of the grid -----
+		phase.enter(xperf::Phase::HeatEquation);
 		temperatureHandler->computeTemperature(concVector, updatedConcOffset,
 				hxLeft, hxRight, xi);
 
 		// ---- Compute diffusion over the locally owned part of the grid -----
+		phase.enter(xperf::Phase::Diffusion);
 		diffusionHandler->computeDiffusion(network, concVector,
 				updatedConcOffset, hxLeft, hxRight, xi - xs);
 
 		// ---- Compute advection over the locally owned part of the grid -----
+		phase.enter(xperf::Phase::Advection);
 		// Set the grid position
 		gridPosition[0] = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 		for (int i = 0; i < advectionHandlers.size(); i++) {
@@ -433,14 +422,17 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		}
 
 		// ----- Compute the modified trap-mutation over the locally owned part of the grid -----
+		phase.enter(xperf::Phase::TrapMutation);
 		mutationHandler->computeTrapMutation(network, concOffset,
 				updatedConcOffset, xi - xs);
 
 		// ----- Compute the re-solution over the locally owned part of the grid -----
+		phase.enter(xperf::Phase::ReSolution);
 		resolutionHandler->computeReSolution(network, concOffset,
 				updatedConcOffset, xi, xs);
 
 		// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+		phase.enter(xperf::Phase::Reactions);
 		network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
 	}
 
@@ -531,10 +523,14 @@ void PetscSolver1DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 
 		// Heat condition
 		if (xi == surfacePosition) {
+			xperf::ScopedPhase phase(xperf::Phase::HeatEquation);
+
 			// Get the partial derivatives for the temperature
 			temperatureHandler->computePartialsForTemperature(tempVals,
 					tempIndices, hxLeft, hxRight, xi);
 
+			phase.enter(xperf::Phase::MatrixAssembly);
+
 			// Set grid coordinate and component number for the row
 			row.i = xi;
 			row.c = tempIndices[0];
@@ -570,6 +566,8 @@ void PetscSolver1DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 		if (skip)
 			continue;
 
+		xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 		// Update the network if the temperature changed
 		// left
 		double temperature = concs[xi - 1][dof - 1];
@@ -600,9 +598,12 @@ void PetscSolver1DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 		}
 
 		// Get the partial derivatives for the temperature
+		phase.enter(xperf::Phase::HeatEquation);
 		temperatureHandler->computePartialsForTemperature(tempVals, tempIndices,
 				hxLeft, hxRight, xi);
 
+		phase.enter(xperf::Phase::MatrixAssembly);
+
 		// Set grid coordinate and component number for the row
 		row.i = xi;
 		row.c = tempIndices[0];
@@ -622,9 +623,12 @@ void PetscSolver1DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 						"MatSetValuesStencil (temperature) failed.");
 
 		// Get the partial derivatives for the diffusion
+		phase.enter(xperf::Phase::Diffusion);
 		diffusionHandler->computePartialsForDiffusion(network, diffVals,
 				diffIndices, hxLeft, hxRight, xi - xs);
 
+		phase.enter(xperf::Phase::MatrixAssembly);
+
 		// Loop on the number of diffusion cluster to set the values in the Jacobian
 		for (int i = 0; i < nDiff; i++) {
 			// Set grid coordinate and component number for the row
@@ -651,6 +655,7 @@ void PetscSolver1DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 		// Set the grid position
 		gridPosition[0] = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 		for (int l = 0; l < advectionHandlers.size(); l++) {
+			phase.enter(xperf::Phase::Advection);
 			advectionHandlers[l]->computePartialsForAdvection(network,
 					advecVals, advecIndices, gridPosition, hxLeft, hxRight,
 					xi - xs);
@@ -662,6 +667,8 @@ void PetscSolver1DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 			// Get the number of advecting clusters
 			nAdvec = advectionHandlers[l]->getNumberOfAdvecting();
 
+			phase.enter(xperf::Phase::MatrixAssembly);
+
 			// Loop on the number of advecting cluster to set the values in the Jacobian
 			for (int i = 0; i < nAdvec; i++) {
 				// Set grid coordinate and component number for the row
@@ -730,42 +737,6 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
-	// Computing the trapped atom concentration is only needed for the attenuation
-	if (useAttenuation) {
-		// Compute the total concentration of atoms contained in bubbles
-		double atomConc = 0.0;
-
-		// Loop over grid points to get the atom concentration
-		// near the surface
-		for (int xi = xs; xi < xs + xm; xi++) {
-			// Boundary conditions
-			if (xi < surfacePosition + leftOffset || xi > nX - 1 - rightOffset)
-				continue;
-
-			// We are only interested in the helium near the surface
-			if ((grid[xi] + grid[xi + 1]) / 2.0 - grid[surfacePosition + 1]
-					> 2.0)
-				continue;
-
-			// Get the concentrations at this grid point
-			concOffset = concs[xi];
-			// Copy data into the PSIClusterReactionNetwork
-			network.updateConcentrationsFromArray(concOffset);
-
-			// Sum the total atom concentration
-			atomConc += network.getTotalTrappedAtomConcentration()
-					* (grid[xi + 1] - grid[xi]);
-		}
-
-		// Share the concentration with all the processes
-		double totalAtomConc = 0.0;
-		MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-		MPI_COMM_WORLD);
-
-		// Set the disappearing rate in the modified TM handler
-		mutationHandler->updateDisappearingRate(totalAtomConc);
-	}
-
 	// Arguments for MatSetValuesStencil called below
 	MatStencil rowId;
 	MatStencil colIds[dof];
@@ -796,6 +767,8 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				- grid[surfacePosition + 1])
 				/ (grid[grid.size() - 1] - grid[surfacePosition + 1]);
 
+		xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 		// Get the temperature from the temperature handler
 		concOffset = concs[xi];
 		temperatureHandler->setTemperature(concOffset);
@@ -811,6 +784,8 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			lastTemperature[xi + 1 - xs] = temperature;
 		}
 
+		phase.leave();
+
 		// Copy data into the ReactionNetwork so that it can
 		// compute the new concentrations.
 		network.updateConcentrationsFromArray(concOffset);
@@ -818,10 +793,12 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		// ----- Take care of the reactions for all the reactants -----
 
 		// Compute all the partial derivatives for the reactions
+		phase.enter(xperf::Phase::Reactions);
 		network.computeAllPartials(reactionStartingIdx, reactionIndices,
 				reactionVals, xi + 1 - xs);
 
 		// Update the column in the Jacobian that represents each DOF
+		phase.enter(xperf::Phase::MatrixAssembly);
 		for (int i = 0; i < dof - 1; i++) {
 			// Set grid coordinate and component number for the row
 			rowId.i = xi;
@@ -859,9 +836,12 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		PetscInt mutationIndices[3 * nHelium];
 
 		// Compute the partial derivative from modified trap-mutation at this grid point
+		phase.enter(xperf::Phase::TrapMutation);
 		int nMutating = mutationHandler->computePartialsForTrapMutation(network,
 				mutationVals, mutationIndices, xi - xs);
 
+		phase.enter(xperf::Phase::MatrixAssembly);
+
 		// Loop on the number of helium undergoing trap-mutation to set the values
 		// in the Jacobian
 		for (int i = 0; i < nMutating; i++) {
@@ -910,9 +890,12 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		MatStencil rowIds[5];
 
 		// Compute the partial derivative from re-solution at this grid point
+		phase.enter(xperf::Phase::ReSolution);
 		int nResoluting = resolutionHandler->computePartialsForReSolution(
 				network, resolutionVals, resolutionIndices, xi, xs);
 
+		phase.enter(xperf::Phase::MatrixAssembly);
+
 		// Loop on the number of xenon to set the values in the Jacobian
 		for (int i = 0; i < nResoluting; i++) {
 			// Set grid coordinate and component number for the row and column
@@ -949,4 +932,173 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	return;
 }
 
+void PetscSolver1DHandler::computeDisappearingRates(DM &da, Vec &C) {
+	PetscErrorCode ierr;
+
+	// Get the concentrations
+	PetscScalar **concs = nullptr;
+	ierr = DMDAVecGetArrayDOFRead(da, C, &concs);
+	checkPetscError(ierr, "PetscSolver1DHandler::computeDisappearingRates: "
+			"DMDAVecGetArrayDOFRead failed.");
+
+	// Get local grid boundaries
+	PetscInt xs, xm;
+	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
+	checkPetscError(ierr, "PetscSolver1DHandler::computeDisappearingRates: "
+			"DMDAGetCorners failed.");
+
+	// Compute the total concentration of atoms contained in bubbles
+	double atomConc = 0.0;
+	auto const& trappedWeights = network.getTotalTrappedAtomWeights();
+
+	// Loop over grid points to get the atom concentration
+	// near the surface
+	for (int xi = xs; xi < xs + xm; xi++) {
+		// Boundary conditions
+		if (xi < surfacePosition + leftOffset || xi > nX - 1 - rightOffset)
+			continue;
+
+		// We are only interested in the helium near the surface
+		if ((grid[xi] + grid[xi + 1]) / 2.0 - grid[surfacePosition + 1] > 2.0)
+			continue;
+
+		// Sum the total atom concentration
+		atomConc += xolotlCore::IReactionNetwork::sumWeights(trappedWeights,
+				concs[xi]) * (grid[xi + 1] - grid[xi]);
+	}
+
+	// Restore the array
+	ierr = DMDAVecRestoreArrayDOFRead(da, C, &concs);
+	checkPetscError(ierr, "PetscSolver1DHandler::computeDisappearingRates: "
+			"DMDAVecRestoreArrayDOFRead failed.");
+
+	// Share the concentration with all the processes
+	double totalAtomConc = 0.0;
+	MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
+	MPI_COMM_WORLD);
+
+	// Set the disappearing rate in the modified TM handler
+	mutationHandler->updateDisappearingRate(totalAtomConc);
+
+	return;
+}
+
+std::vector<PetscInt> PetscSolver1DHandler::computeOwnershipRanges(
+		int nProcs) const {
+	// The active part of the grid is between the surface and the right boundary
+	int firstActive = surfacePosition + leftOffset;
+	int lastActive = nX - rightOffset;
+	int nActive = lastActive - firstActive;
+
+	std::vector<PetscInt> lx(nProcs, 0);
+
+	// Each process needs at least one grid point, fall back on an even
+	// distribution of the whole grid if there are not enough active ones
+	if (nActive < nProcs) {
+		for (int i = 0; i < nProcs; i++) {
+			lx[i] = nX / nProcs + ((nX % nProcs) > i);
+		}
+
+		return lx;
+	}
+
+	// Share the active grid points, the inactive ones on the left go to the
+	// first process and the ones on the right to the last process
+	for (int i = 0; i < nProcs; i++) {
+		lx[i] = nActive / nProcs + ((nActive % nProcs) > i);
+	}
+	lx[0] += firstActive;
+	lx[nProcs - 1] += nX - lastActive;
+
+	return lx;
+}
+
+void PetscSolver1DHandler::repartitionSolverContext(DM &da, Vec &C) {
+	PetscErrorCode ierr;
+
+	// Degrees of freedom is the total number of clusters in the network
+	const int dof = network.getDOF();
+
+	// Get the current local boundaries
+	PetscInt xs, xm;
+	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMDAGetCorners (da) failed.");
+
+	// Compute the new ownership ranges
+	int nProcs;
+	MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+	auto lx = computeOwnershipRanges(nProcs);
+
+	// Create the new distributed array
+	DM newDA;
+	ierr = DMDACreate1d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR, nX, dof, 1,
+			lx.data(), &newDA);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMDACreate1d failed.");
+	ierr = DMSetFromOptions(newDA);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMSetFromOptions failed.");
+	ierr = DMSetUp(newDA);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMSetUp failed.");
+	ierr = DMDASetBlockFillsSparse(newDA, dfillSparse.data(),
+			ofillSparse.data());
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMDASetBlockFills failed.");
+
+	// Migrate the solution, in 1D the global ordering of both arrays is the
+	// natural ordering so the scatter is the identity
+	Vec newC;
+	ierr = DMCreateGlobalVector(newDA, &newC);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMCreateGlobalVector failed.");
+	VecScatter scatter;
+	ierr = VecScatterCreate(C, NULL, newC, NULL, &scatter);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"VecScatterCreate failed.");
+	ierr = VecScatterBegin(scatter, C, newC, INSERT_VALUES, SCATTER_FORWARD);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"VecScatterBegin failed.");
+	ierr = VecScatterEnd(scatter, C, newC, INSERT_VALUES, SCATTER_FORWARD);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"VecScatterEnd failed.");
+	ierr = VecScatterDestroy(&scatter);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"VecScatterDestroy failed.");
+
+	// Replace the old objects
+	ierr = VecDestroy(&C);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"VecDestroy failed.");
+	ierr = DMDestroy(&da);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMDestroy failed.");
+	da = newDA;
+	C = newC;
+
+	// Get the new local boundaries
+	PetscInt newXs, newXm;
+	ierr = DMDAGetCorners(da, &newXs, NULL, NULL, &newXm, NULL, NULL);
+	checkPetscError(ierr, "PetscSolver1DHandler::repartitionSolverContext: "
+			"DMDAGetCorners (newDA) failed.");
+
+	// Resize the per grid point rates in the network, resetting the last
+	// temperature forces them to be recomputed at the next evaluation
+	network.addGridPoints(newXm - xm);
+	lastTemperature.assign(newXm + 2, 0.0);
+
+	// Rebuild the local grids of the diffusion and advection
+	diffusionHandler->initializeDiffusionGrid(advectionHandlers, grid, newXm,
+			newXs);
+	advectionHandlers[0]->initializeAdvectionGrid(advectionHandlers, grid,
+			newXm, newXs);
+
+	// Rebuild the modified trap-mutation indices
+	mutationHandler->initializeIndex1D(surfacePosition, network,
+			advectionHandlers, grid, newXm, newXs);
+
+	return;
+}
+
 } /* end namespace xolotlSolver */
@@ -67,6 +67,30 @@ public:
 	 */
 	void computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J, PetscReal ftime);
 
+	/**
+	 * Compute the concentration of trapped atoms near the surface for the
+	 * attenuation of the trap-mutation.
+	 * \see PetscSolverHandler.h
+	 */
+	void computeDisappearingRates(DM &da, Vec &C) override;
+
+	/**
+	 * Create a new distributed array balanced on the active grid points
+	 * and migrate the solution to it.
+	 * \see ISolverHandler.h
+	 */
+	void repartitionSolverContext(DM &da, Vec &C) override;
+
+	/**
+	 * Compute the number of grid points each process should own so that
+	 * the active grid points, between the surface and the right boundary,
+	 * are evenly shared.
+	 *
+	 * @param nProcs The number of processes
+	 * @return The ownership ranges in the format that DMDACreate1d() expects
+	 */
+	std::vector<PetscInt> computeOwnershipRanges(int nProcs) const;
+
 	/**
 	 * Get the position of the surface.
 	 * \see ISolverHandler.h
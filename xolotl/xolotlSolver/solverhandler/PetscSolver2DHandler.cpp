@@ -2,6 +2,9 @@
 #include <PetscSolver2DHandler.h>
 #include <MathUtils.h>
 #include <Constants.h>
+#include <xolotlPerf.h>
+
+namespace xperf = xolotlPerf;
 
 namespace xolotlSolver {
 
@@ -306,7 +309,6 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	double **concVector = new double*[5];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
 	std::vector<double> incidentFluxVector;
-	double atomConc = 0.0, totalAtomConc = 0.0;
 
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
@@ -314,41 +316,6 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	// Loop over grid points
 	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
-		// Computing the trapped atom concentration is only needed for the attenuation
-		if (useAttenuation) {
-			// Compute the total concentration of atoms contained in bubbles
-			atomConc = 0.0;
-
-			// Loop over grid points
-			for (int xi = surfacePosition[yj] + leftOffset;
-					xi < nX - rightOffset; xi++) {
-				// We are only interested in the helium near the surface
-				if ((grid[xi] + grid[xi + 1]) / 2.0
-						- grid[surfacePosition[yj] + 1] > 2.0)
-					continue;
-
-				// Check if we are on the right processor
-				if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym) {
-					// Get the concentrations at this grid point
-					concOffset = concs[yj][xi];
-					// Copy data into the PSIClusterReactionNetwork
-					network.updateConcentrationsFromArray(concOffset);
-
-					// Sum the total atom concentration
-					atomConc += network.getTotalTrappedAtomConcentration()
-							* (grid[xi + 1] - grid[xi]);
-				}
-			}
-
-			// Share the concentration with all the processes
-			totalAtomConc = 0.0;
-			MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-			MPI_COMM_WORLD);
-
-			// Set the disappearing rate in the modified TM handler
-			mutationHandler->updateDisappearingRate(totalAtomConc);
-		}
-
 		// Skip if we are not on the right process
 		if (yj < ys || yj >= ys + ym)
 			continue;
@@ -390,6 +357,7 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 			// Heat condition
 			if (xi == surfacePosition[yj]) {
+				xperf::ScopedPhase phase(xperf::Phase::HeatEquation);
 				temperatureHandler->computeTemperature(concVector,
 						updatedConcOffset, hxLeft, hxRight, xi, sy, yj);
 			}
@@ -412,6 +380,8 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			if (skip)
 				continue;
 
+			xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 			// Update the network if the temperature changed
 			// left
 			double temperature = concs[yj][xi - 1][dof - 1];
@@ -444,6 +414,8 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				lastTemperature[xi + 1 - xs] = temperature;
 			}
 
+			phase.leave();
+
 			// Copy data into the ReactionNetwork so that it can
 			// compute the fluxes properly. The network is only used to compute the
 			// fluxes and hold the state data from the last time step. I'm reusing
@@ -452,18 +424,22 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			network.updateConcentrationsFromArray(concOffset);
 
 			// ----- Account for flux of incoming particles -----
+			phase.enter(xperf::Phase::Flux);
 			fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 					surfacePosition[yj]);
 
 			// ---- Compute the temperature over the locally owned part of the grid -----
+			phase.enter(xperf::Phase::HeatEquation);
 			temperatureHandler->computeTemperature(concVector,
 					updatedConcOffset, hxLeft, hxRight, xi, sy, yj);
 
 			// ---- Compute diffusion over the locally owned part of the grid -----
+			phase.enter(xperf::Phase::Diffusion);
 			diffusionHandler->computeDiffusion(network, concVector,
 					updatedConcOffset, hxLeft, hxRight, xi - xs, sy, yj - ys);
 
 			// ---- Compute advection over the locally owned part of the grid -----
+			phase.enter(xperf::Phase::Advection);
 			// Set the grid position
 			gridPosition[0] = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 			for (int i = 0; i < advectionHandlers.size(); i++) {
@@ -473,14 +449,17 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			}
 
 			// ----- Compute the modified trap-mutation over the locally owned part of the grid -----
+			phase.enter(xperf::Phase::TrapMutation);
 			mutationHandler->computeTrapMutation(network, concOffset,
 					updatedConcOffset, xi - xs, yj - ys);
 
 			// ----- Compute the re-solution over the locally owned part of the grid -----
+			phase.enter(xperf::Phase::ReSolution);
 			resolutionHandler->computeReSolution(network, concOffset,
 					updatedConcOffset, xi, xs, yj);
 
 			// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+			phase.enter(xperf::Phase::Reactions);
 			network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
 		}
 	}
@@ -585,10 +564,14 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 
 			// Heat condition
 			if (xi == surfacePosition[yj]) {
+				xperf::ScopedPhase phase(xperf::Phase::HeatEquation);
+
 				// Get the partial derivatives for the temperature
 				temperatureHandler->computePartialsForTemperature(tempVals,
 						tempIndices, hxLeft, hxRight, xi, sy, yj);
 
+				phase.enter(xperf::Phase::MatrixAssembly);
+
 				// Set grid coordinate and component number for the row
 				row.i = xi;
 				row.j = yj;
@@ -636,6 +619,8 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 			if (skip)
 				continue;
 
+			xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 			// Update the network if the temperature changed
 			// left
 			double temperature = concs[yj][xi - 1][dof - 1];
@@ -667,9 +652,12 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 			}
 
 			// Get the partial derivatives for the temperature
+			phase.enter(xperf::Phase::HeatEquation);
 			temperatureHandler->computePartialsForTemperature(tempVals,
 					tempIndices, hxLeft, hxRight, xi, sy, yj);
 
+			phase.enter(xperf::Phase::MatrixAssembly);
+
 			// Set grid coordinate and component number for the row
 			row.i = xi;
 			row.j = yj;
@@ -700,9 +688,12 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 							"MatSetValuesStencil (temperature) failed.");
 
 			// Get the partial derivatives for the diffusion
+			phase.enter(xperf::Phase::Diffusion);
 			diffusionHandler->computePartialsForDiffusion(network, diffVals,
 					diffIndices, hxLeft, hxRight, xi - xs, sy, yj - ys);
 
+			phase.enter(xperf::Phase::MatrixAssembly);
+
 			// Loop on the number of diffusion cluster to set the values in the Jacobian
 			for (int i = 0; i < nDiff; i++) {
 				// Set grid coordinate and component number for the row
@@ -739,6 +730,7 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 			// Set the grid position
 			gridPosition[0] = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 			for (int l = 0; l < advectionHandlers.size(); l++) {
+				phase.enter(xperf::Phase::Advection);
 				advectionHandlers[l]->computePartialsForAdvection(network,
 						advecVals, advecIndices, gridPosition, hxLeft, hxRight,
 						xi - xs, hY, yj - ys);
@@ -751,6 +743,8 @@ void PetscSolver2DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 				// Get the number of advecting clusters
 				nAdvec = advectionHandlers[l]->getNumberOfAdvecting();
 
+				phase.enter(xperf::Phase::MatrixAssembly);
+
 				// Loop on the number of advecting cluster to set the values in the Jacobian
 				for (int i = 0; i < nAdvec; i++) {
 					// Set grid coordinate and component number for the row
@@ -831,47 +825,11 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	int pdColIdsVectorSize = 0;
 
 	// Declarations for variables used in the loop
-	double atomConc = 0.0, totalAtomConc = 0.0;
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
 
 	// Loop over the grid points
 	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
-		// Computing the trapped atom concentration is only needed for the attenuation
-		if (useAttenuation) {
-			// Compute the total concentration of atoms contained in bubbles
-			atomConc = 0.0;
-
-			// Loop over grid points
-			for (int xi = surfacePosition[yj] + leftOffset;
-					xi < nX - rightOffset; xi++) {
-				// We are only interested in the helium near the surface
-				if ((grid[xi] + grid[xi + 1]) / 2.0
-						- grid[surfacePosition[yj] + 1] > 2.0)
-					continue;
-
-				// Check if we are on the right processor
-				if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym) {
-					// Get the concentrations at this grid point
-					concOffset = concs[yj][xi];
-					// Copy data into the PSIClusterReactionNetwork
-					network.updateConcentrationsFromArray(concOffset);
-
-					// Sum the total atom concentration
-					atomConc += network.getTotalTrappedAtomConcentration()
-							* (grid[xi + 1] - grid[xi]);
-				}
-			}
-
-			// Share the concentration with all the processes
-			totalAtomConc = 0.0;
-			MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-			MPI_COMM_WORLD);
-
-			// Set the disappearing rate in the modified TM handler
-			mutationHandler->updateDisappearingRate(totalAtomConc);
-		}
-
 		// Skip if we are not on the right process
 		if (yj < ys || yj >= ys + ym)
 			continue;
@@ -902,6 +860,8 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 					- grid[surfacePosition[yj] + 1])
 					/ (grid[grid.size() - 1] - grid[surfacePosition[yj] + 1]);
 
+			xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 			// Get the temperature from the temperature handler
 			concOffset = concs[yj][xi];
 			temperatureHandler->setTemperature(concOffset);
@@ -917,6 +877,8 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				lastTemperature[xi + 1 - xs] = temperature;
 			}
 
+			phase.leave();
+
 			// Copy data into the ReactionNetwork so that it can
 			// compute the new concentrations.
 			network.updateConcentrationsFromArray(concOffset);
@@ -924,10 +886,12 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			// ----- Take care of the reactions for all the reactants -----
 
 			// Compute all the partial derivatives for the reactions
+			phase.enter(xperf::Phase::Reactions);
 			network.computeAllPartials(reactionStartingIdx, reactionIndices,
 					reactionVals, xi + 1 - xs);
 
 			// Update the column in the Jacobian that represents each DOF
+			phase.enter(xperf::Phase::MatrixAssembly);
 			for (int i = 0; i < dof - 1; i++) {
 				// Set grid coordinate and component number for the row
 				rowId.i = xi;
@@ -968,9 +932,12 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			PetscInt mutationIndices[3 * nHelium];
 
 			// Compute the partial derivative from modified trap-mutation at this grid point
+			phase.enter(xperf::Phase::TrapMutation);
 			int nMutating = mutationHandler->computePartialsForTrapMutation(
 					network, mutationVals, mutationIndices, xi - xs, yj - ys);
 
+			phase.enter(xperf::Phase::MatrixAssembly);
+
 			// Loop on the number of helium undergoing trap-mutation to set the values
 			// in the Jacobian
 			for (int i = 0; i < nMutating; i++) {
@@ -1021,9 +988,12 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			MatStencil rowIds[5];
 
 			// Compute the partial derivative from re-solution at this grid point
+			phase.enter(xperf::Phase::ReSolution);
 			int nResoluting = resolutionHandler->computePartialsForReSolution(
 					network, resolutionVals, resolutionIndices, xi, xs, yj);
 
+			phase.enter(xperf::Phase::MatrixAssembly);
+
 			// Loop on the number of xenon to set the values in the Jacobian
 			for (int i = 0; i < nResoluting; i++) {
 				// Set grid coordinate and component number for the row and column
@@ -1068,4 +1038,69 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	return;
 }
 
+void PetscSolver2DHandler::computeDisappearingRates(DM &da, Vec &C) {
+	PetscErrorCode ierr;
+
+	// Get the concentrations
+	PetscScalar ***concs = nullptr;
+	ierr = DMDAVecGetArrayDOFRead(da, C, &concs);
+	checkPetscError(ierr, "PetscSolver2DHandler::computeDisappearingRates: "
+			"DMDAVecGetArrayDOFRead failed.");
+
+	// Get local grid boundaries
+	PetscInt xs, xm, ys, ym;
+	ierr = DMDAGetCorners(da, &xs, &ys, NULL, &xm, &ym, NULL);
+	checkPetscError(ierr, "PetscSolver2DHandler::computeDisappearingRates: "
+			"DMDAGetCorners failed.");
+
+	// The concentration of atoms contained in bubbles for each column,
+	// all the columns are summed at once
+	std::vector<double> atomConc(nY, 0.0), totalAtomConc(nY, 0.0);
+	auto const& trappedWeights = network.getTotalTrappedAtomWeights();
+
+	// Loop over the columns
+	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+		// Skip if we are not on the right process
+		if (yj < ys || yj >= ys + ym)
+			continue;
+
+		// Loop over grid points
+		for (int xi = surfacePosition[yj] + leftOffset; xi < nX - rightOffset;
+				xi++) {
+			// Skip if we are not on the right process
+			if (xi < xs || xi >= xs + xm)
+				continue;
+
+			// We are only interested in the helium near the surface
+			if ((grid[xi] + grid[xi + 1]) / 2.0
+					- grid[surfacePosition[yj] + 1] > 2.0)
+				continue;
+
+			// Sum the total atom concentration
+			atomConc[yj] += xolotlCore::IReactionNetwork::sumWeights(
+					trappedWeights, concs[yj][xi]) * (grid[xi + 1] - grid[xi]);
+		}
+	}
+
+	// Restore the array
+	ierr = DMDAVecRestoreArrayDOFRead(da, C, &concs);
+	checkPetscError(ierr, "PetscSolver2DHandler::computeDisappearingRates: "
+			"DMDAVecRestoreArrayDOFRead failed.");
+
+	// Share the concentrations with all the processes
+	MPI_Allreduce(atomConc.data(), totalAtomConc.data(), nY, MPI_DOUBLE,
+	MPI_SUM, MPI_COMM_WORLD);
+
+	// Set the disappearing rates in the modified TM handler
+	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+		// Skip if we are not on the right process
+		if (yj < ys || yj >= ys + ym)
+			continue;
+
+		mutationHandler->updateDisappearingRate(totalAtomConc[yj], yj - ys);
+	}
+
+	return;
+}
+
 } /* end namespace xolotlSolver */
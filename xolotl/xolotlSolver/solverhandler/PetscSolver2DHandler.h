@@ -67,6 +67,13 @@ public:
 	 */
 	void computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J, PetscReal ftime);
 
+	/**
+	 * Compute the concentration of trapped atoms near the surface for the
+	 * attenuation of the trap-mutation.
+	 * \see PetscSolverHandler.h
+	 */
+	void computeDisappearingRates(DM &da, Vec &C) override;
+
 	/**
 	 * Get the position of the surface.
 	 * \see ISolverHandler.h
@@ -2,6 +2,9 @@
 #include <PetscSolver3DHandler.h>
 #include <MathUtils.h>
 #include <Constants.h>
+#include <xolotlPerf.h>
+
+namespace xperf = xolotlPerf;
 
 namespace xolotlSolver {
 
@@ -332,7 +335,6 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	double **concVector = new double*[7];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
 	std::vector<double> incidentFluxVector;
-	double atomConc = 0.0, totalAtomConc = 0.0;
 
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
@@ -341,42 +343,6 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
 		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
-			// Computing the trapped atom concentration is only needed for the attenuation
-			if (useAttenuation) {
-				// Compute the total concentration of atoms contained in bubbles
-				atomConc = 0.0;
-
-				// Loop over grid points
-				for (int xi = surfacePosition[yj][zk] + leftOffset;
-						xi < nX - rightOffset; xi++) {
-					// We are only interested in the helium near the surface
-					if ((grid[xi] + grid[xi + 1]) / 2.0
-							- grid[surfacePosition[yj][zk] + 1] > 2.0)
-						continue;
-
-					// Check if we are on the right processor
-					if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym
-							&& zk >= zs && zk < zs + zm) {
-						// Get the concentrations at this grid point
-						concOffset = concs[zk][yj][xi];
-						// Copy data into the PSIClusterReactionNetwork
-						network.updateConcentrationsFromArray(concOffset);
-
-						// Sum the total atom concentration
-						atomConc += network.getTotalTrappedAtomConcentration()
-								* (grid[xi + 1] - grid[xi]);
-					}
-				}
-
-				// Share the concentration with all the processes
-				totalAtomConc = 0.0;
-				MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-				MPI_COMM_WORLD);
-
-				// Set the disappearing rate in the modified TM handler
-				mutationHandler->updateDisappearingRate(totalAtomConc);
-			}
-
 			// Skip if we are not on the right process
 			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
 				continue;
@@ -423,6 +389,7 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 				// Heat condition
 				if (xi == surfacePosition[yj][zk]) {
+					xperf::ScopedPhase phase(xperf::Phase::HeatEquation);
 					temperatureHandler->computeTemperature(concVector,
 							updatedConcOffset, hxLeft, hxRight, xi, sy, yj, sz,
 							zk);
@@ -448,6 +415,8 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				if (skip)
 					continue;
 
+				xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 				// Update the network if the temperature changed
 				// left
 				double temperature = concs[zk][yj][xi - 1][dof - 1];
@@ -483,6 +452,8 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 					lastTemperature[xi + 1 - xs] = temperature;
 				}
 
+				phase.leave();
+
 				// Copy data into the ReactionNetwork so that it can
 				// compute the fluxes properly. The network is only used to compute the
 				// fluxes and hold the state data from the last time step. I'm reusing
@@ -491,19 +462,23 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				network.updateConcentrationsFromArray(concOffset);
 
 				// ----- Account for flux of incoming particles -----
+				phase.enter(xperf::Phase::Flux);
 				fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 						surfacePosition[yj][zk]);
 
 				// ---- Compute the temperature over the locally owned part of the grid -----
+				phase.enter(xperf::Phase::HeatEquation);
 				temperatureHandler->computeTemperature(concVector,
 						updatedConcOffset, hxLeft, hxRight, xi, sy, yj, sz, zk);
 
 				// ---- Compute diffusion over the locally owned part of the grid -----
+				phase.enter(xperf::Phase::Diffusion);
 				diffusionHandler->computeDiffusion(network, concVector,
 						updatedConcOffset, hxLeft, hxRight, xi - xs, sy,
 						yj - ys, sz, zk - zs);
 
 				// ---- Compute advection over the locally owned part of the grid -----
+				phase.enter(xperf::Phase::Advection);
 				// Set the grid position
 				gridPosition[0] = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 				for (int i = 0; i < advectionHandlers.size(); i++) {
@@ -513,14 +488,17 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				}
 
 				// ----- Compute the modified trap-mutation over the locally owned part of the grid -----
+				phase.enter(xperf::Phase::TrapMutation);
 				mutationHandler->computeTrapMutation(network, concOffset,
 						updatedConcOffset, xi - xs, yj - ys, zk - zs);
 
 				// ----- Compute the re-solution over the locally owned part of the grid -----
+				phase.enter(xperf::Phase::ReSolution);
 				resolutionHandler->computeReSolution(network, concOffset,
 						updatedConcOffset, xi, xs, yj, zk);
 
 				// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+				phase.enter(xperf::Phase::Reactions);
 				network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
 			}
 		}
@@ -630,10 +608,14 @@ void PetscSolver3DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 
 				// Heat condition
 				if (xi == surfacePosition[yj][zk]) {
+					xperf::ScopedPhase phase(xperf::Phase::HeatEquation);
+
 					// Get the partial derivatives for the temperature
 					temperatureHandler->computePartialsForTemperature(tempVals,
 							tempIndices, hxLeft, hxRight, xi, sy, yj, sz, zk);
 
+					phase.enter(xperf::Phase::MatrixAssembly);
+
 					// Set grid coordinate and component number for the row
 					row.i = xi;
 					row.j = yj;
@@ -698,6 +680,8 @@ void PetscSolver3DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 				if (skip)
 					continue;
 
+				xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 				// Update the network if the temperature changed
 				// left
 				double temperature = concs[zk][yj][xi - 1][dof - 1];
@@ -732,9 +716,12 @@ void PetscSolver3DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 				}
 
 				// Get the partial derivatives for the temperature
+				phase.enter(xperf::Phase::HeatEquation);
 				temperatureHandler->computePartialsForTemperature(tempVals,
 						tempIndices, hxLeft, hxRight, xi, sy, yj, sz, zk);
 
+				phase.enter(xperf::Phase::MatrixAssembly);
+
 				// Set grid coordinate and component number for the row
 				row.i = xi;
 				row.j = yj;
@@ -779,10 +766,13 @@ void PetscSolver3DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 								"MatSetValuesStencil (temperature) failed.");
 
 				// Get the partial derivatives for the diffusion
+				phase.enter(xperf::Phase::Diffusion);
 				diffusionHandler->computePartialsForDiffusion(network, diffVals,
 						diffIndices, hxLeft, hxRight, xi - xs, sy, yj - ys, sz,
 						zk - zs);
 
+				phase.enter(xperf::Phase::MatrixAssembly);
+
 				// Loop on the number of diffusion cluster to set the values in the Jacobian
 				for (int i = 0; i < nDiff; i++) {
 					// Set grid coordinate and component number for the row
@@ -834,6 +824,7 @@ void PetscSolver3DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 				// Set the grid position
 				gridPosition[0] = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 				for (int l = 0; l < advectionHandlers.size(); l++) {
+					phase.enter(xperf::Phase::Advection);
 					advectionHandlers[l]->computePartialsForAdvection(network,
 							advecVals, advecIndices, gridPosition, hxLeft,
 							hxRight, xi - xs, hY, yj - ys, hZ, zk - zs);
@@ -846,6 +837,8 @@ void PetscSolver3DHandler::computeOffDiagonalJacobian(TS &ts, Vec &localC,
 					// Get the number of advecting clusters
 					nAdvec = advectionHandlers[l]->getNumberOfAdvecting();
 
+					phase.enter(xperf::Phase::MatrixAssembly);
+
 					// Loop on the number of advecting cluster to set the values in the Jacobian
 					for (int i = 0; i < nAdvec; i++) {
 						// Set grid coordinate and component number for the row
@@ -932,49 +925,12 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	int pdColIdsVectorSize = 0;
 
 	// Declarations for variables used in the loop
-	double atomConc = 0.0, totalAtomConc = 0.0;
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
 
 	// Loop over the grid points
 	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
 		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
-			// Computing the trapped atom concentration is only needed for the attenuation
-			if (useAttenuation) {
-				// Compute the total concentration of atoms contained in bubbles
-				atomConc = 0.0;
-
-				// Loop over grid points
-				for (int xi = surfacePosition[yj][zk] + leftOffset;
-						xi < nX - rightOffset; xi++) {
-					// We are only interested in the helium near the surface
-					if ((grid[xi] + grid[xi + 1]) / 2.0
-							- grid[surfacePosition[yj][zk] + 1] > 2.0)
-						continue;
-
-					// Check if we are on the right processor
-					if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym
-							&& zk >= zs && zk < zs + zm) {
-						// Get the concentrations at this grid point
-						concOffset = concs[zk][yj][xi];
-						// Copy data into the PSIClusterReactionNetwork
-						network.updateConcentrationsFromArray(concOffset);
-
-						// Sum the total atom concentration
-						atomConc += network.getTotalTrappedAtomConcentration()
-								* (grid[xi + 1] - grid[xi]);
-					}
-				}
-
-				// Share the concentration with all the processes
-				totalAtomConc = 0.0;
-				MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-				MPI_COMM_WORLD);
-
-				// Set the disappearing rate in the modified TM handler
-				mutationHandler->updateDisappearingRate(totalAtomConc);
-			}
-
 			// Skip if we are not on the right process
 			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
 				continue;
@@ -1009,6 +965,8 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 						/ (grid[grid.size() - 1]
 								- grid[surfacePosition[yj][zk] + 1]);
 
+				xperf::ScopedPhase phase(xperf::Phase::SetTemperature);
+
 				// Get the temperature from the temperature handler
 				concOffset = concs[zk][yj][xi];
 				temperatureHandler->setTemperature(concOffset);
@@ -1025,6 +983,8 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 					lastTemperature[xi + 1 - xs] = temperature;
 				}
 
+				phase.leave();
+
 				// Copy data into the ReactionNetwork so that it can
 				// compute the new concentrations.
 				network.updateConcentrationsFromArray(concOffset);
@@ -1032,10 +992,12 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				// ----- Take care of the reactions for all the reactants -----
 
 				// Compute all the partial derivatives for the reactions
+				phase.enter(xperf::Phase::Reactions);
 				network.computeAllPartials(reactionStartingIdx, reactionIndices,
 						reactionVals, xi + 1 - xs);
 
 				// Update the column in the Jacobian that represents each DOF
+				phase.enter(xperf::Phase::MatrixAssembly);
 				for (int i = 0; i < dof - 1; i++) {
 					// Set grid coordinate and component number for the row
 					rowId.i = xi;
@@ -1079,10 +1041,13 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				PetscInt mutationIndices[3 * nHelium];
 
 				// Compute the partial derivative from modified trap-mutation at this grid point
+				phase.enter(xperf::Phase::TrapMutation);
 				int nMutating = mutationHandler->computePartialsForTrapMutation(
 						network, mutationVals, mutationIndices, xi - xs,
 						yj - ys, zk - zs);
 
+				phase.enter(xperf::Phase::MatrixAssembly);
+
 				// Loop on the number of helium undergoing trap-mutation to set the values
 				// in the Jacobian
 				for (int i = 0; i < nMutating; i++) {
@@ -1135,11 +1100,14 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				MatStencil rowIds[5];
 
 				// Compute the partial derivative from re-solution at this grid point
+				phase.enter(xperf::Phase::ReSolution);
 				int nResoluting =
 						resolutionHandler->computePartialsForReSolution(network,
 								resolutionVals, resolutionIndices, xi, xs, yj,
 								zk);
 
+				phase.enter(xperf::Phase::MatrixAssembly);
+
 				// Loop on the number of xenon to set the values in the Jacobian
 				for (int i = 0; i < nResoluting; i++) {
 					// Set grid coordinate and component number for the row and column
@@ -1192,4 +1160,75 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	return;
 }
 
+void PetscSolver3DHandler::computeDisappearingRates(DM &da, Vec &C) {
+	PetscErrorCode ierr;
+
+	// Get the concentrations
+	PetscScalar ****concs = nullptr;
+	ierr = DMDAVecGetArrayDOFRead(da, C, &concs);
+	checkPetscError(ierr, "PetscSolver3DHandler::computeDisappearingRates: "
+			"DMDAVecGetArrayDOFRead failed.");
+
+	// Get local grid boundaries
+	PetscInt xs, xm, ys, ym, zs, zm;
+	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
+	checkPetscError(ierr, "PetscSolver3DHandler::computeDisappearingRates: "
+			"DMDAGetCorners failed.");
+
+	// The concentration of atoms contained in bubbles for each column,
+	// all the columns are summed at once
+	std::vector<double> atomConc(nY * nZ, 0.0), totalAtomConc(nY * nZ, 0.0);
+	auto const& trappedWeights = network.getTotalTrappedAtomWeights();
+
+	// Loop over the columns
+	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
+		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+			// Skip if we are not on the right process
+			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
+				continue;
+
+			// Loop over grid points
+			for (int xi = surfacePosition[yj][zk] + leftOffset;
+					xi < nX - rightOffset; xi++) {
+				// Skip if we are not on the right process
+				if (xi < xs || xi >= xs + xm)
+					continue;
+
+				// We are only interested in the helium near the surface
+				if ((grid[xi] + grid[xi + 1]) / 2.0
+						- grid[surfacePosition[yj][zk] + 1] > 2.0)
+					continue;
+
+				// Sum the total atom concentration
+				atomConc[zk * nY + yj] +=
+						xolotlCore::IReactionNetwork::sumWeights(trappedWeights,
+								concs[zk][yj][xi]) * (grid[xi + 1] - grid[xi]);
+			}
+		}
+	}
+
+	// Restore the array
+	ierr = DMDAVecRestoreArrayDOFRead(da, C, &concs);
+	checkPetscError(ierr, "PetscSolver3DHandler::computeDisappearingRates: "
+			"DMDAVecRestoreArrayDOFRead failed.");
+
+	// Share the concentrations with all the processes
+	MPI_Allreduce(atomConc.data(), totalAtomConc.data(), nY * nZ, MPI_DOUBLE,
+	MPI_SUM, MPI_COMM_WORLD);
+
+	// Set the disappearing rates in the modified TM handler
+	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
+		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+			// Skip if we are not on the right process
+			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
+				continue;
+
+			mutationHandler->updateDisappearingRate(
+					totalAtomConc[zk * nY + yj], yj - ys, zk - zs);
+		}
+	}
+
+	return;
+}
+
 } /* end namespace xolotlSolver */
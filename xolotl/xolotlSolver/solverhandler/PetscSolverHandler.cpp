@@ -1,4 +1,5 @@
 #include "xolotlSolver/solverhandler/PetscSolverHandler.h"
+#include <xolotlPerf.h>
 
 namespace xolotlSolver {
 
@@ -39,4 +40,37 @@ std::vector<PetscInt> PetscSolverHandler::ConvertToPetscSparseFillMap(
 	return ret;
 }
 
+void PetscSolverHandler::updateAttenuation(TS &ts, Vec &C) {
+	// Nothing to do without attenuation
+	if (!useAttenuation)
+		return;
+
+	// The id and state of the vector change whenever its values do
+	PetscErrorCode ierr;
+	PetscObjectId id;
+	PetscObjectState state;
+	ierr = PetscObjectGetId((PetscObject) C, &id);
+	checkPetscError(ierr,
+			"PetscSolverHandler::updateAttenuation: PetscObjectGetId failed.");
+	ierr = PetscObjectStateGet((PetscObject) C, &state);
+	checkPetscError(ierr,
+			"PetscSolverHandler::updateAttenuation: PetscObjectStateGet failed.");
+
+	// The rates were already computed for this solution
+	if (mutationHandler->isDisappearingRateUpToDate(id, state))
+		return;
+
+	// Get the distributed array
+	DM da;
+	ierr = TSGetDM(ts, &da);
+	checkPetscError(ierr,
+			"PetscSolverHandler::updateAttenuation: TSGetDM failed.");
+
+	xolotlPerf::ScopedPhase phase(xolotlPerf::Phase::Attenuation);
+	computeDisappearingRates(da, C);
+	mutationHandler->setDisappearingRateState(id, state);
+
+	return;
+}
+
 } // nmaespace xolotlSolver
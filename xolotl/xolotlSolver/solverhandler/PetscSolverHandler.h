@@ -74,6 +74,16 @@ protected:
 	 */
 	std::vector<PetscScalar> reactionVals;
 
+	/**
+	 * The diagonal and off-diagonal block fills in the format that
+	 * PETSc's DMDASetBlockFillsSparse() expects. They are kept so that
+	 * a repartitioned distributed array gets the same fills.
+	 */
+	std::vector<PetscInt> dfillSparse, ofillSparse;
+
+	//! To know if the grid should be repartitioned before continuing.
+	bool repartitionFlag;
+
 	/**
 	 * Convert a C++ sparse fill map representation to the one that
 	 * PETSc's DMDASetBlockFillsSparse() expects.
@@ -86,6 +96,17 @@ protected:
 	static std::vector<PetscInt> ConvertToPetscSparseFillMap(size_t dof,
 			const xolotlCore::IReactionNetwork::SparseFillMap& fillMap);
 
+	/**
+	 * Compute the concentration of trapped atoms near the surface and give
+	 * it to the trap-mutation handler. It is collective.
+	 *
+	 * @param da The distributed array
+	 * @param C The PETSc global solution vector
+	 */
+	virtual void computeDisappearingRates(DM &da, Vec &C) {
+		return;
+	}
+
 public:
 
 	/**
@@ -99,9 +120,41 @@ public:
 	 * @param _network The reaction network to use.
 	 */
 	PetscSolverHandler(xolotlCore::IReactionNetwork& _network) :
-			SolverHandler(_network) {
+			SolverHandler(_network), repartitionFlag(false) {
+	}
+
+	/**
+	 * Repartition the grid, only implemented in 1D.
+	 * \see ISolverHandler.h
+	 */
+	void repartitionSolverContext(DM &da, Vec &C) override {
+		throw std::string(
+				"\nxolotlSolver::PetscSolverHandler: repartitioning the grid "
+						"is only implemented in 1D.");
+	}
+
+	/**
+	 * Set whether the grid should be repartitioned.
+	 * \see ISolverHandler.h
+	 */
+	void setRepartitionNeeded(bool flag) override {
+		repartitionFlag = flag;
+	}
+
+	/**
+	 * To know if the grid should be repartitioned.
+	 * \see ISolverHandler.h
+	 */
+	bool repartitionNeeded() const override {
+		return repartitionFlag;
 	}
 
+	/**
+	 * Update the attenuation if the solution changed since the last time.
+	 * \see ISolverHandler.h
+	 */
+	void updateAttenuation(TS &ts, Vec &C) override;
+
 };
 //end class PetscSolverHandler
 
@@ -5,6 +5,7 @@
 #include "ISolverHandler.h"
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
+#include "xolotlCore/io/RestartRemap.h"
 #include <Constants.h>
 #include <TokenizedLineReader.h>
 
@@ -94,6 +95,9 @@ protected:
 	//! If the user wants to use a Chebyshev grid.
 	bool readInGrid;
 
+	//! How to move the restart concentrations onto our grid, none to keep the grid of the restart file.
+	std::string restartRemap;
+
 	//! If the user wants to move the surface.
 	bool movingSurface;
 
@@ -378,6 +382,36 @@ protected:
 		return;
 	}
 
+	/**
+	 * Build what moves the concentrations of the restart file onto our
+	 * grid and network. It must be called once the grid is generated.
+	 * Without a remap method the grids should be the same and only the
+	 * clusters are matched.
+	 *
+	 * @param xfile The restart file
+	 * @return The remap
+	 */
+	std::unique_ptr<xolotlCore::RestartRemap> createRestartRemap(
+			const xolotlCore::XFile& xfile) const {
+		auto headerGroup = xfile.getGroup<xolotlCore::XFile::HeaderGroup>();
+		assert(headerGroup);
+
+		// Our grid points, relative to the first one
+		std::vector<double> positions;
+		for (int i = 1; i + 1 < (int) grid.size(); i++) {
+			positions.push_back(grid[i] - grid[1]);
+		}
+
+		return std::unique_ptr<xolotlCore::RestartRemap>(
+				new xolotlCore::RestartRemap(headerGroup->readGrid(),
+						positions, headerGroup->readNetworkComps(),
+						network.getCompositionList(), network.getDOF(),
+						(restartRemap == "none") ?
+								xolotlCore::RestartRemap::Method::Conservative :
+								xolotlCore::RestartRemap::getMethod(
+										restartRemap)));
+	}
+
 	/**
 	 * Constructor.
 	 *
@@ -388,7 +422,8 @@ protected:
 					0.0), hZ(0.0), leftOffset(1), rightOffset(1), bottomOffset(
 					1), topOffset(1), frontOffset(1), backOffset(1), initialVConc(
 					0.0), electronicStoppingPower(0.0), dimension(-1), portion(
-					0.0), useRegularGrid(""), readInGrid(false), movingSurface(
+					0.0), useRegularGrid(""), readInGrid(false), restartRemap(
+					"none"), movingSurface(
 					false), bubbleBursting(false), useAttenuation(false), sputteringYield(
 					0.0), fluxHandler(nullptr), temperatureHandler(nullptr), diffusionHandler(
 					nullptr), mutationHandler(nullptr), resolutionHandler(
@@ -438,6 +473,7 @@ public:
 
 		// Set the network loader
 		networkName = options.getNetworkFilename();
+		restartRemap = options.getRestartRemap();
 
 		// Set the grid options
 		// Take the parameter file option by default
@@ -454,8 +490,12 @@ public:
 			if (headerGroup) {
 				headerGroup->read(nx, hx, ny, hy, nz, hz);
 
-				nX = nx, nY = ny, nZ = nz;
-				hX = hx, hY = hy, hZ = hz;
+				// Keep our grid in the depth direction if the restart
+				// concentrations are remapped onto it
+				if (restartRemap == "none")
+					nX = nx, hX = hx;
+				nY = ny, nZ = nz;
+				hY = hy, hZ = hz;
 			}
 		}
 
@@ -502,6 +542,11 @@ public:
 
 		// Set the number of dimension
 		dimension = options.getDimensionNumber();
+		if (restartRemap != "none" and dimension > 1) {
+			throw std::string(
+					"\nxolotlSolver::SolverHandler: the restart concentrations "
+							"can only be remapped in 0D and 1D.");
+		}
 
 		// Set the void portion
 		portion = options.getVoidPortion();